@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace onnxruntime {
+/**
+   Read-only view of the bytes of a string owned by someone else, e.g. an element of a string tensor.
+   This is the subset of std::string_view needed to read strings without copying them, until the
+   code base moves to C++17.
+*/
+class StringView {
+ public:
+  StringView() noexcept : data_(nullptr), size_(0) {}
+  StringView(const char* data, size_t size) noexcept : data_(data), size_(size) {}
+  StringView(const std::string& s) noexcept : data_(s.data()), size_(s.size()) {}
+
+  const char* data() const noexcept { return data_; }
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const char* begin() const noexcept { return data_; }
+  const char* end() const noexcept { return data_ + size_; }
+  char operator[](size_t i) const noexcept { return data_[i]; }
+
+  std::string ToString() const { return std::string(data_, size_); }
+
+  bool operator==(const StringView& other) const noexcept {
+    return size_ == other.size_ && (size_ == 0 || std::memcmp(data_, other.data_, size_) == 0);
+  }
+  bool operator!=(const StringView& other) const noexcept { return !(*this == other); }
+
+ private:
+  const char* data_;
+  size_t size_;
+};
+
+/**
+   Hashes the bytes of a StringView with FNV-1a, so views can be looked up in unordered containers
+   keyed by StringView.
+*/
+struct StringViewHash {
+  size_t operator()(const StringView& s) const noexcept {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char ch : s) {
+      hash ^= static_cast<unsigned char>(ch);
+      hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+  }
+};
+}  // namespace onnxruntime
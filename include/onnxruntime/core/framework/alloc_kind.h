@@ -20,13 +20,17 @@ namespace onnxruntime {
 //     do not try to optimize for "slice" like ops, where we may be able to
 //     conditionally reuse memory/data in some cases but not others.
 //     Generalizing this is future work.
+//   - sub-buffers: tensor values placed inside the buffer of another tensor
+//     value, e.g. the inputs of a Concat along the outermost axis inside the
+//     Concat output, so their producers write the concatenated result directly.
 
 enum class AllocKind {
   kAllocate = 0,
   kReuse = 1,
   kPreExisting = 2,
   kAllocateStatically = 3,
-  kAllocateOutput = 4
+  kAllocateOutput = 4,
+  kSubBuffer = 5
 };
 
 std::ostream& operator<<(std::ostream& out, AllocKind alloc_kind);
@@ -58,6 +58,14 @@ class KernelDef {
     return alias_map_;
   }
 
+  const std::vector<int>& MayStridedInput() const {
+    return may_strided_inputs_;
+  }
+
+  const std::vector<std::pair<int, int>>& MayStridedOutput() const {
+    return may_strided_output_map_;
+  }
+
   OrtMemType InputMemoryType(size_t input_index) const {
     auto it = input_memory_type_args_.find(input_index);
     if (it == input_memory_type_args_.end())
@@ -108,6 +116,14 @@ class KernelDef {
   // An element <i, j> means that output j is an alias of input i.
   std::vector<std::pair<int, int>> alias_map_;
 
+  // The inputs that this kernel can consume as non-contiguous (strided) tensors.
+  // An index of -1 covers every input.
+  std::vector<int> may_strided_inputs_;
+
+  // An element <i, j> means that output j may be a strided view of input i.
+  // An output index of -1 covers every output.
+  std::vector<std::pair<int, int>> may_strided_output_map_;
+
   // The memory types of inputs/outputs of this kernel
   MemTypeMap input_memory_type_args_;
   MemTypeMap output_memory_type_args_;
@@ -191,6 +207,22 @@ class KernelDefBuilder {
   KernelDefBuilder& Alias(const std::vector<std::pair<int, int>>& aliases);
   KernelDefBuilder& Alias(int input_index, int output_index);
 
+  /**
+     The kernel handles a non-contiguous (strided) tensor at this input, see
+     Tensor::IsContiguous. Pass -1 for kernels with variadic inputs such as Concat.
+  */
+  KernelDefBuilder& MayStridedInput(int input_index);
+
+  /**
+     The output may be produced as a strided view of the input instead of a copy,
+     as Slice, Split and Transpose can. The allocation planner only places the
+     output on the input buffer when every consumer of the output declared
+     MayStridedInput for it; the kernel then describes the result with
+     Tensor::SetStridedView. Otherwise the kernel writes a contiguous copy.
+     Pass -1 as the output index for kernels with variadic outputs such as Split.
+  */
+  KernelDefBuilder& MayStridedOutput(int input_index, int output_index);
+
   /**
      Specify that this kernel requires an input arg
      in certain memory type (instead of the default, device memory).
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "core/common/string_view.h"
+
+namespace onnxruntime {
+/**
+   The strings of a string tensor stored one after the other in a single buffer, with the offset at which
+   each of them starts. Filling it grows two buffers for the whole tensor, where std::string elements
+   allocate once for every string too long for their internal buffer.
+   See Tensor::InitStringArena.
+*/
+class StringArena {
+ public:
+  StringArena() : offsets_(1, 0) {}
+
+  /** Reserves room for num_strings strings with num_bytes bytes in total. */
+  void Reserve(size_t num_strings, size_t num_bytes) {
+    offsets_.reserve(offsets_.size() + num_strings);
+    bytes_.reserve(bytes_.size() + num_bytes);
+  }
+
+  /** Appends a string after the last one. */
+  void Append(const char* data, size_t size) {
+    bytes_.insert(bytes_.end(), data, data + size);
+    offsets_.push_back(bytes_.size());
+  }
+
+  void Append(const StringView& s) { Append(s.data(), s.size()); }
+
+  size_t NumStrings() const noexcept { return offsets_.size() - 1; }
+  size_t NumBytes() const noexcept { return bytes_.size(); }
+
+  /** Returns the i-th string. The view is invalidated by the next Append. */
+  StringView operator[](size_t i) const noexcept {
+    assert(i < NumStrings());
+    return StringView(bytes_.data() + offsets_[i], offsets_[i + 1] - offsets_[i]);
+  }
+
+ private:
+  std::vector<char> bytes_;
+  // offsets_[i] is where the i-th string starts, and the last entry is where the next string will start.
+  std::vector<size_t> offsets_;
+};
+}  // namespace onnxruntime
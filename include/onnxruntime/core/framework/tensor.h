@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <cassert>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -11,6 +15,7 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/data_types.h"
+#include "core/framework/string_arena.h"
 #include "core/framework/tensor_shape.h"
 #include "onnxruntime_config.h"
 
@@ -86,6 +91,11 @@ class Tensor final {
   */
   const TensorShape& Shape() const noexcept { return shape_; }
 
+  /**
+     Returns true if the tensor releases its buffer when it is destroyed.
+  */
+  bool OwnsBuffer() const noexcept { return buffer_deleter_ != nullptr; }
+
   /**
      Returns the location of the tensor's memory
   */
@@ -99,6 +109,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(DataTypeImpl::GetType<T>() == dtype_, "Tensor type mismatch. ",
                 DataTypeImpl::GetType<T>(), "!=", dtype_);
+    MaterializeStringArena();
     return reinterpret_cast<T*>(static_cast<char*>(p_data_) + byte_offset_);
   }
 
@@ -110,6 +121,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(DataTypeImpl::GetType<T>() == dtype_, "Tensor type mismatch. ",
                 DataTypeImpl::GetType<T>(), "!=", dtype_);
+    MaterializeStringArena();
     T* data = reinterpret_cast<T*>(static_cast<char*>(p_data_) + byte_offset_);
     return gsl::make_span(data, shape_.Size());
   }
@@ -119,6 +131,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(DataTypeImpl::GetType<T>() == dtype_, "Tensor type mismatch. ",
                 DataTypeImpl::GetType<T>(), "!=", dtype_);
+    MaterializeStringArena();
     return reinterpret_cast<const T*>(static_cast<char*>(p_data_) + byte_offset_);
   }
 
@@ -127,40 +140,106 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(DataTypeImpl::GetType<T>() == dtype_, "Tensor type mismatch. ",
                 DataTypeImpl::GetType<T>(), "!=", dtype_);
+    MaterializeStringArena();
     const T* data = reinterpret_cast<const T*>(static_cast<char*>(p_data_) + byte_offset_);
     return gsl::make_span(data, shape_.Size());
   }
 
   void* MutableDataRaw(MLDataType type) {
     ORT_ENFORCE(type == dtype_, "Tensor type mismatch.", type, "!=", dtype_);
+    MaterializeStringArena();
     return p_data_;
   }
 
   const void* DataRaw(MLDataType type) const {
     ORT_ENFORCE(type == dtype_, "Tensor type mismatch.", type, "!=", dtype_);
+    MaterializeStringArena();
     return p_data_;
   }
 
-  void* MutableDataRaw() noexcept {
+  void* MutableDataRaw() {
+    MaterializeStringArena();
     return p_data_;
   }
 
-  const void* DataRaw() const noexcept {
+  const void* DataRaw() const {
+    MaterializeStringArena();
     return p_data_;
   }
 
+  /**
+     Returns the i-th string of a contiguous string tensor.
+     Unlike the accessors above, this reads the strings of a tensor holding them in a StringArena
+     without creating its std::string elements.
+  */
+  StringView StringAt(int64_t i) const {
+    assert(dtype_ == DataTypeImpl::GetType<std::string>() && IsContiguous());
+    if (string_arena_ != nullptr && !string_arena_->materialized.load(std::memory_order_acquire)) {
+      return string_arena_->arena[static_cast<size_t>(i)];
+    }
+    const auto* data = reinterpret_cast<const std::string*>(static_cast<const char*>(p_data_) + byte_offset_);
+    return StringView(data[i]);
+  }
+
+  /**
+     Makes a string tensor hold its strings in an empty StringArena, which the producer of the tensor fills
+     with exactly one string per element, in order. The std::string elements are only assigned from the
+     arena when the data of the tensor is accessed through one of the accessors above, so consumers using
+     StringAt never pay for them. This replaces any previous strings of the tensor.
+     @warning this function is NOT thread-safe, it is meant for the producer of the tensor.
+  */
+  StringArena& InitStringArena();
+
+  /**
+     Returns true if the strings of the tensor are held in a StringArena.
+  */
+  bool HasStringArena() const noexcept {
+    return string_arena_ != nullptr;
+  }
+
   /**
    * Resizes the tensor without touching underlying storage.
    * This requires the total size of the tensor to remains constant.
    * @warning this function is NOT thread-safe.
    */
   inline void Reshape(const TensorShape& new_shape) {
+    ORT_ENFORCE(IsContiguous(), "A strided tensor cannot be reshaped in place.");
     ORT_ENFORCE(shape_.Size() == new_shape.Size(),
                 "Tensor size (" + std::to_string(shape_.Size()) +
                     ") != new size (" + std::to_string(new_shape.Size()) + ")");
     shape_ = new_shape;
   }
 
+  /**
+     Returns the offset in bytes of the first element from the start of the buffer.
+  */
+  int64_t ByteOffset() const noexcept {
+    return byte_offset_;
+  }
+
+  /**
+     Returns true if the elements are stored densely in row-major order.
+     A tensor is only strided if a kernel made it a view with SetStridedView.
+  */
+  bool IsContiguous() const noexcept {
+    return strides_.empty();
+  }
+
+  /**
+     Returns the distance in elements between consecutive entries of each axis.
+     For a contiguous tensor these are derived from the shape.
+  */
+  std::vector<int64_t> Strides() const;
+
+  /**
+     Describes the tensor as a view of its buffer that starts byte_offset bytes into
+     the buffer and steps through it with the given per-axis strides (in elements).
+     This is how a kernel whose output was placed on the buffer of an input
+     (see KernelDefBuilder::MayStridedOutput) publishes a result without copying.
+     Strides that match the row-major layout of the shape leave the tensor contiguous.
+  */
+  void SetStridedView(const TensorShape& shape, const std::vector<int64_t>& strides, int64_t byte_offset);
+
   /**
   The number of bytes of data.
   */
@@ -187,6 +266,15 @@ class Tensor final {
 
   void ReleaseBuffer();
 
+  // Assigns the std::string elements from the StringArena the first time the data is accessed.
+  void MaterializeStringArena() const {
+    if (string_arena_ != nullptr && !string_arena_->materialized.load(std::memory_order_acquire)) {
+      MaterializeStringArenaOnce();
+    }
+  }
+
+  void MaterializeStringArenaOnce() const;
+
   void* p_data_;
   /**
      if buffer_deleter_ is null, it means tensor does not own the buffer.
@@ -199,6 +287,18 @@ class Tensor final {
   MLDataType dtype_;
   OrtAllocatorInfo alloc_info_;
   int64_t byte_offset_;
+  // empty unless the tensor is a non-contiguous view; see SetStridedView.
+  std::vector<int64_t> strides_;
+
+  // Strings held in an arena instead of the std::string elements; see InitStringArena.
+  // The arena is kept until the tensor is released as consumers may still read it through StringAt
+  // while another one materializes the std::string elements.
+  struct StringArenaState {
+    StringArena arena;
+    std::once_flag materialize_once;
+    std::atomic<bool> materialized{false};
+  };
+  std::unique_ptr<StringArenaState> string_arena_;
 };
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
@@ -142,6 +142,7 @@ ORT_RUNTIME_CLASS(RunOptions);
 ORT_RUNTIME_CLASS(TypeInfo);
 ORT_RUNTIME_CLASS(TensorTypeAndShapeInfo);
 ORT_RUNTIME_CLASS(SessionOptions);
+ORT_RUNTIME_CLASS(IoBinding);
 
 // When passing in an allocator to any ORT function, be sure that the allocator object
 // is not destroyed until the last allocated object using it is freed.
@@ -184,6 +185,60 @@ ORT_API_STATUS(OrtRun, _Inout_ OrtSession* sess,
                _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
                _In_ const char* const* output_names, size_t output_names_len, _Out_ OrtValue** output);
 
+/**
+ * Input/output binding. Inputs and outputs are bound once by name and the binding can be run
+ * several times. Outputs bound to a pre-allocated OrtValue are written directly into it when the shape
+ * produced by the model matches, so repeated runs don't allocate their outputs.
+ * \param out Should be freed by OrtReleaseIoBinding after use. It must not outlive 'sess'.
+ */
+ORT_API_STATUS(OrtCreateIoBinding, _Inout_ OrtSession* sess, _Out_ OrtIoBinding** out);
+
+/**
+ * Binding the same name again replaces the previous value.
+ * The input may be copied to the device required by the model, 'value' can be released after this call.
+ */
+ORT_API_STATUS(OrtBindInput, _Inout_ OrtIoBinding* binding, _In_ const char* name, _In_ const OrtValue* value);
+
+/**
+ * \param value A pre-allocated output. It is shared with the binding and stays valid after OrtReleaseValue
+ * until the binding is released or the output is bound again.
+ */
+ORT_API_STATUS(OrtBindOutput, _Inout_ OrtIoBinding* binding, _In_ const char* name, _In_ const OrtValue* value);
+
+/**
+ * Bind an output to a device without knowing its shape. It is allocated by the first run and reused afterwards.
+ */
+ORT_API_STATUS(OrtBindOutputToDevice, _Inout_ OrtIoBinding* binding, _In_ const char* name,
+               _In_ const OrtAllocatorInfo* info);
+
+ORT_API(void, OrtClearBoundInputs, _Inout_ OrtIoBinding* binding);
+ORT_API(void, OrtClearBoundOutputs, _Inout_ OrtIoBinding* binding);
+
+/**
+ * Keep the output 'output_name' between runs and feed it to the input 'input_name' in the next run, e.g. to run an
+ * RNN on a stream one frame at a time without copying its state in and out. The state stays in buffers owned by
+ * the binding, it is also returned as a bound output and is overwritten by the run after next.
+ * \param initial_value Fed to the input until the first run and after OrtResetBoundStates. If it is NULL the input
+ * gets its default value from the model in those runs.
+ */
+ORT_API_STATUS(OrtBindState, _Inout_ OrtIoBinding* binding, _In_ const char* input_name,
+               _In_ const char* output_name, _In_opt_ const OrtValue* initial_value);
+
+/**
+ * Restart all the bound states from their initial value, e.g. at the start of a new stream.
+ */
+ORT_API(void, OrtResetBoundStates, _Inout_ OrtIoBinding* binding);
+
+ORT_API_STATUS(OrtRunWithBinding, _Inout_ OrtSession* sess, _In_opt_ OrtRunOptions* run_options,
+               _Inout_ OrtIoBinding* binding);
+
+ORT_API_STATUS(OrtGetBoundOutputCount, _In_ const OrtIoBinding* binding, _Out_ size_t* out);
+
+/**
+ * \param out Should be freed by OrtReleaseValue after use. The buffer is shared with the binding.
+ */
+ORT_API_STATUS(OrtGetBoundOutputValue, _In_ const OrtIoBinding* binding, size_t index, _Out_ OrtValue** out);
+
 /**
  * \return A pointer of the newly created object. The pointer should be freed by OrtReleaseSessionOptions after use
  */
@@ -220,6 +275,10 @@ ORT_API(void, OrtSetSessionLogVerbosityLevel, _In_ OrtSessionOptions* options, u
 // How many threads in the session thread pool.
 ORT_API(int, OrtSetSessionThreadPoolSize, _In_ OrtSessionOptions* options, int session_thread_pool_size);
 
+// How many threads the kernels of the default CPU execution provider split their work across.
+// By default there is one per hardware thread.
+ORT_API(int, OrtSetIntraOpNumThreads, _In_ OrtSessionOptions* options, int intra_op_num_threads);
+
 /**
   * To use additional providers, you must build ORT with the extra providers enabled. Then call one of these
   * functions to enable them in the session:
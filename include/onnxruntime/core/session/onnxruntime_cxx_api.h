@@ -67,6 +67,13 @@ struct default_delete<OrtTensorTypeAndShapeInfo> {
   }
 };
 
+template <>
+struct default_delete<OrtIoBinding> {
+  void operator()(OrtIoBinding* ptr) {
+    OrtReleaseIoBinding(ptr);
+  }
+};
+
 template <>
 struct default_delete<OrtSessionOptions> {
   void operator()(OrtSessionOptions* ptr) {
@@ -107,6 +114,9 @@ class SessionOptionsWrapper {
   void SetSessionThreadPoolSize(int session_thread_pool_size) {
     OrtSetSessionThreadPoolSize(value.get(), session_thread_pool_size);
   }
+  void SetIntraOpNumThreads(int intra_op_num_threads) {
+    OrtSetIntraOpNumThreads(value.get(), intra_op_num_threads);
+  }
 
   SessionOptionsWrapper clone() const {
     OrtSessionOptions* p = OrtCloneSessionOptions(value.get());
@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/embedding_bag.h"
+
+#include <mutex>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
+    EmbeddingBag);
+
+EmbeddingBag::EmbeddingBag(const OpKernelInfo& info) : OpKernel(info), thread_pool_(GetKernelThreadPool(info)) {
+  std::string mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+  ORT_ENFORCE(mode == "sum" || mode == "mean", "Invalid 'mode' attribute value: ", mode);
+  mean_ = mode == "mean";
+}
+
+Status EmbeddingBag::Compute(OpKernelContext* context) const {
+  const Tensor* data = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const TensorShape& data_shape = data->Shape();
+  const TensorShape& indices_shape = indices->Shape();
+
+  if (data_shape.NumDimensions() < 1 || indices_shape.NumDimensions() < 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "data and indices must have a rank of at least 1. data: ", data_shape,
+                           " indices: ", indices_shape);
+  }
+
+  // the bags are along the last axis of the indices, the rows along the first axis of the data
+  std::vector<int64_t> output_dims(indices_shape.GetDims().begin(), indices_shape.GetDims().end() - 1);
+  output_dims.insert(output_dims.end(), data_shape.GetDims().begin() + 1, data_shape.GetDims().end());
+  Tensor* output = context->Output(0, TensorShape(output_dims));
+
+  if (indices->DataType() == DataTypeImpl::GetType<int32_t>()) {
+    return ComputeImpl<int32_t>(*data, *indices, *output);
+  }
+  return ComputeImpl<int64_t>(*data, *indices, *output);
+}
+
+template <typename Tind>
+Status EmbeddingBag::ComputeImpl(const Tensor& data, const Tensor& indices, Tensor& output) const {
+  const TensorShape& indices_shape = indices.Shape();
+  const int64_t num_rows = data.Shape()[0];
+  const int64_t row_size = data.Shape().SizeFromDimension(1);
+  const int64_t bag_size = indices_shape[indices_shape.NumDimensions() - 1];
+  const int64_t num_bags = indices_shape.SizeToDimension(indices_shape.NumDimensions() - 1);
+
+  const float* table = data.template Data<float>();
+  const Tind* indices_data = indices.template Data<Tind>();
+  float* output_data = output.template MutableData<float>();
+  const float scale = (mean_ && bag_size > 0) ? 1.0f / static_cast<float>(bag_size) : 1.0f;
+
+  // A range stops at the first bag with an index out of bounds, reported once all ranges are done.
+  std::mutex invalid_mutex;
+  int64_t invalid_bag = num_bags;
+
+  const int64_t bytes_per_bag = bag_size * row_size * static_cast<int64_t>(sizeof(float));
+  thread_pool_.ParallelFor(num_bags, bytes_per_bag, [&](int64_t begin, int64_t end) {
+    for (int64_t bag = begin; bag < end; ++bag) {
+      const Tind* bag_indices = indices_data + bag * bag_size;
+      float* sum = output_data + bag * row_size;
+      std::fill_n(sum, row_size, 0.0f);
+
+      for (int64_t i = 0; i < bag_size; ++i) {
+        const Tind idx = bag_indices[i];
+        if (idx < 0 || idx >= num_rows) {
+          std::lock_guard<std::mutex> lock(invalid_mutex);
+          invalid_bag = std::min(invalid_bag, bag);
+          return;
+        }
+
+        if (i + 1 < bag_size) {
+          const Tind next_idx = bag_indices[i + 1];
+          if (next_idx >= 0 && next_idx < num_rows) {
+            GatherPrefetchRow(table + next_idx * row_size, row_size * static_cast<int64_t>(sizeof(float)));
+          }
+        }
+
+        const float* row = table + idx * row_size;
+        for (int64_t j = 0; j < row_size; ++j) {
+          sum[j] += row[j];
+        }
+      }
+
+      if (scale != 1.0f) {
+        for (int64_t j = 0; j < row_size; ++j) {
+          sum[j] *= scale;
+        }
+      }
+    }
+  });
+
+  if (invalid_bag != num_bags) {
+    const Tind* bag_indices = indices_data + invalid_bag * bag_size;
+    const Tind* idx = std::find_if(bag_indices, bag_indices + bag_size,
+                                   [num_rows](Tind i) { return i < 0 || i >= num_rows; });
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", *idx,
+                           " data_dim=", num_rows);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
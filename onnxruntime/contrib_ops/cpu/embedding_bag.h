@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/tensor/gather.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Gathers rows of an embedding table and reduces each bag of rows with a sum or a mean,
+// without materializing the gathered rows.
+class EmbeddingBag final : public OpKernel {
+ public:
+  explicit EmbeddingBag(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename Tind>
+  Status ComputeImpl(const Tensor& data, const Tensor& indices, Tensor& output) const;
+
+  bool mean_;
+
+  // Shared by all the kernels of the execution provider.
+  KernelThreadPool& thread_pool_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
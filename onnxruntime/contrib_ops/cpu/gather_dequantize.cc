@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/gather_dequantize.h"
+
+#include <mutex>
+
+#include "core/util/math_cpuonly.h"
+#include "Eigen/src/Core/arch/CUDA/Half.h"
+
+#if defined(USE_MLAS) && defined(_M_AMD64)
+#include "core/mlas/inc/mlas.h"
+#endif
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    GatherDequantize,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", {DataTypeImpl::GetTensorType<int8_t>(),
+                              DataTypeImpl::GetTensorType<uint8_t>(),
+                              DataTypeImpl::GetTensorType<MLFloat16>()})
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
+    GatherDequantize);
+
+namespace {
+
+// formula is Y = (X - ZeroPoint) * Scale
+template <typename T>
+void DequantizeRow(const T* row, const float* scale, const T* zero_point, int64_t row_size, float* output) {
+  const float sc = *scale;
+  const int zp = zero_point != nullptr ? static_cast<int>(*zero_point) : 0;
+  for (int64_t j = 0; j < row_size; ++j) {
+    output[j] = static_cast<float>(static_cast<int>(row[j]) - zp) * sc;
+  }
+}
+
+template <>
+void DequantizeRow<MLFloat16>(const MLFloat16* row, const float*, const MLFloat16*, int64_t row_size, float* output) {
+#if defined(USE_MLAS) && defined(_M_AMD64)
+  MlasConvertHalfToFloatBuffer(&row[0].val, output, static_cast<size_t>(row_size));
+#else
+  auto row_vector = ConstEigenVectorMap<Eigen::half>(static_cast<const Eigen::half*>(static_cast<const void*>(row)), row_size);
+  auto output_vector = EigenVectorMap<float>(output, row_size);
+  output_vector = row_vector.template cast<float>();
+#endif
+}
+
+}  // namespace
+
+Status GatherDequantize::Compute(OpKernelContext* context) const {
+  const Tensor* data = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const TensorShape& data_shape = data->Shape();
+  const TensorShape& indices_shape = indices->Shape();
+
+  if (data_shape.NumDimensions() < 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "data must have a rank of at least 1. data: ", data_shape);
+  }
+
+  std::vector<int64_t> output_dims(indices_shape.GetDims().begin(), indices_shape.GetDims().end());
+  output_dims.insert(output_dims.end(), data_shape.GetDims().begin() + 1, data_shape.GetDims().end());
+  Tensor* output = context->Output(0, TensorShape(output_dims));
+
+  const bool int32_indices = indices->DataType() == DataTypeImpl::GetType<int32_t>();
+  const auto data_type = data->DataType();
+  if (data_type == DataTypeImpl::GetType<int8_t>()) {
+    return int32_indices ? ComputeImpl<int8_t, int32_t>(context, *data, *indices, *output)
+                         : ComputeImpl<int8_t, int64_t>(context, *data, *indices, *output);
+  } else if (data_type == DataTypeImpl::GetType<uint8_t>()) {
+    return int32_indices ? ComputeImpl<uint8_t, int32_t>(context, *data, *indices, *output)
+                         : ComputeImpl<uint8_t, int64_t>(context, *data, *indices, *output);
+  }
+  return int32_indices ? ComputeImpl<MLFloat16, int32_t>(context, *data, *indices, *output)
+                       : ComputeImpl<MLFloat16, int64_t>(context, *data, *indices, *output);
+}
+
+template <typename T, typename Tind>
+Status GatherDequantize::ComputeImpl(OpKernelContext* context, const Tensor& data, const Tensor& indices,
+                                     Tensor& output) const {
+  const int64_t num_rows = data.Shape()[0];
+  const int64_t row_size = data.Shape().SizeFromDimension(1);
+  const int64_t N = indices.Shape().Size();
+
+  // the scale and zero point are per row, and only apply to the 8 bit tables
+  const Tensor* scale_tensor = context->Input<Tensor>(2);
+  const Tensor* zero_point_tensor = context->Input<Tensor>(3);
+  const float* scale = nullptr;
+  const T* zero_point = nullptr;
+  if (!std::is_same<T, MLFloat16>::value) {
+    if (scale_tensor == nullptr || scale_tensor->Shape().NumDimensions() != 1 ||
+        scale_tensor->Shape()[0] != num_rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "scale must be a 1D tensor with one element per row of data: ", num_rows);
+    }
+    scale = scale_tensor->template Data<float>();
+
+    if (zero_point_tensor != nullptr) {
+      if (zero_point_tensor->Shape() != scale_tensor->Shape()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "zero_point must be a 1D tensor with one element per row of data: ", num_rows);
+      }
+      zero_point = zero_point_tensor->template Data<T>();
+    }
+  }
+
+  const T* table = data.template Data<T>();
+  const Tind* indices_data = indices.template Data<Tind>();
+  float* output_data = output.template MutableData<float>();
+
+  // A range stops at the first index out of bounds, reported once all ranges are done.
+  std::mutex invalid_mutex;
+  int64_t invalid_index = N;
+
+  const int64_t row_bytes = row_size * static_cast<int64_t>(sizeof(T));
+  thread_pool_.ParallelFor(N, row_size * static_cast<int64_t>(sizeof(float)), [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      const Tind idx = indices_data[i];
+      if (idx < 0 || idx >= num_rows) {
+        std::lock_guard<std::mutex> lock(invalid_mutex);
+        invalid_index = std::min(invalid_index, i);
+        return;
+      }
+
+      if (i + kGatherPrefetchDistance < end) {
+        const Tind prefetch_idx = indices_data[i + kGatherPrefetchDistance];
+        if (prefetch_idx >= 0 && prefetch_idx < num_rows) {
+          GatherPrefetchRow(table + prefetch_idx * row_size, row_bytes);
+        }
+      }
+
+      DequantizeRow<T>(table + idx * row_size,
+                       scale != nullptr ? scale + idx : nullptr,
+                       zero_point != nullptr ? zero_point + idx : nullptr,
+                       row_size,
+                       output_data + i * row_size);
+    }
+  });
+
+  if (invalid_index != N) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=",
+                           indices_data[invalid_index], " data_dim=", num_rows);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
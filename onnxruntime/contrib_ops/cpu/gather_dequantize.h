@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/tensor/gather.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Gathers rows of an embedding table stored as 8 bit integers with a scale and zero point per row,
+// or as float16, and dequantizes the gathered rows into a float output.
+class GatherDequantize final : public OpKernel {
+ public:
+  explicit GatherDequantize(const OpKernelInfo& info) : OpKernel(info), thread_pool_(GetKernelThreadPool(info)) {}
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename T, typename Tind>
+  Status ComputeImpl(OpKernelContext* context, const Tensor& data, const Tensor& indices, Tensor& output) const;
+
+  // Shared by all the kernels of the execution provider.
+  KernelThreadPool& thread_pool_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
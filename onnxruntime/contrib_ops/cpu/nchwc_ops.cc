@@ -0,0 +1,237 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "nchwc_ops.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    ReorderInput,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    ReorderInput);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    ReorderOutput,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    ReorderOutput);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NchwcConv,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcConv);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NchwcMaxPool,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcMaxPool);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NchwcAveragePool,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcAveragePool);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NchwcGlobalMaxPool,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcGlobalMaxPool);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NchwcGlobalAveragePool,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcGlobalAveragePool);
+
+namespace {
+int64_t AlignChannels(int64_t channels) {
+  const auto block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  return (channels + block_size - 1) / block_size * block_size;
+}
+}  // namespace
+
+Status ReorderInput::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& X_shape = X->Shape();
+  ORT_RETURN_IF_NOT(X_shape.NumDimensions() == 4, "ReorderInput only supports 4D input. Got: ", X_shape);
+
+  std::vector<int64_t> Y_dims(X_shape.GetDims());
+  Y_dims[1] = AlignChannels(Y_dims[1]);
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+
+  MlasReorderInput(X_shape.GetDims().data(), X->template Data<float>(), Y->template MutableData<float>());
+  return Status::OK();
+}
+
+Status ReorderOutput::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& X_shape = X->Shape();
+  ORT_RETURN_IF_NOT(X_shape.NumDimensions() == 4, "ReorderOutput only supports 4D input. Got: ", X_shape);
+  ORT_RETURN_IF_NOT(channels_ <= X_shape[1], "Channel count exceeds the blocked input channels");
+
+  std::vector<int64_t> Y_dims(X_shape.GetDims());
+  Y_dims[1] = channels_;
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+
+  MlasReorderOutput(Y_dims.data(), X->template Data<float>(), Y->template MutableData<float>());
+  return Status::OK();
+}
+
+Status NchwcConv::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* B = OpKernel::Node().InputDefs().size() == 3 ? context->Input<Tensor>(2) : nullptr;
+
+  const auto& X_shape = X->Shape();
+  const auto& W_shape = W->Shape();
+  ORT_RETURN_IF_NOT(X_shape.NumDimensions() == 4, "NchwcConv only supports 4D input. Got: ", X_shape);
+  ORT_RETURN_IF_ERROR(ValidateInputShape(X, W));
+
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  ORT_RETURN_IF_NOT(X_shape[1] % block_size == 0 && W_shape[0] % block_size == 0,
+                    "NchwcConv channel counts must be a multiple of the block size");
+  ORT_RETURN_IF_NOT(B == nullptr || B->Shape().Size() == W_shape[0], "NchwcConv bias must be padded");
+
+  std::vector<int64_t> kernel_shape;
+  ORT_RETURN_IF_ERROR(ComputeKernelShape(W_shape, kernel_shape));
+
+  std::vector<int64_t> pads(pads_);
+  if (pads.empty()) {
+    pads.resize(kernel_shape.size() * 2, 0);
+  }
+  std::vector<int64_t> dilations(dilations_);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  std::vector<int64_t> strides(strides_);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  std::vector<int64_t> Y_dims({X_shape[0], W_shape[0]});
+  TensorShape input_shape = X_shape.Slice(2);
+  ORT_RETURN_IF_ERROR(InferOutputShape(input_shape, kernel_shape, strides, dilations, &pads, &Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+
+  MLAS_ACTIVATION Activation;
+  if (activation_.empty()) {
+    Activation.ActivationKind = MlasIdentityActivation;
+  } else if (activation_ == "Relu") {
+    Activation.ActivationKind = MlasReluActivation;
+  } else if (activation_ == "LeakyRelu") {
+    Activation.ActivationKind = MlasLeakyReluActivation;
+    Activation.alpha = alpha_;
+  } else if (activation_ == "Tanh") {
+    Activation.ActivationKind = MlasTanhActivation;
+  } else if (activation_ == "Sigmoid") {
+    Activation.ActivationKind = MlasLogisticActivation;
+  } else {
+    ORT_NOT_IMPLEMENTED("Not implemented fused activation: ", activation_);
+  }
+
+  MlasNchwcConv(kernel_shape.size(),
+                X_shape.GetDims().data(),
+                kernel_shape.data(),
+                dilations.data(),
+                pads.data(),
+                strides.data(),
+                Y_dims.data(),
+                X->template Data<float>(),
+                W->template Data<float>(),
+                B != nullptr ? B->template Data<float>() : nullptr,
+                Y->template MutableData<float>(),
+                &Activation);
+
+  return Status::OK();
+}
+
+NchwcPoolBase::NchwcPoolBase(const OpKernelInfo& info, MLAS_POOLING_KIND kind, bool global_pooling)
+    : OpKernel(info), kind_(kind), global_pooling_(global_pooling), auto_pad_(AutoPadType::NOTSET) {
+  if (!global_pooling_) {
+    ORT_ENFORCE(info.GetAttrs<int64_t>("kernel_shape", kernel_shape_).IsOK(), "No kernel shape is set.");
+    ORT_ENFORCE(kernel_shape_.size() == 2, "Only 2D pooling is supported.");
+
+    std::string auto_pad;
+    if (info.GetAttr<std::string>("auto_pad", &auto_pad).IsOK()) {
+      auto_pad_ = StringToAutoPadType(auto_pad);
+    }
+
+    if (!info.GetAttrs<int64_t>("pads", pads_).IsOK() || pads_.empty()) {
+      pads_.resize(kernel_shape_.size() * 2, 0);
+    }
+
+    if (!info.GetAttrs<int64_t>("strides", strides_).IsOK() || strides_.empty()) {
+      strides_.resize(kernel_shape_.size(), 1);
+    }
+
+    for (size_t dim = 0; dim < kernel_shape_.size(); ++dim) {
+      ORT_ENFORCE(kernel_shape_[dim] > 0);
+      ORT_ENFORCE(pads_[dim] < kernel_shape_[dim] && pads_[dim + kernel_shape_.size()] < kernel_shape_[dim],
+                  "Pad should be smaller than kernel.");
+    }
+  }
+}
+
+Status NchwcPoolBase::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& X_shape = X->Shape();
+  ORT_RETURN_IF_NOT(X_shape.NumDimensions() == 4, "Nchwc pooling only supports 4D input. Got: ", X_shape);
+
+  std::vector<int64_t> pads(pads_);
+  std::vector<int64_t> Y_dims({X_shape[0], X_shape[1]});
+
+  if (global_pooling_) {
+    Y_dims.push_back(1);
+    Y_dims.push_back(1);
+  } else {
+    for (size_t dim = 0; dim < kernel_shape_.size(); ++dim) {
+      int64_t dim_size = 0;
+      ORT_RETURN_IF_ERROR(ComputePadAndOutputShape<false>(X_shape[dim + 2],
+                                                          strides_[dim],
+                                                          kernel_shape_[dim],
+                                                          1,
+                                                          auto_pad_,
+                                                          &pads[dim],
+                                                          &pads[dim + kernel_shape_.size()],
+                                                          &dim_size));
+      ORT_RETURN_IF_NOT(dim_size > 0, "Invalid input shape: ", X_shape);
+      Y_dims.push_back(dim_size);
+    }
+  }
+
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+
+  MlasNchwcPool(kind_,
+                2,
+                X_shape.GetDims().data(),
+                global_pooling_ ? nullptr : kernel_shape_.data(),
+                global_pooling_ ? nullptr : pads.data(),
+                global_pooling_ ? nullptr : strides_.data(),
+                Y_dims.data(),
+                X->template Data<float>(),
+                Y->template MutableData<float>());
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
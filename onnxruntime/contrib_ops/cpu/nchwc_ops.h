@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/nn/conv_base.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Tensors consumed and produced by the Nchwc* operators are stored in the MLAS
+// NCHWc layout. Their shape is the NCHW shape with the channel count rounded up
+// to a multiple of MlasNchwcGetBlockSize().
+
+class ReorderInput : public OpKernel {
+ public:
+  ReorderInput(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+class ReorderOutput : public OpKernel {
+ public:
+  ReorderOutput(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(info.GetAttr<int64_t>("channels", &channels_).IsOK());
+    ORT_ENFORCE(channels_ > 0, "invalid channel count");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t channels_;
+};
+
+// The filter is expected to have been reordered by MlasReorderFilterOIHWBiBo and
+// the bias to have been padded to the aligned output channel count.
+class NchwcConv : public OpKernel, public ConvBase {
+ public:
+  NchwcConv(const OpKernelInfo& info) : OpKernel(info), ConvBase(info) {
+    ORT_ENFORCE(group_ == 1, "grouped convolution is not supported");
+    activation_ = info.GetAttrOrDefault<std::string>("activation", "");
+    alpha_ = info.GetAttrOrDefault("alpha", 0.01f);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+class NchwcPoolBase : public OpKernel {
+ protected:
+  NchwcPoolBase(const OpKernelInfo& info, MLAS_POOLING_KIND kind, bool global_pooling);
+
+ public:
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  MLAS_POOLING_KIND kind_;
+  bool global_pooling_;
+  AutoPadType auto_pad_;
+  std::vector<int64_t> kernel_shape_;
+  std::vector<int64_t> pads_;
+  std::vector<int64_t> strides_;
+};
+
+class NchwcMaxPool : public NchwcPoolBase {
+ public:
+  NchwcMaxPool(const OpKernelInfo& info) : NchwcPoolBase(info, MlasMaximumPooling, false) {}
+};
+
+class NchwcAveragePool : public NchwcPoolBase {
+ public:
+  NchwcAveragePool(const OpKernelInfo& info)
+      : NchwcPoolBase(info,
+                      info.GetAttrOrDefault<int64_t>("count_include_pad", 0) != 0 ? MlasAveragePoolingIncludePad
+                                                                                  : MlasAveragePoolingExcludePad,
+                      false) {}
+};
+
+class NchwcGlobalMaxPool : public NchwcPoolBase {
+ public:
+  NchwcGlobalMaxPool(const OpKernelInfo& info) : NchwcPoolBase(info, MlasMaximumPooling, true) {}
+};
+
+class NchwcGlobalAveragePool : public NchwcPoolBase {
+ public:
+  NchwcGlobalAveragePool(const OpKernelInfo& info) : NchwcPoolBase(info, MlasAveragePoolingExcludePad, true) {}
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
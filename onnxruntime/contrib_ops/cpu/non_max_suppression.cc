@@ -10,9 +10,9 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 /* Modifications Copyright (c) Microsoft. */
-
 #include "contrib_ops/cpu/non_max_suppression.h"
-#include <queue>
+#include <algorithm>
+#include <cmath>
 
 namespace onnxruntime {
 namespace contrib {
@@ -26,51 +26,168 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
         .TypeConstraint("T2", DataTypeImpl::GetTensorType<int32_t>()),
     NonMaxSuppression<float>);
 
+ONNX_OPERATOR_KERNEL_EX(
+    BatchedNonMaxSuppression,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    BatchedNonMaxSuppression);
+
+namespace {
+
+struct SelectionParameters {
+  int64_t max_output_boxes;
+  float iou_threshold;
+  bool has_score_threshold;
+  float score_threshold;
+  bool center_point_box;
+};
+
+// Corners of a box with the minimum coordinates first, as the corners of the input boxes can be
+// any diagonal pair.
 template <typename T>
-void NonMaxSuppression<T>::MaxMin(const T& lhs, const T& rhs, T& min, T& max) const {
-  if (lhs >= rhs) {
-    min = rhs;
-    max = lhs;
-  } else {
-    min = lhs;
-    max = rhs;
+struct BoxCorners {
+  T y_min;
+  T x_min;
+  T y_max;
+  T x_max;
+
+  BoxCorners(const T* box, bool center_point_box) {
+    T y1, x1, y2, x2;
+    if (center_point_box) {
+      // [x_center, y_center, width, height]
+      const T half_width = box[2] / 2;
+      const T half_height = box[3] / 2;
+      y1 = box[1] - half_height;
+      x1 = box[0] - half_width;
+      y2 = box[1] + half_height;
+      x2 = box[0] + half_width;
+    } else {
+      // [y1, x1, y2, x2]
+      y1 = box[0];
+      x1 = box[1];
+      y2 = box[2];
+      x2 = box[3];
+    }
+    y_min = std::min(y1, y2);
+    y_max = std::max(y1, y2);
+    x_min = std::min(x1, x2);
+    x_max = std::max(x1, x2);
   }
-}
 
+  T Area() const { return (y_max - y_min) * (x_max - x_min); }
+};
+
+// The boxes selected so far, stored as one array per coordinate so the overlap of a candidate
+// with a block of them is computed with vector instructions.
 template <typename T>
-bool NonMaxSuppression<T>::SuppressByIOU(const T* boxes_data, int32_t box_index1, int32_t box_index2) const {
-  T x1_min, y1_min, x1_max, y1_max, x2_min, y2_min, x2_max, y2_max;
-  // boxes data [y1, x1, y2, x2],
-  MaxMin(boxes_data[4 * box_index1 + 1], boxes_data[4 * box_index1 + 3], x1_min, x1_max);
-  MaxMin(boxes_data[4 * box_index1 + 0], boxes_data[4 * box_index1 + 2], y1_min, y1_max);
-  MaxMin(boxes_data[4 * box_index2 + 1], boxes_data[4 * box_index2 + 3], x2_min, x2_max);
-  MaxMin(boxes_data[4 * box_index2 + 0], boxes_data[4 * box_index2 + 2], y2_min, y2_max);
-
-  const T intersection_x_min = std::max(x1_min, x2_min);
-  const T intersection_y_min = std::max(y1_min, y2_min);
-  const T intersection_x_max = std::min(x1_max, x2_max);
-  const T intersection_y_max = std::min(y1_max, y2_max);
-
-  const T intersection_area = std::max(intersection_x_max - intersection_x_min, static_cast<T>(0.0)) *
-                              std::max(intersection_y_max - intersection_y_min, static_cast<T>(0.0));
-
-  if (intersection_area <= static_cast<T>(0.0)) {
+class SelectedBoxes {
+ public:
+  // Returns true if the IOU (Intersection Over Union) of the box with any selected box exceeds the threshold.
+  // Boxes with an empty area never overlap, as their intersection is empty.
+  bool Overlaps(const BoxCorners<T>& box, T area, float iou_threshold) const {
+    constexpr size_t kBlockSize = 16;
+    const T threshold = static_cast<T>(iou_threshold);
+    const size_t count = area_.size();
+
+    // test a whole block without branches, and only stop between blocks
+    for (size_t block = 0; block < count; block += kBlockSize) {
+      const size_t block_end = std::min(count, block + kBlockSize);
+      int overlaps = 0;
+      for (size_t i = block; i < block_end; ++i) {
+        const T height = std::max(std::min(box.y_max, y_max_[i]) - std::max(box.y_min, y_min_[i]), T(0));
+        const T width = std::max(std::min(box.x_max, x_max_[i]) - std::max(box.x_min, x_min_[i]), T(0));
+        const T intersection_area = height * width;
+        const T union_area = area + area_[i] - intersection_area;
+        // a positive intersection implies positive areas and union, otherwise the ratio is 0 or NaN
+        overlaps |= static_cast<int>(intersection_area / union_area > threshold);
+      }
+      if (overlaps) {
+        return true;
+      }
+    }
     return false;
   }
 
-  const T area1 = (x1_max - x1_min) * (y1_max - y1_min);
-  const T area2 = (x2_max - x2_min) * (y2_max - y2_min);
-  const T union_area = area1 + area2 - intersection_area;
+  void Add(const BoxCorners<T>& box, T area) {
+    y_min_.push_back(box.y_min);
+    x_min_.push_back(box.x_min);
+    y_max_.push_back(box.y_max);
+    x_max_.push_back(box.x_max);
+    area_.push_back(area);
+  }
 
-  if (area1 <= static_cast<T>(0.0) || area2 <= static_cast<T>(0.0) || union_area <= static_cast<T>(0.0)) {
-    return false;
+ private:
+  std::vector<T> y_min_;
+  std::vector<T> x_min_;
+  std::vector<T> y_max_;
+  std::vector<T> x_max_;
+  std::vector<T> area_;
+};
+
+template <typename T>
+struct ScoreIndexPair {
+  T score;
+  int64_t index;
+};
+
+// Orders the candidates by descending score, and the boxes with the same score by index.
+template <typename T>
+bool SelectedBefore(const ScoreIndexPair<T>& lhs, const ScoreIndexPair<T>& rhs) {
+  return lhs.score > rhs.score || (lhs.score == rhs.score && lhs.index < rhs.index);
+}
+
+// Greedily selects boxes in descending order of their scores, skipping the boxes that overlap an
+// already selected box, and appends the indices of the selected boxes to 'selected'.
+template <typename T>
+void SelectBoxes(const T* boxes, const T* scores, int64_t num_boxes, const SelectionParameters& params,
+                 std::vector<int64_t>& selected) {
+  // drop the boxes under the score threshold before ordering the others. NaN scores can't be ordered.
+  std::vector<ScoreIndexPair<T>> candidates;
+  for (int64_t i = 0; i < num_boxes; ++i) {
+    const T score = scores[i];
+    if (params.has_score_threshold ? static_cast<float>(score) > params.score_threshold : !std::isnan(score)) {
+      candidates.push_back({score, i});
+    }
   }
 
-  const T intersection_over_union = intersection_area / union_area;
+  // Detectors often emit their boxes sorted by score already. Otherwise the candidates are kept in
+  // a heap, as only the best ones need to be ordered when few boxes are selected.
+  const bool is_sorted = std::is_sorted(candidates.begin(), candidates.end(), SelectedBefore<T>);
+  auto heap_order = [](const ScoreIndexPair<T>& lhs, const ScoreIndexPair<T>& rhs) {
+    return SelectedBefore(rhs, lhs);
+  };
+  if (!is_sorted) {
+    std::make_heap(candidates.begin(), candidates.end(), heap_order);
+  }
 
-  return intersection_over_union > iou_threshold_;
+  SelectedBoxes<T> selected_boxes;
+  const size_t selected_begin = selected.size();
+  auto remaining_end = candidates.end();
+  for (size_t next = 0; next < candidates.size() &&
+                        static_cast<int64_t>(selected.size() - selected_begin) < params.max_output_boxes;
+       ++next) {
+    ScoreIndexPair<T> candidate;
+    if (is_sorted) {
+      candidate = candidates[next];
+    } else {
+      std::pop_heap(candidates.begin(), remaining_end, heap_order);
+      --remaining_end;
+      candidate = *remaining_end;
+    }
+
+    const BoxCorners<T> box(boxes + 4 * candidate.index, params.center_point_box);
+    const T area = box.Area();
+    if (!selected_boxes.Overlaps(box, area, params.iou_threshold)) {
+      selected_boxes.Add(box, area);
+      selected.push_back(candidate.index);
+    }
+  }
 }
 
+}  // namespace
+
 template <typename T>
 Status NonMaxSuppression<T>::Compute(OpKernelContext* ctx) const {
   const Tensor* boxes = ctx->Input<Tensor>(0);
@@ -94,60 +211,99 @@ Status NonMaxSuppression<T>::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  const T* boxes_data = boxes->Data<T>();
-  const T* scores_data = scores->Data<T>();
-
-  struct ScoreIndexPair {
-    T score;
-    int32_t index;
-  };
-
-  auto LessCompare = [](const ScoreIndexPair& lhs, const ScoreIndexPair& rhs) {
-    return lhs.score < rhs.score;
-  };
-
-  // Filter by score_threshold_
-  std::priority_queue<ScoreIndexPair, std::deque<ScoreIndexPair>, decltype(LessCompare)> sorted_scores_with_index(LessCompare);
-  for (int32_t i = 0; i < num_boxes; ++i) {
-    if (static_cast<float>(scores_data[i]) > score_threshold_) {
-      sorted_scores_with_index.emplace(ScoreIndexPair({scores_data[i], i}));
-    }
-  }
-
-  int num_of_selected = 0;
-  std::vector<int32_t> selected_index(max_output_size_, 0);
-  ScoreIndexPair next_top_score;
-
-  // Get the next box with top score, filter by iou_threshold_
-  while (num_of_selected < max_output_size_ && !sorted_scores_with_index.empty()) {
-    next_top_score = sorted_scores_with_index.top();
-    sorted_scores_with_index.pop();
-
-    bool selected = true;
-    // Check with existing boxes, suppress if exceed the IOU (Intersection Over Union) threshold
-    for (int i = num_of_selected - 1; i >= 0; --i) {
-      if (SuppressByIOU(boxes_data, selected_index[i], next_top_score.index)) {
-        selected = false;
-        break;
-      }
-    }
-
-    if (selected) {
-      selected_index[num_of_selected] = next_top_score.index;
-      ++num_of_selected;
-    }
-  }
+  SelectionParameters params{max_output_size_, iou_threshold_, true, score_threshold_, false};
+  std::vector<int64_t> selected;
+  SelectBoxes(boxes->Data<T>(), scores->Data<T>(), num_boxes, params, selected);
+  const auto num_of_selected = static_cast<int64_t>(selected.size());
 
   int64_t num_to_copy = pad_to_max_output_size_ == 1 ? max_output_size_ : num_of_selected;
   TensorShape output_shape({num_to_copy});
   Tensor* selected_indices = ctx->Output(0, output_shape);
   auto output_data = selected_indices->MutableData<int32_t>();
-  memcpy(output_data, selected_index.data(), num_to_copy * sizeof(int32_t));
+  std::transform(selected.begin(), selected.end(), output_data,
+                 [](int64_t index) { return static_cast<int32_t>(index); });
+  std::fill(output_data + num_of_selected, output_data + num_to_copy, 0);
 
   TensorShape valid_outputs_shape({1});
   Tensor* valid_outputs = ctx->Output(1, valid_outputs_shape);
   if (valid_outputs) {
-    valid_outputs->MutableData<int32_t>()[0] = num_of_selected;
+    valid_outputs->MutableData<int32_t>()[0] = static_cast<int32_t>(num_of_selected);
+  }
+
+  return Status::OK();
+}
+
+Status BatchedNonMaxSuppression::Compute(OpKernelContext* ctx) const {
+  const Tensor* boxes = ctx->Input<Tensor>(0);
+  ORT_ENFORCE(boxes);
+  const Tensor* scores = ctx->Input<Tensor>(1);
+  ORT_ENFORCE(scores);
+
+  const auto& boxes_dims = boxes->Shape().GetDims();
+  ORT_RETURN_IF_NOT(boxes_dims.size() == 3 && boxes_dims[2] == 4,
+                    "boxes must be a 3D tensor with shape [num_batches, spatial_dimension, 4].");
+  const auto& scores_dims = scores->Shape().GetDims();
+  ORT_RETURN_IF_NOT(scores_dims.size() == 3,
+                    "scores must be a 3D tensor with shape [num_batches, num_classes, spatial_dimension].");
+  ORT_RETURN_IF_NOT(scores_dims[0] == boxes_dims[0], "boxes and scores should have same num_batches.");
+  ORT_RETURN_IF_NOT(scores_dims[2] == boxes_dims[1], "boxes and scores should have same spatial_dimension.");
+
+  const int64_t num_batches = boxes_dims[0];
+  const int64_t num_classes = scores_dims[1];
+  const int64_t num_boxes = boxes_dims[1];
+
+  SelectionParameters params{0, 0.0f, false, 0.0f, center_point_box_ == 1};
+
+  const Tensor* max_output_boxes_per_class = ctx->Input<Tensor>(2);
+  if (max_output_boxes_per_class) {
+    ORT_RETURN_IF_NOT(max_output_boxes_per_class->Shape().Size() == 1,
+                      "max_output_boxes_per_class must contain a single value.");
+    params.max_output_boxes = max_output_boxes_per_class->Data<int64_t>()[0];
+  }
+
+  const Tensor* iou_threshold = ctx->Input<Tensor>(3);
+  if (iou_threshold) {
+    ORT_RETURN_IF_NOT(iou_threshold->Shape().Size() == 1, "iou_threshold must contain a single value.");
+    params.iou_threshold = iou_threshold->Data<float>()[0];
+    ORT_RETURN_IF_NOT(params.iou_threshold >= 0 && params.iou_threshold <= 1, "iou_threshold must be in range [0, 1]");
+  }
+
+  const Tensor* score_threshold = ctx->Input<Tensor>(4);
+  if (score_threshold) {
+    ORT_RETURN_IF_NOT(score_threshold->Shape().Size() == 1, "score_threshold must contain a single value.");
+    params.has_score_threshold = true;
+    params.score_threshold = score_threshold->Data<float>()[0];
+  }
+
+  const int64_t num_pairs = num_batches * num_classes;
+  std::vector<std::vector<int64_t>> selected(static_cast<size_t>(num_pairs));
+  if (params.max_output_boxes > 0 && num_boxes > 0) {
+    const float* boxes_data = boxes->Data<float>();
+    const float* scores_data = scores->Data<float>();
+    // each pair reads its scores and at least the boxes of its candidates
+    thread_pool_.ParallelFor(num_pairs, num_boxes * 5 * static_cast<int64_t>(sizeof(float)),
+                             [&](int64_t begin, int64_t end) {
+                               for (int64_t pair = begin; pair < end; ++pair) {
+                                 SelectBoxes(boxes_data + (pair / num_classes) * num_boxes * 4,
+                                             scores_data + pair * num_boxes, num_boxes, params,
+                                             selected[pair]);
+                               }
+                             });
+  }
+
+  int64_t num_selected = 0;
+  for (const auto& pair_selected : selected) {
+    num_selected += static_cast<int64_t>(pair_selected.size());
+  }
+
+  Tensor* selected_indices = ctx->Output(0, TensorShape({num_selected, 3}));
+  int64_t* output_data = selected_indices->MutableData<int64_t>();
+  for (int64_t pair = 0; pair < num_pairs; ++pair) {
+    for (int64_t box_index : selected[pair]) {
+      *output_data++ = pair / num_classes;
+      *output_data++ = pair % num_classes;
+      *output_data++ = box_index;
+    }
   }
 
   return Status::OK();
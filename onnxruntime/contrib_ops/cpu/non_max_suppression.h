@@ -5,7 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
-//#include "core/util/math_cpuonly.h"
+#include "core/providers/cpu/kernel_thread_pool.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -23,15 +23,31 @@ class NonMaxSuppression final : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
-private:
-  bool SuppressByIOU(const T* boxes_data, int32_t box_index1, int32_t box_index2) const;
-  void MaxMin(const T& lhs, const T& rhs, T& min, T& max) const;
-
 private :
   int64_t max_output_size_;
   float iou_threshold_;
   float score_threshold_;
   int64_t pad_to_max_output_size_;
 };
+
+// NonMaxSuppression over a batch of images with boxes scored for several classes, following the
+// batched form of the ONNX operator. The boxes of each (batch, class) pair are selected independently,
+// so the pairs are processed in parallel.
+class BatchedNonMaxSuppression final : public OpKernel {
+ public:
+  BatchedNonMaxSuppression(const OpKernelInfo& info) : OpKernel(info),
+      center_point_box_(info.GetAttrOrDefault<int64_t>("center_point_box", 0)),
+      thread_pool_(GetKernelThreadPool(info)) {
+    ORT_ENFORCE(center_point_box_ == 0 || center_point_box_ == 1, "center_point_box must be 0 or 1");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t center_point_box_;
+
+  // Shared by all the kernels of the execution provider.
+  KernelThreadPool& thread_pool_;
+};
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -146,11 +146,108 @@ void pre_calc_for_bilinear_interpolate(
   }
 }
 
+// Number of channels of a ROI pooled by one work item. The bilinear interpolation tables of a ROI
+// are shared by all its channels.
+constexpr int64_t kChannelBlockSize = 16;
+
+template <typename T>
+struct RoiGeometry {
+  int64_t batch_index;
+  T roi_start_h;
+  T roi_start_w;
+  T bin_size_h;
+  T bin_size_w;
+  int64_t roi_bin_grid_h;
+  int64_t roi_bin_grid_w;
+};
+
+template <typename T>
+RoiGeometry<T> GetRoiGeometry(const T* offset_bottom_rois,
+                              float spatial_scale,
+                              int64_t pooled_height,
+                              int64_t pooled_width,
+                              int64_t sampling_ratio) {
+  RoiGeometry<T> geometry;
+  geometry.batch_index = static_cast<int64_t>(offset_bottom_rois[0]);
+  offset_bottom_rois++;
+
+  // Do not using rounding; this implementation detail is critical
+  geometry.roi_start_w = offset_bottom_rois[0] * spatial_scale;
+  geometry.roi_start_h = offset_bottom_rois[1] * spatial_scale;
+  T roi_end_w = offset_bottom_rois[2] * spatial_scale;
+  T roi_end_h = offset_bottom_rois[3] * spatial_scale;
+
+  // Force malformed ROIs to be 1x1
+  T roi_width = std::max(roi_end_w - geometry.roi_start_w, (T)1.);
+  T roi_height = std::max(roi_end_h - geometry.roi_start_h, (T)1.);
+  geometry.bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
+  geometry.bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
+
+  // We use roi_bin_grid to sample the grid and mimic integral
+  geometry.roi_bin_grid_h = (sampling_ratio > 0)
+                                ? sampling_ratio
+                                : static_cast<int64_t>(ceil(roi_height / pooled_height));  // e.g., = 2
+  geometry.roi_bin_grid_w =
+      (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(ceil(roi_width / pooled_width));
+  return geometry;
+}
+
+// Pools channels [channel_begin, channel_end) of a ROI with its precalculated interpolation tables.
+template <typename T>
+void ROIAlignChannels(
+    const RoiGeometry<T>& geometry,
+    const PreCalc<T>* pre_calc,
+    const T* bottom_data,
+    int64_t channels,
+    int64_t height,
+    int64_t width,
+    int64_t pooled_height,
+    int64_t pooled_width,
+    int64_t channel_begin,
+    int64_t channel_end,
+    bool avg_mode,
+    T* top_data) {
+  const int64_t pooled_size = pooled_height * pooled_width;
+  const int64_t count = geometry.roi_bin_grid_h * geometry.roi_bin_grid_w;
+
+  for (int64_t c = channel_begin; c < channel_end; c++) {
+    const T* offset_bottom_data = bottom_data + (geometry.batch_index * channels + c) * height * width;
+    T* offset_top_data = top_data + c * pooled_size;
+    const PreCalc<T>* pc = pre_calc;
+
+    for (int64_t index = 0; index < pooled_size; index++) {
+      T output_val = 0.;
+      if (avg_mode) {  // avg pooling
+        for (int64_t i = 0; i < count; i++, pc++) {
+          output_val += pc->w1 * offset_bottom_data[pc->pos1] +
+                        pc->w2 * offset_bottom_data[pc->pos2] +
+                        pc->w3 * offset_bottom_data[pc->pos3] +
+                        pc->w4 * offset_bottom_data[pc->pos4];
+        }
+        output_val /= count;
+      } else {  // max pooling
+        for (int64_t i = 0; i < count; i++, pc++) {
+          if (i == 0) {
+            output_val = pc->w1 * offset_bottom_data[pc->pos1];
+          } else {
+            output_val = std::max(std::max(std::max(output_val, pc->w2 * offset_bottom_data[pc->pos2]),
+                                           pc->w3 * offset_bottom_data[pc->pos3]),
+                                  pc->w4 * offset_bottom_data[pc->pos4]);
+          }
+        }
+      }
+
+      offset_top_data[index] = output_val;
+    }
+  }
+}
+
 template <typename T>
 void ROIAlignForward(
-    int64_t nthreads,
+    KernelThreadPool& thread_pool,
     const T* bottom_data,
     float spatial_scale,
+    int64_t n_rois,
     int64_t channels,
     int64_t height,
     int64_t width,
@@ -160,108 +257,52 @@ void ROIAlignForward(
     const T* bottom_rois,
     int64_t roi_cols,
     T* top_data,
-    const std::string& mode) {
-  int64_t n_rois = nthreads / channels / pooled_width / pooled_height;
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int n = 0; n < n_rois; n++) {
-    int64_t index_n = n * channels * pooled_width * pooled_height;
-
-    const T* offset_bottom_rois = bottom_rois + n * roi_cols;
-    const T roi_batch_ind = offset_bottom_rois[0];
-    offset_bottom_rois++;
-
-    // Do not using rounding; this implementation detail is critical
-    T roi_start_w = offset_bottom_rois[0] * spatial_scale;
-    T roi_start_h = offset_bottom_rois[1] * spatial_scale;
-    T roi_end_w = offset_bottom_rois[2] * spatial_scale;
-    T roi_end_h = offset_bottom_rois[3] * spatial_scale;
-
-    // Force malformed ROIs to be 1x1
-    T roi_width = std::max(roi_end_w - roi_start_w, (T)1.);
-    T roi_height = std::max(roi_end_h - roi_start_h, (T)1.);
-    T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
-    T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
-
-    // We use roi_bin_grid to sample the grid and mimic integral
-    int64_t roi_bin_grid_h = (sampling_ratio > 0)
-                                 ? sampling_ratio
-                                 : static_cast<int64_t>(ceil(roi_height / pooled_height));  // e.g., = 2
-    int64_t roi_bin_grid_w =
-        (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(ceil(roi_width / pooled_width));
-
-    // We do average (integral) pooling inside a bin
-    const int64_t count = roi_bin_grid_h * roi_bin_grid_w;  // e.g. = 4
-
-    // we want to precalculate indices and weights shared by all channels,
-    // this is the key point of optimization
-    std::vector<PreCalc<T>> pre_calc(
-        roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height);
-    pre_calc_for_bilinear_interpolate(
-        height,
-        width,
-        pooled_height,
-        pooled_width,
-        roi_bin_grid_h,
-        roi_bin_grid_w,
-        roi_start_h,
-        roi_start_w,
-        bin_size_h,
-        bin_size_w,
-        roi_bin_grid_h,
-        roi_bin_grid_w,
-        pre_calc);
-
-    for (int64_t c = 0; c < channels; c++) {
-      int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-      const T* offset_bottom_data =
-          bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-      int64_t pre_calc_index = 0;
-
-      for (int64_t ph = 0; ph < pooled_height; ph++) {
-        for (int64_t pw = 0; pw < pooled_width; pw++) {
-          int64_t index = index_n_c + ph * pooled_width + pw;
-
-          T output_val = 0.;
-          if (mode == "avg") {  // avg pooling
-            for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-              for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                PreCalc<T> pc = pre_calc[pre_calc_index];
-                output_val += pc.w1 * offset_bottom_data[pc.pos1] +
-                              pc.w2 * offset_bottom_data[pc.pos2] +
-                              pc.w3 * offset_bottom_data[pc.pos3] +
-                              pc.w4 * offset_bottom_data[pc.pos4];
-
-                pre_calc_index += 1;
-              }
-            }
-            output_val /= count;
-          } else {  // max pooling
-            bool max_flag = false;
-            for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-              for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                PreCalc<T> pc = pre_calc[pre_calc_index];
-                if (!max_flag) {
-                  output_val = pc.w1 * offset_bottom_data[pc.pos1];
-                  max_flag = true;
-                } else {
-                  output_val = std::max(std::max(std::max(output_val, pc.w2 * offset_bottom_data[pc.pos2]),
-                                                 pc.w3 * offset_bottom_data[pc.pos3]),
-                                        pc.w4 * offset_bottom_data[pc.pos4]);
-                }
-
-                pre_calc_index += 1;
-              }
-            }
-          }
+    bool avg_mode) {
+  const int64_t num_channel_blocks = (channels + kChannelBlockSize - 1) / kChannelBlockSize;
+  const int64_t pooled_size = pooled_height * pooled_width;
+
+  // each output element reads at least the four corners of a sample
+  const int64_t cost_per_block =
+      std::min(channels, kChannelBlockSize) * pooled_size * 4 * static_cast<int64_t>(sizeof(T));
+
+  thread_pool.ParallelFor(n_rois * num_channel_blocks, cost_per_block, [&](int64_t begin, int64_t end) {
+    // the tables of the current ROI, reused by its channel blocks and the next ROIs of the range
+    std::vector<PreCalc<T>> pre_calc;
+    RoiGeometry<T> geometry;
+    int64_t current_roi = -1;
+
+    for (int64_t item = begin; item < end; item++) {
+      const int64_t n = item / num_channel_blocks;
+      if (n != current_roi) {
+        geometry = GetRoiGeometry(bottom_rois + n * roi_cols, spatial_scale, pooled_height, pooled_width,
+                                  sampling_ratio);
+
+        // we want to precalculate indices and weights shared by all channels,
+        // this is the key point of optimization
+        pre_calc.resize(geometry.roi_bin_grid_h * geometry.roi_bin_grid_w * pooled_size);
+        pre_calc_for_bilinear_interpolate(
+            height,
+            width,
+            pooled_height,
+            pooled_width,
+            geometry.roi_bin_grid_h,
+            geometry.roi_bin_grid_w,
+            geometry.roi_start_h,
+            geometry.roi_start_w,
+            geometry.bin_size_h,
+            geometry.bin_size_w,
+            geometry.roi_bin_grid_h,
+            geometry.roi_bin_grid_w,
+            pre_calc);
+        current_roi = n;
+      }
 
-          top_data[index] = output_val;
-        }  // for pw
-      }    // for ph
-    }      // for c
-  }        // for n
+      const int64_t channel_begin = (item % num_channel_blocks) * kChannelBlockSize;
+      ROIAlignChannels(geometry, pre_calc.data(), bottom_data, channels, height, width, pooled_height,
+                       pooled_width, channel_begin, std::min(channels, channel_begin + kChannelBlockSize),
+                       avg_mode, top_data + n * channels * pooled_size);
+    }
+  });
 }
 }  // namespace
 
@@ -290,11 +331,11 @@ Status ROIAlign<T>::Compute(OpKernelContext* context) const {
   }
 
   auto& Y = *context->Output(0, {rois_dims[0], x_dims[1], pooled_h_, pooled_w_});
-  int64_t output_size = Y.Shape().Size();
   ROIAlignForward<T>(
-      output_size,
+      thread_pool_,
       X_ptr->Data<T>(),
       spatial_scale_,
+      rois_dims[0],
       x_dims[1],
       x_dims[2],
       x_dims[3],
@@ -304,7 +345,7 @@ Status ROIAlign<T>::Compute(OpKernelContext* context) const {
       rois_ptr->Data<T>(),
       rois_dims[1],
       Y.template MutableData<T>(),
-      mode_);
+      mode_ == "avg");
 
   return Status::OK();
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/kernel_thread_pool.h"
 #include <cctype>
 
 namespace onnxruntime {
@@ -11,7 +12,7 @@ namespace contrib {
 template <typename T>
 class ROIAlign final : public OpKernel {
  public:
-  explicit ROIAlign(const OpKernelInfo& info) : OpKernel(info) {
+  explicit ROIAlign(const OpKernelInfo& info) : OpKernel(info), thread_pool_(GetKernelThreadPool(info)) {
     // mode
     std::string mode_tmp;
     if (info.GetAttr<std::string>("mode", &mode_tmp).IsOK()) {
@@ -57,6 +58,9 @@ class ROIAlign final : public OpKernel {
   int64_t sampling_ratio_{0};
   float spatial_scale_{1.0f};
 
+  // Shared by all the kernels of the execution provider.
+  KernelThreadPool& thread_pool_;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ROIAlign);
 };
 }  // namespace contrib
@@ -10,6 +10,7 @@
 #include <locale.h>
 #endif
 
+#include <algorithm>
 #include <codecvt>
 #include <locale>
 #include <functional>
@@ -103,12 +104,76 @@ const std::string default_locale("en_US.UTF-8");
 
 #endif
 
-template <class ForwardIter>
-Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
-                      const Locale& loc,
-                      std::wstring_convert<std::codecvt_utf8<wchar_t>>& converter,
-                      size_t N, size_t C,
-                      StringNormalizer::CaseAction caseaction) {
+// Changes the case of utf8 strings. Most strings are ASCII, so the case of ASCII
+// chars is looked up in tables taken from the locale and only strings with other
+// chars are converted to wide strings.
+class CaseMap {
+ public:
+  explicit CaseMap(const std::string& locale_name) : locale_(locale_name) {
+    std::wstring wstr(1, L'\0');
+    for (size_t ch = 0; ch < kAsciiChars; ++ch) {
+      wstr[0] = static_cast<wchar_t>(ch);
+      locale_.ChangeCase(StringNormalizer::LOWER, wstr);
+      lower_[ch] = AsciiOrNoMapping(wstr[0]);
+      wstr[0] = static_cast<wchar_t>(ch);
+      locale_.ChangeCase(StringNormalizer::UPPER, wstr);
+      upper_[ch] = AsciiOrNoMapping(wstr[0]);
+    }
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CaseMap);
+
+  // Writes input with its case changed to output, which must not be input
+  Status ChangeCase(StringNormalizer::CaseAction caseaction, const StringView& input,
+                    std::wstring_convert<std::codecvt_utf8<wchar_t>>& converter,
+                    std::string& output) const {
+    assert(caseaction != StringNormalizer::NONE);
+    const uint8_t* table = (caseaction == StringNormalizer::LOWER) ? lower_ : upper_;
+    const size_t len = input.size();
+    output.resize(len);
+    size_t i = 0;
+    for (; i < len; ++i) {
+      auto ch = static_cast<unsigned char>(input[i]);
+      if (ch >= kAsciiChars || table[ch] == kNoAsciiMapping) {
+        break;
+      }
+      output[i] = static_cast<char>(table[ch]);
+    }
+    if (i == len) {
+      return Status::OK();
+    }
+
+    std::wstring wstr = converter.from_bytes(input.begin(), input.end());
+    if (wstr == wconv_error) {
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                    "Input contains invalid utf8 chars at: " + input.ToString());
+    }
+    // In place transform
+    locale_.ChangeCase(caseaction, wstr);
+    output = converter.to_bytes(wstr);
+    return Status::OK();
+  }
+
+ private:
+  static constexpr size_t kAsciiChars = 128;
+  static constexpr uint8_t kNoAsciiMapping = 0xFF;
+
+  static uint8_t AsciiOrNoMapping(wchar_t ch) {
+    // Some locales map ASCII chars outside of ASCII
+    return (static_cast<uint32_t>(ch) < kAsciiChars) ? static_cast<uint8_t>(ch) : kNoAsciiMapping;
+  }
+
+  Locale locale_;
+  uint8_t lower_[kAsciiChars];
+  uint8_t upper_[kAsciiChars];
+};
+
+constexpr size_t CaseMap::kAsciiChars;
+constexpr uint8_t CaseMap::kNoAsciiMapping;
+
+// Creates the output for C strings. When there is none the output is
+// one empty string and nullptr is returned.
+Tensor* CreateOutput(OpKernelContext* ctx, size_t N, size_t C) {
   std::vector<int64_t> output_dims;
   if (N == 1) {
     output_dims.push_back(1);
@@ -120,34 +185,42 @@ Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
     TensorShape output_shape(output_dims);
     // This will create one empty string
     ctx->Output(0, output_shape);
-    return Status::OK();
+    return nullptr;
   }
 
   output_dims.push_back(C);
 
   TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
+  return ctx->Output(0, output_shape);
+}
 
-  size_t output_idx = 0;
-  while (first != end) {
-    auto& s = *first;
+Status CopyCaseAction(const std::vector<StringView>& inputs, OpKernelContext* ctx,
+                      const CaseMap& case_map,
+                      std::wstring_convert<std::codecvt_utf8<wchar_t>>& converter,
+                      size_t N,
+                      StringNormalizer::CaseAction caseaction) {
+  auto output_tensor = CreateOutput(ctx, N, inputs.size());
+  if (output_tensor == nullptr) {
+    return Status::OK();
+  }
+
+  // The strings are written to an arena, so there is no allocation per string
+  size_t input_bytes = 0;
+  for (const auto& s : inputs) {
+    input_bytes += s.size();
+  }
+  auto& output = output_tensor->InitStringArena();
+  output.Reserve(inputs.size(), input_bytes);
+
+  std::string cased;  // reused for every string
+  for (const auto& s : inputs) {
     if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
-      std::wstring wstr = converter.from_bytes(s);
-      if (wstr == wconv_error) {
-        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars at: " + static_cast<const std::string&>(s));
-      }
-      // In place transform
-      loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
+      ORT_RETURN_IF_ERROR(case_map.ChangeCase(caseaction, s, converter, cased));
+      output.Append(cased);
     } else {
       assert(caseaction == StringNormalizer::NONE);
-      // Simple copy or move if the iterator points to a non-const string
-      *(output_data + output_idx) = std::move(s);
+      output.Append(s);
     }
-    ++output_idx;
-    ++first;
   }
   return Status::OK();
 }
@@ -182,26 +255,28 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
     compare_caseaction_ = (casechangeaction_ == UPPER) ? UPPER : LOWER;
   }
 
-  locale_name_ = info.GetAttrOrDefault("locale", default_locale);
-  Locale locale(locale_name_);
+  case_map_ = std::make_unique<CaseMap>(info.GetAttrOrDefault("locale", default_locale));
   std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
 
-  std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
-  for (const auto& sw : swords) {
+  stopword_strings_ = info.GetAttrsOrDefault<std::string>("stopwords");
+  for (auto& sw : stopword_strings_) {
     ORT_ENFORCE(!sw.empty(), "Empty stopwords not allowed");
-    if (is_case_sensitive_) {
-      auto p = stopwords_.insert(sw);
-      ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
-    } else {
-      std::wstring wstr = converter.from_bytes(sw);
-      ORT_ENFORCE(wstr != wconv_error, "Stopword contains invalid utf8 chars");
-      locale.ChangeCase(compare_caseaction_, wstr);
-      auto p = wstopwords_.insert(wstr);
-      ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
+    if (!is_case_sensitive_) {
+      std::string cased;
+      ORT_ENFORCE(case_map_->ChangeCase(compare_caseaction_, sw, converter, cased).IsOK(),
+                  "Stopword contains invalid utf8 chars");
+      sw = std::move(cased);
     }
   }
+  // The strings do not move once they are all in place
+  for (const auto& sw : stopword_strings_) {
+    auto p = stopwords_.insert(sw);
+    ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
+  }
 }
 
+StringNormalizer::~StringNormalizer() = default;
+
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   using namespace string_normalizer;
 
@@ -229,71 +304,49 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either[C > 0] or [1][C > 0] allowed");
   }
 
-  Status status;
-  Locale locale(locale_name_);
   std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
-  auto const input_data = X->template Data<std::string>();
-  using StrRef = std::reference_wrapper<const std::string>;
-  if (is_case_sensitive_) {
-    if (!stopwords_.empty()) {
-      std::vector<StrRef> filtered_strings;
-      filtered_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        if (0 == stopwords_.count(s)) {
-          filtered_strings.push_back(std::cref(s));
-        }
-        ++first;
+  std::vector<StringView> filtered_strings;
+  filtered_strings.reserve(C);
+  if (stopwords_.empty()) {
+    // Nothing to filter. Copy input to output and change case if needed
+    for (size_t i = 0; i < C; ++i) {
+      filtered_strings.push_back(X->StringAt(i));
+    }
+    return CopyCaseAction(filtered_strings, ctx, *case_map_, converter, N, casechangeaction_);
+  }
+
+  // Filter input. When the strings are compared in the case of the output
+  // the compared strings are kept and become the output. Otherwise,
+  // we keep views of the original strings.
+  const bool keep_cased = !is_case_sensitive_ && casechangeaction_ != NONE;
+  StringArena filtered_cased_strings;
+  std::string key;  // reused for every string
+  for (size_t i = 0; i < C; ++i) {
+    const StringView s = X->StringAt(i);
+    if (is_case_sensitive_) {
+      if (0 == stopwords_.count(s)) {
+        filtered_strings.push_back(s);
       }
-      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), casechangeaction_);
     } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, casechangeaction_);
-    }
-  } else {
-    if (!wstopwords_.empty()) {
-      // Filter input. When no case action is required
-      // we simply store original string references.
-      // Otherwise, we store converted strings.
-      std::vector<StrRef> filtered_orignal_strings;
-      std::vector<std::string> filtered_cased_strings;
-      filtered_orignal_strings.reserve(C);
-      filtered_cased_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
-        if (wstr == wconv_error) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Input contains invalid utf8 chars at: " + s);
-        }
-        locale.ChangeCase(compare_caseaction_, wstr);
-        if (0 == wstopwords_.count(wstr)) {
-          if (casechangeaction_ == NONE) {
-            filtered_orignal_strings.push_back(std::cref(s));
-          } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
-          }
+      ORT_RETURN_IF_ERROR(case_map_->ChangeCase(compare_caseaction_, s, converter, key));
+      if (0 == stopwords_.count(key)) {
+        if (keep_cased) {
+          filtered_cased_strings.Append(key);
+        } else {
+          filtered_strings.push_back(s);
         }
-        ++first;
       }
-      if (casechangeaction_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
-      } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
-      }
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, casechangeaction_);
     }
   }
-  return status;
+
+  if (keep_cased) {
+    auto output_tensor = CreateOutput(ctx, N, filtered_cased_strings.NumStrings());
+    if (output_tensor != nullptr) {
+      output_tensor->InitStringArena() = std::move(filtered_cased_strings);
+    }
+    return Status::OK();
+  }
+  return CopyCaseAction(filtered_strings, ctx, *case_map_, converter, N, casechangeaction_);
 }
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -3,15 +3,22 @@
 
 #pragma once
 
+#include "core/common/string_view.h"
 #include "core/framework/op_kernel.h"
 
 #include <locale>
+#include <memory>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace string_normalizer {
+class CaseMap;
+}
+
 class StringNormalizer : public OpKernel {
  public:
   enum CaseAction {
@@ -21,7 +28,7 @@ class StringNormalizer : public OpKernel {
   };
 
   explicit StringNormalizer(const OpKernelInfo& info);
-  ~StringNormalizer() = default;
+  ~StringNormalizer();
 
   Status Compute(OpKernelContext* ctx) const override;
 
@@ -29,10 +36,12 @@ class StringNormalizer : public OpKernel {
   bool is_case_sensitive_;
   CaseAction casechangeaction_;
   CaseAction compare_caseaction_;  // used for case-insensitive compare
-  std::string locale_name_;
-  // Either if these are populated but not both
-  std::unordered_set<std::string> stopwords_;
-  std::unordered_set<std::wstring> wstopwords_;
+  // Created once as constructing a locale is expensive
+  std::unique_ptr<string_normalizer::CaseMap> case_map_;
+  // Changed to compare_caseaction_ when case-insensitive
+  std::vector<std::string> stopword_strings_;
+  // Views of stopword_strings_, so the input strings are looked up without a copy
+  std::unordered_set<StringView, StringViewHash> stopwords_;
 };
 
 }  // namespace contrib
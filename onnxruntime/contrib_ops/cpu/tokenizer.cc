@@ -10,9 +10,6 @@
 #include "core/common/utf8_util.h"
 #include "re2/re2.h"
 
-#include <codecvt>
-#include <locale>
-
 namespace onnxruntime {
 namespace contrib {
 
@@ -36,6 +33,23 @@ class Tokenizer final : public OpKernel {
                             size_t N, size_t C,
                             const std::vector<int64_t>& input_dims) const;
 
+  // A token is a range of bytes of an input string
+  struct Token {
+    size_t offset_;
+    size_t size_;
+  };
+
+  // Writes the tokens of each input string, given as the number of tokens of each row,
+  // with start/end markers and padding
+  Status OutputTokens(OpKernelContext* ctx, size_t N, size_t C,
+                      const std::vector<int64_t>& input_dims,
+                      size_t max_tokens,
+                      const std::vector<Token>& tokens,
+                      const std::vector<size_t>& row_sizes) const;
+
+  // Appends the pad_value strings completing a row of tokens to the output
+  void OutputPadding(StringArena& output, size_t pads) const;
+
   bool mark_;
   std::string pad_value_;
   int64_t mincharnum_;
@@ -60,16 +74,14 @@ namespace tokenizer_details {
 const char start_text = 0x2;
 const char end_text = 0x3;
 
-const std::string conv_error("Conversion Error");
-const std::wstring wconv_error(L"Conversion Error");
-
 // Use a Trie like structure for searching multiple strings
 // at once but convert it to a ternary tree for saving space.
 // We insert separators in the same order they are specified.
 // Template parameter is a CharT which can be a char/wchar_t
 // or anything else that supports operator ><,== as long as
-// this is not a variable length sequence. We convert utf8 to utf16
-// before inserting.
+// this is not a variable length sequence. The separators are
+// searched as utf8 bytes: as a utf8 char never starts in the middle
+// of another one, a separator can only match on char boundaries.
 // Value is a supplementary information useful for search hit
 // and is present in the nodes that terminate the whole search pattern
 template <class CharT, class Value>
@@ -212,7 +224,7 @@ class TernarySearchTree {
 // Ternary Tree. This allows us to cut out the length of the matching
 // separator from the original string.
 struct SearchValue {
-  size_t w_len;
+  size_t char_len;  // in utf8 chars
   int priority_;
   bool operator<(const SearchValue& o) const {
     return priority_ < o.priority_;
@@ -224,7 +236,7 @@ struct SearchValue {
 using namespace tokenizer_details;
 
 struct Tokenizer::SearchData {
-  TernarySearchTree<wchar_t, SearchValue> tst_;
+  TernarySearchTree<char, SearchValue> tst_;
 };
 
 Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
@@ -262,13 +274,13 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   if (!char_tokenezation_) {
     if (!separators.empty()) {
       std::unique_ptr<SearchData> sd(std::make_unique<SearchData>());
-      std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
       int priority = 0;  // earlier search patterns get priority
       for (const auto& sep : separators) {
         ORT_ENFORCE(!sep.empty(), "No empty separators allowed");
-        std::wstring wsep = converter.from_bytes(sep);
-        ORT_ENFORCE(wsep != wconv_error, "Separator strings contains invalid utf8 chars");
-        bool result = sd->tst_.put(wsep.c_str(), wsep.length(), {wsep.length(), priority});
+        size_t sep_chars = 0;
+        ORT_ENFORCE(utf8_validate(reinterpret_cast<const unsigned char*>(sep.data()), sep.size(), sep_chars),
+                    "Separator strings contains invalid utf8 chars");
+        bool result = sd->tst_.put(sep.data(), sep.size(), {sep_chars, priority});
         ORT_ENFORCE(result, "duplicate separator detected");
         ++priority;
       }
@@ -293,23 +305,22 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   // utf8 characters in the string. So for every string we calculate its character(utf8) length
   // add padding and add start/end test separators if necessary
   size_t max_tokens = 0;
+  size_t input_bytes = 0;
   auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
+  const size_t num_inputs = N * C;
+  for (size_t i = 0; i < num_inputs; ++i) {
+    const StringView s = X->StringAt(i);
     size_t tokens = 0;  // length in utf8 chars
     if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
                        tokens)) {
       return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
+                    "Input string contains invalid utf8 chars: " + s.ToString());
     }
     if (mark_) {
       tokens += 2;  // Start/end markers as separate tokens
     }
     max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
+    input_bytes += s.size();
   }
 
   std::vector<int64_t> output_dims(input_dims);
@@ -324,14 +335,13 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   output_dims.push_back(max_tokens);
   TensorShape output_shape(output_dims);
   auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
+  // The tokens are written to an arena, so there is no allocation per token
+  auto& output = output_tensor->InitStringArena();
+  output.Reserve(num_inputs * max_tokens, input_bytes + num_inputs * max_tokens * std::max<size_t>(pad_value_.size(), 1));
+  for (size_t i = 0; i < num_inputs; ++i) {
+    const StringView s = X->StringAt(i);
     if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
+      output.Append(&start_text, 1);
     }
     size_t tokens = 0;
     const size_t str_len = s.size();
@@ -341,27 +351,26 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
       assert(result);
       (void)result;
       assert(token_idx + tlen <= str_len);
-      *(output_data + output_index) = s.substr(token_idx, tlen);
-      ++output_index;
+      output.Append(s.data() + token_idx, tlen);
       token_idx += tlen;
       ++tokens;
     }
     if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
+      output.Append(&end_text, 1);
     }
     // Padding strings
     assert(tokens + (mark_ * 2) <= max_tokens);
-    const size_t pads = max_tokens - (mark_ * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-    ++curr_input;
+    OutputPadding(output, max_tokens - (mark_ * 2) - tokens);
   }
   return Status::OK();
 }
 
+void Tokenizer::OutputPadding(StringArena& output, size_t pads) const {
+  for (size_t p = 0; p < pads; ++p) {
+    output.Append(pad_value_);
+  }
+}
+
 Status Tokenizer::SeparatorTokenize(OpKernelContext* ctx,
                                     size_t N, size_t C,
                                     const std::vector<int64_t>& input_dims) const {
@@ -369,157 +378,111 @@ Status Tokenizer::SeparatorTokenize(OpKernelContext* ctx,
     int priority_;
     size_t offset_;
     size_t size_;
-    // create a conflict for overlapping matches
-    // thus if they overlap neither is less than the other
-    // and they are considered equal
-    bool operator<(const Match& o) const {
-      return (offset_ + size_) <= o.offset_;
-    }
   };
 
-  std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
   // Scan all strings and attempt to find separators in them
-  // collect all the output tokens here
+  // collect all the output tokens here as byte ranges of the input strings
   size_t max_tokens = 0;
-  std::vector<std::vector<std::wstring>> tokenized_strings;
-  tokenized_strings.reserve(N * C);
+  std::vector<Token> tokens;
+  std::vector<size_t> row_sizes;
+  row_sizes.reserve(N * C);
+  // reused for every string
+  std::vector<Match> matches;
+  std::vector<size_t> char_offsets;
   auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    std::wstring wstr = converter.from_bytes(s);
-    if (wstr == wconv_error) {
+  const size_t num_inputs = N * C;
+  for (size_t i = 0; i < num_inputs; ++i) {
+    const StringView s = X->StringAt(i);
+    size_t num_chars = 0;
+    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), num_chars)) {
       return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Invalid utf8 chars in the input: " + s);
+                    "Invalid utf8 chars in the input: " + s.ToString());
     }
 
-    std::set<Match> matches;
-    const wchar_t* ws = wstr.c_str();
-    size_t len_remaining = wstr.length();
-    size_t offset = 0;
-    while (len_remaining > 0) {
-      const auto* val = search_data_->tst_.get(ws, len_remaining);
+    // Offsets and sizes below are in utf8 chars, so record the byte offset
+    // of each one to search and output the tokens straight from the input string
+    char_offsets.clear();
+    for (size_t byte_offset = 0; byte_offset < s.size();) {
+      char_offsets.push_back(byte_offset);
+      size_t tlen = 0;
+      utf8_bytes(static_cast<unsigned char>(s[byte_offset]), tlen);
+      byte_offset += tlen;
+    }
+    char_offsets.push_back(s.size());
+
+    // The matches are kept ordered by offset and without overlaps. A new match
+    // can only overlap the last ones, which it replaces if it has a higher priority.
+    matches.clear();
+    for (size_t offset = 0; offset < num_chars; ++offset) {
+      const size_t byte_offset = char_offsets[offset];
+      const auto* val = search_data_->tst_.get(s.data() + byte_offset, s.size() - byte_offset);
       if (val != nullptr) {
-        auto p = matches.insert({val->priority_, offset, val->w_len});
-        while (!p.second && val->priority_ < p.first->priority_) {
+        bool selected = true;
+        while (!matches.empty() && matches.back().offset_ + matches.back().size_ > offset) {
           // if overlapping matches of the same pattern(priority), then
           // the earlier match naturally wins
-          matches.erase(p.first);
-          p = matches.insert({val->priority_, offset, val->w_len});
+          if (val->priority_ < matches.back().priority_) {
+            matches.pop_back();
+          } else {
+            selected = false;
+            break;
+          }
+        }
+        if (selected) {
+          matches.push_back({val->priority_, offset, val->char_len});
         }
       }
-      ++ws;
-      ++offset;
-      --len_remaining;
     }
 
     // Tokenize
-    tokenized_strings.emplace_back();
-    auto& row_tokens = tokenized_strings.back();
-    row_tokens.reserve(matches.size() + 1);
-    ws = wstr.c_str();
-    offset = 0;
+    const size_t row_begin = tokens.size();
+    size_t offset = 0;
     for (const auto& m : matches) {
       assert(m.offset_ >= offset);
       size_t sz = (m.offset_ - offset);
       if (sz > 0 && sz >= size_t(mincharnum_)) {
-        row_tokens.emplace_back(ws, sz);
+        tokens.push_back({char_offsets[offset], char_offsets[m.offset_] - char_offsets[offset]});
       }
       offset = m.offset_ + m.size_;
-      ws = wstr.c_str() + offset;
     }
-    assert(offset <= wstr.length());
-    if (offset < wstr.length()) {
-      row_tokens.emplace_back(ws, wstr.length() - offset);
+    assert(offset <= num_chars);
+    if (offset < num_chars) {
+      tokens.push_back({char_offsets[offset], s.size() - char_offsets[offset]});
     }
+    row_sizes.push_back(tokens.size() - row_begin);
 
-    size_t tokens = row_tokens.size();
+    size_t tokens_num = row_sizes.back();
     if (mark_) {
-      tokens += 2;  // Start/end markers as separate tokens
+      tokens_num += 2;  // Start/end markers as separate tokens
     }
-    max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
-  }
-
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if ((max_tokens - mark_ * 2) == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
+    max_tokens = std::max(max_tokens, tokens_num);
   }
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  size_t output_index = 0;
-  for (auto& row : tokenized_strings) {
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (auto& token : row) {
-      *(output_data + output_index) = converter.to_bytes(token);
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-  }
-  return Status::OK();
+  return OutputTokens(ctx, N, C, input_dims, max_tokens, tokens, row_sizes);
 }
 
 Status Tokenizer::ExpressionTokenize(OpKernelContext* ctx,
                                      size_t N, size_t C,
                                      const std::vector<int64_t>& input_dims) const {
   using namespace re2;
-  // Represents a token that will be output after
-  // first is the index, second is the size;
-  using Token = std::pair<size_t, size_t>;
-  std::vector<std::vector<Token>> tokens;
-  tokens.reserve(N * C);
+  std::vector<Token> tokens;
+  std::vector<size_t> row_sizes;
+  row_sizes.reserve(N * C);
 
   size_t max_tokens = 0;
   auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
+  const size_t num_inputs = N * C;
 
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    tokens.emplace_back();
-    auto& row = tokens.back();
+  for (size_t i = 0; i < num_inputs; ++i) {
+    const StringView s = X->StringAt(i);
+    const size_t row_begin = tokens.size();
 
-    StringPiece text(s);
-    const auto end_pos = s.length();
+    StringPiece text(s.data(), s.size());
+    const auto end_pos = s.size();
     size_t start_pos = 0;
     StringPiece submatch;
 
@@ -533,7 +496,7 @@ Status Tokenizer::ExpressionTokenize(OpKernelContext* ctx,
         assert(match_pos >= start_pos);
         auto token_len = match_pos - start_pos;
         if (token_len > 0) {
-          row.emplace_back(start_pos, token_len);
+          tokens.push_back({start_pos, token_len});
         }
         // Update starting position
         // Guard against empty string match
@@ -547,18 +510,27 @@ Status Tokenizer::ExpressionTokenize(OpKernelContext* ctx,
         // record trailing token
         auto trailing_len = end_pos - start_pos;
         if (trailing_len > 0) {
-          row.emplace_back(start_pos, trailing_len);
+          tokens.push_back({start_pos, trailing_len});
         }
       }
     }
-    size_t tokens_num = row.size();
+    row_sizes.push_back(tokens.size() - row_begin);
+
+    size_t tokens_num = row_sizes.back();
     if (mark_) {
       tokens_num += 2;  // Start/end markers as separate tokens
     }
     max_tokens = std::max(max_tokens, tokens_num);
-    ++curr_input;
   }
-  // Check for empty output
+
+  return OutputTokens(ctx, N, C, input_dims, max_tokens, tokens, row_sizes);
+}
+
+Status Tokenizer::OutputTokens(OpKernelContext* ctx, size_t N, size_t C,
+                               const std::vector<int64_t>& input_dims,
+                               size_t max_tokens,
+                               const std::vector<Token>& tokens,
+                               const std::vector<size_t>& row_sizes) const {
   std::vector<int64_t> output_dims(input_dims);
   // Check if we have no output due to either empty input
   // everything is a separator
@@ -573,49 +545,47 @@ Status Tokenizer::ExpressionTokenize(OpKernelContext* ctx,
   TensorShape output_shape(output_dims);
 
   auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
+  auto X = ctx->Input<Tensor>(0);
 
-#ifdef _DEBUG
+  size_t token_bytes = 0;
+  for (const auto& token : tokens) {
+    token_bytes += token.size_;
+  }
+
+  // The tokens are written to an arena, so there is no allocation per token
   const size_t max_output_index = N * C * max_tokens;
-#endif
-  curr_input = input_data;
-  size_t output_index = 0;
-  for (const auto& row : tokens) {
-    assert(curr_input != last);
+  auto& output = output_tensor->InitStringArena();
+  output.Reserve(max_output_index, token_bytes + max_output_index * std::max<size_t>(pad_value_.size(), 1));
+
+  auto token = tokens.cbegin();
+  for (size_t row = 0; row < row_sizes.size(); ++row) {
 #ifdef _DEBUG
-    size_t c_idx = output_index;
+    size_t c_idx = output.NumStrings();
 #endif
     if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
+      output.Append(&start_text, 1);
     }
     // Output tokens for this row
-    const char* data = curr_input->data();
-    for (const auto& token : row) {
+    const StringView s = X->StringAt(row);
+    for (auto row_end = token + row_sizes[row]; token != row_end; ++token) {
 #ifdef _DEBUG
-      auto s_len = curr_input->length();
-      assert(token.second > 0);
-      assert(token.first < s_len);
-      assert(token.first + token.second <= s_len);
+      auto s_len = s.size();
+      assert(token->size_ > 0);
+      assert(token->offset_ < s_len);
+      assert(token->offset_ + token->size_ <= s_len);
 #endif
-      (output_data + output_index)->assign(data + token.first, token.second);
-      ++output_index;
+      output.Append(s.data() + token->offset_, token->size_);
     }
     if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
+      output.Append(&end_text, 1);
     }
+    OutputPadding(output, max_tokens - (mark_ * 2) - row_sizes[row]);
 #ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
+    assert(output.NumStrings() <= max_output_index);
+    assert((output.NumStrings() - c_idx) <= max_tokens);
 #endif
-    ++curr_input;
   }
+  assert(output.NumStrings() == max_output_index);
 
   return Status::OK();
 }
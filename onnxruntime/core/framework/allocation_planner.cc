@@ -36,6 +36,9 @@ std::ostream& operator<<(std::ostream& out, AllocKind alloc_kind) {
     case AllocKind::kAllocateOutput:
       out << "AllocateOutput";
       break;
+    case AllocKind::kSubBuffer:
+      out << "SubBuffer";
+      break;
   }
   return out;
 }
@@ -58,6 +61,8 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
       if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.alloc_kind == AllocKind::kSubBuffer)
+        out << " " << elt_plan.reused_buffer << "+" << elt_plan.sub_buffer_offset;
 
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
@@ -131,6 +136,9 @@ class PlannerImpl {
     const onnxruntime::NodeArg* p_def_site;  // the (unique) NodeArg corresponding to the MLValue
     int usecount = 0;                        // static reference-count
     MLValueIndex reused_buffer_index;        // index of original buffer to reuse
+    bool consumers_accept_strided = true;    // every consumer can read a strided view of the ml-value
+    bool may_be_strided = false;             // the ml-value may be a strided view of another buffer
+    bool has_sub_buffers = false;            // other ml-values are placed inside the buffer of the ml-value
   };
 
   // ml_value_info_ is indexed by an MLValueIndex
@@ -175,6 +183,9 @@ class PlannerImpl {
     info.usecount = 0;
     info.reused_buffer_index = id;  // initially, no reuse; the ml-value uses its own buffer
     info.p_def_site = p_def_site;
+    info.consumers_accept_strided = true;
+    info.may_be_strided = false;
+    info.has_sub_buffers = false;
   }
 
   void Reuse(MLValueIndex reused, MLValueIndex reused_for) {
@@ -188,6 +199,15 @@ class PlannerImpl {
 
     // update allocation plan (for use at execution-time)
     auto& symplan = AllocPlan(reused_for);
+    auto& reused_plan = AllocPlan(reused);
+    if (reused_plan.alloc_kind == AllocKind::kSubBuffer) {
+      // the same part of the containing buffer
+      symplan.alloc_kind = AllocKind::kSubBuffer;
+      symplan.reused_buffer = reused_plan.reused_buffer;
+      symplan.sub_buffer_offset = reused_plan.sub_buffer_offset;
+      symplan.sub_buffer_size = reused_plan.sub_buffer_size;
+      return;
+    }
     symplan.alloc_kind = AllocKind::kReuse;
     symplan.reused_buffer = original;
   }
@@ -224,7 +244,7 @@ class PlannerImpl {
           if (p_input_arg->Exists()) {
             auto input_arg_index = Index(p_input_arg->Name());
             auto original = Buffer(input_arg_index);
-            if (1 == UseCount(original)) {
+            if (1 == UseCount(original) && !ml_value_info_.at(input_arg_index).may_be_strided) {
               if (SameSize(*p_input_arg, *p_output_arg)) {
                 // we can reuse this input since it is its last use and permitted for in-place update
                 *reusable_input = input_arg_index;  // or original; both should be okay
@@ -238,6 +258,42 @@ class PlannerImpl {
     return false;
   }
 
+  // Find if output_arg can be produced as a strided view of one of the node's inputs. This requires
+  // the kernel to declare it (e.g., for slice) and every consumer of the output to accept strided input.
+  bool FindStridedInput(const onnxruntime::Node& node, int output_arg_num, MLValueIndex* strided_input) {
+    auto p_output_arg = node.OutputDefs()[output_arg_num];
+    if (!ml_value_info_.at(Index(p_output_arg->Name())).consumers_accept_strided) {
+      return false;
+    }
+
+    const KernelCreateInfo* ci;
+    Status st = kernel_registry_.SearchKernelRegistry(node, &ci);
+    if (!st.IsOK() || ci == nullptr || ci->kernel_def == nullptr) {
+      return false;
+    }
+
+    auto& input_args = node.InputDefs();
+    for (auto pair : ci->kernel_def->MayStridedOutput()) {
+      if (pair.second == output_arg_num || pair.second == -1) {
+        if ((0 <= pair.first) && (static_cast<size_t>(pair.first) < input_args.size())) {
+          auto p_input_arg = input_args[pair.first];
+          if (p_input_arg->Exists()) {
+            *strided_input = Index(p_input_arg->Name());
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+  static bool AcceptsStridedInput(const KernelDef& kernel_def, int input_arg_num) {
+    for (int index : kernel_def.MayStridedInput()) {
+      if (index == input_arg_num || index == -1) return true;
+    }
+    return false;
+  }
+
   bool SameShape(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
     // TODO: This should probably be defined to be the equality operator on TensorShapeProto.
     int rank1 = shape1.dim_size();
@@ -379,6 +435,20 @@ class PlannerImpl {
         return Status(ONNXRUNTIME, FAIL, errormsg.str());
       }
 
+      // a strided view may only be handed to kernels that can read one. implicit inputs are
+      // consumed by subgraphs, which are planned separately, so they always need contiguous data.
+      int input_arg_num = 0;
+      for (auto node_input : pnode->InputDefs()) {
+        if (node_input->Exists() && !AcceptsStridedInput(*p_kernelDef, input_arg_num))
+          ml_value_info_.at(Index(node_input->Name())).consumers_accept_strided = false;
+        input_arg_num++;
+      }
+
+      for (auto node_input : pnode->ImplicitInputDefs()) {
+        if (node_input->Exists())
+          ml_value_info_.at(Index(node_input->Name())).consumers_accept_strided = false;
+      }
+
       auto exec_provider = execution_providers_.Get(*pnode);
       if (exec_provider == nullptr) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Can not find the execution provider ",
@@ -459,6 +529,128 @@ class PlannerImpl {
     return Status::OK();
   }
 
+  // Returns the static shape of a tensor if shape inference determined every dimension.
+  bool GetStaticShape(const onnxruntime::NodeArg& arg, std::vector<int64_t>& shape) {
+    auto* shape_proto = context_.GetShape(arg);
+    if (shape_proto == nullptr) return false;
+    shape.clear();
+    for (auto& dim : shape_proto->dim()) {
+      if (!dim.has_dim_value() || dim.dim_value() < 0) return false;
+      shape.push_back(dim.dim_value());
+    }
+    return true;
+  }
+
+  // A Concat along the outermost non-trivial axis copies each input into one contiguous block of
+  // its output. When the shapes are static, place those inputs inside the output buffer so that
+  // their producers write the concatenated result directly and the copies in Concat become no-ops.
+  // This runs before the per-node planning, which then leaves the placed inputs alone.
+  void PlanConcatSubBuffers() {
+    // the containing buffer is allocated when the first input is produced, which is not
+    // safe to do from concurrently running nodes.
+    if (context_.EnableParallelExecution()) return;
+
+    // map each ml-value to the node producing it, and the output index
+    std::unordered_map<MLValueIndex, std::pair<const onnxruntime::Node*, int>> producers;
+    for (auto& step : plan_.execution_plan) {
+      auto pnode = graph_viewer_.GetNode(step.node_index);
+      int output_arg_num = 0;
+      for (auto node_output : pnode->OutputDefs()) {
+        if (node_output->Exists()) producers[Index(node_output->Name())] = {pnode, output_arg_num};
+        output_arg_num++;
+      }
+    }
+
+    auto& graph_outputs = graph_viewer_.GetOutputs();
+    auto is_graph_output = [&graph_outputs](const onnxruntime::NodeArg* arg) {
+      return std::find(graph_outputs.begin(), graph_outputs.end(), arg) != graph_outputs.end();
+    };
+
+    for (auto& step : plan_.execution_plan) {
+      auto pnode = graph_viewer_.GetNode(step.node_index);
+      const KernelCreateInfo* ci;
+      Status st = kernel_registry_.SearchKernelRegistry(*pnode, &ci);
+      if (!st.IsOK() || ci == nullptr || ci->kernel_def == nullptr) continue;
+      const KernelDef& kernel_def = *ci->kernel_def;
+      // the CPU kernel skips the copy of an input that is already in place
+      if (kernel_def.OpName() != "Concat" || kernel_def.Domain() != kOnnxDomain ||
+          kernel_def.Provider() != kCpuExecutionProvider)
+        continue;
+
+      auto p_output_arg = pnode->OutputDefs()[0];
+      auto output_index = Index(p_output_arg->Name());
+      auto output_type = utils::GetMLDataType(*p_output_arg);
+      std::vector<int64_t> output_shape;
+      if (IsNonTensor(*p_output_arg) || output_type == DataTypeImpl::GetTensorType<std::string>() ||
+          AllocPlan(output_index).alloc_kind == AllocKind::kSubBuffer ||
+          !GetStaticShape(*p_output_arg, output_shape) || output_shape.empty())
+        continue;
+
+      auto& attributes = pnode->GetAttributes();
+      auto axis_attr = attributes.find("axis");
+      if (axis_attr == attributes.end()) continue;
+      int64_t axis = axis_attr->second.i();
+      if (axis < 0) axis += static_cast<int64_t>(output_shape.size());
+      if (axis < 0 || axis >= static_cast<int64_t>(output_shape.size())) continue;
+      if (std::any_of(output_shape.begin(), output_shape.begin() + axis, [](int64_t dim) { return dim != 1; }))
+        continue;
+
+      const auto& output_location = AllocPlan(output_index).location;
+      const size_t element_size = static_cast<const TensorTypeBase*>(output_type)->GetElementType()->Size();
+
+      // place each input that is produced by a node of this graph into its block of the output
+      auto& input_args = pnode->InputDefs();
+      size_t offset = 0;
+      for (auto p_input_arg : input_args) {
+        std::vector<int64_t> input_shape;
+        if (!p_input_arg->Exists() || !GetStaticShape(*p_input_arg, input_shape))
+          break;  // the offsets of the following inputs are unknown
+
+        size_t input_size = element_size;
+        for (auto dim : input_shape) input_size *= static_cast<size_t>(dim);
+
+        auto input_index = Index(p_input_arg->Name());
+        auto producer = producers.find(input_index);
+        // the value must be used once, by this input of the Concat. it is counted once for its definition and once
+        // for each use: as an input or implicit input of a node, including this one, and as a graph output.
+        // any other use could read it after the buffer of the Concat output is reused, or write to it in place.
+        bool used_once_by_concat = UseCount(input_index) == 2 &&
+                                   std::count(input_args.begin(), input_args.end(), p_input_arg) == 1;
+        if (producer != producers.end() && used_once_by_concat && !is_graph_output(p_input_arg) &&
+            AllocPlan(input_index).alloc_kind == AllocKind::kAllocate &&
+            AllocPlan(input_index).location == output_location &&
+            !ml_value_info_.at(input_index).has_sub_buffers &&
+            !ProducesAlias(*producer->second.first, producer->second.second)) {
+          auto& input_plan = AllocPlan(input_index);
+          input_plan.alloc_kind = AllocKind::kSubBuffer;
+          input_plan.reused_buffer = output_index;
+          input_plan.sub_buffer_offset = offset;
+          input_plan.sub_buffer_size = input_size;
+
+          // the output buffer stays alive as long as any of the inputs placed in it
+          Buffer(input_index) = output_index;
+          UseCount(output_index) += UseCount(input_index);
+          ml_value_info_.at(output_index).has_sub_buffers = true;
+        }
+        offset += input_size;
+      }
+
+      if (ml_value_info_.at(output_index).has_sub_buffers)
+        AllocPlan(output_index).planned_shape = output_shape;
+    }
+  }
+
+  // Returns true if the kernel of the node must produce the output as an alias of an input.
+  bool ProducesAlias(const onnxruntime::Node& node, int output_arg_num) {
+    const KernelCreateInfo* ci;
+    Status st = kernel_registry_.SearchKernelRegistry(node, &ci);
+    if (!st.IsOK() || ci == nullptr || ci->kernel_def == nullptr) return true;
+    for (auto pair : ci->kernel_def->Alias()) {
+      if (pair.second == output_arg_num) return true;
+    }
+    return false;
+  }
+
   Status ComputeReusePlan() {
     std::vector<SequentialExecutionPlan::NodeExecutionPlan>& execution_plan{plan_.execution_plan};
 
@@ -485,6 +677,8 @@ class PlannerImpl {
 
     ORT_RETURN_IF_ERROR(GeneratePlanForWeights());
 
+    PlanConcatSubBuffers();
+
     for (size_t program_counter = 0; program_counter < execution_plan.size(); ++program_counter) {
       SequentialExecutionPlan::NodeExecutionPlan step = execution_plan[program_counter];
       auto pnode = graph_viewer_.GetNode(step.node_index);
@@ -497,15 +691,24 @@ class PlannerImpl {
         auto current = Index(node_output->Name());
         AllocPlan(current).value_type = utils::GetMLDataType(*node_output);
         MLValueIndex reused;
-        if (std::find(graph_outputs.begin(), graph_outputs.end(), node_output) != graph_outputs.end()) {
+        if (AllocPlan(current).alloc_kind == AllocKind::kSubBuffer) {
+          // placed inside the buffer of a Concat output by PlanConcatSubBuffers
+        } else if (std::find(graph_outputs.begin(), graph_outputs.end(), node_output) != graph_outputs.end()) {
           // node_output is graph's output, so we can't reuse intermedia buffer
           AllocPlan(current).alloc_kind = AllocKind::kAllocateOutput;
+        } else if (ml_value_info_.at(current).has_sub_buffers) {
+          // the buffer is allocated before this node runs, so it can't be one that becomes free later
+          AllocPlan(current).alloc_kind = AllocKind::kAllocate;
         } else if (IsNonTensor(*node_output)) {
           // we do not try sharing-optimization for non-tensors
           AllocPlan(current).alloc_kind = AllocKind::kAllocate;
         } else if (FindReusableInput(*pnode, output_arg_num, &reused)) {
           // Reuse one of this node's input buffers as the output buffer (for in-place update)
           Reuse(reused, current);
+        } else if (FindStridedInput(*pnode, output_arg_num, &reused)) {
+          // The output is a view into one of this node's input buffers
+          Reuse(reused, current);
+          ml_value_info_.at(current).may_be_strided = true;
         } else if (!context_.EnableParallelExecution() && FindReusableTensor(*node_output, &reused)) {
           // Reuse an available (dead) buffer for this output, this is only for sequential execution.
           Reuse(reused, current);
@@ -28,12 +28,30 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs,
       planner_(nullptr),
       fetch_mlvalue_idxs_{fetch_mlvalue_idxs} {
   Init(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators);
+  InitMemoryPatterns(feeds);
+}
+
+ExecutionFrame::~ExecutionFrame() = default;
 
+void ExecutionFrame::Reset(const std::vector<int>& feed_mlvalue_idxs,
+                           const std::vector<MLValue>& feeds,
+                           std::vector<MLValue>& fetches,
+                           const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  // release everything from the previous execution but keep the size of all_values_
+  std::fill(all_values_.begin(), all_values_.end(), MLValue());
+  retired_values_.clear();
+  custom_allocators_.clear();
+
+  Init(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs_, fetches, fetch_allocators);
+  InitMemoryPatterns(feeds);
+}
+
+void ExecutionFrame::InitMemoryPatterns(const std::vector<MLValue>& feeds) {
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
   // memory pattern optimization.
-  if (session_state.GetEnableMemoryPattern() &&
-      session_state.GetExecutionPlan()) {
+  if (session_state_.GetEnableMemoryPattern() &&
+      session_state_.GetExecutionPlan()) {
     std::vector<TensorShape> input_shapes;
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -44,13 +62,27 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs,
       auto& tensor = feed.Get<Tensor>();
       input_shapes.push_back(tensor.Shape());
     }
+
+    const MemoryPatternGroup* mem_patterns = nullptr;
     // if there is some traditional ml value type in inputs
     // disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes);
+      mem_patterns = session_state_.GetMemoryPatternGroup(input_shapes);
+
+      // a reset frame keeps the big chunks if they were allocated for the same pattern
+      if (mem_patterns && mem_patterns == mem_patterns_) {
+        return;
+      }
+    }
+
+    mem_patterns_ = mem_patterns;
+    planner_.reset();
+    buffers_.clear();
+
+    if (all_tensors) {
       // if no existing patterns, generate one in this executionframe
       if (!mem_patterns_) {
-        planner_ = std::make_unique<MLValuePatternPlanner>(*session_state.GetExecutionPlan());
+        planner_ = std::make_unique<MLValuePatternPlanner>(*session_state_.GetExecutionPlan());
       } else {
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
@@ -65,8 +97,6 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs,
   }
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
-
 Status ExecutionFrame::AllocateMLValueTensorSelfOwnBuffer(int mlvalue_index,
                                                           const DataTypeImpl* element_type,
                                                           const OrtAllocatorInfo& location,
@@ -214,6 +244,42 @@ Status ExecutionFrame::AllocateTensorWithPreAllocateBufferHelper(MLValue* p_mlva
   return Status::OK();
 }
 
+// The allocation planner placed this value inside the buffer of another value, e.g. an input of a Concat
+// inside the Concat output. The containing value is allocated first if this is the first value placed in it.
+Status ExecutionFrame::AllocateMLValueTensorInSubBuffer(int mlvalue_index,
+                                                        const SequentialExecutionPlan::AllocPlanPerValue& per_alloc_plan,
+                                                        MLDataType element_type,
+                                                        const TensorShape& shape) {
+  const int container_index = per_alloc_plan.reused_buffer;
+  ORT_ENFORCE(container_index >= 0 && static_cast<size_t>(container_index) < all_values_.size());
+  MLValue* p_container = &all_values_[container_index];
+
+  const TensorShape container_shape(GetAllocationPlan(container_index).planned_shape);
+  if (!p_container->IsAllocated()) {
+    ORT_RETURN_IF_ERROR(AllocateAsPerAllocationPlan(container_index, MLValueAllocationParameters(&container_shape)));
+  }
+
+  size_t size;
+  if (shape.Size() < 0 || !IAllocator::CalcMemSizeForArray(static_cast<size_t>(shape.Size()), element_type->Size(), &size)) {
+    return Status(ONNXRUNTIME, FAIL, "size overflow");
+  }
+
+  // the shapes at runtime differ from the ones the plan was made for, so the value needs a buffer of its own
+  if (!p_container->IsTensor() || p_container->Get<Tensor>().Shape() != container_shape ||
+      size != per_alloc_plan.sub_buffer_size) {
+    return AllocateMLValueTensorSelfOwnBufferHelper(mlvalue_index, element_type, per_alloc_plan.location, shape,
+                                                    per_alloc_plan.create_fence_if_async);
+  }
+
+  auto* container_tensor = p_container->GetMutable<Tensor>();
+  void* buffer = static_cast<char*>(container_tensor->MutableDataRaw()) + container_tensor->ByteOffset() +
+                 per_alloc_plan.sub_buffer_offset;
+
+  MLValue* p_mlvalue = &all_values_[mlvalue_index];
+  p_mlvalue->ShareFenceWith(*p_container);
+  return AllocateTensorWithPreAllocateBufferHelper(p_mlvalue, buffer, element_type, per_alloc_plan.location, shape);
+}
+
 Status AllocateTraditionalMLValue(MLValue* p_mlvalue,
                                   const NonTensorTypeBase* type,
                                   const MLValueAllocationParameters& parameters) {
@@ -282,6 +348,13 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(int mlvalue_index,
                                                                  per_alloc_plan.create_fence_if_async));
       break;
     }
+    case AllocKind::kSubBuffer: {
+      ORT_RETURN_IF_ERROR(AllocateMLValueTensorInSubBuffer(mlvalue_index,
+                                                           per_alloc_plan,
+                                                           ml_data_type,
+                                                           parameters.GetTensorShape()));
+      break;
+    }
     default: {
       std::ostringstream ostr;
       ostr << "Invalid allocation kind: " << static_cast<std::underlying_type<AllocKind>::type>(alloc_kind);
@@ -419,10 +492,24 @@ Status ExecutionFrame::GetOrCreateNodeOutputMLValue(int index,
   p_mlvalue = &all_values_.at(mlvalue_idx);
 
   if (p_mlvalue->IsAllocated()) {
-    // The ml has already been allocated.
-    // Now only tensor need to be check.
-    VerifyShape(p_mlvalue, parameters);  // TODO find a better way to do this
-    return Status::OK();
+    // A pre-allocated output provided by the caller is written to directly, and must have the shape produced
+    // unless the caller also provided a custom allocator for it, e.g. for an output bound with IOBinding that
+    // may be reused across runs with different shapes. The custom allocator then replaces it by a new value.
+    // Outputs such as the slices of a Scan output have no custom allocator, so a mismatch is still an error.
+    // A value that was allocated early to hold sub-buffers is replaced the same way if the planned shape
+    // was wrong, but it is kept alive for the values placed inside it.
+    bool shape_mismatch = p_mlvalue->IsTensor() &&
+                          p_mlvalue->Get<Tensor>().Shape() != parameters.GetTensorShape();
+    bool has_sub_buffers = !GetAllocationPlan(mlvalue_idx).planned_shape.empty();
+    if (shape_mismatch && (has_sub_buffers || custom_allocators_.count(mlvalue_idx) != 0)) {
+      if (has_sub_buffers) retired_values_.push_back(*p_mlvalue);
+      *p_mlvalue = MLValue();
+    } else {
+      // The ml has already been allocated.
+      // Now only tensor need to be check.
+      VerifyShape(p_mlvalue, parameters);  // TODO find a better way to do this
+      return Status::OK();
+    }
   }
 
   // It's not allocated, then allocate it with given shape and return.
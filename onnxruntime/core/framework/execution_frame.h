@@ -48,6 +48,14 @@ class ExecutionFrame {
 
   ~ExecutionFrame();
 
+  // Prepare to execute the graph again with new feeds and fetches for the same feed and fetch indexes,
+  // e.g. in each iteration of a Loop or Scan subgraph. The buffers for the memory pattern are kept when the
+  // shapes of the feeds select the same pattern.
+  void Reset(const std::vector<int>& feed_mlvalue_idxs,
+             const std::vector<MLValue>& feeds,
+             std::vector<MLValue>& fetches,
+             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
   // TODO: These two AllocateMLValue... methods are in the API purely for unit test usage.
   // Fix the unit tests so they set an execution plan that results in these methods being called by
   // GetOrCreateNodeOutputMLValue instead
@@ -113,6 +121,8 @@ class ExecutionFrame {
             std::vector<MLValue>& fetches,
             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
 
+  void InitMemoryPatterns(const std::vector<MLValue>& feeds);
+
   common::Status AllocateAsPerAllocationPlan(int mlvalue_index,
                                              const MLValueAllocationParameters& parameters);
 
@@ -128,6 +138,11 @@ class ExecutionFrame {
                                                    const OrtAllocatorInfo& location,
                                                    const TensorShape& shape);
 
+  Status AllocateMLValueTensorInSubBuffer(int mlvalue_index,
+                                          const SequentialExecutionPlan::AllocPlanPerValue& per_alloc_plan,
+                                          MLDataType element_type,
+                                          const TensorShape& shape);
+
   void TraceAllocate(int mlvalue_idx, size_t size);
 
   void TraceFree(int mlvalue_idx);
@@ -165,5 +180,10 @@ class ExecutionFrame {
 
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<OrtAllocatorInfo, BufferUniquePtr> buffers_;
+
+  // Values containing sub-buffers that were replaced because their shape at runtime differs
+  // from the planned one. They are kept until the end of the execution as the values placed
+  // inside them are still in use.
+  std::vector<MLValue> retired_values_;
 };
 }  // namespace onnxruntime
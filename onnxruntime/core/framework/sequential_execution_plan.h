@@ -33,6 +33,14 @@ struct SequentialExecutionPlan {
     // reused_buffer is valid only if alloc_kind == kReuse. It indicates
     // which MLValue's buffer must be reused for this MLValue.
     MLValueIndex reused_buffer{0};
+    // sub_buffer_offset and sub_buffer_size are valid only if alloc_kind == kSubBuffer.
+    // The MLValue occupies these bytes of the buffer of the MLValue reused_buffer.
+    size_t sub_buffer_offset{0};
+    size_t sub_buffer_size{0};
+    // planned_shape is set for an MLValue containing sub-buffers, which is allocated
+    // with this shape when the first sub-buffer is created. If the sizes at runtime
+    // differ from the planned ones, a sub-buffer gets a buffer of its own instead.
+    std::vector<int64_t> planned_shape;
     // if the value is used in async kernel, a fence object would be created
     // note the fence object would be shared between MLValues reusing the same buffer
     bool create_fence_if_async{false};
@@ -28,6 +28,16 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
                                    std::vector<MLValue>& fetches,
                                    const std::unordered_map<size_t, CustomAllocator> fetch_allocators,
                                    const logging::Logger& logger) {
+  ExecutionFrame frame{feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, session_state};
+
+  return Execute(session_state, frame, feeds, fetches, logger);
+}
+
+Status SequentialExecutor::Execute(const SessionState& session_state,
+                                   ExecutionFrame& frame,
+                                   const std::vector<MLValue>& feeds,
+                                   std::vector<MLValue>& fetches,
+                                   const logging::Logger& logger) {
   bool f_profiler_enabled = session_state.Profiler().FEnabled();
   TimePoint tp;
   TimePoint sync_time_begin;
@@ -37,8 +47,6 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
     tp = session_state.Profiler().StartTime();
   }
 
-  ExecutionFrame frame{feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, session_state};
-
   LOGS(logger, INFO) << "Begin execution";
   const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
   const auto& exec_plan_vec = seq_exec_plan.execution_plan;
@@ -14,6 +14,8 @@
 #include "core/graph/graph_viewer.h"
 
 namespace onnxruntime {
+class ExecutionFrame;
+
 class SequentialExecutor : public IExecutor {
  public:
   SequentialExecutor(const bool& terminate_flag = false) : terminate_flag_{terminate_flag} {}
@@ -26,6 +28,13 @@ class SequentialExecutor : public IExecutor {
                          const std::unordered_map<size_t, CustomAllocator> fetch_allocators,
                          const logging::Logger& logger) override;
 
+  // Execute using a frame created by the caller, e.g. one that is Reset and reused by each iteration of a subgraph.
+  common::Status Execute(const SessionState& session_state,
+                         ExecutionFrame& frame,
+                         const std::vector<MLValue>& feeds,
+                         std::vector<MLValue>& fetches,
+                         const logging::Logger& logger);
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SequentialExecutor);
   const bool& terminate_flag_;
@@ -43,6 +43,7 @@ void Tensor::Init(MLDataType p_type,
   }
   alloc_info_ = alloc;
   byte_offset_ = offset;
+  strides_.clear();
 }
 
 Tensor::Tensor(Tensor&& other)
@@ -51,12 +52,15 @@ Tensor::Tensor(Tensor&& other)
       shape_(other.shape_),
       dtype_(other.dtype_),
       alloc_info_(other.alloc_info_),
-      byte_offset_(other.byte_offset_) {
+      byte_offset_(other.byte_offset_),
+      strides_(std::move(other.strides_)),
+      string_arena_(std::move(other.string_arena_)) {
   other.dtype_ = DataTypeImpl::GetType<float>();
   other.shape_ = TensorShape(vector<int64_t>(1, 0));
   other.p_data_ = nullptr;
   other.buffer_deleter_ = nullptr;
   other.byte_offset_ = 0;
+  other.strides_.clear();
 }
 
 Tensor& Tensor::operator=(Tensor&& other) {
@@ -67,6 +71,8 @@ Tensor& Tensor::operator=(Tensor&& other) {
     shape_ = other.shape_;
     alloc_info_ = other.alloc_info_;
     byte_offset_ = other.byte_offset_;
+    strides_ = std::move(other.strides_);
+    string_arena_ = std::move(other.string_arena_);
     p_data_ = other.p_data_;
     buffer_deleter_ = other.buffer_deleter_;
 
@@ -74,11 +80,68 @@ Tensor& Tensor::operator=(Tensor&& other) {
     other.shape_ = TensorShape(vector<int64_t>(1, 0));
     other.p_data_ = nullptr;
     other.byte_offset_ = 0;
+    other.strides_.clear();
     other.buffer_deleter_ = nullptr;
   }
   return *this;
 }
 
+std::vector<int64_t> Tensor::Strides() const {
+  if (!strides_.empty())
+    return strides_;
+
+  const auto& dims = shape_.GetDims();
+  std::vector<int64_t> strides(dims.size());
+  int64_t pitch = 1;
+  for (size_t i = dims.size(); i-- > 0;) {
+    strides[i] = pitch;
+    pitch *= dims[i];
+  }
+  return strides;
+}
+
+void Tensor::SetStridedView(const TensorShape& shape, const std::vector<int64_t>& strides, int64_t byte_offset) {
+  ORT_ENFORCE(shape.NumDimensions() == strides.size(), "Strides rank ", strides.size(),
+              " does not match shape rank ", shape.NumDimensions());
+  ORT_ENFORCE(!OwnsBuffer(), "Only a tensor that does not own its buffer can be a view.");
+
+  shape_ = shape;
+  byte_offset_ = byte_offset;
+  strides_.clear();
+
+  // axes of size 1 are never stepped through, so their stride does not affect contiguity.
+  int64_t pitch = 1;
+  for (size_t i = strides.size(); i-- > 0;) {
+    if (shape[i] != 1 && strides[i] != pitch) {
+      strides_ = strides;
+      break;
+    }
+    pitch *= shape[i];
+  }
+}
+
+StringArena& Tensor::InitStringArena() {
+  ORT_ENFORCE(dtype_ == DataTypeImpl::GetType<string>(), "Only a string tensor can hold a string arena.");
+  ORT_ENFORCE(IsContiguous(), "A strided tensor cannot hold a string arena.");
+  string_arena_ = std::make_unique<StringArenaState>();
+  return string_arena_->arena;
+}
+
+void Tensor::MaterializeStringArenaOnce() const {
+  StringArenaState& state = *string_arena_;
+  std::call_once(state.materialize_once, [this, &state]() {
+    const int64_t len = shape_.Size();
+    ORT_ENFORCE(state.arena.NumStrings() == static_cast<size_t>(len), "The string arena holds ",
+                state.arena.NumStrings(), " strings for a tensor of ", len, " elements.");
+    auto* data = reinterpret_cast<string*>(static_cast<char*>(p_data_) + byte_offset_);
+    for (int64_t i = 0; i < len; ++i) {
+      StringView s = state.arena[static_cast<size_t>(i)];
+      data[i].assign(s.data(), s.size());
+    }
+    state.materialized.store(true, std::memory_order_release);
+  });
+}
+
 Tensor::~Tensor() {
   ReleaseBuffer();
 }
@@ -75,13 +75,30 @@ const std::string& GetNodeInputProviderType(const SessionState::NodeInfo& info)
   return required_provider_type;
 }
 
+// Copies source_mlvalue to target_mlvalue. A pre-allocated target must have the shape of the source unless
+// replace_target_of_other_shape is set, in which case a new target is allocated.
 static Status CopyMLValue(const FeedsFetchesManager::MLValueCopyInfo& copy_info,
-                          const MLValue& source_mlvalue, MLValue& target_mlvalue) {
+                          const MLValue& source_mlvalue, MLValue& target_mlvalue,
+                          bool replace_target_of_other_shape = false) {
   if (copy_info.copy_provider == nullptr) {
     target_mlvalue = source_mlvalue;
   } else {
+    if (!source_mlvalue.IsTensor() || (target_mlvalue.IsAllocated() && !target_mlvalue.IsTensor())) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Only tensors can be copied across devices.");
+    }
+
     auto& source_tensor = source_mlvalue.Get<Tensor>();
 
+    if (target_mlvalue.IsAllocated() && target_mlvalue.Get<Tensor>().Shape() != source_tensor.Shape()) {
+      if (!replace_target_of_other_shape) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Shape of the pre-allocated value ",
+                               target_mlvalue.Get<Tensor>().Shape(), " does not match the shape to copy ",
+                               source_tensor.Shape());
+      }
+
+      target_mlvalue = MLValue();
+    }
+
     if (!target_mlvalue.IsAllocated()) {
       ORT_RETURN_IF_ERROR(utils::AllocateHelper(*copy_info.allocation_provider, copy_info.allocation_device_id,
                                                 source_tensor, target_mlvalue));
@@ -359,9 +376,11 @@ static common::Status CachedSetupFetchesForExecute(std::vector<MLValue>& fetches
 }
 
 // copies outputs across devices only if required
+// a user fetch with a custom allocator is replaced if it has another shape than the output copied to it.
 static common::Status CopyOutputsAcrossDevices(const SessionState& session_state,
                                                const std::vector<MLValue>& fetches,
                                                std::vector<MLValue>& user_fetches,
+                                               const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                                                bool& needed_copy,
                                                std::vector<FeedsFetchesManager::MLValueCopyInfo>* copiers) {
   needed_copy = false;
@@ -370,7 +389,8 @@ static common::Status CopyOutputsAcrossDevices(const SessionState& session_state
   // used the cached copy logic if available
   if (copiers && !copiers->empty()) {
     for (size_t idx = 0; idx < num_outputs; ++idx) {
-      ORT_RETURN_IF_ERROR(CopyMLValue((*copiers)[idx], fetches[idx], user_fetches[idx]));
+      ORT_RETURN_IF_ERROR(CopyMLValue((*copiers)[idx], fetches[idx], user_fetches[idx],
+                                      fetch_allocators.count(idx) != 0));
     }
 
     return Status::OK();
@@ -430,7 +450,7 @@ static common::Status CopyOutputsAcrossDevices(const SessionState& session_state
 
     const int device_id = 0;  // TODO: As per comment in the copy input code, make this configurable.
     FeedsFetchesManager::MLValueCopyInfo copy_info{device_id, p_output_provider, p_copy_provider};
-    ORT_RETURN_IF_ERROR(CopyMLValue(copy_info, fetched_mlvalue, output_mlvalue));
+    ORT_RETURN_IF_ERROR(CopyMLValue(copy_info, fetched_mlvalue, output_mlvalue, fetch_allocators.count(idx) != 0));
 
     if (copiers) {
       (*copiers)[idx] = std::move(copy_info);
@@ -440,9 +460,11 @@ static common::Status CopyOutputsAcrossDevices(const SessionState& session_state
   return Status::OK();
 }
 
-static common::Status CachedCopyOutputsAcrossDevices(const std::vector<MLValue>& fetches,
-                                                     std::vector<MLValue>& user_fetches,
-                                                     const std::vector<FeedsFetchesManager::MLValueCopyInfo>& copy_info) {
+static common::Status CachedCopyOutputsAcrossDevices(
+    const std::vector<MLValue>& fetches,
+    std::vector<MLValue>& user_fetches,
+    const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+    const std::vector<FeedsFetchesManager::MLValueCopyInfo>& copy_info) {
   auto num_outputs = fetches.size();
 
   // internal logic error if these are mismatched
@@ -450,12 +472,30 @@ static common::Status CachedCopyOutputsAcrossDevices(const std::vector<MLValue>&
 
   // used the cached copy logic if available
   for (size_t idx = 0; idx < num_outputs; ++idx) {
-    ORT_RETURN_IF_ERROR(CopyMLValue(copy_info[idx], fetches[idx], user_fetches[idx]));
+    ORT_RETURN_IF_ERROR(CopyMLValue(copy_info[idx], fetches[idx], user_fetches[idx],
+                                    fetch_allocators.count(idx) != 0));
   }
 
   return Status::OK();
 }
 
+// The custom allocators to use during execution when it writes to device_fetches instead of the user fetches.
+// A pre-allocated user fetch which can't be used during execution, as it is on another device than the output,
+// is replaced when the output is copied to it if needed, so its custom allocator must not allocate the output.
+static std::unordered_map<size_t, IExecutor::CustomAllocator> GetDeviceFetchAllocators(
+    const std::vector<MLValue>& fetches,
+    const std::vector<MLValue>& device_fetches,
+    const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  std::unordered_map<size_t, IExecutor::CustomAllocator> device_fetch_allocators;
+  for (const auto& entry : fetch_allocators) {
+    if (!fetches[entry.first].IsAllocated() || device_fetches[entry.first].IsAllocated()) {
+      device_fetch_allocators.insert(entry);
+    }
+  }
+
+  return device_fetch_allocators;
+}
+
 // check if all the execution providers use the same allocator. if so, no copies between devices should be required,
 // and the overall status for DeviceCopyChecks can be set to NoCopy
 static DeviceCopyCheck CheckExecutionProviders(const ExecutionProviders& execution_providers) {
@@ -529,11 +569,14 @@ common::Status ExecuteGraphWithCachedInfo(const SessionState& session_state,
 
     ORT_RETURN_IF_ERROR(p_exec->Execute(session_state,
                                         feeds_fetches_info.feeds_mlvalue_idxs, *p_feeds,
-                                        feeds_fetches_info.fetches_mlvalue_idxs, *p_fetches, fetch_allocators,
+                                        feeds_fetches_info.fetches_mlvalue_idxs, *p_fetches,
+                                        p_fetches == &fetches
+                                            ? fetch_allocators
+                                            : GetDeviceFetchAllocators(fetches, device_fetches, fetch_allocators),
                                         logger));
 
     if (device_copy_checks.output_copy_needed == DeviceCopyCheck::Copy) {
-      ORT_RETURN_IF_ERROR(CachedCopyOutputsAcrossDevices(*p_fetches, fetches,
+      ORT_RETURN_IF_ERROR(CachedCopyOutputsAcrossDevices(*p_fetches, fetches, fetch_allocators,
                                                          feeds_fetches_manager.GetFetchesDeviceCopiers()));
     }
   }
@@ -541,6 +584,33 @@ common::Status ExecuteGraphWithCachedInfo(const SessionState& session_state,
   return Status::OK();
 }
 
+common::Status ExecuteSubgraphWithCachedInfo(const SessionState& session_state,
+                                             const FeedsFetchesManager& feeds_fetches_manager,
+                                             const std::vector<MLValue>& feeds,
+                                             std::vector<MLValue>& fetches,
+                                             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                                             const bool& terminate_flag,
+                                             const logging::Logger& logger,
+                                             std::unique_ptr<ExecutionFrame>& frame) {
+  if (feeds_fetches_manager.GetDeviceCopyChecks().status != DeviceCopyCheck::NoCopy) {
+    return ExecuteGraphWithCachedInfo(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
+                                      /*sequential_execution*/ true, terminate_flag, logger);
+  }
+
+  const auto& feeds_fetches_info = feeds_fetches_manager.GetFeedsFetchesInfo();
+
+  if (frame) {
+    frame->Reset(feeds_fetches_info.feeds_mlvalue_idxs, feeds, fetches, fetch_allocators);
+  } else {
+    frame = std::make_unique<ExecutionFrame>(feeds_fetches_info.feeds_mlvalue_idxs, feeds,
+                                             feeds_fetches_info.fetches_mlvalue_idxs, fetches, fetch_allocators,
+                                             session_state);
+  }
+
+  SequentialExecutor executor(terminate_flag);
+  return executor.Execute(session_state, *frame, feeds, fetches, logger);
+}
+
 // execute graph and update feeds_fetches_manager with cached copy info if cache_copy_info is true
 common::Status ExecuteGraph(const SessionState& session_state,
                             FeedsFetchesManager& feeds_fetches_manager,
@@ -609,11 +679,13 @@ common::Status ExecuteGraph(const SessionState& session_state,
 
     ORT_RETURN_IF_ERROR(p_exec->Execute(session_state,
                                         feeds_fetches_info.feeds_mlvalue_idxs, *p_feeds,
-                                        feeds_fetches_info.fetches_mlvalue_idxs, *p_fetches, fetch_allocators,
+                                        feeds_fetches_info.fetches_mlvalue_idxs, *p_fetches,
+                                        GetDeviceFetchAllocators(fetches, device_fetches, fetch_allocators),
                                         logger));
 
     copiers = cache_copy_info ? &feeds_fetches_manager.GetMutableFetchesDeviceCopiers() : nullptr;
-    ORT_RETURN_IF_ERROR(CopyOutputsAcrossDevices(session_state, *p_fetches, fetches, copy_needed, copiers));
+    ORT_RETURN_IF_ERROR(CopyOutputsAcrossDevices(session_state, *p_fetches, fetches, fetch_allocators,
+                                                 copy_needed, copiers));
 
     device_copy_checks.output_copy_needed = copy_needed ? DeviceCopyCheck::Copy : DeviceCopyCheck::NoCopy;
   }
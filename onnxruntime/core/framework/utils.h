@@ -11,6 +11,7 @@
 #include "core/framework/session_state.h"
 
 namespace onnxruntime {
+class ExecutionFrame;
 class ExecutionProviders;
 class FeedsFetchesManager;
 class Graph;
@@ -65,6 +66,18 @@ common::Status ExecuteGraphWithCachedInfo(const SessionState& session_state,
                                           const bool& terminate_flag,
                                           const logging::Logger& logger);
 
+// ExecuteGraphWithCachedInfo for a subgraph that is executed repeatedly with the same feeds_fetches_manager, e.g.
+// the iterations of Loop or Scan. When no device copies are needed the ExecutionFrame in 'frame' is created by the
+// first call and Reset by the following calls, so its buffers are reused instead of creating a frame each time.
+common::Status ExecuteSubgraphWithCachedInfo(const SessionState& session_state,
+                                             const FeedsFetchesManager& feeds_fetches_manager,
+                                             const std::vector<MLValue>& feeds,
+                                             std::vector<MLValue>& fetches,
+                                             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                                             const bool& terminate_flag,
+                                             const logging::Logger& logger,
+                                             std::unique_ptr<ExecutionFrame>& frame);
+
 #define DispatchOnTensorType(tensor_type, function, ...)      \
   if (tensor_type == DataTypeImpl::GetType<float>())          \
     function<float>(__VA_ARGS__);                             \
@@ -219,6 +219,50 @@ void convPoolShapeInference(
   }
 }
 
+OpSchema& RegisterNchwcPoolOpSchema(OpSchema&& op_schema) {
+  return op_schema
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc("Pooling over tensors in the blocked NCHWc format. The attributes are the same as the ONNX pooling operator.")
+      .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
+      .Attr("kernel_shape", "", AttributeProto::INTS)
+      .Attr("strides", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("pads", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("count_include_pad", "", AttributeProto::INT, static_cast<int64_t>(0))
+      .Input(0, "X", "", "T")
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::convPoolTypeAndShapeInference(ctx, false, true);
+      });
+}
+
+OpSchema& RegisterNchwcGlobalPoolOpSchema(OpSchema&& op_schema) {
+  return op_schema
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc("Global pooling over tensors in the blocked NCHWc format.")
+      .Input(0, "X", "", "T")
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0))
+          return;
+
+        auto& input_shape = getInputShape(ctx, 0);
+        if (input_shape.dim_size() != 4) {
+          fail_shape_inference("Input tensor must have 4 dimensions");
+        }
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        *output_shape.add_dim() = input_shape.dim(0);
+        *output_shape.add_dim() = input_shape.dim(1);
+        output_shape.add_dim()->set_dim_value(1);
+        output_shape.add_dim()->set_dim_value(1);
+        updateOutputShape(ctx, 0, output_shape);
+      });
+}
+
 void RegisterContribSchemas() {
   ONNX_CONTRIB_OPERATOR_SCHEMA(SampleOp)
       .SetDomain(kMSDomain)
@@ -279,7 +323,8 @@ Sample echo operator.)DOC");
       .SinceVersion(1)
       .SetDoc(R"DOC(
 The fused convolution operator schema is the same as Conv besides it includes an attribute
-activation.)DOC")
+activation and an optional input Z. If Z is present, it is added to the convolution output
+before the activation is applied.)DOC")
       .Attr(
           "auto_pad",
           "",
@@ -326,6 +371,8 @@ activation.)DOC")
           "",
           "T")
       .Input(2, "B", "", "T", OpSchema::Optional)
+      .Input(3, "Z", "Tensor with the same shape as Y that is added to the convolution output", "T",
+             OpSchema::Optional)
       .Output(
           0,
           "Y",
@@ -336,6 +383,85 @@ activation.)DOC")
         ONNX_NAMESPACE::convPoolTypeAndShapeInference(ctx, false, true);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(ReorderInput)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Reorders a 4D tensor from NCHW format to the blocked NCHWc format used by the Nchwc
+operators. The channel count of the output is rounded up to a multiple of the block
+size and the extra channels are zero filled.)DOC")
+      .Input(0, "X", "Input tensor in NCHW format", "T")
+      .Output(0, "Y", "Output tensor in NCHWc format", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0))
+          return;
+
+        // The blocked channel count depends on the platform block size.
+        auto& input_shape = getInputShape(ctx, 0);
+        if (input_shape.dim_size() != 4) {
+          fail_shape_inference("Input tensor must have 4 dimensions");
+        }
+        ONNX_NAMESPACE::TensorShapeProto output_shape(input_shape);
+        output_shape.mutable_dim(1)->clear_dim_value();
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(ReorderOutput)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Reorders a 4D tensor from the blocked NCHWc format to NCHW format, dropping the
+channels beyond the 'channels' attribute.)DOC")
+      .Attr("channels", "Number of channels in the output tensor", AttributeProto::INT)
+      .Input(0, "X", "Input tensor in NCHWc format", "T")
+      .Output(0, "Y", "Output tensor in NCHW format", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0))
+          return;
+
+        auto& input_shape = getInputShape(ctx, 0);
+        if (input_shape.dim_size() != 4) {
+          fail_shape_inference("Input tensor must have 4 dimensions");
+        }
+        ONNX_NAMESPACE::TensorShapeProto output_shape(input_shape);
+        output_shape.mutable_dim(1)->set_dim_value(getAttribute(ctx, "channels", 0));
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(NchwcConv)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Convolution over tensors in the blocked NCHWc format. The attributes are the same as
+Conv with the addition of an optional fused activation. The filter must be reordered
+with MlasReorderFilterOIHWBiBo and the bias padded to the blocked output channel
+count.)DOC")
+      .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
+      .Attr("kernel_shape", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("dilations", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("strides", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("pads", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("group", "", AttributeProto::INT, static_cast<int64_t>(1))
+      .Attr("activation", "", AttributeProto::STRING, OPTIONAL)
+      .Attr("alpha", "", AttributeProto::FLOAT, OPTIONAL)
+      .Input(0, "X", "", "T")
+      .Input(1, "W", "", "T")
+      .Input(2, "B", "", "T", OpSchema::Optional)
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::convPoolTypeAndShapeInference(ctx, true, false);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(NchwcMaxPool, RegisterNchwcPoolOpSchema);
+  ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(NchwcAveragePool, RegisterNchwcPoolOpSchema);
+  ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(NchwcGlobalMaxPool, RegisterNchwcGlobalPoolOpSchema);
+  ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(NchwcGlobalAveragePool, RegisterNchwcGlobalPoolOpSchema);
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(FusedGemm)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1051,6 +1177,61 @@ The bounding box coordinates corresponding to the selected indices can then be o
         }
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(BatchedNonMaxSuppression)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+NonMaxSuppression over a batch of images with boxes scored for several classes, with the inputs and outputs of the
+batched ONNX NonMaxSuppression operator. The boxes of each batch and class are pruned independently: boxes with a score
+not greater than score_threshold are removed, then the boxes are selected in descending order of their scores, skipping
+those whose intersection-over-union (IOU) with an already selected box is greater than iou_threshold.
+At most max_output_boxes_per_class boxes are selected for each batch and class.
+The output lists the selected boxes by batch, then class, then descending score.)DOC")
+      .Input(0,
+             "boxes",
+             "3D tensor with shape [num_batches, spatial_dimension, 4]. The format is given by center_point_box.",
+             "T")
+      .Input(1, "scores", "3D tensor with shape [num_batches, num_classes, spatial_dimension].", "T")
+      .Input(2,
+             "max_output_boxes_per_class",
+             "Optional. Integer representing the maximum number of boxes to be selected per batch per class. "
+             "Defaults to 0, which selects no box.",
+             "tensor(int64)",
+             OpSchema::Optional)
+      .Input(3,
+             "iou_threshold",
+             "Optional. Float representing the threshold for deciding whether boxes overlap too much with respect to IOU. "
+             "Value range [0, 1]. Defaults to 0.",
+             "T",
+             OpSchema::Optional)
+      .Input(4,
+             "score_threshold",
+             "Optional. Float representing the threshold for deciding when to remove boxes based on score. "
+             "No box is removed by score if it is not given.",
+             "T",
+             OpSchema::Optional)
+      .Output(0,
+              "selected_indices",
+              "selected indices from the boxes tensor. [num_selected_indices, 3], "
+              "the selected index format is [batch_index, class_index, box_index].",
+              "tensor(int64)")
+      .Attr(
+          "center_point_box",
+          "Integer indicating the format of the box data. The default is 0. "
+          "0 - the box data is supplied as [y1, x1, y2, x2] where (y1, x1) and (y2, x2) are the coordinates of any "
+          "diagonal pair of box corners. "
+          "1 - the box data is supplied as [x_center, y_center, width, height].",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain the boxes, scores and thresholds to float tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        auto selected_indices_type = ctx.getOutputType(0)->mutable_tensor_type();
+        selected_indices_type->set_elem_type(::onnx::TensorProto_DataType::TensorProto_DataType_INT64);
+        auto* output_shape = selected_indices_type->mutable_shape();
+        output_shape->add_dim();
+        output_shape->add_dim()->set_dim_value(3);
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(MurmurHash3)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1170,6 +1351,104 @@ Example 4:
   output  = [[[2,3]],[[4,5]]]
 )DOC");
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(EmbeddingBag)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr(
+          "mode",
+          "How the rows of a bag are reduced, \"sum\" or \"mean\".",
+          AttributeProto::STRING,
+          std::string("sum"))
+      .Input(0, "data", "Embedding table of rank r >= 1. Rows are selected along the first axis.", "T")
+      .Input(1, "indices", "Tensor of rank q >= 1. Each bag is the set of rows along the last axis.", "Tind")
+      .Output(0, "output", "Tensor of rank q - 1 + r - 1.", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain input and output types to float tensors.")
+      .TypeConstraint(
+          "Tind",
+          {"tensor(int32)", "tensor(int64)"},
+          "Constrain indice type to int32 or int64")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasNInputShapes(ctx, 2)) {
+          return;
+        }
+        auto& data_shape = getInputShape(ctx, 0);
+        auto& indices_shape = getInputShape(ctx, 1);
+        if (data_shape.dim_size() < 1 || indices_shape.dim_size() < 1) {
+          fail_shape_inference("both data and indices tensor need to have rank larger than zero.");
+        }
+        auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+        for (int i = 0; i < indices_shape.dim_size() - 1; ++i) {
+          *output_shape->add_dim() = indices_shape.dim(i);
+        }
+        for (int i = 1; i < data_shape.dim_size(); ++i) {
+          *output_shape->add_dim() = data_shape.dim(i);
+        }
+      })
+      .SetDoc(R"DOC(
+Gathers rows of `data` along its first axis like Gather with axis 0, and reduces the rows
+selected by the last axis of `indices` with a sum or a mean. This is equivalent to Gather
+followed by ReduceSum or ReduceMean over the gathered bag axis, without materializing the
+gathered rows.
+Example:
+  data    = [[1,2],[3,4],[5,6]]
+  indices = [[0,2],[1,1]]
+  mode    = "sum"
+  output  = [[6,8],[6,8]]
+)DOC");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GatherDequantize)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Input(0, "data", "Embedding table of rank r >= 1. Rows are selected along the first axis.", "T")
+      .Input(1, "indices", "Tensor of rank q >= 0.", "Tind")
+      .Input(2,
+             "scale",
+             "1D tensor with the scale of each row of data. Required if data is an 8 bit integer tensor.",
+             "tensor(float)",
+             OpSchema::Optional)
+      .Input(3,
+             "zero_point",
+             "1D tensor with the zero point of each row of data. Defaults to 0.",
+             "T",
+             OpSchema::Optional)
+      .Output(0, "output", "Float tensor of rank q + r - 1.", "tensor(float)")
+      .TypeConstraint(
+          "T",
+          {"tensor(int8)", "tensor(uint8)", "tensor(float16)"},
+          "Constrain the table to 8 bit integer or float16 tensors.")
+      .TypeConstraint(
+          "Tind",
+          {"tensor(int32)", "tensor(int64)"},
+          "Constrain indice type to int32 or int64")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ctx.getOutputType(0)->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto::FLOAT);
+        if (!hasNInputShapes(ctx, 2)) {
+          return;
+        }
+        auto& data_shape = getInputShape(ctx, 0);
+        auto& indices_shape = getInputShape(ctx, 1);
+        if (data_shape.dim_size() < 1) {
+          fail_shape_inference("data tensor needs to have rank larger than zero.");
+        }
+        auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+        for (int i = 0; i < indices_shape.dim_size(); ++i) {
+          *output_shape->add_dim() = indices_shape.dim(i);
+        }
+        for (int i = 1; i < data_shape.dim_size(); ++i) {
+          *output_shape->add_dim() = data_shape.dim(i);
+        }
+      })
+      .SetDoc(R"DOC(
+Gather with axis 0 on an embedding table stored with a reduced precision. Only the gathered
+rows are converted to float. An 8 bit table is dequantized with the scale and zero point of
+each row, output = (data[indices] - zero_point[indices]) * scale[indices]. A float16 table is
+converted to float and the scale and zero point are ignored.
+)DOC");
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(WordConvEmbedding)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
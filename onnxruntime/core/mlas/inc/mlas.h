@@ -94,6 +94,44 @@ MlasSgemm(
     size_t ldc
     );
 
+//
+// Single precision matrix/matrix multiply routines for a prepacked matrix B.
+//
+
+size_t
+MLASCALL
+MlasSgemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasSgemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
 //
 // Convolution routines.
 //
@@ -102,10 +140,13 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmDepthwise,
+    MlasConvAlgorithmWinograd,
 };
 
 struct MLAS_CONV_PARAMETERS {
     const MLAS_ACTIVATION* Activation;
+    float Beta;
     size_t Dimensions;
     size_t BatchCount;
     size_t GroupCount;
@@ -129,6 +170,14 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            int32_t TargetThreadCount;
+        } Depthwise;
+        struct {
+            size_t TileBlockCount;
+            size_t FilterTransformSize;
+            int32_t TargetThreadCount;
+        } Winograd;
     } u;
 };
 
@@ -148,6 +197,7 @@ MlasConvPrepare(
     const int64_t* OutputShape,
     size_t FilterCount,
     const MLAS_ACTIVATION* Activation,
+    float Beta,
     size_t* WorkingBufferSize
     );
 
@@ -162,6 +212,79 @@ MlasConv(
     float* Output
     );
 
+//
+// When MlasConvPrepare selects MlasConvAlgorithmWinograd, the filter passed to
+// MlasConv must be the output of MlasConvWinogradTransformFilter, which stores
+// u.Winograd.FilterTransformSize elements. The transform only depends on the
+// filter tensor, so callers with a constant filter can compute it once.
+//
+
+void
+MLASCALL
+MlasConvWinogradTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* FilterTransform
+    );
+
+//
+// Transposed convolution routines.
+//
+
+enum MLAS_CONV_TRANSPOSE_ALGORITHM {
+    MlasConvTransposeAlgorithmGemmCol2Im,
+    MlasConvTransposeAlgorithmGemmScatter,
+};
+
+struct MLAS_CONV_TRANSPOSE_PARAMETERS {
+    const MLAS_ACTIVATION* Activation;
+    size_t BatchCount;
+    size_t GroupCount;
+    size_t InputChannels;
+    size_t InputShape[2];
+    size_t KernelShape[2];
+    size_t DilationShape[2];
+    size_t Padding[4];
+    size_t StrideShape[2];
+    size_t FilterCount;
+    size_t OutputShape[2];
+    size_t InputSize;
+    size_t OutputSize;
+    size_t KernelSize;
+    MLAS_CONV_TRANSPOSE_ALGORITHM Algorithm;
+    size_t FilterBlockCount;
+    int32_t TargetThreadCount;
+};
+
+void
+MLASCALL
+MlasConvTransposePrepare(
+    MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    size_t* WorkingBufferSize
+    );
+
+void
+MLASCALL
+MlasConvTranspose(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    );
+
 //
 // Pooling routines.
 //
@@ -186,6 +309,76 @@ MlasPool(
     float* Output
     );
 
+//
+// Blocked channel (NCHWc) routines.
+//
+// Tensors in the NCHWc format store the channel dimension in blocks of
+// MlasNchwcGetBlockSize() elements: [N, C/c, H, W, c]. Channel counts that are
+// not a multiple of the block size are padded with zeros. The shape arguments
+// to these routines use the logical NCHW shape of the tensor.
+//
+
+size_t
+MLASCALL
+MlasNchwcGetBlockSize(
+    void
+    );
+
+void
+MLASCALL
+MlasNchwcConv(
+    size_t Dimensions,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    const MLAS_ACTIVATION* Activation
+    );
+
+void
+MLASCALL
+MlasNchwcPool(
+    MLAS_POOLING_KIND PoolingKind,
+    size_t Dimensions,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    float* Output
+    );
+
+void
+MLASCALL
+MlasReorderInput(
+    const int64_t* InputShape,
+    const float* S,
+    float* D
+    );
+
+void
+MLASCALL
+MlasReorderOutput(
+    const int64_t* OutputShape,
+    const float* S,
+    float* D
+    );
+
+void
+MLASCALL
+MlasReorderFilterOIHWBiBo(
+    const int64_t* FilterShape,
+    const float* S,
+    float* D
+    );
+
 //
 // Miscellaneous compute routines.
 //
@@ -206,6 +399,20 @@ MlasComputeTanh(
     size_t N
     );
 
+//
+// Transpose routines.
+//
+
+void
+MLASCALL
+MlasTranspose(
+    const float* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t M,
+    size_t N
+    );
+
 //
 // Half-precision floating-point routines.
 //
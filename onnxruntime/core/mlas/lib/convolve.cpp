@@ -23,6 +23,24 @@ Abstract:
 #define MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD \
     (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK)
 
+//
+// Define the number of elements in a Winograd F(2x2, 3x3) input tile and the
+// target number of working buffer elements per thread used to size the block
+// of tiles transformed at once.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_ELEMENTS 16
+
+#define MLAS_CONV_WINOGRAD_WORKING_BUFFER_SIZE_PER_THREAD (256 * 1024)
+
+//
+// Define the minimum number of input channels and filters for which the
+// Winograd algorithm is selected. Smaller convolutions are dominated by the
+// cost of the tile transforms.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS 16
+
 //
 // Define the parameters to execute segments of a convolution operation on
 // worker threads.
@@ -571,7 +589,7 @@ Return Value:
         //
 
         size_t CountK;
-        float beta = 0.0f;
+        float beta = Parameters->Beta;
         float* SegmentOutput = Output + SegmentStartN + n;
 
         for (size_t k = 0; k < K; k += CountK) {
@@ -718,8 +736,8 @@ Return Value:
         //
 
         MlasSgemmOperation(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
-            OutputSize, K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb, 0.0f,
-            output, OutputSize);
+            OutputSize, K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb,
+            Parameters->Beta, output, OutputSize);
 
         //
         // Apply the activation with optional bias.
@@ -736,144 +754,122 @@ Return Value:
     }
 }
 
+template<size_t KernelSize, size_t StrideWidth, size_t VectorCount>
 inline
-bool
-MlasConvTryMultithread(
-    const MLAS_CONV_PARAMETERS* Parameters,
+void
+MlasConvDepthwiseComputeBlock(
     const float* Input,
-    const float* Filter,
-    const float* Bias,
-    float* WorkingBuffer,
+    size_t InputWidth,
+    size_t ky,
+    size_t CountKy,
+    const MLAS_FLOAT32X4* FilterVectors,
+    MLAS_FLOAT32X4 BiasVector,
     float* Output
     )
 /*++
 
 Routine Description:
 
-    This routine attempts to launch a convolution operation across multiple
-    threads.
+    This routine computes a block of VectorCount*4 output elements of a
+    depthwise convolution row. All input elements accessed by the block must
+    be inside the input image.
 
 Arguments:
 
-    Parameters - Supplies the structure that contains the convolution
-        parameters.
+    Input - Supplies the input row corresponding to the first kernel row and
+        the first output element of the block.
 
-    Input - Supplies the input tensor.
+    InputWidth - Supplies the number of elements per input row.
 
-    Filter - Supplies the filter tensor.
+    ky - Supplies the first kernel row that maps to a valid input row.
 
-    Bias - Optionally supplies the bias vector.
+    CountKy - Supplies the number of kernel rows that map to valid input rows.
 
-    WorkingBuffer - Supplies a working buffer sized to the number of elements
-        returned by MlasConvPrepare.
+    FilterVectors - Supplies the broadcasted filter elements.
 
-    Output - Supplies the output tensor.
+    BiasVector - Supplies the broadcasted bias value.
+
+    Output - Supplies the output block.
 
 Return Value:
 
-    Returns true if the operation was completed across multiple threads, else
-    false if the operation should fall back to a single thread.
+    None.
 
 --*/
 {
+    MLAS_FLOAT32X4 Accumulators[VectorCount];
 
-#if defined(MLAS_HAS_THREADING_SUPPORT)
-
-    MLAS_CONV_WORK_BLOCK WorkBlock;
-
-    const size_t OutputSize = Parameters->OutputSize;
-    const size_t ThreadStrideN = Parameters->u.ExpandThenGemmSegmented.ThreadStrideN;
-
-    if (ThreadStrideN >= OutputSize) {
-        return false;
+    for (size_t v = 0; v < VectorCount; v++) {
+        Accumulators[v] = BiasVector;
     }
 
-    //
-    // Initialize the common fields of the work block.
-    //
-
-    WorkBlock.Parameters = Parameters;
-    WorkBlock.Input = Input;
-    WorkBlock.Filter = Filter;
-    WorkBlock.Bias = Bias;
-    WorkBlock.WorkingBuffer = WorkingBuffer;
-    WorkBlock.Output = Output;
+    for (size_t EndingKy = ky + CountKy; ky < EndingKy; ky++) {
 
-    //
-    // Segment the operation across multiple threads.
-    //
+        const float* InputRow = Input + ky * InputWidth;
 
-    int32_t Index = 0;
-    size_t SegmentCountN;
+        for (size_t kx = 0; kx < KernelSize; kx++) {
 
-    for (size_t SegmentStartN = 0; SegmentStartN < OutputSize; SegmentStartN += SegmentCountN) {
+            const MLAS_FLOAT32X4 FilterVector = FilterVectors[ky * KernelSize + kx];
 
-        SegmentCountN = OutputSize - SegmentStartN;
+            for (size_t v = 0; v < VectorCount; v++) {
 
-        if (SegmentCountN > ThreadStrideN) {
-            SegmentCountN = ThreadStrideN;
-        }
+                const float* InputElements = InputRow + v * 4 * StrideWidth + kx;
+                MLAS_FLOAT32X4 InputVector;
 
-        WorkBlock.Segments[Index].StartN = SegmentStartN;
-        WorkBlock.Segments[Index].CountN = SegmentCountN;
+                if (StrideWidth == 1) {
+                    InputVector = MlasLoadFloat32x4(InputElements);
+                } else {
+                    InputVector = MlasLoadEvenFloat32x4(InputElements);
+                }
 
-        Index++;
+                Accumulators[v] = MlasMultiplyAddFloat32x4(InputVector, FilterVector, Accumulators[v]);
+            }
+        }
     }
 
-    MlasExecuteThreaded(MlasConvOperationThreaded, &WorkBlock, Index);
-
-    return true;
-
-#else
-
-    //
-    // No threading implementation is available.
-    //
-
-    MLAS_UNREFERENCED_PARAMETER(Parameters);
-    MLAS_UNREFERENCED_PARAMETER(Input);
-    MLAS_UNREFERENCED_PARAMETER(Filter);
-    MLAS_UNREFERENCED_PARAMETER(Bias);
-    MLAS_UNREFERENCED_PARAMETER(WorkingBuffer);
-    MLAS_UNREFERENCED_PARAMETER(Output);
-
-    return false;
-
-#endif
-
+    for (size_t v = 0; v < VectorCount; v++) {
+        MlasStoreFloat32x4(Output + v * 4, Accumulators[v]);
+    }
 }
 
+template<size_t KernelSize, size_t StrideWidth>
 void
-MLASCALL
-MlasConv(
+MlasConvDepthwiseKernel(
     const MLAS_CONV_PARAMETERS* Parameters,
     const float* Input,
     const float* Filter,
-    const float* Bias,
-    float* WorkingBuffer,
-    float* Output
+    float BiasValue,
+    float* Output,
+    size_t oh,
+    size_t CountOh
     )
 /*++
 
 Routine Description:
 
-    This routine implements the convolution operation.
+    This routine computes a range of output rows for one channel of a 2D
+    depthwise convolution with a square kernel.
+
+    Output elements whose receptive field is entirely inside the input image
+    are computed with vector loads and without bounds checks. The remaining
+    elements near the left and right edges are computed one at a time.
 
 Arguments:
 
     Parameters - Supplies the structure that contains the convolution
         parameters.
 
-    Input - Supplies the input tensor.
+    Input - Supplies the input image for the channel.
 
-    Filter - Supplies the filter tensor.
+    Filter - Supplies the filter for the channel.
 
-    Bias - Optionally supplies the bias vector.
+    BiasValue - Supplies the bias value for the channel.
 
-    WorkingBuffer - Supplies a working buffer sized to the number of elements
-        returned by MlasConvPrepare.
+    Output - Supplies the output image for the channel.
 
-    Output - Supplies the output tensor.
+    oh - Supplies the first output row to compute.
+
+    CountOh - Supplies the number of output rows to compute.
 
 Return Value:
 
@@ -881,189 +877,1152 @@ Return Value:
 
 --*/
 {
-    const size_t FilterCount = Parameters->FilterCount;
-    const size_t OutputSize = Parameters->OutputSize;
-    const size_t K = Parameters->K;
-
-    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
-    const size_t OutputGroupSize = FilterCount * OutputSize;
-    const size_t FilterGroupSize = FilterCount * K;
+    constexpr size_t HeightShapeIndex = 0;
+    constexpr size_t WidthShapeIndex = 1;
 
-    const size_t BatchCount = Parameters->BatchCount;
-    const size_t GroupCount = Parameters->GroupCount;
+    const ptrdiff_t InputHeight = ptrdiff_t(Parameters->InputShape[HeightShapeIndex]);
+    const ptrdiff_t InputWidth = ptrdiff_t(Parameters->InputShape[WidthShapeIndex]);
+    const size_t OutputWidth = Parameters->OutputShape[WidthShapeIndex];
 
-    const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
+    const ptrdiff_t PaddingLeftY = ptrdiff_t(Parameters->Padding[HeightShapeIndex]);
+    const ptrdiff_t PaddingLeftX = ptrdiff_t(Parameters->Padding[WidthShapeIndex]);
 
-#if defined(MLAS_HAS_THREADING_SUPPORT)
+    const ptrdiff_t StrideHeight = ptrdiff_t(Parameters->StrideShape[HeightShapeIndex]);
 
     //
-    // Schedule batches of GEMMs across multiple threads.
+    // Compute the range of output columns that can be computed without bounds
+    // checks. Strided vector loads access one element beyond the last element
+    // used by the block, so reserve an extra element for these.
     //
 
-    if (Algorithm == MlasConvAlgorithmGemmDirect && ((BatchCount > 1) || (GroupCount > 1))) {
-
-        const size_t BatchGroupCount = BatchCount * GroupCount;
-
-        int32_t TargetThreadCount = MlasPlatform.GetMaximumThreadCount();
-
-        if (size_t(TargetThreadCount) >= BatchGroupCount) {
-            TargetThreadCount = int32_t(BatchGroupCount);
-        }
+    const ptrdiff_t Kernel = ptrdiff_t(KernelSize);
+    const ptrdiff_t Stride = ptrdiff_t(StrideWidth);
 
-        MLAS_CONV_WORK_BLOCK WorkBlock;
+    size_t OutputInteriorStart = size_t((PaddingLeftX + Stride - 1) / Stride);
+    size_t OutputInteriorEnd = 0;
 
-        WorkBlock.Parameters = Parameters;
-        WorkBlock.Input = Input;
-        WorkBlock.Filter = Filter;
-        WorkBlock.Bias = Bias;
-        WorkBlock.WorkingBuffer = nullptr;
-        WorkBlock.Output = Output;
-        WorkBlock.TargetThreadCount = TargetThreadCount;
+    const ptrdiff_t LastInteriorOrigin = InputWidth + PaddingLeftX - Kernel - (Stride - 1);
 
-        MlasExecuteThreaded(MlasConvGemmDirectThreaded, &WorkBlock, TargetThreadCount);
+    if (LastInteriorOrigin >= 0) {
+        OutputInteriorEnd = size_t(LastInteriorOrigin / Stride) + 1;
+    }
 
-        return;
+    if (OutputInteriorEnd > OutputWidth) {
+        OutputInteriorEnd = OutputWidth;
     }
 
-#endif
+    if (OutputInteriorStart > OutputInteriorEnd) {
+        OutputInteriorStart = OutputInteriorEnd;
+    }
 
     //
-    // Iterate over each batch and group.
+    // Broadcast the filter and bias for the vector loops.
     //
 
-    for (size_t batch = 0; batch < BatchCount; batch++) {
+    MLAS_FLOAT32X4 FilterVectors[KernelSize * KernelSize];
 
-        const float* filter = Filter;
-        const float* bias = Bias;
+    for (size_t k = 0; k < KernelSize * KernelSize; k++) {
+        FilterVectors[k] = MlasBroadcastFloat32x4(Filter[k]);
+    }
 
-        for (size_t group = 0; group < GroupCount; group++) {
+    const MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(BiasValue);
 
-            //
-            // Dispatch the convolution.
-            //
+    Output += oh * OutputWidth;
 
-            switch (Algorithm) {
+    for (size_t EndingOh = oh + CountOh; oh < EndingOh; oh++) {
 
-                case MlasConvAlgorithmGemmDirect:
-                {
-                    //
-                    // Invoke the threaded GEMM directly with the input tensor.
-                    //
+        //
+        // Compute the range of kernel rows that map to valid input rows.
+        //
 
-                    MlasSgemm(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
-                        OutputSize, K, 1.0f, filter, K, Input, Parameters->u.GemmDirect.ldb, 0.0f,
-                        Output, OutputSize);
+        const ptrdiff_t OriginInputY = ptrdiff_t(oh) * StrideHeight - PaddingLeftY;
 
-                    //
-                    // Apply the activation with optional bias.
-                    //
+        ptrdiff_t KernelStartY = (OriginInputY < 0) ? -OriginInputY : 0;
+        ptrdiff_t KernelEndY = InputHeight - OriginInputY;
 
-                    MlasActivation(Parameters->Activation, Output, bias, FilterCount, Output,
-                        OutputSize, OutputSize);
+        if (KernelEndY > Kernel) {
+            KernelEndY = Kernel;
+        }
 
-                    break;
-                }
+        if (KernelEndY < KernelStartY) {
+            KernelEndY = KernelStartY;
+        }
 
-                case MlasConvAlgorithmExpandThenGemm:
-                {
-                    //
-                    // Expand the input tensor to the working buffer and then invoke the
-                    // threaded GEMM.
-                    //
+        const size_t ky = size_t(KernelStartY);
+        const size_t CountKy = size_t(KernelEndY - KernelStartY);
 
-                    if (Parameters->Dimensions == 2) {
-                        MlasConvIm2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
-                    } else {
-                        MlasConvVol2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
-                    }
+        //
+        // The input row pointer is only dereferenced for valid kernel rows.
+        //
 
-                    MlasSgemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
-                        K, WorkingBuffer, OutputSize, 0.0f, Output, OutputSize);
+        const float* InputOrigin = Input + OriginInputY * InputWidth - PaddingLeftX;
 
-                    //
-                    // Apply the activation with optional bias.
-                    //
+        auto ComputeSingle = [&](size_t ow) {
 
-                    MlasActivation(Parameters->Activation, Output, bias, FilterCount, Output,
-                        OutputSize, OutputSize);
+            float Accumulator = BiasValue;
+            const ptrdiff_t OriginInputX = ptrdiff_t(ow) * Stride - PaddingLeftX;
 
-                    break;
-                }
+            for (size_t y = ky; y < ky + CountKy; y++) {
 
-                case MlasConvAlgorithmExpandThenGemmSegmented:
-                {
-                    //
-                    // Attempt to launch the convolution across multiple threads or fall
-                    // back to a single thread.
-                    //
+                const float* InputRow = InputOrigin + ptrdiff_t(y) * InputWidth + PaddingLeftX;
 
-                    if (!MlasConvTryMultithread(Parameters, Input, filter, bias, WorkingBuffer,
-                        Output)) {
-                        MlasConvOperation(Parameters, Input, filter, bias, WorkingBuffer,
-                            Output, 0, OutputSize);
-                    }
+                for (size_t kx = 0; kx < KernelSize; kx++) {
 
-                    break;
+                    const ptrdiff_t ix = OriginInputX + ptrdiff_t(kx);
+
+                    if (ix >= 0 && ix < InputWidth) {
+                        Accumulator += InputRow[ix] * Filter[y * KernelSize + kx];
+                    }
                 }
             }
 
-            //
-            // Advance the buffer pointers.
-            //
+            Output[ow] = Accumulator;
+        };
 
-            if (bias != nullptr) {
-                bias += FilterCount;
-            }
+        size_t ow = 0;
 
-            filter += FilterGroupSize;
-            Input += InputGroupSize;
-            Output += OutputGroupSize;
+        for (; ow < OutputInteriorStart; ow++) {
+            ComputeSingle(ow);
+        }
+
+        for (; ow + 8 <= OutputInteriorEnd; ow += 8) {
+            MlasConvDepthwiseComputeBlock<KernelSize, StrideWidth, 2>(
+                InputOrigin + ow * StrideWidth, size_t(InputWidth), ky, CountKy,
+                FilterVectors, BiasVector, Output + ow);
+        }
+
+        if (ow + 4 <= OutputInteriorEnd) {
+            MlasConvDepthwiseComputeBlock<KernelSize, StrideWidth, 1>(
+                InputOrigin + ow * StrideWidth, size_t(InputWidth), ky, CountKy,
+                FilterVectors, BiasVector, Output + ow);
+            ow += 4;
+        }
+
+        for (; ow < OutputWidth; ow++) {
+            ComputeSingle(ow);
         }
+
+        Output += OutputWidth;
     }
 }
 
 void
-MLASCALL
-MlasConvPrepare(
-    MLAS_CONV_PARAMETERS* Parameters,
-    size_t Dimensions,
-    size_t BatchCount,
-    size_t GroupCount,
-    size_t InputChannels,
-    const int64_t* InputShape,
-    const int64_t* KernelShape,
-    const int64_t* DilationShape,
-    const int64_t* Padding,
-    const int64_t* StrideShape,
-    const int64_t* OutputShape,
-    size_t FilterCount,
-    const MLAS_ACTIVATION* Activation,
-    size_t* WorkingBufferSize
+MlasConvDepthwiseThreaded(
+    void* Context,
+    int32_t Index
     )
 /*++
 
 Routine Description:
 
-    This routine prepares for a convolution operation by computing required
-    parameters including the required working buffer size for intermediate
-    results.
+    This routine is invoked from a worker thread to execute a segment of a
+    depthwise convolution operation.
+
+    The output rows of all batches and channels are partitioned evenly across
+    the worker threads.
 
 Arguments:
 
-    Parameters - Supplies the structure that stores the provided and computed
-        parameters for the convolution operation.
+    Context - Supplies the pointer to the context for the threaded operation.
 
-    Dimensions - Supplies the number of dimensions (must be 2 or 3).
+    Index - Supplies the current index of the threaded operation.
 
-    BatchCount - Supplies the number of batches to the processed.
+Return Value:
 
-    GroupCount - Supplies the number of channel groups.
+    None.
 
-    InputChannels - Supplies the number of input channels per group.
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
 
-    InputShape - Supplies the shape of the input tensor.
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
 
-    KernelShape - Supplies the shape of the kernel transform.
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t KernelSize = Parameters->KernelShape[0];
+    const size_t StrideWidth = Parameters->StrideShape[1];
+    const size_t K = Parameters->K;
+
+    const size_t TotalWork = Parameters->BatchCount * GroupCount * OutputHeight;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, TotalWork, &WorkIndex, &WorkRemaining);
+
+    size_t bg = WorkIndex / OutputHeight;
+    size_t oh = WorkIndex % OutputHeight;
+
+    while (WorkRemaining > 0) {
+
+        size_t CountOh = OutputHeight - oh;
+
+        if (CountOh > WorkRemaining) {
+            CountOh = WorkRemaining;
+        }
+
+        const size_t group = bg % GroupCount;
+
+        const float* input = WorkBlock->Input + bg * InputSize;
+        const float* filter = WorkBlock->Filter + group * K;
+        const float BiasValue = (WorkBlock->Bias != nullptr) ? WorkBlock->Bias[group] : 0.0f;
+        float* output = WorkBlock->Output + bg * OutputSize;
+
+        if (KernelSize == 3) {
+            if (StrideWidth == 1) {
+                MlasConvDepthwiseKernel<3, 1>(Parameters, input, filter, BiasValue, output, oh, CountOh);
+            } else {
+                MlasConvDepthwiseKernel<3, 2>(Parameters, input, filter, BiasValue, output, oh, CountOh);
+            }
+        } else {
+            if (StrideWidth == 1) {
+                MlasConvDepthwiseKernel<5, 1>(Parameters, input, filter, BiasValue, output, oh, CountOh);
+            } else {
+                MlasConvDepthwiseKernel<5, 2>(Parameters, input, filter, BiasValue, output, oh, CountOh);
+            }
+        }
+
+        //
+        // Apply the activation to the rows computed above. The bias has
+        // already been added by the kernel.
+        //
+
+        const size_t OutputWidth = Parameters->OutputShape[1];
+        float* OutputRows = output + oh * OutputWidth;
+
+        MlasActivation(Parameters->Activation, OutputRows, nullptr, 1, OutputRows,
+            CountOh * OutputWidth, CountOh * OutputWidth);
+
+        WorkRemaining -= CountOh;
+        bg++;
+        oh = 0;
+    }
+}
+
+void
+MLASCALL
+MlasConvWinogradTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* FilterTransform
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the filter tensor for use with the Winograd
+    F(2x2, 3x3) convolution algorithm.
+
+    Each 3x3 filter g is transformed to the 4x4 tile U = G g G^T. The
+    transformed filter is stored as [GroupCount][16][FilterCount][InputChannels]
+    so that each of the 16 tile elements forms a row-major matrix for the
+    batched GEMM.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Filter - Supplies the filter tensor.
+
+    FilterTransform - Supplies the buffer to receive the transformed filter.
+        The buffer must hold u.Winograd.FilterTransformSize elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannels = Parameters->InputChannels;
+
+    const size_t TileStride = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                const float* g = Filter;
+                float t[4][3];
+
+                //
+                // Compute G g.
+                //
+
+                for (size_t j = 0; j < 3; j++) {
+                    t[0][j] = g[j];
+                    t[1][j] = 0.5f * (g[j] + g[3 + j] + g[6 + j]);
+                    t[2][j] = 0.5f * (g[j] - g[3 + j] + g[6 + j]);
+                    t[3][j] = g[6 + j];
+                }
+
+                //
+                // Compute (G g) G^T.
+                //
+
+                float* u = FilterTransform + f * InputChannels + c;
+
+                for (size_t i = 0; i < 4; i++) {
+                    u[(i * 4 + 0) * TileStride] = t[i][0];
+                    u[(i * 4 + 1) * TileStride] = 0.5f * (t[i][0] + t[i][1] + t[i][2]);
+                    u[(i * 4 + 2) * TileStride] = 0.5f * (t[i][0] - t[i][1] + t[i][2]);
+                    u[(i * 4 + 3) * TileStride] = t[i][2];
+                }
+
+                Filter += 9;
+            }
+        }
+
+        FilterTransform += MLAS_CONV_WINOGRAD_TILE_ELEMENTS * TileStride;
+    }
+}
+
+void
+MlasConvWinogradTransformInput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    size_t TileStart,
+    size_t CountT,
+    float* InputTransform
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of input tiles for the Winograd F(2x2, 3x3)
+    convolution algorithm.
+
+    Each 4x4 input tile d is transformed to V = B^T d B. The transformed tiles
+    are stored as [InputChannels][16][TileBlockCount]. Interleaving the tile
+    elements per channel avoids power of two strides between the 16 output
+    streams.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the current batch and group.
+
+    TileStart - Supplies the index of the first tile to transform.
+
+    CountT - Supplies the number of tiles to transform.
+
+    InputTransform - Supplies the buffer to receive the transformed tiles.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t HeightShapeIndex = 0;
+    constexpr size_t WidthShapeIndex = 1;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputSize = Parameters->InputSize;
+
+    const ptrdiff_t InputHeight = ptrdiff_t(Parameters->InputShape[HeightShapeIndex]);
+    const ptrdiff_t InputWidth = ptrdiff_t(Parameters->InputShape[WidthShapeIndex]);
+
+    const ptrdiff_t PaddingLeftY = ptrdiff_t(Parameters->Padding[HeightShapeIndex]);
+    const ptrdiff_t PaddingLeftX = ptrdiff_t(Parameters->Padding[WidthShapeIndex]);
+
+    const size_t TilesX = (Parameters->OutputShape[WidthShapeIndex] + 1) / 2;
+
+    const size_t TileStride = Parameters->u.Winograd.TileBlockCount;
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        float* v = InputTransform + c * MLAS_CONV_WINOGRAD_TILE_ELEMENTS * TileStride;
+        size_t t = 0;
+
+        while (t < CountT) {
+
+            const size_t Tile = TileStart + t;
+            const size_t TileX = Tile % TilesX;
+
+            const ptrdiff_t OriginInputY = ptrdiff_t(Tile / TilesX) * 2 - PaddingLeftY;
+            const ptrdiff_t OriginInputX = ptrdiff_t(TileX) * 2 - PaddingLeftX;
+
+            const bool RowsInside = (OriginInputY >= 0 && OriginInputY + 4 <= InputHeight);
+
+            //
+            // Transform four horizontally adjacent tiles at once if the input
+            // accessed by the strided vector loads is inside the image.
+            //
+
+            if (RowsInside && t + 4 <= CountT && TileX + 4 <= TilesX &&
+                OriginInputX >= 0 && OriginInputX + 11 <= InputWidth) {
+
+                const float* InputRow = Input + OriginInputY * InputWidth + OriginInputX;
+
+                MLAS_FLOAT32X4 d[4][4];
+
+                for (size_t i = 0; i < 4; i++) {
+                    for (size_t j = 0; j < 4; j++) {
+                        d[i][j] = MlasLoadEvenFloat32x4(InputRow + j);
+                    }
+                    InputRow += InputWidth;
+                }
+
+                MLAS_FLOAT32X4 s[4][4];
+
+                for (size_t j = 0; j < 4; j++) {
+                    s[0][j] = MlasSubtractFloat32x4(d[0][j], d[2][j]);
+                    s[1][j] = MlasAddFloat32x4(d[1][j], d[2][j]);
+                    s[2][j] = MlasSubtractFloat32x4(d[2][j], d[1][j]);
+                    s[3][j] = MlasSubtractFloat32x4(d[1][j], d[3][j]);
+                }
+
+                for (size_t i = 0; i < 4; i++) {
+                    MlasStoreFloat32x4(&v[(i * 4 + 0) * TileStride + t], MlasSubtractFloat32x4(s[i][0], s[i][2]));
+                    MlasStoreFloat32x4(&v[(i * 4 + 1) * TileStride + t], MlasAddFloat32x4(s[i][1], s[i][2]));
+                    MlasStoreFloat32x4(&v[(i * 4 + 2) * TileStride + t], MlasSubtractFloat32x4(s[i][2], s[i][1]));
+                    MlasStoreFloat32x4(&v[(i * 4 + 3) * TileStride + t], MlasSubtractFloat32x4(s[i][1], s[i][3]));
+                }
+
+                t += 4;
+                continue;
+            }
+
+            float d[4][4];
+
+            if (RowsInside && OriginInputX >= 0 && OriginInputX + 4 <= InputWidth) {
+
+                const float* InputRow = Input + OriginInputY * InputWidth + OriginInputX;
+
+                for (size_t i = 0; i < 4; i++) {
+                    for (size_t j = 0; j < 4; j++) {
+                        d[i][j] = InputRow[j];
+                    }
+                    InputRow += InputWidth;
+                }
+
+            } else {
+
+                for (size_t i = 0; i < 4; i++) {
+
+                    const ptrdiff_t iy = OriginInputY + ptrdiff_t(i);
+
+                    for (size_t j = 0; j < 4; j++) {
+
+                        const ptrdiff_t ix = OriginInputX + ptrdiff_t(j);
+
+                        d[i][j] = (iy >= 0 && iy < InputHeight && ix >= 0 && ix < InputWidth) ?
+                            Input[iy * InputWidth + ix] : 0.0f;
+                    }
+                }
+            }
+
+            //
+            // Compute B^T d.
+            //
+
+            float s[4][4];
+
+            for (size_t j = 0; j < 4; j++) {
+                s[0][j] = d[0][j] - d[2][j];
+                s[1][j] = d[1][j] + d[2][j];
+                s[2][j] = d[2][j] - d[1][j];
+                s[3][j] = d[1][j] - d[3][j];
+            }
+
+            //
+            // Compute (B^T d) B.
+            //
+
+            for (size_t i = 0; i < 4; i++) {
+                v[(i * 4 + 0) * TileStride + t] = s[i][0] - s[i][2];
+                v[(i * 4 + 1) * TileStride + t] = s[i][1] + s[i][2];
+                v[(i * 4 + 2) * TileStride + t] = s[i][2] - s[i][1];
+                v[(i * 4 + 3) * TileStride + t] = s[i][1] - s[i][3];
+            }
+
+            t++;
+        }
+
+        Input += InputSize;
+    }
+}
+
+void
+MlasConvWinogradTransformOutput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* GemmOutput,
+    size_t TileStart,
+    size_t CountT,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of tiles produced by the batched GEMM of
+    the Winograd F(2x2, 3x3) convolution algorithm to the output tensor.
+
+    Each 4x4 tile m is transformed to the 2x2 output Y = A^T m A. Output
+    elements beyond the edge of the output tensor are discarded. If the
+    convolution has a non-zero beta, the existing output is scaled by beta
+    and accumulated.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    GemmOutput - Supplies the batched GEMM output stored as
+        [FilterCount][16][TileBlockCount].
+
+    TileStart - Supplies the index of the first tile to transform.
+
+    CountT - Supplies the number of tiles to transform.
+
+    Output - Supplies the output tensor for the current batch and group.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t HeightShapeIndex = 0;
+    constexpr size_t WidthShapeIndex = 1;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutputSize;
+
+    const size_t OutputHeight = Parameters->OutputShape[HeightShapeIndex];
+    const size_t OutputWidth = Parameters->OutputShape[WidthShapeIndex];
+
+    const size_t TilesX = (OutputWidth + 1) / 2;
+
+    const size_t TileStride = Parameters->u.Winograd.TileBlockCount;
+
+    const float Beta = Parameters->Beta;
+    const MLAS_FLOAT32X4 BetaBroadcast = MlasBroadcastFloat32x4(Beta);
+
+    auto StoreOutput = [Beta](float* OutputElement, float Value) {
+        if (Beta != 0.0f) {
+            Value += Beta * *OutputElement;
+        }
+        *OutputElement = Value;
+    };
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        const float* m = GemmOutput + f * MLAS_CONV_WINOGRAD_TILE_ELEMENTS * TileStride;
+        size_t t = 0;
+
+        while (t < CountT) {
+
+            const size_t Tile = TileStart + t;
+            const size_t TileX = Tile % TilesX;
+
+            const size_t oy = (Tile / TilesX) * 2;
+            const size_t ox = TileX * 2;
+
+            float* OutputRow = Output + oy * OutputWidth + ox;
+
+            //
+            // Transform four horizontally adjacent tiles at once if all of
+            // their output elements are inside the output tensor.
+            //
+
+            if (t + 4 <= CountT && TileX + 4 <= TilesX && oy + 2 <= OutputHeight &&
+                ox + 8 <= OutputWidth) {
+
+                MLAS_FLOAT32X4 s[2][4];
+
+                for (size_t j = 0; j < 4; j++) {
+
+                    MLAS_FLOAT32X4 m0 = MlasLoadFloat32x4(&m[(0 * 4 + j) * TileStride + t]);
+                    MLAS_FLOAT32X4 m1 = MlasLoadFloat32x4(&m[(1 * 4 + j) * TileStride + t]);
+                    MLAS_FLOAT32X4 m2 = MlasLoadFloat32x4(&m[(2 * 4 + j) * TileStride + t]);
+                    MLAS_FLOAT32X4 m3 = MlasLoadFloat32x4(&m[(3 * 4 + j) * TileStride + t]);
+
+                    s[0][j] = MlasAddFloat32x4(MlasAddFloat32x4(m0, m1), m2);
+                    s[1][j] = MlasSubtractFloat32x4(MlasSubtractFloat32x4(m1, m2), m3);
+                }
+
+                for (size_t i = 0; i < 2; i++) {
+
+                    MLAS_FLOAT32X4 y0 = MlasAddFloat32x4(MlasAddFloat32x4(s[i][0], s[i][1]), s[i][2]);
+                    MLAS_FLOAT32X4 y1 = MlasSubtractFloat32x4(MlasSubtractFloat32x4(s[i][1], s[i][2]), s[i][3]);
+
+                    MLAS_FLOAT32X4 o0 = MlasInterleaveLowFloat32x4(y0, y1);
+                    MLAS_FLOAT32X4 o1 = MlasInterleaveHighFloat32x4(y0, y1);
+
+                    if (Beta != 0.0f) {
+                        o0 = MlasAddFloat32x4(o0, MlasMultiplyFloat32x4(BetaBroadcast,
+                            MlasLoadFloat32x4(OutputRow)));
+                        o1 = MlasAddFloat32x4(o1, MlasMultiplyFloat32x4(BetaBroadcast,
+                            MlasLoadFloat32x4(OutputRow + 4)));
+                    }
+
+                    MlasStoreFloat32x4(OutputRow, o0);
+                    MlasStoreFloat32x4(OutputRow + 4, o1);
+
+                    OutputRow += OutputWidth;
+                }
+
+                t += 4;
+                continue;
+            }
+
+            //
+            // Compute A^T m.
+            //
+
+            float s[2][4];
+
+            for (size_t j = 0; j < 4; j++) {
+                s[0][j] = m[(0 * 4 + j) * TileStride + t] + m[(1 * 4 + j) * TileStride + t] +
+                    m[(2 * 4 + j) * TileStride + t];
+                s[1][j] = m[(1 * 4 + j) * TileStride + t] - m[(2 * 4 + j) * TileStride + t] -
+                    m[(3 * 4 + j) * TileStride + t];
+            }
+
+            //
+            // Compute (A^T m) A and store the valid output elements.
+            //
+
+            StoreOutput(&OutputRow[0], s[0][0] + s[0][1] + s[0][2]);
+
+            if (ox + 1 < OutputWidth) {
+                StoreOutput(&OutputRow[1], s[0][1] - s[0][2] - s[0][3]);
+            }
+
+            if (oy + 1 < OutputHeight) {
+
+                OutputRow += OutputWidth;
+
+                StoreOutput(&OutputRow[0], s[1][0] + s[1][1] + s[1][2]);
+
+                if (ox + 1 < OutputWidth) {
+                    StoreOutput(&OutputRow[1], s[1][1] - s[1][2] - s[1][3]);
+                }
+            }
+
+            t++;
+        }
+
+        Output += OutputSize;
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd F(2x2, 3x3) convolution operation.
+
+    The rows of output tiles are partitioned evenly across the worker threads.
+    Each thread transforms blocks of input tiles, computes one GEMM for each
+    of the 16 tile elements and transforms the result to the output tensor.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t TileBlockCount = Parameters->u.Winograd.TileBlockCount;
+
+    const size_t TilesY = (OutputHeight + 1) / 2;
+    const size_t TilesX = (OutputWidth + 1) / 2;
+
+    size_t TileRowStart;
+    size_t TileRowCount;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, TilesY, &TileRowStart, &TileRowCount);
+
+    if (TileRowCount == 0) {
+        return;
+    }
+
+    float* InputTransform = WorkBlock->WorkingBuffer +
+        Index * MLAS_CONV_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount) * TileBlockCount;
+    float* GemmOutput = InputTransform +
+        MLAS_CONV_WINOGRAD_TILE_ELEMENTS * InputChannels * TileBlockCount;
+
+    const size_t TileEnd = (TileRowStart + TileRowCount) * TilesX;
+    size_t CountT;
+
+    for (size_t TileStart = TileRowStart * TilesX; TileStart < TileEnd; TileStart += CountT) {
+
+        CountT = TileEnd - TileStart;
+
+        if (CountT > TileBlockCount) {
+            CountT = TileBlockCount;
+        }
+
+        MlasConvWinogradTransformInput(Parameters, WorkBlock->Input, TileStart, CountT,
+            InputTransform);
+
+        const size_t ldt = MLAS_CONV_WINOGRAD_TILE_ELEMENTS * TileBlockCount;
+
+        for (size_t e = 0; e < MLAS_CONV_WINOGRAD_TILE_ELEMENTS; e++) {
+
+            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountT,
+                InputChannels, 1.0f, WorkBlock->Filter + e * FilterCount * InputChannels,
+                InputChannels, InputTransform + e * TileBlockCount, ldt, 0.0f,
+                GemmOutput + e * TileBlockCount, ldt);
+        }
+
+        MlasConvWinogradTransformOutput(Parameters, GemmOutput, TileStart, CountT,
+            WorkBlock->Output);
+    }
+
+    //
+    // Apply the activation with optional bias to the output rows computed by
+    // this thread.
+    //
+
+    const size_t OutputRowStart = TileRowStart * 2;
+    size_t OutputRowEnd = (TileRowStart + TileRowCount) * 2;
+
+    if (OutputRowEnd > OutputHeight) {
+        OutputRowEnd = OutputHeight;
+    }
+
+    float* OutputRows = WorkBlock->Output + OutputRowStart * OutputWidth;
+
+    MlasActivation(Parameters->Activation, OutputRows, WorkBlock->Bias, FilterCount,
+        OutputRows, (OutputRowEnd - OutputRowStart) * OutputWidth, OutputSize);
+}
+
+inline
+bool
+MlasConvTryMultithread(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine attempts to launch a convolution operation across multiple
+    threads.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+Return Value:
+
+    Returns true if the operation was completed across multiple threads, else
+    false if the operation should fall back to a single thread.
+
+--*/
+{
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+    MLAS_CONV_WORK_BLOCK WorkBlock;
+
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t ThreadStrideN = Parameters->u.ExpandThenGemmSegmented.ThreadStrideN;
+
+    if (ThreadStrideN >= OutputSize) {
+        return false;
+    }
+
+    //
+    // Initialize the common fields of the work block.
+    //
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = Filter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+
+    //
+    // Segment the operation across multiple threads.
+    //
+
+    int32_t Index = 0;
+    size_t SegmentCountN;
+
+    for (size_t SegmentStartN = 0; SegmentStartN < OutputSize; SegmentStartN += SegmentCountN) {
+
+        SegmentCountN = OutputSize - SegmentStartN;
+
+        if (SegmentCountN > ThreadStrideN) {
+            SegmentCountN = ThreadStrideN;
+        }
+
+        WorkBlock.Segments[Index].StartN = SegmentStartN;
+        WorkBlock.Segments[Index].CountN = SegmentCountN;
+
+        Index++;
+    }
+
+    MlasExecuteThreaded(MlasConvOperationThreaded, &WorkBlock, Index);
+
+    return true;
+
+#else
+
+    //
+    // No threading implementation is available.
+    //
+
+    MLAS_UNREFERENCED_PARAMETER(Parameters);
+    MLAS_UNREFERENCED_PARAMETER(Input);
+    MLAS_UNREFERENCED_PARAMETER(Filter);
+    MLAS_UNREFERENCED_PARAMETER(Bias);
+    MLAS_UNREFERENCED_PARAMETER(WorkingBuffer);
+    MLAS_UNREFERENCED_PARAMETER(Output);
+
+    return false;
+
+#endif
+
+}
+
+void
+MLASCALL
+MlasConv(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * OutputSize;
+    const size_t FilterGroupSize = FilterCount * K;
+
+    const size_t BatchCount = Parameters->BatchCount;
+    const size_t GroupCount = Parameters->GroupCount;
+
+    const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
+
+    //
+    // Winograd convolutions partition each batch and group across threads by
+    // rows of output tiles. The filter has already been transformed.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.WorkingBuffer = WorkingBuffer;
+        WorkBlock.TargetThreadCount = Parameters->u.Winograd.TargetThreadCount;
+
+        const size_t FilterTransformGroupSize =
+            MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * Parameters->InputChannels;
+
+        for (size_t batch = 0; batch < BatchCount; batch++) {
+
+            const float* filter = Filter;
+            const float* bias = Bias;
+
+            for (size_t group = 0; group < GroupCount; group++) {
+
+                WorkBlock.Input = Input;
+                WorkBlock.Filter = filter;
+                WorkBlock.Bias = bias;
+                WorkBlock.Output = Output;
+
+                MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, WorkBlock.TargetThreadCount);
+
+                if (bias != nullptr) {
+                    bias += FilterCount;
+                }
+
+                filter += FilterTransformGroupSize;
+                Input += InputGroupSize;
+                Output += OutputGroupSize;
+            }
+        }
+
+        return;
+    }
+
+    //
+    // Depthwise convolutions process all batches and groups in a single
+    // threaded operation.
+    //
+
+    if (Algorithm == MlasConvAlgorithmDepthwise) {
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Filter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = nullptr;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = Parameters->u.Depthwise.TargetThreadCount;
+
+        MlasExecuteThreaded(MlasConvDepthwiseThreaded, &WorkBlock, WorkBlock.TargetThreadCount);
+
+        return;
+    }
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+    //
+    // Schedule batches of GEMMs across multiple threads.
+    //
+
+    if (Algorithm == MlasConvAlgorithmGemmDirect && ((BatchCount > 1) || (GroupCount > 1))) {
+
+        const size_t BatchGroupCount = BatchCount * GroupCount;
+
+        int32_t TargetThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+        if (size_t(TargetThreadCount) >= BatchGroupCount) {
+            TargetThreadCount = int32_t(BatchGroupCount);
+        }
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Filter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = nullptr;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = TargetThreadCount;
+
+        MlasExecuteThreaded(MlasConvGemmDirectThreaded, &WorkBlock, TargetThreadCount);
+
+        return;
+    }
+
+#endif
+
+    //
+    // Iterate over each batch and group.
+    //
+
+    for (size_t batch = 0; batch < BatchCount; batch++) {
+
+        const float* filter = Filter;
+        const float* bias = Bias;
+
+        for (size_t group = 0; group < GroupCount; group++) {
+
+            //
+            // Dispatch the convolution.
+            //
+
+            switch (Algorithm) {
+
+                case MlasConvAlgorithmGemmDirect:
+                {
+                    //
+                    // Invoke the threaded GEMM directly with the input tensor.
+                    //
+
+                    MlasSgemm(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
+                        OutputSize, K, 1.0f, filter, K, Input, Parameters->u.GemmDirect.ldb,
+                        Parameters->Beta, Output, OutputSize);
+
+                    //
+                    // Apply the activation with optional bias.
+                    //
+
+                    MlasActivation(Parameters->Activation, Output, bias, FilterCount, Output,
+                        OutputSize, OutputSize);
+
+                    break;
+                }
+
+                case MlasConvAlgorithmExpandThenGemm:
+                {
+                    //
+                    // Expand the input tensor to the working buffer and then invoke the
+                    // threaded GEMM.
+                    //
+
+                    if (Parameters->Dimensions == 2) {
+                        MlasConvIm2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
+                    } else {
+                        MlasConvVol2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
+                    }
+
+                    MlasSgemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
+                        K, WorkingBuffer, OutputSize, Parameters->Beta, Output, OutputSize);
+
+                    //
+                    // Apply the activation with optional bias.
+                    //
+
+                    MlasActivation(Parameters->Activation, Output, bias, FilterCount, Output,
+                        OutputSize, OutputSize);
+
+                    break;
+                }
+
+                case MlasConvAlgorithmExpandThenGemmSegmented:
+                {
+                    //
+                    // Attempt to launch the convolution across multiple threads or fall
+                    // back to a single thread.
+                    //
+
+                    if (!MlasConvTryMultithread(Parameters, Input, filter, bias, WorkingBuffer,
+                        Output)) {
+                        MlasConvOperation(Parameters, Input, filter, bias, WorkingBuffer,
+                            Output, 0, OutputSize);
+                    }
+
+                    break;
+                }
+
+                case MlasConvAlgorithmDepthwise:
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // Handled above.
+                    //
+
+                    break;
+                }
+            }
+
+            //
+            // Advance the buffer pointers.
+            //
+
+            if (bias != nullptr) {
+                bias += FilterCount;
+            }
+
+            filter += FilterGroupSize;
+            Input += InputGroupSize;
+            Output += OutputGroupSize;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasConvPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t Dimensions,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    float Beta,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a convolution operation by computing required
+    parameters including the required working buffer size for intermediate
+    results.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    Dimensions - Supplies the number of dimensions (must be 2 or 3).
+
+    BatchCount - Supplies the number of batches to the processed.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Supplies the shape of the kernel transform.
 
     DilationShape - Supplies the shape of the dilation.
 
@@ -1079,6 +2038,11 @@ Arguments:
     Activation - Supplies the parameters for the activation to apply to the
         convolution output.
 
+    Beta - Supplies the scalar multiplier for the existing contents of the
+        output tensor, which are accumulated before the bias and activation
+        are applied. This allows a residual tensor to be fused with the
+        convolution.
+
     WorkingBufferSize - Receives the number of elements to allocate for the
         working buffer for intermediate results.
 
@@ -1093,6 +2057,7 @@ Return Value:
     //
 
     Parameters->Activation = Activation;
+    Parameters->Beta = Beta;
     Parameters->Dimensions = Dimensions;
     Parameters->BatchCount = BatchCount;
     Parameters->GroupCount = GroupCount;
@@ -1136,6 +2101,114 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    //
+    // Detect a depthwise convolution with a 3x3 or 5x5 kernel that can be
+    // computed directly from the input tensor. Each output row is computed
+    // independently, so the operation is partitioned by output rows across
+    // all batches and channels. The direct kernel overwrites the output, so
+    // accumulating convolutions use the GEMM based algorithms.
+    //
+
+    if (Dimensions == 2 && InputChannels == 1 && FilterCount == 1 && AllDilationsAreOne &&
+        Beta == 0.0f &&
+        Parameters->KernelShape[0] == Parameters->KernelShape[1] &&
+        (Parameters->KernelShape[0] == 3 || Parameters->KernelShape[0] == 5) &&
+        (Parameters->StrideShape[1] == 1 || Parameters->StrideShape[1] == 2)) {
+
+        const size_t TotalRows = BatchCount * GroupCount * Parameters->OutputShape[0];
+
+        int32_t TargetThreadCount;
+        double Complexity = double(BatchCount) * double(GroupCount) * double(OutputSize) * double(K);
+
+        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+            TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        } else {
+            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+        }
+
+        int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+        if (TargetThreadCount >= MaximumThreadCount) {
+            TargetThreadCount = MaximumThreadCount;
+        }
+
+        if (size_t(TargetThreadCount) >= TotalRows) {
+            TargetThreadCount = int32_t(TotalRows);
+        }
+
+        Parameters->Algorithm = MlasConvAlgorithmDepthwise;
+        Parameters->u.Depthwise.TargetThreadCount = TargetThreadCount;
+
+        return;
+    }
+
+    //
+    // Detect a 3x3 convolution with unit strides and dilations that can use the
+    // Winograd F(2x2, 3x3) algorithm. Each 2x2 block of output elements for a
+    // filter and input channel requires 16 multiplies instead of 36.
+    //
+
+    if (Dimensions == 2 && AllStridesAreOne && AllDilationsAreOne &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3 &&
+        InputChannels >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS) {
+
+        const size_t TilesY = (Parameters->OutputShape[0] + 1) / 2;
+        const size_t TileCount = TilesY * ((Parameters->OutputShape[1] + 1) / 2);
+
+        //
+        // Compute the number of tiles to transform at once so that the tile
+        // buffers for a thread stay within the target working buffer size.
+        //
+
+        const size_t TileBufferStride = MLAS_CONV_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount);
+
+        size_t TileBlockCount = MLAS_CONV_WINOGRAD_WORKING_BUFFER_SIZE_PER_THREAD / TileBufferStride;
+
+        if (TileBlockCount < 16) {
+            TileBlockCount = 16;
+        }
+
+        if (TileBlockCount > TileCount) {
+            TileBlockCount = TileCount;
+        }
+
+        //
+        // Compute the number of target threads given the complexity of the
+        // batched GEMM, limited by the number of rows of output tiles.
+        //
+
+        int32_t TargetThreadCount;
+        double Complexity = double(MLAS_CONV_WINOGRAD_TILE_ELEMENTS) * double(FilterCount) *
+            double(InputChannels) * double(TileCount);
+
+        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+            TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        } else {
+            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+        }
+
+        int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+        if (TargetThreadCount >= MaximumThreadCount) {
+            TargetThreadCount = MaximumThreadCount;
+        }
+
+        if (size_t(TargetThreadCount) >= TilesY) {
+            TargetThreadCount = int32_t(TilesY);
+        }
+
+        Parameters->Algorithm = MlasConvAlgorithmWinograd;
+        Parameters->u.Winograd.TileBlockCount = TileBlockCount;
+        Parameters->u.Winograd.FilterTransformSize =
+            GroupCount * MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+        Parameters->u.Winograd.TargetThreadCount = TargetThreadCount;
+
+        *WorkingBufferSize = TargetThreadCount * TileBufferStride * TileBlockCount;
+
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
@@ -0,0 +1,489 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convtranspose.cpp
+
+Abstract:
+
+    This module implements the transposed convolution operation.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the target number of working buffer elements per thread. The
+// number of filters processed by a thread at once is chosen so that the
+// column buffer for the block stays within this size.
+//
+
+#define MLAS_CONV_TRANSPOSE_WORKING_BUFFER_SIZE_PER_THREAD (256 * 1024)
+
+//
+// Define the parameters to execute segments of a transposed convolution
+// operation on worker threads.
+//
+
+struct MLAS_CONV_TRANSPOSE_WORK_BLOCK {
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters;
+    const float* Input;
+    const float* Filter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+};
+
+void
+MlasConvTransposeCol2Im(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* ColumnBuffer,
+    float* Output,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine scatters the columns produced by the GEMM of a transposed
+    convolution to the output tensor.
+
+    If the kernel taps do not overlap in the output tensor, then each output
+    element receives at most one value and the value is stored directly.
+    Otherwise, the values are accumulated to the output tensor, which must
+    have been cleared by the caller.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the transposed
+        convolution parameters.
+
+    ColumnBuffer - Supplies the GEMM output, stored as
+        [FilterCount][KernelHeight][KernelWidth][InputHeight * InputWidth].
+
+    Output - Supplies the output tensor for the block of filters.
+
+    FilterCount - Supplies the number of filters in the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t HeightShapeIndex = 0;
+    constexpr size_t WidthShapeIndex = 1;
+
+    const ptrdiff_t InputHeight = ptrdiff_t(Parameters->InputShape[HeightShapeIndex]);
+    const ptrdiff_t InputWidth = ptrdiff_t(Parameters->InputShape[WidthShapeIndex]);
+    const ptrdiff_t OutputHeight = ptrdiff_t(Parameters->OutputShape[HeightShapeIndex]);
+    const ptrdiff_t OutputWidth = ptrdiff_t(Parameters->OutputShape[WidthShapeIndex]);
+
+    const size_t KernelHeight = Parameters->KernelShape[HeightShapeIndex];
+    const size_t KernelWidth = Parameters->KernelShape[WidthShapeIndex];
+
+    const ptrdiff_t DilationHeight = ptrdiff_t(Parameters->DilationShape[HeightShapeIndex]);
+    const ptrdiff_t DilationWidth = ptrdiff_t(Parameters->DilationShape[WidthShapeIndex]);
+
+    const ptrdiff_t PaddingLeftY = ptrdiff_t(Parameters->Padding[HeightShapeIndex]);
+    const ptrdiff_t PaddingLeftX = ptrdiff_t(Parameters->Padding[WidthShapeIndex]);
+
+    const ptrdiff_t StrideHeight = ptrdiff_t(Parameters->StrideShape[HeightShapeIndex]);
+    const ptrdiff_t StrideWidth = ptrdiff_t(Parameters->StrideShape[WidthShapeIndex]);
+
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+
+    const bool Accumulate = (Parameters->Algorithm == MlasConvTransposeAlgorithmGemmCol2Im);
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        for (size_t ky = 0; ky < KernelHeight; ky++) {
+
+            for (size_t kx = 0; kx < KernelWidth; kx++) {
+
+                const ptrdiff_t OffsetY = ptrdiff_t(ky) * DilationHeight - PaddingLeftY;
+                const ptrdiff_t OffsetX = ptrdiff_t(kx) * DilationWidth - PaddingLeftX;
+
+                //
+                // Compute the range of input columns that map to valid output
+                // columns for this kernel tap.
+                //
+
+                ptrdiff_t InputStartX = 0;
+
+                if (OffsetX < 0) {
+                    InputStartX = (-OffsetX + StrideWidth - 1) / StrideWidth;
+                }
+
+                ptrdiff_t InputEndX = InputWidth;
+
+                if (OutputWidth - OffsetX <= 0) {
+                    InputEndX = 0;
+                } else if ((OutputWidth - OffsetX + StrideWidth - 1) / StrideWidth < InputEndX) {
+                    InputEndX = (OutputWidth - OffsetX + StrideWidth - 1) / StrideWidth;
+                }
+
+                for (ptrdiff_t iy = 0; iy < InputHeight; iy++) {
+
+                    const ptrdiff_t oy = iy * StrideHeight + OffsetY;
+
+                    if (oy < 0 || oy >= OutputHeight) {
+                        continue;
+                    }
+
+                    const float* col = ColumnBuffer + iy * InputWidth;
+                    float* out = Output + oy * OutputWidth + OffsetX;
+
+                    if (Accumulate) {
+                        for (ptrdiff_t ix = InputStartX; ix < InputEndX; ix++) {
+                            out[ix * StrideWidth] += col[ix];
+                        }
+                    } else {
+                        for (ptrdiff_t ix = InputStartX; ix < InputEndX; ix++) {
+                            out[ix * StrideWidth] = col[ix];
+                        }
+                    }
+                }
+
+                ColumnBuffer += InputSize;
+            }
+        }
+
+        Output += OutputSize;
+    }
+}
+
+void
+MlasConvTransposeThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    transposed convolution operation.
+
+    The work is divided into blocks of filters across all batches and groups.
+    For each block, the GEMM computes the column buffer for the filters of the
+    block, the columns are scattered to the output tensor and then the bias
+    and activation are applied while the output is still in the cache.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_TRANSPOSE_WORK_BLOCK* WorkBlock = (MLAS_CONV_TRANSPOSE_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t KernelSize = Parameters->KernelSize;
+    const size_t FilterBlockCount = Parameters->FilterBlockCount;
+
+    const size_t FilterBlocksPerGroup = (FilterCount + FilterBlockCount - 1) / FilterBlockCount;
+    const size_t TotalWork = Parameters->BatchCount * GroupCount * FilterBlocksPerGroup;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, Parameters->TargetThreadCount, TotalWork, &WorkIndex, &WorkRemaining);
+
+    float* ColumnBuffer = WorkBlock->WorkingBuffer +
+        Index * FilterBlockCount * KernelSize * InputSize;
+
+    const size_t ldf = FilterCount * KernelSize;
+
+    while (WorkRemaining > 0) {
+
+        const size_t bg = WorkIndex / FilterBlocksPerGroup;
+        const size_t group = bg % GroupCount;
+        const size_t FilterStart = (WorkIndex % FilterBlocksPerGroup) * FilterBlockCount;
+
+        size_t CountF = FilterCount - FilterStart;
+
+        if (CountF > FilterBlockCount) {
+            CountF = FilterBlockCount;
+        }
+
+        const float* input = WorkBlock->Input + bg * InputChannels * InputSize;
+        const float* filter = WorkBlock->Filter + group * InputChannels * ldf + FilterStart * KernelSize;
+        float* output = WorkBlock->Output + (bg * FilterCount + FilterStart) * OutputSize;
+
+        //
+        // Compute the columns for this block of filters. The filter tensor is
+        // stored as [InputChannels][FilterCount * KernelSize] for each group.
+        //
+
+        MlasSgemmOperation(CblasTrans, CblasNoTrans, CountF * KernelSize, InputSize,
+            InputChannels, 1.0f, filter, ldf, input, InputSize, 0.0f, ColumnBuffer,
+            InputSize);
+
+        if (Parameters->Algorithm == MlasConvTransposeAlgorithmGemmCol2Im) {
+            std::fill_n(output, CountF * OutputSize, 0.0f);
+        }
+
+        MlasConvTransposeCol2Im(Parameters, ColumnBuffer, output, CountF);
+
+        //
+        // Apply the activation with optional bias.
+        //
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group * FilterCount + FilterStart;
+        }
+
+        MlasActivation(Parameters->Activation, output, bias, CountF, output, OutputSize,
+            OutputSize);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+void
+MLASCALL
+MlasConvTransposePrepare(
+    MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a 2D transposed convolution operation by
+    computing required parameters including the required working buffer size
+    for intermediate results.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the transposed convolution operation.
+
+    BatchCount - Supplies the number of batches to the processed.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of padding elements at the edge of the
+        output tensor.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor.
+
+    FilterCount - Supplies the number of output channels per group.
+
+    Activation - Supplies the parameters for the activation to apply to the
+        transposed convolution output.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Save the transposed convolution parameters.
+    //
+
+    Parameters->Activation = Activation;
+    Parameters->BatchCount = BatchCount;
+    Parameters->GroupCount = GroupCount;
+    Parameters->InputChannels = InputChannels;
+    Parameters->FilterCount = FilterCount;
+
+    size_t InputSize = 1;
+    size_t OutputSize = 1;
+    size_t KernelSize = 1;
+
+    bool TapsCoverOutput = true;
+
+    for (size_t dim = 0; dim < 2; dim++) {
+
+        Parameters->InputShape[dim] = size_t(InputShape[dim]);
+        Parameters->OutputShape[dim] = size_t(OutputShape[dim]);
+        Parameters->KernelShape[dim] = size_t(KernelShape[dim]);
+        Parameters->DilationShape[dim] = size_t(DilationShape[dim]);
+        Parameters->Padding[dim] = size_t(Padding[dim]);
+        Parameters->Padding[dim + 2] = size_t(Padding[dim + 2]);
+        Parameters->StrideShape[dim] = size_t(StrideShape[dim]);
+
+        InputSize *= Parameters->InputShape[dim];
+        OutputSize *= Parameters->OutputShape[dim];
+        KernelSize *= Parameters->KernelShape[dim];
+
+        //
+        // The kernel taps write each output element exactly once if the
+        // stride matches the kernel size, there is no dilation, and the
+        // output tensor does not extend beyond the last tap.
+        //
+
+        TapsCoverOutput &= (Parameters->DilationShape[dim] == 1 &&
+            Parameters->StrideShape[dim] == Parameters->KernelShape[dim] &&
+            Parameters->OutputShape[dim] + Parameters->Padding[dim] <=
+                Parameters->InputShape[dim] * Parameters->StrideShape[dim]);
+    }
+
+    Parameters->InputSize = InputSize;
+    Parameters->OutputSize = OutputSize;
+    Parameters->KernelSize = KernelSize;
+
+    Parameters->Algorithm = TapsCoverOutput ? MlasConvTransposeAlgorithmGemmScatter :
+        MlasConvTransposeAlgorithmGemmCol2Im;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const size_t BatchGroupCount = BatchCount * GroupCount;
+
+    int32_t TargetThreadCount;
+    double Complexity = double(BatchGroupCount) * double(FilterCount) * double(KernelSize) *
+        double(InputChannels) * double(InputSize);
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Compute the number of filters to process at once. The column buffer for
+    // a block should fit in the target working buffer size and there should
+    // be enough blocks to keep the target number of threads busy.
+    //
+
+    const size_t ColumnsPerFilter = KernelSize * InputSize;
+
+    size_t FilterBlockCount = FilterCount;
+
+    if (ColumnsPerFilter > 0 && BatchGroupCount > 0) {
+
+        FilterBlockCount = MLAS_CONV_TRANSPOSE_WORKING_BUFFER_SIZE_PER_THREAD / ColumnsPerFilter;
+
+        const size_t BlocksPerBatchGroup =
+            (size_t(TargetThreadCount) + BatchGroupCount - 1) / BatchGroupCount;
+        const size_t FilterCountPerBlock =
+            (FilterCount + BlocksPerBatchGroup - 1) / BlocksPerBatchGroup;
+
+        if (FilterBlockCount > FilterCountPerBlock) {
+            FilterBlockCount = FilterCountPerBlock;
+        }
+    }
+
+    if (FilterBlockCount == 0) {
+        FilterBlockCount = 1;
+    }
+
+    const size_t TotalWork =
+        BatchGroupCount * ((FilterCount + FilterBlockCount - 1) / FilterBlockCount);
+
+    if (size_t(TargetThreadCount) > TotalWork) {
+        TargetThreadCount = int32_t(TotalWork);
+    }
+
+    Parameters->FilterBlockCount = FilterBlockCount;
+    Parameters->TargetThreadCount = TargetThreadCount;
+
+    *WorkingBufferSize = size_t(TargetThreadCount) * FilterBlockCount * ColumnsPerFilter;
+}
+
+void
+MLASCALL
+MlasConvTranspose(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the 2D transposed convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the transposed
+        convolution parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor, stored as
+        [GroupCount * InputChannels][FilterCount][KernelHeight][KernelWidth].
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvTransposePrepare.
+
+    Output - Supplies the output tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_TRANSPOSE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = Filter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+
+    MlasExecuteThreaded(MlasConvTransposeThreaded, &WorkBlock, Parameters->TargetThreadCount);
+}
@@ -314,6 +314,28 @@ MlasExecuteThreaded(
     int32_t Iterations
     );
 
+inline
+void
+MlasPartitionWork(
+    int32_t ThreadId,
+    int32_t ThreadCount,
+    size_t TotalWork,
+    size_t* WorkIndex,
+    size_t* WorkRemaining
+    )
+{
+    const size_t WorkPerThread = TotalWork / ThreadCount;
+    const size_t WorkPerThreadExtra = TotalWork % ThreadCount;
+
+    if (uint32_t(ThreadId) < WorkPerThreadExtra) {
+        *WorkIndex = (WorkPerThread + 1) * ThreadId;
+        *WorkRemaining = WorkPerThread + 1;
+    } else {
+        *WorkIndex = WorkPerThread * ThreadId + WorkPerThreadExtra;
+        *WorkRemaining = WorkPerThread;
+    }
+}
+
 //
 // Define the missing ARM64 NEON intrinsic macros from arm64_neon.h that enable
 // cross-compiler support.
@@ -380,6 +402,22 @@ MlasLoadFloat32x4(const float* Buffer)
 #endif
 }
 
+//
+// Loads the even elements of the eight elements at Buffer. All eight elements
+// must be accessible.
+//
+
+inline
+MLAS_FLOAT32X4
+MlasLoadEvenFloat32x4(const float* Buffer)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vld2q_f32(Buffer).val[0];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_shuffle_ps(_mm_loadu_ps(Buffer), _mm_loadu_ps(Buffer + 4), _MM_SHUFFLE(2, 0, 2, 0));
+#endif
+}
+
 inline
 void
 MlasStoreFloat32x4(float* Buffer, MLAS_FLOAT32X4 Vector)
@@ -544,6 +582,28 @@ MlasDivideFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+inline
+MLAS_FLOAT32X4
+MlasInterleaveLowFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vzipq_f32(Vector1, Vector2).val[0];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_unpacklo_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasInterleaveHighFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vzipq_f32(Vector1, Vector2).val[1];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_unpackhi_ps(Vector1, Vector2);
+#endif
+}
+
 inline
 MLAS_FLOAT32X4
 MlasMaximumFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
@@ -0,0 +1,1068 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    snchwc.cpp
+
+Abstract:
+
+    This module implements the single precision operations using the NCHWc
+    blocking format.
+
+    The channel dimension of the tensors is split into blocks of
+    MLAS_NCHWC_BLOCK_SIZE channels that are stored as the innermost dimension.
+    A convolution can then be computed directly from the input tensor without
+    expanding the input to convolution patches: each input element is
+    broadcast and multiplied against a block of filter values that produces
+    a block of output channels.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of channels in a block. A block spans two vectors.
+//
+
+#define MLAS_NCHWC_BLOCK_SIZE                       8
+
+//
+// Define the number of output positions computed at a time by the
+// convolution kernel.
+//
+
+#define MLAS_NCHWC_CONV_OUTPUT_COUNT                4
+
+//
+// Define the common parameters for a NCHWc operation.
+//
+
+struct MLAS_NCHWC_WORK_BLOCK {
+    int32_t TargetThreadCount;
+    size_t BatchCount;
+    size_t InputChannels;
+    size_t InputShape[2];
+    size_t InputSize;
+    size_t OutputChannels;
+    size_t OutputShape[2];
+    size_t OutputSize;
+    size_t KernelShape[2];
+    size_t DilationShape[2];
+    size_t Padding[4];
+    size_t StrideShape[2];
+};
+
+//
+// Define the parameters to execute segments of a NCHWc convolution operation
+// on worker threads.
+//
+
+struct MLAS_NCHWC_CONV_WORK_BLOCK : MLAS_NCHWC_WORK_BLOCK {
+    const float* Input;
+    const float* Filter;
+    const float* Bias;
+    const MLAS_ACTIVATION* Activation;
+    float* Output;
+};
+
+//
+// Define the parameters to execute segments of a NCHWc pooling operation on
+// worker threads.
+//
+
+struct MLAS_NCHWC_POOL_WORK_BLOCK : MLAS_NCHWC_WORK_BLOCK {
+    MLAS_POOLING_KIND PoolingKind;
+    const float* Input;
+    float* Output;
+};
+
+inline
+size_t
+MlasNchwcAlignChannels(
+    int64_t Channels
+    )
+{
+    return (size_t(Channels) + MLAS_NCHWC_BLOCK_SIZE - 1) & ~size_t(MLAS_NCHWC_BLOCK_SIZE - 1);
+}
+
+size_t
+MLASCALL
+MlasNchwcGetBlockSize(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of channels stored in a block of a NCHWc
+    formatted tensor.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the NCHWc block size.
+
+--*/
+{
+    return MLAS_NCHWC_BLOCK_SIZE;
+}
+
+void
+MlasNchwcPrepareWorkBlock(
+    MLAS_NCHWC_WORK_BLOCK* WorkBlock,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a NCHWc convolution or pooling operation by
+    computing the common parameters for the operation.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that receives the common parameters.
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Optionally supplies the shape of the kernel. If not
+        supplied, the kernel spans the spatial dimensions of the input tensor.
+
+    DilationShape - Optionally supplies the shape of the dilation.
+
+    Padding - Optionally supplies the number of zero padding elements at the
+        edge of the input tensor.
+
+    StrideShape - Optionally supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    WorkBlock->BatchCount = size_t(InputShape[0]);
+    WorkBlock->InputChannels = MlasNchwcAlignChannels(InputShape[1]);
+    WorkBlock->OutputChannels = MlasNchwcAlignChannels(OutputShape[1]);
+
+    size_t InputSize = 1;
+    size_t OutputSize = 1;
+
+    for (size_t dim = 0; dim < 2; dim++) {
+
+        WorkBlock->InputShape[dim] = size_t(InputShape[dim + 2]);
+        WorkBlock->OutputShape[dim] = size_t(OutputShape[dim + 2]);
+
+        WorkBlock->KernelShape[dim] =
+            (KernelShape != nullptr) ? size_t(KernelShape[dim]) : WorkBlock->InputShape[dim];
+        WorkBlock->DilationShape[dim] =
+            (DilationShape != nullptr) ? size_t(DilationShape[dim]) : 1;
+        WorkBlock->StrideShape[dim] =
+            (StrideShape != nullptr) ? size_t(StrideShape[dim]) : 1;
+
+        if (Padding != nullptr) {
+            WorkBlock->Padding[dim] = size_t(Padding[dim]);
+            WorkBlock->Padding[dim + 2] = size_t(Padding[dim + 2]);
+        } else {
+            WorkBlock->Padding[dim] = 0;
+            WorkBlock->Padding[dim + 2] = 0;
+        }
+
+        InputSize *= WorkBlock->InputShape[dim];
+        OutputSize *= WorkBlock->OutputShape[dim];
+    }
+
+    WorkBlock->InputSize = InputSize;
+    WorkBlock->OutputSize = OutputSize;
+}
+
+int32_t
+MlasNchwcGetTargetThreadCount(
+    size_t RowCount,
+    double Complexity
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of threads to use for a NCHWc operation
+    that is partitioned by output rows.
+
+Arguments:
+
+    RowCount - Supplies the number of output rows that can be independently
+        computed.
+
+    Complexity - Supplies the number of multiplies or loads required to
+        compute the operation.
+
+Return Value:
+
+    Returns the number of threads to use.
+
+--*/
+{
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= RowCount) {
+        TargetThreadCount = int32_t(RowCount);
+    }
+
+    return TargetThreadCount;
+}
+
+template<size_t OutputCount, bool CheckBounds>
+inline
+void
+MlasNchwcConvKernel(
+    const MLAS_NCHWC_CONV_WORK_BLOCK* WorkBlock,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t InitialInputY,
+    size_t InitialInputX
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a set of adjacent output positions of a single row
+    for one block of output channels.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input image for the current batch.
+
+    Filter - Supplies the filter for the current block of output channels.
+
+    Bias - Optionally supplies the bias for the current block of output
+        channels.
+
+    Output - Supplies the location to store the first output position.
+
+    InitialInputY - Supplies the input row of the kernel origin. The value
+        wraps around for positions in the top padding region.
+
+    InitialInputX - Supplies the input column of the kernel origin for the
+        first output position. The value wraps around for positions in the
+        left padding region.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t InputHeight = WorkBlock->InputShape[0];
+    const size_t InputWidth = WorkBlock->InputShape[1];
+    const size_t InputSize = WorkBlock->InputSize;
+
+    const size_t KernelHeight = WorkBlock->KernelShape[0];
+    const size_t KernelWidth = WorkBlock->KernelShape[1];
+    const size_t DilationHeight = WorkBlock->DilationShape[0];
+    const size_t DilationWidth = WorkBlock->DilationShape[1];
+    const size_t StrideWidth = WorkBlock->StrideShape[1];
+
+    const size_t InputChannelBlocks = WorkBlock->InputChannels / BlockSize;
+
+    MLAS_FLOAT32X4 Accumulator0[OutputCount];
+    MLAS_FLOAT32X4 Accumulator1[OutputCount];
+
+    MLAS_FLOAT32X4 Bias0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Bias1 = MlasZeroFloat32x4();
+
+    if (Bias != nullptr) {
+        Bias0 = MlasLoadFloat32x4(Bias);
+        Bias1 = MlasLoadFloat32x4(Bias + 4);
+    }
+
+    for (size_t o = 0; o < OutputCount; o++) {
+        Accumulator0[o] = Bias0;
+        Accumulator1[o] = Bias1;
+    }
+
+    for (size_t icb = 0; icb < InputChannelBlocks; icb++) {
+
+        for (size_t ky = 0; ky < KernelHeight; ky++) {
+
+            size_t InputY = InitialInputY + ky * DilationHeight;
+
+            //
+            // Skip the entire kernel row if the input row is in the top or
+            // bottom padding region.
+            //
+
+            if (InputY >= InputHeight) {
+                Filter += KernelWidth * BlockSize * BlockSize;
+                continue;
+            }
+
+            const float* InputRow = Input + InputY * InputWidth * BlockSize;
+
+            for (size_t kx = 0; kx < KernelWidth; kx++) {
+
+                size_t InputX = InitialInputX + kx * DilationWidth;
+
+                for (size_t ic = 0; ic < BlockSize; ic++) {
+
+                    MLAS_FLOAT32X4 FilterElements0 = MlasLoadFloat32x4(Filter);
+                    MLAS_FLOAT32X4 FilterElements1 = MlasLoadFloat32x4(Filter + 4);
+
+                    for (size_t o = 0; o < OutputCount; o++) {
+
+                        size_t ix = InputX + o * StrideWidth;
+
+                        if (CheckBounds && ix >= InputWidth) {
+                            continue;
+                        }
+
+                        MLAS_FLOAT32X4 InputElement =
+                            MlasBroadcastFloat32x4(&InputRow[ix * BlockSize + ic]);
+
+                        Accumulator0[o] = MlasMultiplyAddFloat32x4(InputElement, FilterElements0, Accumulator0[o]);
+                        Accumulator1[o] = MlasMultiplyAddFloat32x4(InputElement, FilterElements1, Accumulator1[o]);
+                    }
+
+                    Filter += BlockSize;
+                }
+            }
+        }
+
+        Input += InputSize * BlockSize;
+    }
+
+    for (size_t o = 0; o < OutputCount; o++) {
+        MlasStoreFloat32x4(Output, Accumulator0[o]);
+        MlasStoreFloat32x4(Output + 4, Accumulator1[o]);
+        Output += BlockSize;
+    }
+}
+
+void
+MlasNchwcConvThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    NCHWc convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+    constexpr size_t OutputCountBatch = MLAS_NCHWC_CONV_OUTPUT_COUNT;
+
+    const MLAS_NCHWC_CONV_WORK_BLOCK* WorkBlock = (const MLAS_NCHWC_CONV_WORK_BLOCK*)Context;
+
+    const size_t InputWidth = WorkBlock->InputShape[1];
+    const size_t OutputHeight = WorkBlock->OutputShape[0];
+    const size_t OutputWidth = WorkBlock->OutputShape[1];
+
+    const size_t KernelWidth = WorkBlock->KernelShape[1];
+    const size_t DilationWidth = WorkBlock->DilationShape[1];
+    const size_t PaddingLeftY = WorkBlock->Padding[0];
+    const size_t PaddingLeftX = WorkBlock->Padding[1];
+    const size_t StrideHeight = WorkBlock->StrideShape[0];
+    const size_t StrideWidth = WorkBlock->StrideShape[1];
+
+    const size_t InputChannels = WorkBlock->InputChannels;
+    const size_t OutputChannelBlocks = WorkBlock->OutputChannels / BlockSize;
+
+    const size_t FilterBlockSize = InputChannels * WorkBlock->KernelShape[0] * KernelWidth * BlockSize;
+
+    const MLAS_ACTIVATION* Activation = WorkBlock->Activation;
+    const bool ApplyActivation = (Activation->ActivationKind != MlasIdentityActivation);
+
+    //
+    // Compute the range of output columns where the kernel lies entirely
+    // within the input columns, so that no bounds checks are required.
+    //
+
+    const size_t KernelSpanX = (KernelWidth - 1) * DilationWidth;
+
+    size_t OutputWidthStart = (PaddingLeftX + StrideWidth - 1) / StrideWidth;
+    size_t OutputWidthEnd = 0;
+
+    if (InputWidth + PaddingLeftX > KernelSpanX) {
+        OutputWidthEnd = (InputWidth + PaddingLeftX - KernelSpanX - 1) / StrideWidth + 1;
+    }
+
+    if (OutputWidthStart > OutputWidth) {
+        OutputWidthStart = OutputWidth;
+    }
+
+    if (OutputWidthEnd > OutputWidth) {
+        OutputWidthEnd = OutputWidth;
+    }
+
+    if (OutputWidthEnd < OutputWidthStart) {
+        OutputWidthEnd = OutputWidthStart;
+    }
+
+    //
+    // Compute the range of output rows to use for this thread.
+    //
+
+    const size_t TotalRows = WorkBlock->BatchCount * OutputChannelBlocks * OutputHeight;
+
+    size_t RowIndex;
+    size_t RowsRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, TotalRows, &RowIndex, &RowsRemaining);
+
+    size_t oh = RowIndex % OutputHeight;
+    size_t ocb = (RowIndex / OutputHeight) % OutputChannelBlocks;
+    size_t batch = (RowIndex / OutputHeight) / OutputChannelBlocks;
+
+    float* Output = WorkBlock->Output + RowIndex * OutputWidth * BlockSize;
+
+    while (RowsRemaining-- > 0) {
+
+        const float* Input = WorkBlock->Input + batch * InputChannels * WorkBlock->InputSize;
+        const float* Filter = WorkBlock->Filter + ocb * FilterBlockSize;
+        const float* Bias = WorkBlock->Bias;
+
+        if (Bias != nullptr) {
+            Bias += ocb * BlockSize;
+        }
+
+        const size_t InputY = oh * StrideHeight - PaddingLeftY;
+
+        float* output = Output;
+        size_t ow = 0;
+
+        while (ow < OutputWidth) {
+
+            const size_t InputX = ow * StrideWidth - PaddingLeftX;
+
+            if (ow >= OutputWidthStart && ow + OutputCountBatch <= OutputWidthEnd) {
+
+                MlasNchwcConvKernel<OutputCountBatch, false>(WorkBlock, Input, Filter, Bias,
+                    output, InputY, InputX);
+
+                ow += OutputCountBatch;
+                output += OutputCountBatch * BlockSize;
+
+            } else {
+
+                if (ow >= OutputWidthStart && ow < OutputWidthEnd) {
+                    MlasNchwcConvKernel<1, false>(WorkBlock, Input, Filter, Bias, output,
+                        InputY, InputX);
+                } else {
+                    MlasNchwcConvKernel<1, true>(WorkBlock, Input, Filter, Bias, output,
+                        InputY, InputX);
+                }
+
+                ow += 1;
+                output += BlockSize;
+            }
+        }
+
+        //
+        // Apply the activation to the output row.
+        //
+
+        if (ApplyActivation) {
+            MlasActivation(Activation, Output, nullptr, 1, Output, OutputWidth * BlockSize,
+                OutputWidth * BlockSize);
+        }
+
+        Output += OutputWidth * BlockSize;
+
+        if (++oh == OutputHeight) {
+
+            oh = 0;
+
+            if (++ocb == OutputChannelBlocks) {
+                ocb = 0;
+                batch++;
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasNchwcConv(
+    size_t Dimensions,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    const MLAS_ACTIVATION* Activation
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the NCHWc convolution operation.
+
+Arguments:
+
+    Dimensions - Supplies the number of dimensions (must be 2).
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of zero padding elements at the edge of the
+        input tensor.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor.
+
+    Input - Supplies the input tensor in NCHWc format.
+
+    Filter - Supplies the filter tensor in the format produced by
+        MlasReorderFilterOIHWBiBo.
+
+    Bias - Optionally supplies the bias vector, padded to a multiple of the
+        block size.
+
+    Output - Supplies the output tensor in NCHWc format.
+
+    Activation - Supplies the parameters for the activation to apply to the
+        convolution output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_UNREFERENCED_PARAMETER(Dimensions);
+
+    MLAS_NCHWC_CONV_WORK_BLOCK WorkBlock;
+
+    MlasNchwcPrepareWorkBlock(&WorkBlock, InputShape, KernelShape, DilationShape,
+        Padding, StrideShape, OutputShape);
+
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = Filter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.Activation = Activation;
+    WorkBlock.Output = Output;
+
+    //
+    // Schedule the operation across a set of worker threads.
+    //
+
+    const size_t TotalRows = WorkBlock.BatchCount * (WorkBlock.OutputChannels / MLAS_NCHWC_BLOCK_SIZE) *
+        WorkBlock.OutputShape[0];
+
+    const double Complexity = double(WorkBlock.BatchCount) * double(WorkBlock.OutputChannels) *
+        double(WorkBlock.OutputSize) * double(WorkBlock.InputChannels) *
+        double(WorkBlock.KernelShape[0] * WorkBlock.KernelShape[1]);
+
+    WorkBlock.TargetThreadCount = MlasNchwcGetTargetThreadCount(TotalRows, Complexity);
+
+    MlasExecuteThreaded(MlasNchwcConvThreaded, &WorkBlock, WorkBlock.TargetThreadCount);
+}
+
+template<MLAS_POOLING_KIND PoolingKind>
+void
+MlasNchwcPoolKernel(
+    const MLAS_NCHWC_POOL_WORK_BLOCK* WorkBlock,
+    const float* Input,
+    float* Output,
+    size_t oh
+    )
+/*++
+
+Routine Description:
+
+    This routine computes one output row of a NCHWc pooling operation for a
+    single block of channels.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that contains the pooling parameters.
+
+    Input - Supplies the input image for the current block of channels.
+
+    Output - Supplies the output row.
+
+    oh - Supplies the index of the output row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t InputHeight = WorkBlock->InputShape[0];
+    const size_t InputWidth = WorkBlock->InputShape[1];
+    const size_t OutputWidth = WorkBlock->OutputShape[1];
+    const size_t KernelHeight = WorkBlock->KernelShape[0];
+    const size_t KernelWidth = WorkBlock->KernelShape[1];
+    const size_t StrideWidth = WorkBlock->StrideShape[1];
+
+    const size_t InputYStart = oh * WorkBlock->StrideShape[0] - WorkBlock->Padding[0];
+
+    size_t ihStart = InputYStart;
+    size_t ihEnd = InputYStart + KernelHeight;
+
+    if (ptrdiff_t(ihStart) < 0) {
+        ihStart = 0;
+    }
+
+    if (ptrdiff_t(ihEnd) > ptrdiff_t(InputHeight)) {
+        ihEnd = InputHeight;
+    }
+
+    for (size_t ow = 0; ow < OutputWidth; ow++) {
+
+        const size_t InputXStart = ow * StrideWidth - WorkBlock->Padding[1];
+
+        size_t iwStart = InputXStart;
+        size_t iwEnd = InputXStart + KernelWidth;
+
+        if (ptrdiff_t(iwStart) < 0) {
+            iwStart = 0;
+        }
+
+        if (ptrdiff_t(iwEnd) > ptrdiff_t(InputWidth)) {
+            iwEnd = InputWidth;
+        }
+
+        MLAS_FLOAT32X4 Reduction0;
+        MLAS_FLOAT32X4 Reduction1;
+
+        if (PoolingKind == MlasMaximumPooling) {
+            Reduction0 = MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+        } else {
+            Reduction0 = MlasZeroFloat32x4();
+        }
+
+        Reduction1 = Reduction0;
+
+        for (size_t ih = ihStart; ih < ihEnd; ih++) {
+
+            const float* input = Input + (ih * InputWidth + iwStart) * BlockSize;
+
+            for (size_t iw = iwStart; iw < iwEnd; iw++) {
+
+                MLAS_FLOAT32X4 InputElements0 = MlasLoadFloat32x4(input);
+                MLAS_FLOAT32X4 InputElements1 = MlasLoadFloat32x4(input + 4);
+
+                if (PoolingKind == MlasMaximumPooling) {
+                    Reduction0 = MlasMaximumFloat32x4(Reduction0, InputElements0);
+                    Reduction1 = MlasMaximumFloat32x4(Reduction1, InputElements1);
+                } else {
+                    Reduction0 = MlasAddFloat32x4(Reduction0, InputElements0);
+                    Reduction1 = MlasAddFloat32x4(Reduction1, InputElements1);
+                }
+
+                input += BlockSize;
+            }
+        }
+
+        if (PoolingKind != MlasMaximumPooling) {
+
+            size_t PoolSize;
+
+            if (PoolingKind == MlasAveragePoolingIncludePad) {
+                PoolSize = KernelHeight * KernelWidth;
+            } else {
+                PoolSize = (ihEnd - ihStart) * (iwEnd - iwStart);
+            }
+
+            MLAS_FLOAT32X4 Divisor = MlasBroadcastFloat32x4(float(PoolSize));
+
+            Reduction0 = MlasDivideFloat32x4(Reduction0, Divisor);
+            Reduction1 = MlasDivideFloat32x4(Reduction1, Divisor);
+        }
+
+        MlasStoreFloat32x4(Output, Reduction0);
+        MlasStoreFloat32x4(Output + 4, Reduction1);
+
+        Output += BlockSize;
+    }
+}
+
+template<MLAS_POOLING_KIND PoolingKind>
+void
+MlasNchwcPoolThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    NCHWc pooling operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const MLAS_NCHWC_POOL_WORK_BLOCK* WorkBlock = (const MLAS_NCHWC_POOL_WORK_BLOCK*)Context;
+
+    const size_t OutputHeight = WorkBlock->OutputShape[0];
+    const size_t OutputRowSize = WorkBlock->OutputShape[1] * BlockSize;
+    const size_t InputImageSize = WorkBlock->InputSize * BlockSize;
+
+    //
+    // Compute the range of output rows to use for this thread. The batch and
+    // channel block dimensions are combined as the pooling is independent
+    // for each block of channels.
+    //
+
+    const size_t TotalRows = WorkBlock->BatchCount * (WorkBlock->InputChannels / BlockSize) * OutputHeight;
+
+    size_t RowIndex;
+    size_t RowsRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, TotalRows, &RowIndex, &RowsRemaining);
+
+    size_t oh = RowIndex % OutputHeight;
+    size_t ImageIndex = RowIndex / OutputHeight;
+
+    float* Output = WorkBlock->Output + RowIndex * OutputRowSize;
+
+    while (RowsRemaining-- > 0) {
+
+        MlasNchwcPoolKernel<PoolingKind>(WorkBlock, WorkBlock->Input + ImageIndex * InputImageSize,
+            Output, oh);
+
+        Output += OutputRowSize;
+
+        if (++oh == OutputHeight) {
+            oh = 0;
+            ImageIndex++;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasNchwcPool(
+    MLAS_POOLING_KIND PoolingKind,
+    size_t Dimensions,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the NCHWc pooling operation.
+
+Arguments:
+
+    PoolingKind - Supplies the kind of pooling operation to perform.
+
+    Dimensions - Supplies the number of dimensions (must be 2).
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Optionally supplies the shape of the kernel. If not
+        supplied, then a global pooling operation is performed.
+
+    Padding - Optionally supplies the number of zero padding elements at the
+        edge of the input tensor.
+
+    StrideShape - Optionally supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor.
+
+    Input - Supplies the input tensor in NCHWc format.
+
+    Output - Supplies the output tensor in NCHWc format.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_UNREFERENCED_PARAMETER(Dimensions);
+
+    MLAS_NCHWC_POOL_WORK_BLOCK WorkBlock;
+
+    MlasNchwcPrepareWorkBlock(&WorkBlock, InputShape, KernelShape, nullptr,
+        Padding, StrideShape, OutputShape);
+
+    WorkBlock.PoolingKind = PoolingKind;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+
+    //
+    // Schedule the operation across a set of worker threads.
+    //
+
+    const size_t TotalRows = WorkBlock.BatchCount * (WorkBlock.InputChannels / MLAS_NCHWC_BLOCK_SIZE) *
+        WorkBlock.OutputShape[0];
+
+    const double Complexity = double(WorkBlock.BatchCount) * double(WorkBlock.InputChannels) *
+        double(WorkBlock.OutputSize) * double(WorkBlock.KernelShape[0] * WorkBlock.KernelShape[1]);
+
+    WorkBlock.TargetThreadCount = MlasNchwcGetTargetThreadCount(TotalRows, Complexity);
+
+    PMLAS_THREADED_ROUTINE ThreadedRoutine;
+
+    switch (PoolingKind) {
+
+        case MlasMaximumPooling:
+            ThreadedRoutine = MlasNchwcPoolThreaded<MlasMaximumPooling>;
+            break;
+
+        case MlasAveragePoolingExcludePad:
+            ThreadedRoutine = MlasNchwcPoolThreaded<MlasAveragePoolingExcludePad>;
+            break;
+
+        case MlasAveragePoolingIncludePad:
+        default:
+            ThreadedRoutine = MlasNchwcPoolThreaded<MlasAveragePoolingIncludePad>;
+            break;
+    }
+
+    MlasExecuteThreaded(ThreadedRoutine, &WorkBlock, WorkBlock.TargetThreadCount);
+}
+
+void
+MLASCALL
+MlasReorderInput(
+    const int64_t* InputShape,
+    const float* S,
+    float* D
+    )
+/*++
+
+Routine Description:
+
+    This routine reorders an input tensor from NCHW format to NCHWc format.
+
+Arguments:
+
+    InputShape - Supplies the shape of the input tensor.
+
+    S - Supplies the address of the source tensor.
+
+    D - Supplies the address of the destination tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t BatchCount = size_t(InputShape[0]);
+    const size_t InputChannels = size_t(InputShape[1]);
+    const size_t InputSize = size_t(InputShape[2]) * size_t(InputShape[3]);
+
+    for (size_t batch = 0; batch < BatchCount; batch++) {
+
+        for (size_t c = 0; c < InputChannels; c += BlockSize) {
+
+            const size_t ChannelCount = (std::min)(BlockSize, InputChannels - c);
+
+            for (size_t i = 0; i < InputSize; i++) {
+
+                size_t bc = 0;
+
+                for (; bc < ChannelCount; bc++) {
+                    D[bc] = S[bc * InputSize + i];
+                }
+
+                for (; bc < BlockSize; bc++) {
+                    D[bc] = 0.0f;
+                }
+
+                D += BlockSize;
+            }
+
+            S += ChannelCount * InputSize;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasReorderOutput(
+    const int64_t* OutputShape,
+    const float* S,
+    float* D
+    )
+/*++
+
+Routine Description:
+
+    This routine reorders an output tensor from NCHWc format to NCHW format.
+
+Arguments:
+
+    OutputShape - Supplies the shape of the output tensor.
+
+    S - Supplies the address of the source tensor.
+
+    D - Supplies the address of the destination tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t BatchCount = size_t(OutputShape[0]);
+    const size_t OutputChannels = size_t(OutputShape[1]);
+    const size_t OutputSize = size_t(OutputShape[2]) * size_t(OutputShape[3]);
+
+    for (size_t batch = 0; batch < BatchCount; batch++) {
+
+        for (size_t c = 0; c < OutputChannels; c += BlockSize) {
+
+            const size_t ChannelCount = (std::min)(BlockSize, OutputChannels - c);
+
+            for (size_t bc = 0; bc < ChannelCount; bc++) {
+
+                const float* s = S + bc;
+
+                for (size_t i = 0; i < OutputSize; i++) {
+                    *D++ = *s;
+                    s += BlockSize;
+                }
+            }
+
+            S += OutputSize * BlockSize;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasReorderFilterOIHWBiBo(
+    const int64_t* FilterShape,
+    const float* S,
+    float* D
+    )
+/*++
+
+Routine Description:
+
+    This routine reorders a filter tensor from OIHW format to the blocked
+    format consumed by MlasNchwcConv: [O/c, I/c, H, W, c(input), c(output)].
+
+Arguments:
+
+    FilterShape - Supplies the shape of the filter tensor.
+
+    S - Supplies the address of the source tensor.
+
+    D - Supplies the address of the destination tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t OutputChannels = size_t(FilterShape[0]);
+    const size_t InputChannels = size_t(FilterShape[1]);
+    const size_t KernelSize = size_t(FilterShape[2]) * size_t(FilterShape[3]);
+
+    const size_t AlignedInputChannels = MlasNchwcAlignChannels(FilterShape[1]);
+    const size_t AlignedOutputChannels = MlasNchwcAlignChannels(FilterShape[0]);
+
+    for (size_t o = 0; o < AlignedOutputChannels; o += BlockSize) {
+
+        for (size_t i = 0; i < AlignedInputChannels; i += BlockSize) {
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                for (size_t bi = 0; bi < BlockSize; bi++) {
+
+                    for (size_t bo = 0; bo < BlockSize; bo++) {
+
+                        const size_t oc = o + bo;
+                        const size_t ic = i + bi;
+
+                        if (oc < OutputChannels && ic < InputChannels) {
+                            *D++ = S[(oc * InputChannels + ic) * KernelSize + k];
+                        } else {
+                            *D++ = 0.0f;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
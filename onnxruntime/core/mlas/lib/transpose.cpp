@@ -0,0 +1,320 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transpose.cpp
+
+Abstract:
+
+    This module implements the matrix transpose operation.
+
+    The matrix is processed in blocks of columns so that the rows read from the
+    source stay resident in the cache while the block is transposed using 4x4
+    vector tiles. The blocks are the unit of work that is partitioned across
+    threads.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of source columns that are processed as a unit of work.
+//
+
+#define MLAS_TRANSPOSE_BLOCK_N                      16
+
+//
+// Define the number of elements to transpose per thread.
+//
+
+#define MLAS_TRANSPOSE_THREAD_COMPLEXITY            (64 * 1024)
+
+//
+// Structure to encapsulate the parameters for a threaded transpose.
+//
+
+struct MLAS_TRANSPOSE_WORK_BLOCK {
+    const float* Input;
+    float* Output;
+    size_t BatchCount;
+    size_t M;
+    size_t N;
+    int32_t TargetThreadCount;
+};
+
+inline
+MLAS_FLOAT32X4
+MlasCombineLowFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vcombine_f32(vget_low_f32(Vector1), vget_low_f32(Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_movelh_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasCombineHighFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vcombine_f32(vget_high_f32(Vector1), vget_high_f32(Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_movehl_ps(Vector2, Vector1);
+#endif
+}
+
+inline
+void
+MlasTransposeFloat4x4(
+    const float* Input,
+    size_t ldi,
+    float* Output,
+    size_t ldo
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a 4x4 tile of the source matrix.
+
+Arguments:
+
+    Input - Supplies the address of the source tile.
+
+    ldi - Supplies the number of elements in a row of the source matrix.
+
+    Output - Supplies the address of the destination tile.
+
+    ldo - Supplies the number of elements in a row of the destination matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 a = MlasLoadFloat32x4(Input);
+    MLAS_FLOAT32X4 b = MlasLoadFloat32x4(Input + ldi);
+    MLAS_FLOAT32X4 c = MlasLoadFloat32x4(Input + ldi * 2);
+    MLAS_FLOAT32X4 d = MlasLoadFloat32x4(Input + ldi * 3);
+
+    MLAS_FLOAT32X4 ab01 = MlasInterleaveLowFloat32x4(a, b);
+    MLAS_FLOAT32X4 ab23 = MlasInterleaveHighFloat32x4(a, b);
+    MLAS_FLOAT32X4 cd01 = MlasInterleaveLowFloat32x4(c, d);
+    MLAS_FLOAT32X4 cd23 = MlasInterleaveHighFloat32x4(c, d);
+
+    MlasStoreFloat32x4(Output, MlasCombineLowFloat32x4(ab01, cd01));
+    MlasStoreFloat32x4(Output + ldo, MlasCombineHighFloat32x4(ab01, cd01));
+    MlasStoreFloat32x4(Output + ldo * 2, MlasCombineLowFloat32x4(ab23, cd23));
+    MlasStoreFloat32x4(Output + ldo * 3, MlasCombineHighFloat32x4(ab23, cd23));
+}
+
+void
+MlasTransposeBlock(
+    const float* Input,
+    float* Output,
+    size_t M,
+    size_t N,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a block of columns of the source matrix.
+
+Arguments:
+
+    Input - Supplies the address of the first source column of the block.
+
+    Output - Supplies the address of the first destination row of the block.
+
+    M - Supplies the number of rows of the source matrix.
+
+    N - Supplies the number of columns of the source matrix.
+
+    CountN - Supplies the number of columns in the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t m = 0;
+
+    while (m + 4 <= M) {
+
+        const float* input = Input + m * N;
+        float* output = Output + m;
+
+        size_t n = 0;
+
+        while (n + 4 <= CountN) {
+            MlasTransposeFloat4x4(input + n, N, output + n * M, M);
+            n += 4;
+        }
+
+        while (n < CountN) {
+            output[n * M] = input[n];
+            output[n * M + 1] = input[n + N];
+            output[n * M + 2] = input[n + N * 2];
+            output[n * M + 3] = input[n + N * 3];
+            n += 1;
+        }
+
+        m += 4;
+    }
+
+    while (m < M) {
+
+        const float* input = Input + m * N;
+        float* output = Output + m;
+
+        for (size_t n = 0; n < CountN; n++) {
+            output[n * M] = input[n];
+        }
+
+        m += 1;
+    }
+}
+
+void
+MlasTransposeThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    transpose operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_TRANSPOSE_WORK_BLOCK* WorkBlock = (MLAS_TRANSPOSE_WORK_BLOCK*)Context;
+
+    const size_t M = WorkBlock->M;
+    const size_t N = WorkBlock->N;
+
+    const size_t BlocksPerBatch = (N + MLAS_TRANSPOSE_BLOCK_N - 1) / MLAS_TRANSPOSE_BLOCK_N;
+    const size_t TotalWork = WorkBlock->BatchCount * BlocksPerBatch;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, TotalWork, &WorkIndex, &WorkRemaining);
+
+    while (WorkRemaining > 0) {
+
+        const size_t batch = WorkIndex / BlocksPerBatch;
+        const size_t n = (WorkIndex % BlocksPerBatch) * MLAS_TRANSPOSE_BLOCK_N;
+
+        size_t CountN = N - n;
+
+        if (CountN > MLAS_TRANSPOSE_BLOCK_N) {
+            CountN = MLAS_TRANSPOSE_BLOCK_N;
+        }
+
+        MlasTransposeBlock(WorkBlock->Input + batch * M * N + n,
+            WorkBlock->Output + batch * M * N + n * M, M, N, CountN);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const float* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a batch of matrices.
+
+Arguments:
+
+    Input - Supplies the address of the source matrices, each stored as M rows
+        of N elements.
+
+    Output - Supplies the address of the destination matrices, each stored as
+        N rows of M elements.
+
+    BatchCount - Supplies the number of matrices.
+
+    M - Supplies the number of rows of each source matrix.
+
+    N - Supplies the number of columns of each source matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_TRANSPOSE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.BatchCount = BatchCount;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const size_t BlocksPerBatch = (N + MLAS_TRANSPOSE_BLOCK_N - 1) / MLAS_TRANSPOSE_BLOCK_N;
+    const size_t TotalWork = BatchCount * BlocksPerBatch;
+
+    int32_t TargetThreadCount;
+    double Complexity = double(BatchCount) * double(M) * double(N);
+
+    if (Complexity < double(MLAS_TRANSPOSE_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_TRANSPOSE_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > TotalWork) {
+        TargetThreadCount = int32_t(TotalWork);
+    }
+
+    if (TargetThreadCount == 0) {
+        return;
+    }
+
+    WorkBlock.TargetThreadCount = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasTransposeThreaded, &WorkBlock, TargetThreadCount);
+}
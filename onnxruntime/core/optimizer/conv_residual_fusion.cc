@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <deque>
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/conv_residual_fusion.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsFusableActivation(const Node& node) {
+  return utils::IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Relu", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", 6);
+}
+
+// FusedConv does not broadcast the Z input, so both inputs of the Add must have
+// the same shape. Symbolic dimensions only match if they have the same name.
+bool HaveSameShape(const NodeArg& arg_0, const NodeArg& arg_1) {
+  const auto* shape_0 = arg_0.Shape();
+  const auto* shape_1 = arg_1.Shape();
+  if (shape_0 == nullptr || shape_1 == nullptr || shape_0->dim_size() != shape_1->dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < shape_0->dim_size(); i++) {
+    const auto& dim_0 = shape_0->dim(i);
+    const auto& dim_1 = shape_1->dim(i);
+    if (dim_0.has_dim_value() && dim_1.has_dim_value()) {
+      if (dim_0.dim_value() != dim_1.dim_value()) {
+        return false;
+      }
+    } else if (!dim_0.has_dim_param() || !dim_1.has_dim_param() || dim_0.dim_param() != dim_1.dim_param()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Status ConvResidualFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level));
+
+    if (!utils::IsSupportedOptypeVersionAndDomain(*node, "Conv", 1) || node->GetOutputEdgesCount() != 1 ||
+        graph.IsNodeOutputsInGraphOutputs(*node)) {
+      continue;
+    }
+
+    // FusedConv is only implemented for float tensors.
+    const auto* conv_type = node->InputDefs()[0]->Type();
+    if (conv_type == nullptr || *conv_type != "tensor(float)") {
+      continue;
+    }
+
+    // Both inputs of the Add may be produced by Conv nodes, but only one of
+    // them can be fused with the Add.
+    const Node& add_node = *(node->OutputNodesBegin());
+    if (!utils::IsSupportedOptypeVersionAndDomain(add_node, "Add", 7) ||
+        add_node.GetExecutionProviderType() != node->GetExecutionProviderType() ||
+        std::find(removed_nodes.begin(), removed_nodes.end(), add_node.Index()) != removed_nodes.end()) {
+      continue;
+    }
+
+    const auto& add_inputs = add_node.InputDefs();
+    const NodeArg* conv_output_def = node->OutputDefs()[0];
+    NodeArg* sum_def = nullptr;
+    if (add_inputs[0] == conv_output_def) {
+      sum_def = const_cast<NodeArg*>(add_inputs[1]);
+    } else if (add_inputs[1] == conv_output_def) {
+      sum_def = const_cast<NodeArg*>(add_inputs[0]);
+    }
+    if (sum_def == nullptr || !HaveSameShape(*conv_output_def, *sum_def)) {
+      continue;
+    }
+
+    // Include the activation that follows the Add, if any.
+    const Node* act_node = nullptr;
+    if (add_node.GetOutputEdgesCount() == 1 && !graph.IsNodeOutputsInGraphOutputs(add_node)) {
+      const Node& next_node = *(add_node.OutputNodesBegin());
+      if (IsFusableActivation(next_node) &&
+          next_node.GetExecutionProviderType() == node->GetExecutionProviderType()) {
+        act_node = &next_node;
+      }
+    }
+
+    const Node& last_node = act_node != nullptr ? *act_node : add_node;
+
+    auto& conv_inputs = node->MutableInputDefs();
+    std::vector<NodeArg*> fused_inputs{conv_inputs[0], conv_inputs[1]};
+    if (conv_inputs.size() >= 3) {
+      fused_inputs.push_back(conv_inputs[2]);
+    } else {
+      fused_inputs.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+    }
+    fused_inputs.push_back(sum_def);
+
+    Node& fused_conv = graph.AddNode(graph.GenerateNodeName("fused " + node->Name()), "FusedConv",
+                                     "fused Conv " + node->Name() + " with residual Add",
+                                     fused_inputs,
+                                     std::vector<NodeArg*>{const_cast<NodeArg*>(last_node.OutputDefs()[0])},
+                                     &node->GetAttributes(),
+                                     kMSDomain);
+    fused_conv.SetExecutionProviderType(node->GetExecutionProviderType());
+
+    if (act_node != nullptr) {
+      fused_conv.AddAttribute("activation", act_node->OpType());
+
+      // Add optional attributes for activations
+      if (act_node->OpType() == "LeakyRelu") {
+        for (const auto& attr : act_node->GetAttributes()) {
+          fused_conv.AddAttribute(attr.first, attr.second);
+        }
+      }
+    }
+
+    removed_nodes.push_front(node->Index());
+    removed_nodes.push_front(add_node.Index());
+    if (act_node != nullptr) {
+      removed_nodes.push_front(act_node->Index());
+    }
+  }
+
+  // The consumers were pushed to the front, so they are removed before their
+  // producers.
+  for (auto node : removed_nodes) {
+    graph.RemoveNode(node);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class ConvResidualFusion
+
+Transformer that fuses the tail of a residual block, Conv -> Add(shortcut) -> optional activation,
+into a single FusedConv node. The shortcut tensor becomes the Z input of FusedConv, which the
+convolution accumulates into before applying the bias and activation, so the separate passes of the
+Add and activation over the output tensor are removed. BatchNormalization nodes are expected to have
+been folded into the Conv weights by ConvBNFusion.
+*/
+class ConvResidualFusion : public onnxruntime::GraphTransformer {
+ public:
+  ConvResidualFusion() noexcept : onnxruntime::GraphTransformer("ConvResidualFusion", "Fusing residual Add and activation into Conv") {}
+
+ private:
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+};
+
+}  // namespace onnxruntime
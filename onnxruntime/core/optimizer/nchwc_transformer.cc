@@ -0,0 +1,380 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <unordered_map>
+#include "core/graph/graph_utils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/nchwc_transformer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Tracks the NCHWc form of a tensor that has been produced by the transformer.
+struct NchwcArgument {
+  NodeArg* nchwc_arg_;
+  // Logical number of channels of the original NCHW tensor.
+  int64_t channels_;
+  // Number of consumers (including graph outputs) of the original NCHW tensor
+  // that have not been converted. If non-zero once the graph has been
+  // processed, a ReorderOutput node is required to produce the original tensor.
+  int remaining_original_uses_;
+};
+
+class NchwcTransformerImpl {
+ public:
+  explicit NchwcTransformerImpl(Graph& graph) noexcept
+      : graph_(graph), block_size_(static_cast<int64_t>(MlasNchwcGetBlockSize())) {}
+
+  void Transform(Node& node);
+  void Finalize(bool& modified);
+
+ private:
+  int64_t AlignChannels(int64_t channels) const {
+    return (channels + block_size_ - 1) / block_size_ * block_size_;
+  }
+
+  NchwcArgument* LookupNchwcArgument(const NodeArg* arg);
+  NodeArg* GetOrCreateNchwcInput(NodeArg* arg, int64_t channels);
+  NodeArg* CreateNchwcArgument(const NodeArg* arg);
+  NodeArg* AddInitializer(const std::string& base_name, const std::vector<int64_t>& dims, const std::vector<float>& data);
+  int CountArgumentUses(const NodeArg* arg) const;
+  void ConvertNode(Node& node, Node& nchwc_node, int64_t output_channels);
+
+  void TransformConv(Node& node);
+  void TransformPool(Node& node, const std::string& nchwc_op_type, bool global_pooling);
+  void TransformRelu(Node& node);
+  void TransformAdd(Node& node);
+
+  Graph& graph_;
+  const int64_t block_size_;
+
+  std::unordered_map<const NodeArg*, NchwcArgument> nchwc_args_;
+  // Original tensors in the order they were converted, used to keep the
+  // placement of the ReorderOutput nodes deterministic.
+  std::vector<const NodeArg*> converted_outputs_;
+  std::vector<NodeIndex> removed_nodes_;
+};
+
+NchwcArgument* NchwcTransformerImpl::LookupNchwcArgument(const NodeArg* arg) {
+  auto it = nchwc_args_.find(arg);
+  return (it != nchwc_args_.end()) ? &it->second : nullptr;
+}
+
+int NchwcTransformerImpl::CountArgumentUses(const NodeArg* arg) const {
+  int uses = 0;
+  for (const auto& node : graph_.Nodes()) {
+    uses += static_cast<int>(std::count(node.InputDefs().cbegin(), node.InputDefs().cend(), arg));
+    uses += static_cast<int>(std::count(node.ImplicitInputDefs().cbegin(), node.ImplicitInputDefs().cend(), arg));
+  }
+  const auto& graph_outputs = graph_.GetOutputs();
+  uses += static_cast<int>(std::count(graph_outputs.cbegin(), graph_outputs.cend(), arg));
+  return uses;
+}
+
+NodeArg* NchwcTransformerImpl::CreateNchwcArgument(const NodeArg* arg) {
+  TypeProto type_proto;
+  type_proto.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  return &graph_.GetOrCreateNodeArg(graph_.GenerateNodeArgName(arg->Name() + "_nchwc"), &type_proto);
+}
+
+NodeArg* NchwcTransformerImpl::GetOrCreateNchwcInput(NodeArg* arg, int64_t channels) {
+  auto* nchwc_input = LookupNchwcArgument(arg);
+  if (nchwc_input != nullptr) {
+    return nchwc_input->nchwc_arg_;
+  }
+
+  // The tensor enters the NCHWc chain here. The original tensor continues to be
+  // produced by its existing source, so no ReorderOutput is ever required.
+  NodeArg* nchwc_arg = CreateNchwcArgument(arg);
+  graph_.AddNode(graph_.GenerateNodeName("ReorderInput"),
+                 "ReorderInput",
+                 "Reorder " + arg->Name() + " to NCHWc",
+                 std::vector<NodeArg*>{arg},
+                 std::vector<NodeArg*>{nchwc_arg},
+                 nullptr,
+                 kMSDomain);
+  nchwc_args_.emplace(arg, NchwcArgument{nchwc_arg, channels, 0});
+  return nchwc_arg;
+}
+
+NodeArg* NchwcTransformerImpl::AddInitializer(const std::string& base_name,
+                                              const std::vector<int64_t>& dims,
+                                              const std::vector<float>& data) {
+  TensorProto tensor_proto;
+  tensor_proto.set_name(graph_.GenerateNodeArgName(base_name + "_nchwc"));
+  tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    tensor_proto.add_dims(dim);
+  }
+  tensor_proto.set_raw_data(data.data(), data.size() * sizeof(float));
+  graph_.AddInitializedTensor(tensor_proto);
+
+  TypeProto type_proto;
+  type_proto.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    type_proto.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return &graph_.GetOrCreateNodeArg(tensor_proto.name(), &type_proto);
+}
+
+// Records that the original node has been replaced by a node operating on NCHWc
+// tensors. The uses of the NCHWc inputs by the original node are released and
+// the output of the replacement node is registered for later consumers.
+void NchwcTransformerImpl::ConvertNode(Node& node, Node& nchwc_node, int64_t output_channels) {
+  for (const auto* input_def : node.InputDefs()) {
+    auto* nchwc_input = LookupNchwcArgument(input_def);
+    if (nchwc_input != nullptr && nchwc_input->remaining_original_uses_ > 0) {
+      nchwc_input->remaining_original_uses_--;
+    }
+  }
+
+  const NodeArg* output_def = node.OutputDefs()[0];
+  nchwc_args_.emplace(output_def,
+                      NchwcArgument{nchwc_node.MutableOutputDefs()[0], output_channels, CountArgumentUses(output_def)});
+  converted_outputs_.push_back(output_def);
+  removed_nodes_.push_back(node.Index());
+}
+
+void NchwcTransformerImpl::TransformConv(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+
+  // The sum input of FusedConv has no NCHWc equivalent.
+  if (input_defs.size() >= 4 && input_defs[3]->Exists()) {
+    return;
+  }
+
+  const TensorProto* conv_W_tensor_proto = nullptr;
+  if (!graph_.GetInitializedTensor(input_defs[1]->Name(), conv_W_tensor_proto) ||
+      conv_W_tensor_proto->data_type() != TensorProto_DataType_FLOAT ||
+      conv_W_tensor_proto->dims_size() != 4) {
+    return;
+  }
+
+  const TensorProto* conv_B_tensor_proto = nullptr;
+  if (input_defs.size() >= 3 && input_defs[2]->Exists()) {
+    if (!graph_.GetInitializedTensor(input_defs[2]->Name(), conv_B_tensor_proto) ||
+        conv_B_tensor_proto->data_type() != TensorProto_DataType_FLOAT ||
+        conv_B_tensor_proto->dims_size() != 1 ||
+        conv_B_tensor_proto->dims(0) != conv_W_tensor_proto->dims(0)) {
+      return;
+    }
+  }
+
+  const auto* group_attr = utils::GetNodeAttribute(node, "group");
+  if (group_attr != nullptr && group_attr->i() != 1) {
+    return;
+  }
+
+  const int64_t output_channels = conv_W_tensor_proto->dims(0);
+  const int64_t input_channels = conv_W_tensor_proto->dims(1);
+
+  // Starting a chain from a tensor with a channel count that is not a multiple
+  // of the block size (such as the RGB input of a network) wastes more work on
+  // the padding than is gained from the blocked kernel.
+  auto* nchwc_input = LookupNchwcArgument(input_defs[0]);
+  if (nchwc_input == nullptr && (input_channels % block_size_) != 0) {
+    return;
+  }
+  if (nchwc_input != nullptr && nchwc_input->channels_ != input_channels) {
+    return;
+  }
+  if (output_channels < block_size_) {
+    return;
+  }
+
+  const int64_t aligned_output_channels = AlignChannels(output_channels);
+  const int64_t aligned_input_channels = AlignChannels(input_channels);
+
+  Initializer conv_W{conv_W_tensor_proto};
+  std::vector<float> reordered_filter(static_cast<size_t>(
+      aligned_output_channels * aligned_input_channels * conv_W_tensor_proto->dims(2) * conv_W_tensor_proto->dims(3)));
+  const int64_t filter_shape[] = {output_channels, input_channels, conv_W_tensor_proto->dims(2), conv_W_tensor_proto->dims(3)};
+  MlasReorderFilterOIHWBiBo(filter_shape, conv_W.data<float>(), reordered_filter.data());
+
+  std::vector<NodeArg*> nchwc_inputs;
+  nchwc_inputs.push_back(GetOrCreateNchwcInput(input_defs[0], input_channels));
+  nchwc_inputs.push_back(AddInitializer(input_defs[1]->Name(),
+                                        {aligned_output_channels, aligned_input_channels,
+                                         conv_W_tensor_proto->dims(2), conv_W_tensor_proto->dims(3)},
+                                        reordered_filter));
+
+  if (conv_B_tensor_proto != nullptr) {
+    Initializer conv_B{conv_B_tensor_proto};
+    std::vector<float> padded_bias(static_cast<size_t>(aligned_output_channels), 0.0f);
+    std::copy_n(conv_B.data<float>(), output_channels, padded_bias.begin());
+    nchwc_inputs.push_back(AddInitializer(input_defs[2]->Name(), {aligned_output_channels}, padded_bias));
+  }
+
+  Node& nchwc_node = graph_.AddNode(graph_.GenerateNodeName(node.Name() + "_nchwc"),
+                                    "NchwcConv",
+                                    "NCHWc " + node.Name(),
+                                    nchwc_inputs,
+                                    std::vector<NodeArg*>{CreateNchwcArgument(node.OutputDefs()[0])},
+                                    &node.GetAttributes(),
+                                    kMSDomain);
+
+  ConvertNode(node, nchwc_node, output_channels);
+}
+
+void NchwcTransformerImpl::TransformPool(Node& node, const std::string& nchwc_op_type, bool global_pooling) {
+  auto* nchwc_input = LookupNchwcArgument(node.InputDefs()[0]);
+  if (nchwc_input == nullptr) {
+    return;
+  }
+
+  // The optional Indices output of MaxPool has no NCHWc equivalent.
+  const auto& output_defs = node.OutputDefs();
+  if (output_defs.size() > 1 && output_defs[1]->Exists()) {
+    return;
+  }
+
+  NodeAttributes nchwc_attributes;
+  if (!global_pooling) {
+    std::vector<int64_t> kernel_shape;
+    if (!utils::GetRepeatedNodeAttributeValues(node, "kernel_shape", kernel_shape) || kernel_shape.size() != 2) {
+      return;
+    }
+    const auto& attributes = node.GetAttributes();
+    for (const char* attribute_name : {"auto_pad", "kernel_shape", "pads", "strides", "count_include_pad"}) {
+      auto it = attributes.find(attribute_name);
+      if (it != attributes.end()) {
+        nchwc_attributes.insert(*it);
+      }
+    }
+  }
+
+  Node& nchwc_node = graph_.AddNode(graph_.GenerateNodeName(node.Name() + "_nchwc"),
+                                    nchwc_op_type,
+                                    "NCHWc " + node.Name(),
+                                    std::vector<NodeArg*>{nchwc_input->nchwc_arg_},
+                                    std::vector<NodeArg*>{CreateNchwcArgument(output_defs[0])},
+                                    &nchwc_attributes,
+                                    kMSDomain);
+
+  ConvertNode(node, nchwc_node, nchwc_input->channels_);
+}
+
+void NchwcTransformerImpl::TransformRelu(Node& node) {
+  auto* nchwc_input = LookupNchwcArgument(node.InputDefs()[0]);
+  if (nchwc_input == nullptr) {
+    return;
+  }
+
+  // Relu maps the zero padded channels to zero, so the NCHWc tensor can be
+  // passed through unchanged.
+  Node& nchwc_node = graph_.AddNode(graph_.GenerateNodeName(node.Name() + "_nchwc"),
+                                    "Relu",
+                                    "NCHWc " + node.Name(),
+                                    std::vector<NodeArg*>{nchwc_input->nchwc_arg_},
+                                    std::vector<NodeArg*>{CreateNchwcArgument(node.OutputDefs()[0])});
+
+  ConvertNode(node, nchwc_node, nchwc_input->channels_);
+}
+
+void NchwcTransformerImpl::TransformAdd(Node& node) {
+  const auto& input_defs = node.InputDefs();
+  auto* nchwc_input_0 = LookupNchwcArgument(input_defs[0]);
+  auto* nchwc_input_1 = LookupNchwcArgument(input_defs[1]);
+  if (nchwc_input_0 == nullptr || nchwc_input_1 == nullptr ||
+      nchwc_input_0->channels_ != nchwc_input_1->channels_) {
+    return;
+  }
+
+  // Broadcasting does not carry over to the blocked layout, so the inputs must
+  // have the same fully known shape.
+  const auto* shape_0 = input_defs[0]->Shape();
+  const auto* shape_1 = input_defs[1]->Shape();
+  if (shape_0 == nullptr || shape_1 == nullptr || shape_0->dim_size() != 4 || shape_1->dim_size() != 4) {
+    return;
+  }
+  for (int i = 0; i < 4; i++) {
+    const auto& dim_0 = shape_0->dim(i);
+    const auto& dim_1 = shape_1->dim(i);
+    if (!dim_0.has_dim_value() || !dim_1.has_dim_value() || dim_0.dim_value() != dim_1.dim_value()) {
+      return;
+    }
+  }
+
+  Node& nchwc_node = graph_.AddNode(graph_.GenerateNodeName(node.Name() + "_nchwc"),
+                                    "Add",
+                                    "NCHWc " + node.Name(),
+                                    std::vector<NodeArg*>{nchwc_input_0->nchwc_arg_, nchwc_input_1->nchwc_arg_},
+                                    std::vector<NodeArg*>{CreateNchwcArgument(node.OutputDefs()[0])});
+
+  ConvertNode(node, nchwc_node, nchwc_input_0->channels_);
+}
+
+void NchwcTransformerImpl::Transform(Node& node) {
+  if (utils::IsSupportedOptypeVersionAndDomain(node, "Conv", 1) ||
+      utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", 1, kMSDomain)) {
+    TransformConv(node);
+  } else if (utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", 1) ||
+             utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", 8)) {
+    TransformPool(node, "NchwcMaxPool", false);
+  } else if (utils::IsSupportedOptypeVersionAndDomain(node, "AveragePool", 1) ||
+             utils::IsSupportedOptypeVersionAndDomain(node, "AveragePool", 7)) {
+    TransformPool(node, "NchwcAveragePool", false);
+  } else if (utils::IsSupportedOptypeVersionAndDomain(node, "GlobalMaxPool", 1)) {
+    TransformPool(node, "NchwcGlobalMaxPool", true);
+  } else if (utils::IsSupportedOptypeVersionAndDomain(node, "GlobalAveragePool", 1)) {
+    TransformPool(node, "NchwcGlobalAveragePool", true);
+  } else if (utils::IsSupportedOptypeVersionAndDomain(node, "Relu", 6)) {
+    TransformRelu(node);
+  } else if (utils::IsSupportedOptypeVersionAndDomain(node, "Add", 7)) {
+    TransformAdd(node);
+  }
+}
+
+void NchwcTransformerImpl::Finalize(bool& modified) {
+  // Produce the original NCHW tensors that are still consumed by nodes that
+  // were not converted or that are graph outputs.
+  for (const auto* output_def : converted_outputs_) {
+    const auto& nchwc_output = nchwc_args_.at(output_def);
+    if (nchwc_output.remaining_original_uses_ > 0) {
+      Node& reorder_output = graph_.AddNode(graph_.GenerateNodeName("ReorderOutput"),
+                                            "ReorderOutput",
+                                            "Reorder " + output_def->Name() + " from NCHWc",
+                                            std::vector<NodeArg*>{nchwc_output.nchwc_arg_},
+                                            std::vector<NodeArg*>{graph_.GetNodeArg(output_def->Name())},
+                                            nullptr,
+                                            kMSDomain);
+      reorder_output.AddAttribute("channels", nchwc_output.channels_);
+    }
+  }
+
+  // Remove the consumers before the producers so that edges are only removed
+  // between nodes that still exist.
+  for (auto it = removed_nodes_.rbegin(); it != removed_nodes_.rend(); ++it) {
+    graph_.RemoveNode(*it);
+  }
+
+  if (!removed_nodes_.empty()) {
+    modified = true;
+  }
+}
+
+}  // namespace
+
+Status NchwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  NchwcTransformerImpl impl(graph);
+  GraphViewer graph_viewer(graph);
+
+  for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
+    auto& node = *graph.GetNode(index);
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level));
+
+    if (node.GetExecutionProviderType().empty() || node.GetExecutionProviderType() == kCpuExecutionProvider) {
+      impl.Transform(node);
+    }
+  }
+
+  impl.Finalize(modified);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class NchwcTransformer
+
+Transformer that converts chains of 2D Conv, MaxPool, AveragePool, GlobalMaxPool,
+GlobalAveragePool, Relu and Add nodes to operate on tensors in the blocked NCHWc
+format. Conv nodes with constant weights start a chain. Reorder nodes are only
+inserted where a tensor enters or leaves the chain.
+*/
+class NchwcTransformer : public onnxruntime::GraphTransformer {
+ public:
+  NchwcTransformer() noexcept : onnxruntime::GraphTransformer("NchwcTransformer", "Transforming to the NCHWc layout") {}
+
+ private:
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+};
+
+}  // namespace onnxruntime
@@ -12,6 +12,7 @@
 #include "core/providers/cpu/controlflow/loop.h"
 #include "core/providers/cpu/controlflow/utils.h"
 
+#include "core/framework/execution_frame.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
@@ -105,6 +106,9 @@ class LoopImpl {
   void CreateInitialFeeds(std::vector<MLValue>& feeds);
   void UpdateFeeds(const std::vector<MLValue>& last_outputs, std::vector<MLValue>& next_inputs);
 
+  // clear any entries in the fetches from two iterations ago that can't be written to by the next iteration
+  void ReleaseNonReusableFetches(std::vector<MLValue>& fetches, const std::vector<MLValue>& feeds) const;
+
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<MLValue>& per_iteration_output, int output_index);
 
@@ -321,12 +325,59 @@ Status LoopImpl::ConcatenateLoopOutput(std::vector<MLValue>& per_iteration_outpu
   return Status::OK();
 }
 
+void LoopImpl::ReleaseNonReusableFetches(std::vector<MLValue>& fetches, const std::vector<MLValue>& feeds) const {
+  if (fetches.empty())
+    return;
+
+  // the loop outputs are kept for ConcatenateLoopOutput so they can't be reused
+  for (size_t i = num_loop_carried_vars_ + 1, end = fetches.size(); i < end; ++i) {
+    fetches[i] = MLValue();
+  }
+
+  // a subgraph output may be a subgraph input passed through, or the same value may be both a loop carried
+  // variable and a loop output. writing to a buffer that is still referenced that way would corrupt it, so
+  // only keep tensors that don't share a buffer with the current feeds or the loop outputs of the last
+  // two iterations.
+  auto is_referenced = [&](const void* data) {
+    for (const auto& feed : feeds) {
+      if (feed.IsTensor() && feed.Get<Tensor>().DataRaw() == data)
+        return true;
+    }
+
+    for (const auto& per_iteration_outputs : loop_output_tensors_) {
+      auto num_recent = std::min<size_t>(2, per_iteration_outputs.size());
+      for (auto it = per_iteration_outputs.rbegin(), end = it + num_recent; it != end; ++it) {
+        if (it->IsTensor() && it->Get<Tensor>().DataRaw() == data)
+          return true;
+      }
+    }
+
+    return false;
+  };
+
+  for (int i = 0; i <= num_loop_carried_vars_; ++i) {
+    auto& fetch = fetches[i];
+    if (!fetch.IsTensor() || is_referenced(fetch.Get<Tensor>().DataRaw())) {
+      fetch = MLValue();
+    }
+  }
+}
+
 Status LoopImpl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* cached_ffm) {
   auto status = Status::OK();
 
   std::vector<MLValue> feeds;
   std::vector<MLValue> fetches;
 
+  // the fetches from the iteration before the last one. their cond and loop carried variables are no longer
+  // used as feeds, so they are provided as the fetches for the next iteration which writes to them directly if
+  // the shape is unchanged. this double buffers the loop carried variables instead of allocating them each time.
+  // the loop outputs still need to be concatenated at the end as the number of iterations isn't known upfront.
+  std::vector<MLValue> previous_fetches;
+
+  // the frame used to execute the subgraph is reused by all the iterations after the first one
+  std::unique_ptr<ExecutionFrame> frame;
+
   CreateInitialFeeds(feeds);
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
@@ -334,16 +385,17 @@ Status LoopImpl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* ca
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
       UpdateFeeds(fetches, feeds);
-      fetches.clear();
+
+      std::swap(fetches, previous_fetches);
+      ReleaseNonReusableFetches(fetches, feeds);
     }
 
     // loop carried variables can change shape across iterations, and we don't know how many iterations
     // there will be to allocate loop outputs upfront. due to that we can't use a custom fetch allocator
     // for any outputs
     if (cached_ffm) {
-      status = utils::ExecuteGraphWithCachedInfo(session_state_, *cached_ffm, feeds, fetches, {},
-                                                 /*sequential_execution*/ true, context_.GetTerminateFlag(),
-                                                 context_.Logger());
+      status = utils::ExecuteSubgraphWithCachedInfo(session_state_, *cached_ffm, feeds, fetches, {},
+                                                    context_.GetTerminateFlag(), context_.Logger(), frame);
     } else {
       status = utils::ExecuteGraph(session_state_, *ffm, feeds, fetches, {},
                                    /*sequential_execution*/ true, context_.GetTerminateFlag(), context_.Logger(),
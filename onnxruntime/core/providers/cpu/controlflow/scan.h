@@ -8,6 +8,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/feeds_fetches_manager.h"
+#include "core/providers/cpu/kernel_thread_pool.h"
 
 namespace onnxruntime {
 template <int OpSet>
@@ -25,5 +26,10 @@ class Scan final : public OpKernel {
   std::vector<int64_t> output_axes_;
 
   mutable std::unique_ptr<FeedsFetchesManager> cached_feeds_fetches_manager_;
+
+  // Used by opset 8 to execute independent batch entries concurrently, and by opset 9 to transpose
+  // the scan inputs and outputs. Shared by all the kernels of the execution provider, and only starts
+  // threads once some work is split across them.
+  KernelThreadPool* thread_pool_ = nullptr;
 };
 }  // namespace onnxruntime
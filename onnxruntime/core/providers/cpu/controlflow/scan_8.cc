@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 // there's no way to use a raw pointer as the copy destination with std::copy_n
 // (which gsl::copy uses with span::data() which returns a raw pointer) with the 14.11 toolset
 // without generating a 4996 warning. going through an iterator is way too much overhead so turn off the warning.
@@ -88,7 +90,8 @@ class Scan8Impl {
   Scan8Impl(OpKernelContextInternal& context,
             const SessionState& session_state,
             int64_t num_scan_inputs,
-            const std::vector<int64_t>& directions);
+            const std::vector<int64_t>& directions,
+            KernelThreadPool* thread_pool);
 
   // Initialize by validating all the inputs, and allocating the output tensors
   Status Initialize();
@@ -108,6 +111,18 @@ class Scan8Impl {
   Status AllocateOutputTensors();
   Status CreateLoopStateVariables(std::vector<std::vector<LoopStateVariable>>& loop_state_variables);
 
+  // iterate the sequence for a single batch entry
+  Status ExecuteBatchEntry(int64_t b,
+                           std::vector<LoopStateVariable>& loop_state_variables,
+                           std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+                           FeedsFetchesManager* ffm,
+                           const FeedsFetchesManager* cached_ffm);
+
+  // execute batch entries start_batch to batch_size_ - 1 concurrently. the outputs must have been allocated.
+  Status ExecuteRemainingBatchEntriesInParallel(int64_t start_batch,
+                                                std::vector<std::vector<LoopStateVariable>>& batch_loop_state_variables,
+                                                const FeedsFetchesManager& cached_ffm);
+
   using ConstTensorSlicerIterators = std::vector<MLValueTensorSlicer<const MLValue>::Iterator>;
   using MutableTensorSlicerIterators = std::vector<MLValueTensorSlicer<MLValue>::Iterator>;
 
@@ -130,6 +145,8 @@ class Scan8Impl {
   std::vector<std::unique_ptr<OutputIterator>> output_iterators_;
 
   std::unordered_map<std::string, const MLValue*> implicit_inputs_;
+
+  KernelThreadPool* thread_pool_;
 };
 
 template <>
@@ -145,6 +162,8 @@ Scan<8>::Scan(const OpKernelInfo& info) : OpKernel(info) {
   ORT_ENFORCE(info.GetAttr<int64_t>("num_scan_inputs", &num_scan_inputs_).IsOK());
 
   ReadDirections(info, "directions", input_directions_, num_scan_inputs_);
+
+  thread_pool_ = &GetKernelThreadPool(info);
 }
 
 template <>
@@ -153,11 +172,8 @@ Status Scan<8>::Compute(OpKernelContext* ctx) const {
   auto* session_state = ctx_internal->SubgraphSessionState("body");
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'body' attribute.");
 
-  // TODO:
-  //       Consider how usage of ExecutionFrame and SequentialExecutor can be optimized
-  //         - initial implementation is focused on making it work, rather than optimizing.
-
-  Scan8Impl scan_impl{*ctx_internal, *session_state, num_scan_inputs_, input_directions_};
+  Scan8Impl scan_impl{*ctx_internal, *session_state, num_scan_inputs_, input_directions_,
+                      thread_pool_};
 
   auto status = scan_impl.Initialize();
   ORT_RETURN_IF_ERROR(status);
@@ -171,12 +187,14 @@ Status Scan<8>::Compute(OpKernelContext* ctx) const {
 Scan8Impl::Scan8Impl(OpKernelContextInternal& context,
                      const SessionState& session_state,
                      int64_t num_scan_inputs,
-                     const std::vector<int64_t>& directions)
+                     const std::vector<int64_t>& directions,
+                     KernelThreadPool* thread_pool)
     : context_{context},
       session_state_{session_state},
       subgraph_{*session_state.GetGraphViewer()},
       directions_{directions},
-      implicit_inputs_{context_.GetImplicitInputs()} {
+      implicit_inputs_{context_.GetImplicitInputs()},
+      thread_pool_{thread_pool} {
   // optional first input so may be nullptr
   sequence_lens_tensor_ = context.Input<Tensor>(0);
 
@@ -386,6 +404,82 @@ Status Scan8Impl::CreateFeedsFetchesManager(std::unique_ptr<FeedsFetchesManager>
                                                  ffm);
 }
 
+Status Scan8Impl::ExecuteBatchEntry(int64_t b,
+                                    std::vector<LoopStateVariable>& loop_state_variables,
+                                    std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+                                    FeedsFetchesManager* ffm,
+                                    const FeedsFetchesManager* cached_ffm) {
+  auto sequence_len = sequence_lens_[b];
+
+  // Setup input MLValue streams
+  std::vector<MLValueTensorSlicer<const MLValue>::Iterator> scan_input_stream_iterators;
+  scan_input_stream_iterators.reserve(num_variadic_inputs_ - num_loop_state_variables_);
+
+  for (int i = num_loop_state_variables_, end = num_variadic_inputs_; i < end; ++i) {
+    const auto& mlvalue = GetSubgraphInputMLValue(context_, i);
+
+    // forward
+    if (directions_[i - num_loop_state_variables_] == static_cast<int64_t>(ScanDirection::kForward)) {
+      // the iterator is self contained, so we don't need to keep the MLValueTensorSlicer instance around
+      scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).begin());
+    } else {  // reverse
+      scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).rbegin());
+      // need to skip past the empty entries at the end of the input if sequence length is short
+      auto offset = max_sequence_len_ - sequence_len;
+      if (offset > 0) {
+        // reverse iterator so += moves backwards through the input
+        scan_input_stream_iterators.back() += offset;
+      }
+    }
+  }
+
+  // Call the subgraph for each item in the sequence
+  auto status = IterateSequence(context_, session_state_, loop_state_variables, scan_input_stream_iterators,
+                                sequence_len, num_loop_state_variables_, num_variadic_inputs_, num_variadic_outputs_,
+                                implicit_inputs_, output_iterators, ffm, cached_ffm);
+
+  // zero out any remaining values in the sequence
+  for (int64_t i = sequence_len; i < max_sequence_len_; ++i) {
+    for (int output = num_loop_state_variables_; output < num_variadic_outputs_; ++output) {
+      auto& iterator = *output_iterators[output];
+      iterator.ZeroOutCurrent();
+      ++iterator;
+    }
+  }
+
+  return status;
+}
+
+Status Scan8Impl::ExecuteRemainingBatchEntriesInParallel(
+    int64_t start_batch,
+    std::vector<std::vector<LoopStateVariable>>& batch_loop_state_variables,
+    const FeedsFetchesManager& cached_ffm) {
+  std::vector<Status> batch_status(batch_size_);
+
+  auto execute_batch_entries = [this, start_batch, &batch_loop_state_variables, &batch_status,
+                                &cached_ffm](int64_t begin, int64_t end) {
+    for (int64_t b = start_batch + begin; b < start_batch + end; ++b) {
+      // each batch entry writes to its own slices of the outputs
+      std::vector<std::unique_ptr<OutputIterator>> output_iterators(num_variadic_outputs_);
+      for (int output = num_loop_state_variables_; output < num_variadic_outputs_; ++output) {
+        output_iterators[output] = output_iterators_[output]->CreateBatchIterator(b);
+      }
+
+      batch_status[b] = ExecuteBatchEntry(b, batch_loop_state_variables[b], output_iterators, nullptr, &cached_ffm);
+    }
+  };
+
+  // every batch entry runs the whole subgraph so is worth a thread of its own. when this Scan is itself running
+  // on the pool, e.g. in the subgraph of another Scan or Loop, the entries run on the calling thread instead.
+  thread_pool_->ParallelFor(batch_size_ - start_batch, KernelThreadPool::kMinCostPerThread, execute_batch_entries);
+
+  for (const auto& status : batch_status) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
 Status Scan8Impl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* cached_ffm) {
   Status status = Status::OK();
 
@@ -394,50 +488,29 @@ Status Scan8Impl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* c
   status = CreateLoopStateVariables(batch_loop_state_variables);
   ORT_RETURN_IF_ERROR(status);
 
+  // the batch entries are independent, however the subgraph needs to be executed once on its own as that
+  // allocates any outputs with symbolic dimensions and creates the cached FeedsFetchesManager on the first run.
   for (int64_t b = 0; b < batch_size_; ++b) {
-    auto sequence_len = sequence_lens_[b];
-
-    // Setup input MLValue streams
-    std::vector<MLValueTensorSlicer<const MLValue>::Iterator> scan_input_stream_iterators;
-    scan_input_stream_iterators.reserve(num_variadic_inputs_ - num_loop_state_variables_);
-
-    for (int i = num_loop_state_variables_, end = num_variadic_inputs_; i < end; ++i) {
-      const auto& mlvalue = GetSubgraphInputMLValue(context_, i);
-
-      // forward
-      if (directions_[i - num_loop_state_variables_] == static_cast<int64_t>(ScanDirection::kForward)) {
-        // the iterator is self contained, so we don't need to keep the MLValueTensorSlicer instance around
-        scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).begin());
-      } else {  // reverse
-        scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).rbegin());
-        // need to skip past the empty entries at the end of the input if sequence length is short
-        auto offset = max_sequence_len_ - sequence_len;
-        if (offset > 0) {
-          // reverse iterator so += moves backwards through the input
-          scan_input_stream_iterators.back() += offset;
-        }
-      }
-    }
-
-    // Call the subgraph for each item in the sequence
-    status = IterateSequence(context_, session_state_, batch_loop_state_variables[b], scan_input_stream_iterators,
-                             sequence_len, num_loop_state_variables_, num_variadic_inputs_, num_variadic_outputs_,
-                             implicit_inputs_, output_iterators_, ffm, cached_ffm);
+    status = ExecuteBatchEntry(b, batch_loop_state_variables[b], output_iterators_, ffm, cached_ffm);
+    ORT_RETURN_IF_ERROR(status);
 
     // use the cached info from now on
-    cached_ffm = ffm;
+    cached_ffm = ffm ? ffm : cached_ffm;
     ffm = nullptr;
 
-    // zero out any remaining values in the sequence
-    for (int64_t i = sequence_len; i < max_sequence_len_; ++i) {
-      for (int output = num_loop_state_variables_; output < num_variadic_outputs_; ++output) {
-        auto& iterator = *output_iterators_[output];
-        iterator.ZeroOutCurrent();
-        ++iterator;
-      }
+    // once the subgraph has been executed the outputs are allocated, so the rest of the batch can run concurrently
+    auto num_remaining = batch_size_ - b - 1;
+    bool can_run_in_parallel = thread_pool_ && thread_pool_->NumThreads() > 1 &&
+                               num_remaining > 1 && sequence_lens_[b] > 0 &&
+                               std::all_of(output_iterators_.cbegin() + num_loop_state_variables_,
+                                           output_iterators_.cend(),
+                                           [](const std::unique_ptr<OutputIterator>& iterator) {
+                                             return iterator->FinalOutputAllocated();
+                                           });
+
+    if (can_run_in_parallel) {
+      return ExecuteRemainingBatchEntriesInParallel(b + 1, batch_loop_state_variables, *cached_ffm);
     }
-
-    ORT_RETURN_IF_ERROR(status);
   }
 
   return status;
@@ -105,7 +105,8 @@ class ScanImpl {
            const std::vector<int64_t>& input_directions,
            const std::vector<int64_t>& output_directions,
            const std::vector<int64_t>& input_axes,
-           const std::vector<int64_t>& output_axes);
+           const std::vector<int64_t>& output_axes,
+           KernelThreadPool* thread_pool);
 
   // Initialize by validating all the inputs, and allocating the output tensors
   Status Initialize();
@@ -158,6 +159,8 @@ class ScanImpl {
   std::vector<std::unique_ptr<OutputIterator>> output_iterators_;
 
   std::unordered_map<std::string, const MLValue*> implicit_inputs_;
+
+  KernelThreadPool* thread_pool_;
 };
 
 template <>
@@ -192,6 +195,8 @@ Scan<9>::Scan(const OpKernelInfo& info) : OpKernel(info) {
   } else {
     output_axes_ = std::vector<int64_t>(num_scan_outputs, 0);
   }
+
+  thread_pool_ = &GetKernelThreadPool(info);
 }
 
 template <>
@@ -201,7 +206,7 @@ Status Scan<9>::Compute(OpKernelContext* ctx) const {
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'body' attribute.");
 
   ScanImpl scan_impl{*ctx_internal, *session_state, num_scan_inputs_, input_directions_, output_directions_,
-                     input_axes_, output_axes_};
+                     input_axes_, output_axes_, thread_pool_};
 
   auto status = scan_impl.Initialize();
   ORT_RETURN_IF_ERROR(status);
@@ -218,7 +223,8 @@ ScanImpl::ScanImpl(OpKernelContextInternal& context,
                    const std::vector<int64_t>& input_directions,
                    const std::vector<int64_t>& output_directions,
                    const std::vector<int64_t>& input_axes,
-                   const std::vector<int64_t>& output_axes)
+                   const std::vector<int64_t>& output_axes,
+                   KernelThreadPool* thread_pool)
     : context_{context},
       session_state_{session_state},
       subgraph_{*session_state.GetGraphViewer()},
@@ -227,7 +233,8 @@ ScanImpl::ScanImpl(OpKernelContextInternal& context,
       output_directions_{output_directions},
       input_axes_from_attribute_{input_axes},
       output_axes_from_attribute_{output_axes},
-      implicit_inputs_{context_.GetImplicitInputs()} {
+      implicit_inputs_{context_.GetImplicitInputs()},
+      thread_pool_{thread_pool} {
   num_variadic_inputs_ = context_.NumVariadicInputs(0);
   num_variadic_outputs_ = context_.OutputCount();
   num_loop_state_variables_ = num_variadic_inputs_ - num_scan_inputs_;
@@ -356,7 +363,8 @@ Status ScanImpl::SetupInputs() {
 
       MLValue transpose_output = scan::detail::AllocateTensorInMLValue(input_tensor.DataType(), new_shape, alloc);
 
-      status = TransposeBase::DoTranspose(permutations, input_tensor, *transpose_output.GetMutable<Tensor>());
+      status = TransposeBase::DoTranspose(permutations, input_tensor, *transpose_output.GetMutable<Tensor>(),
+                                          thread_pool_);
       ORT_RETURN_IF_ERROR(status);
 
       inputs_.push_back(transpose_output);
@@ -488,7 +496,7 @@ Status ScanImpl::TransposeOutput() {
       Tensor* output = context_.Output(output_index, new_shape);
       ORT_ENFORCE(output, "Outputs from Scan are not optional and should never be null.");
 
-      status = TransposeBase::DoTranspose(permutations, temporary_output_tensor, *output);
+      status = TransposeBase::DoTranspose(permutations, temporary_output_tensor, *output, thread_pool_);
       ORT_RETURN_IF_ERROR(status);
     }
   }
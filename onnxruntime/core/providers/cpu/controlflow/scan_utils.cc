@@ -13,6 +13,7 @@
 
 #include "gsl/gsl_algorithm"
 
+#include "core/framework/execution_frame.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
@@ -153,6 +154,9 @@ Status IterateSequence(OpKernelContextInternal& context,
   std::vector<MLValue> fetches;
   std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
+  // the frame used to execute the subgraph is reused by all the iterations after the first one
+  std::unique_ptr<ExecutionFrame> frame;
+
   feeds.resize(num_inputs);
   fetches.resize(num_variadic_outputs);
 
@@ -209,9 +213,8 @@ Status IterateSequence(OpKernelContextInternal& context,
 
     // Create Executor and run graph.
     if (cached_ffm) {
-      status = utils::ExecuteGraphWithCachedInfo(session_state, *cached_ffm, feeds, fetches, fetch_allocators,
-                                                 /*sequential_execution*/ true, context.GetTerminateFlag(),
-                                                 context.Logger());
+      status = utils::ExecuteSubgraphWithCachedInfo(session_state, *cached_ffm, feeds, fetches, fetch_allocators,
+                                                    context.GetTerminateFlag(), context.Logger(), frame);
     } else {
       status = utils::ExecuteGraph(session_state, *ffm, feeds, fetches, fetch_allocators,
                                    /*sequential_execution*/ true, context.GetTerminateFlag(), context.Logger(),
@@ -488,6 +491,27 @@ Status OutputIterator::AllocateSubgraphOutput(const TensorShape& shape, MLValue&
   return Status::OK();
 }
 
+std::unique_ptr<OutputIterator> OutputIterator::CreateBatchIterator(int64_t batch) const {
+  ORT_ENFORCE(is_v8_ && !is_loop_state_var_, "Batch iterators are only supported for opset 8 Scan outputs.");
+  ORT_ENFORCE(is_concrete_shape_, "Final output must be allocated before a batch iterator can be created.");
+
+  std::unique_ptr<OutputIterator> iterator(new OutputIterator(*this));
+
+  // restrict the iterations to the sequence for this batch entry
+  auto sequence_len = final_shape_[1];
+  iterator->cur_iteration_ = batch * sequence_len;
+  iterator->num_iterations_ = (batch + 1) * sequence_len;
+
+  iterator->slicer_iterators_.clear();
+  iterator->slicer_iterators_.push_back(
+      (direction_ == ScanDirection::kForward)
+          ? MLValueTensorSlicer<MLValue>::Create(*final_output_mlvalue_, 1, batch).begin()
+          : MLValueTensorSlicer<MLValue>::Create(*final_output_mlvalue_, 1, batch).rbegin());
+  iterator->cur_slicer_iterator_ = iterator->slicer_iterators_.begin();
+
+  return iterator;
+}
+
 MLValue& OutputIterator::operator*() {
   ORT_ENFORCE(cur_iteration_ < num_iterations_);
   ORT_ENFORCE(is_concrete_shape_,
@@ -94,6 +94,10 @@ class OutputIterator {
 
   bool FinalOutputAllocated() const { return is_concrete_shape_; }
 
+  // create an iterator over the slices of an opset 8 Scan output for a single batch entry.
+  // the final output must have been allocated. used to process batch entries concurrently.
+  std::unique_ptr<OutputIterator> CreateBatchIterator(int64_t batch) const;
+
   // custom fetch allocator that can be used when the final shape is not concrete.
   // when the subgraph requests the allocation of the subgraph output, we forward the request to this instance,
   // allocate the overall output (taking into account the sequence length dimension),
@@ -6,15 +6,18 @@
 #include "core/framework/allocatormgr.h"
 #include "core/framework/execution_provider.h"
 #include "core/graph/constants.h"
+#include "core/providers/cpu/kernel_thread_pool.h"
 
 namespace onnxruntime {
 
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // Maximum number of threads a kernel splits its work across. 0 uses one thread per hardware thread.
+  int intra_op_num_threads{0};
 
-  explicit CPUExecutionProviderInfo(bool use_arena)
-      : create_arena(use_arena) {}
+  explicit CPUExecutionProviderInfo(bool use_arena, int num_threads = 0)
+      : create_arena(use_arena), intra_op_num_threads(num_threads) {}
 
   CPUExecutionProviderInfo() = default;
 };
@@ -26,7 +29,8 @@ using FuseRuleFn = std::function<void(const onnxruntime::GraphViewer&,
 class CPUExecutionProvider : public IExecutionProvider {
  public:
   explicit CPUExecutionProvider(const CPUExecutionProviderInfo& info)
-      : IExecutionProvider{onnxruntime::kCpuExecutionProvider} {
+      : IExecutionProvider{onnxruntime::kCpuExecutionProvider},
+        kernel_thread_pool_{std::make_unique<KernelThreadPool>(info.intra_op_num_threads)} {
     DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
                                                 [](int) { return std::make_unique<CPUAllocator>(); },
                                                 std::numeric_limits<size_t>::max()};
@@ -64,7 +68,11 @@ class CPUExecutionProvider : public IExecutionProvider {
 
   void InsertFusedRules(FuseRuleFn rule);
 
+  // Threads shared by all the kernels of this provider. Kernels get it from GetKernelThreadPool.
+  KernelThreadPool& GetKernelThreadPool() const { return *kernel_thread_pool_; }
+
  private:
   std::vector<FuseRuleFn> fuse_rules_;
+  std::unique_ptr<KernelThreadPool> kernel_thread_pool_;
 };
 }  // namespace onnxruntime
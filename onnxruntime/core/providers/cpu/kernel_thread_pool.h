@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+
+#ifdef USE_EIGEN_THREADPOOL
+#include <unsupported/Eigen/CXX11/ThreadPool>
+#else
+#include "core/common/task_thread_pool.h"
+#endif
+
+namespace onnxruntime {
+
+class OpKernelInfo;
+
+// Threads shared by the kernels of an execution provider to split large computations into ranges
+// that run concurrently. The threads are only created the first time there is enough work to split,
+// as most nodes in a model only process a few elements, e.g. from a shape.
+//
+// A ParallelFor called while running a range of another ParallelFor, e.g. by a kernel in a Scan
+// subgraph whose batch entries are run concurrently, runs all of its work on the calling thread.
+// Nested kernels therefore neither add threads nor wait on tasks queued behind their own.
+class KernelThreadPool {
+ public:
+#ifdef USE_EIGEN_THREADPOOL
+  using ThreadPool = Eigen::NonBlockingThreadPool;
+#else
+  using ThreadPool = TaskThreadPool;
+#endif
+
+  // Minimum cost of the work done by a thread, in bytes read or written.
+  static constexpr int64_t kMinCostPerThread = 64 * 1024;
+
+  // num_threads is the maximum number of threads working on a ParallelFor, including the calling
+  // thread. 0 uses one thread per hardware thread.
+  explicit KernelThreadPool(int num_threads = 0)
+      : num_threads_(num_threads > 0 ? num_threads
+                                     : std::max(static_cast<int>(std::thread::hardware_concurrency()), 1)) {}
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelThreadPool);
+
+  int NumThreads() const { return num_threads_; }
+
+  // Calls fn(begin, end) on ranges covering [0, total). The ranges are run concurrently if
+  // the total cost, given as the number of bytes read or written per item, is worth the cost of
+  // dispatching them.
+  template <typename TFunc>
+  void ParallelFor(int64_t total, int64_t cost_per_item, TFunc fn) {
+    int64_t num_ranges = std::min<int64_t>(total * cost_per_item / kMinCostPerThread, num_threads_);
+    num_ranges = std::min(num_ranges, total);
+
+    ThreadPool* pool = num_ranges > 1 && !InParallelFor() ? GetThreadPool() : nullptr;
+    if (pool == nullptr) {
+      fn(int64_t{0}, total);
+      return;
+    }
+
+    std::vector<std::future<void>> task_results;
+    task_results.reserve(static_cast<size_t>(num_ranges - 1));
+
+    const int64_t range_size = total / num_ranges;
+    const int64_t remainder = total % num_ranges;
+    auto range_begin = [range_size, remainder](int64_t range) {
+      return range * range_size + std::min(range, remainder);
+    };
+
+    // the calling thread does the first range
+    for (int64_t range = 1; range < num_ranges; ++range) {
+      std::packaged_task<void()> task{[&fn, begin = range_begin(range), end = range_begin(range + 1)]() {
+        ParallelForScope scope;
+        fn(begin, end);
+      }};
+      task_results.push_back(task.get_future());
+
+#ifdef USE_EIGEN_THREADPOOL
+      auto shared_task = std::make_shared<std::packaged_task<void()>>(std::move(task));
+      pool->Schedule([shared_task]() { (*shared_task)(); });
+#else
+      pool->RunTask(std::move(task));
+#endif
+    }
+
+    {
+      ParallelForScope scope;
+      fn(int64_t{0}, range_begin(1));
+    }
+
+    // wait for all the tasks to complete before propagating any exception as they reference local state
+    for (auto& future : task_results) {
+      future.wait();
+    }
+
+    for (auto& future : task_results) {
+      future.get();
+    }
+  }
+
+ private:
+  // Marks the current thread as running a range of a ParallelFor
+  class ParallelForScope {
+   public:
+    ParallelForScope() : was_in_parallel_for_(InParallelFor()) { InParallelFor() = true; }
+    ~ParallelForScope() { InParallelFor() = was_in_parallel_for_; }
+
+   private:
+    bool was_in_parallel_for_;
+  };
+
+  static bool& InParallelFor() {
+    static thread_local bool in_parallel_for = false;
+    return in_parallel_for;
+  }
+
+  ThreadPool* GetThreadPool() {
+    std::call_once(init_flag_, [this]() {
+      if (num_threads_ > 1) {
+        thread_pool_ = std::make_unique<ThreadPool>(num_threads_ - 1);
+      }
+    });
+    return thread_pool_.get();
+  }
+
+  const int num_threads_;
+  std::once_flag init_flag_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+};
+
+// Returns the pool shared by the kernels of the execution provider a kernel is created for.
+// Kernels of other execution providers share a pool with one thread per hardware thread.
+KernelThreadPool& GetKernelThreadPool(const OpKernelInfo& info);
+
+}  // namespace onnxruntime
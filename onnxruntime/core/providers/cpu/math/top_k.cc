@@ -21,16 +21,25 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
 #include "core/util/math_cpuonly.h"
-#include <queue>
+#include <algorithm>
+#include <mutex>
 using namespace std;
 namespace onnxruntime {
 // spec https://github.com/onnx/onnx/blob/master/docs/Operators.md#TopK
-ONNX_CPU_OPERATOR_KERNEL(
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
     TopK,
     1,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),
     TopK<float>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    TopK,
+    1,
+    double,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()).TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),
+    TopK<double>);
+
 static int64_t SizeToDim(size_t k, const vector<int64_t>& dims) {
   ORT_ENFORCE(k <= dims.size());
   int64_t r = 1;
@@ -49,38 +58,181 @@ static int64_t SizeFromDim(size_t k, const vector<int64_t>& dims) {
   return r;
 }
 
+// Orders (value, index) pairs so that the selected ones come first: the largest (or smallest)
+// values, and the lowest index among equal values.
 template <typename T>
 struct ValueCmp {
-  bool operator()(
-      const pair<T, int64_t>& lhs,
-      const pair<T, int64_t>& rhs) {
-    return (
-        lhs.first > rhs.first ||
-        (lhs.first == rhs.first && lhs.second < rhs.second));
+  bool largest;
+
+  bool operator()(const pair<T, int64_t>& lhs, const pair<T, int64_t>& rhs) const {
+    if (lhs.first != rhs.first) {
+      return largest ? lhs.first > rhs.first : lhs.first < rhs.first;
+    }
+    return lhs.second < rhs.second;
   }
 };
 
-template <>
-Status TopK<float>::Compute(OpKernelContext* p_op_kernel_context) const {
+// Number of elements checked against the selection threshold at once. The loop over a block
+// has no early exit so that the compiler can vectorize it.
+static constexpr int64_t kThresholdBlock = 16;
+
+// Selects the k first elements in the order of cmp among the n elements input[i * stride], and
+// appends them to selected in no particular order. index_offset is added to their indices.
+template <typename T>
+static void SelectTopK(const T* input, int64_t n, int64_t stride, int64_t index_offset, int64_t k,
+                       const ValueCmp<T>& cmp, vector<pair<T, int64_t>>& selected) {
+  k = std::min(k, n);
+  if (k == 0) return;
+  const auto first = selected.size();
+
+  if (n < 16 * k) {
+    // k is a large part of the slice, so a partial sort of all the elements is faster than a heap
+    vector<pair<T, int64_t>> elements(static_cast<size_t>(n));
+    for (int64_t i = 0; i < n; ++i) {
+      elements[i] = {input[i * stride], index_offset + i};
+    }
+    nth_element(elements.begin(), elements.begin() + (k - 1), elements.end(), cmp);
+    selected.insert(selected.end(), elements.begin(), elements.begin() + k);
+    return;
+  }
+
+  // Keep a heap of the k elements selected so far, with the last one in the order of cmp on top.
+  // The following elements are only compared with the value on top, the threshold, and most of
+  // them are rejected without touching the heap.
+  for (int64_t i = 0; i < k; ++i) {
+    selected.push_back({input[i * stride], index_offset + i});
+  }
+  auto heap_begin = selected.begin() + first;
+  make_heap(heap_begin, selected.end(), cmp);
+
+  // the elements are visited in the order of their indices, so one equal to the threshold is never selected
+  auto select = [&](int64_t i) {
+    const T value = input[i * stride];
+    if (cmp.largest ? value > selected[first].first : value < selected[first].first) {
+      pop_heap(heap_begin, selected.end(), cmp);
+      selected.back() = {value, index_offset + i};
+      push_heap(heap_begin, selected.end(), cmp);
+    }
+  };
+
+  int64_t i = k;
+  if (stride == 1) {
+    for (; i + kThresholdBlock <= n; i += kThresholdBlock) {
+      const T threshold = selected[first].first;
+      bool any = false;
+      for (int64_t j = 0; j < kThresholdBlock; ++j) {
+        any |= cmp.largest ? input[i + j] > threshold : input[i + j] < threshold;
+      }
+      if (any) {
+        for (int64_t j = 0; j < kThresholdBlock; ++j) {
+          select(i + j);
+        }
+      }
+    }
+  }
+  for (; i < n; ++i) {
+    select(i);
+  }
+}
+
+// Finds the top k of the n elements input[i * stride] and writes their values and indices with
+// output_stride, in the order of cmp if sorted is set.
+template <typename T>
+static void FindTopK(const T* input, int64_t n, int64_t stride, int64_t k, const ValueCmp<T>& cmp, bool sorted,
+                     T* values, int64_t* indices, int64_t output_stride) {
+  vector<pair<T, int64_t>> selected;
+  selected.reserve(static_cast<size_t>(k));
+  SelectTopK(input, n, stride, 0, k, cmp, selected);
+  if (sorted) {
+    sort(selected.begin(), selected.end(), cmp);
+  }
+  for (int64_t l = 0; l < k; ++l) {
+    values[l * output_stride] = selected[l].first;
+    indices[l * output_stride] = selected[l].second;
+  }
+}
+
+// Same as FindTopK for a single long slice. Each thread selects the top k of a part of the slice,
+// and the top k of those are selected at the end.
+template <typename T>
+static void FindTopKInParallel(KernelThreadPool& thread_pool, const T* input, int64_t n, int64_t stride, int64_t k,
+                               const ValueCmp<T>& cmp, bool sorted, T* values, int64_t* indices,
+                               int64_t output_stride) {
+  mutex candidates_mutex;
+  vector<pair<T, int64_t>> candidates;
+
+  thread_pool.ParallelFor(n, sizeof(T), [&](int64_t begin, int64_t end) {
+    vector<pair<T, int64_t>> selected;
+    selected.reserve(static_cast<size_t>(std::min(k, end - begin)));
+    SelectTopK(input + begin * stride, end - begin, stride, begin, k, cmp, selected);
+
+    lock_guard<mutex> lock(candidates_mutex);
+    candidates.insert(candidates.end(), selected.begin(), selected.end());
+  });
+
+  nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), cmp);
+  if (sorted) {
+    sort(candidates.begin(), candidates.begin() + k, cmp);
+  }
+  for (int64_t l = 0; l < k; ++l) {
+    values[l * output_stride] = candidates[l].first;
+    indices[l * output_stride] = candidates[l].second;
+  }
+}
+
+// Finds the top k along the given axis. The slices along the axis are split across threads, unless
+// there are too few of them to keep the threads busy, in which case each slice is split instead.
+template <typename T>
+static Status ComputeTopK(KernelThreadPool& thread_pool, const Tensor* X, int axis, int64_t k, bool largest,
+                          bool sorted, Tensor* Values, Tensor* Indices) {
+  const vector<int64_t>& in_dims = X->Shape().GetDims();
+  const int64_t rows = SizeToDim(axis, in_dims);
+  const int64_t cols = X->Shape().Size() / rows;
+  const int64_t axis_dim = in_dims[axis];
+
+  // This is basically the number of elements within each of the "k" rows
+  const int64_t block_slice = SizeFromDim(axis + 1, in_dims);
+  const int64_t num_slices = rows * block_slice;
+  const int64_t reduced_cols = k * block_slice;
+
+  const T* input = X->template Data<T>();
+  T* values = Values->template MutableData<T>();
+  int64_t* indices = Indices->template MutableData<int64_t>();
+  const ValueCmp<T> cmp{largest};
+
+  if (num_slices < static_cast<int64_t>(std::thread::hardware_concurrency())) {
+    for (int64_t slice = 0; slice < num_slices; ++slice) {
+      const int64_t i = slice / block_slice, j = slice % block_slice;
+      FindTopKInParallel(thread_pool, input + i * cols + j, axis_dim, block_slice, k, cmp, sorted,
+                         values + i * reduced_cols + j, indices + i * reduced_cols + j, block_slice);
+    }
+  } else {
+    thread_pool.ParallelFor(num_slices, axis_dim * static_cast<int64_t>(sizeof(T)), [&](int64_t begin, int64_t end) {
+      for (int64_t slice = begin; slice < end; ++slice) {
+        const int64_t i = slice / block_slice, j = slice % block_slice;
+        FindTopK(input + i * cols + j, axis_dim, block_slice, k, cmp, sorted,
+                 values + i * reduced_cols + j, indices + i * reduced_cols + j, block_slice);
+      }
+    });
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status TopK<T>::Compute(OpKernelContext* p_op_kernel_context) const {
   const Tensor* X = p_op_kernel_context->Input<Tensor>(0);
   if (X == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
   const vector<int64_t>& in_dims = X->Shape().GetDims();
   // Will return axis_ as is if positive or fixes it in case it is negative
-  auto axis_parsed = HandleNegativeAxis(axis_, in_dims.size());	
-  // Check to ensure k_ is within the bounds of what is available in that specific axis 	
+  auto axis_parsed = HandleNegativeAxis(axis_, in_dims.size());
+  // Check to ensure k_ is within the bounds of what is available in that specific axis
   if (in_dims.at(axis_parsed) < k_) {
     ostringstream err_msg;
     err_msg << "k argment [" << k_ << "] should not be greater than specified axis dim value [" << in_dims.at(axis_parsed) << "]";
     return Status(common::ONNXRUNTIME, common::FAIL, err_msg.str());
   }
 
-  const int64_t rows = SizeToDim(axis_parsed, in_dims);
-  const int64_t cols = X->Shape().Size() / rows;
-  auto input_map = ConstEigenMatrixMapRowMajor<float>(
-      static_cast<const float*>(X->template Data<float>()),
-      rows,
-      cols);
-
   // Resize output tensors to be the same shape as the input except
   // for the specified dimension ((i.e.) axis_parsed), which will be of size k_. E.x. for an input tensor
   // of shape [3, 4, 5] and k_=2 with axis_parsed=1, both of these will be shape [3, 2, 5]
@@ -89,47 +241,10 @@ Status TopK<float>::Compute(OpKernelContext* p_op_kernel_context) const {
   auto* Values = p_op_kernel_context->Output(0, output_linear_shape);
   auto* Indices = p_op_kernel_context->Output(1, output_linear_shape);
 
-  // Use Eigen maps to allow indexing into the 2d tensors like Values_map(i,j)
-  const int64_t reduced_cols = SizeFromDim(axis_parsed, output_linear_shape);
-  auto Values_map = EigenMatrixMapRowMajor<float>(
-      Values->template MutableData<float>(), rows, reduced_cols);
-  auto Indices_map = EigenMatrixMapRowMajor<int64_t>(
-      Indices->template MutableData<int64_t>(), rows, reduced_cols);
-
-  // This is basically the number of elements within each of the "k_" rows  
-  const int64_t block_slice = reduced_cols / k_;
-  // Sort preserving Indices
-  for (int64_t i = 0; i < rows; ++i) {
-	  for (int64_t j = 0; j < block_slice; ++j) {
-		// Build a min-heap, the heap element is pair of (value, idx)
-		// the top of the heap is the smallest value
-		priority_queue<
-			pair<float, int64_t>,
-			vector<pair<float, int64_t>>,
-			ValueCmp<float>>
-			min_heap;
-		// Maintain the size of heap to be less or equal to k_, so the
-		// heap will hold the k_ largest Values
-		for (int64_t k = 0; k < in_dims[axis_parsed]; ++k) {
-			const auto value = input_map(i, k * block_slice + j);
-			if (min_heap.size() < k_ || value > min_heap.top().first) {
-				min_heap.push({value, k});
-			}
-			if (min_heap.size() > k_) {
-				min_heap.pop();
-			}    
-		} 
-		// Extract these k_ elements and place them in the results placeholder
-		for (int64_t l = 0; l < k_; ++l) {
-			auto& pqElem = min_heap.top();
-			auto col_index = (k_ - l -1) * block_slice + j;  
-			Values_map(i, col_index) = pqElem.first;
-			Indices_map(i, col_index) = pqElem.second;
-			min_heap.pop();
-		}
-	  }
-  }
-
-  return Status::OK();
+  // opset 1 returns the largest values, sorted
+  return ComputeTopK<T>(thread_pool_, X, static_cast<int>(axis_parsed), k_, true, true, Values, Indices);
 }
+
+template class TopK<float>;
+template class TopK<double>;
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #include "core/common/exceptions.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
+#include "core/providers/cpu/kernel_thread_pool.h"
 #include "core/util/math_cpuonly.h"
 #include "gsl/gsl_util"
 
@@ -12,7 +13,8 @@ namespace onnxruntime {
 template <typename T>
 class TopK final : public OpKernel {
  public:
-  TopK(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info) {
+  TopK(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info),
+                                             thread_pool_(GetKernelThreadPool(op_kernel_info)) {
     int64_t k_temp;
     ORT_ENFORCE(op_kernel_info.GetAttr<int64_t>("k", &k_temp).IsOK());
     ORT_ENFORCE(k_temp > 0);
@@ -28,5 +30,8 @@ class TopK final : public OpKernel {
  private:
   int axis_;
   unsigned k_;
+
+  // Shared by all the kernels of the execution provider.
+  KernelThreadPool& thread_pool_;
 };
 }  // namespace onnxruntime
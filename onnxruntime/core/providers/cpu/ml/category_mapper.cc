@@ -33,35 +33,40 @@ Status CategoryMapper::Compute(OpKernelContext* context) const {
     if (Y.DataType() != DataTypeImpl::GetType<int64_t>())
       return Status(ONNXRUNTIME, FAIL, "Input of string must have output of int64");
 
-    auto input = gsl::make_span(X.template Data<std::string>(), shape.Size());
     auto output = gsl::make_span(Y.template MutableData<int64_t>(), shape.Size());
-    auto out = output.begin();
 
-    // map isn't going to change so get end() once instead of calling inside the for_each loop
+    // map isn't going to change so get end() once instead of calling inside the loop
     const auto map_end = string_to_int_map_.end();
 
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const std::string& value) {
-                    auto map_to = string_to_int_map_.find(value);
-                    *out = map_to == map_end ? default_int_ : map_to->second;
-                    ++out;
-                  });
+    // The input strings are read as views, so they are not copied out of an arena
+    for (int64_t i = 0; i < shape.Size(); ++i) {
+      auto map_to = string_to_int_map_.find(X.StringAt(i));
+      output[i] = map_to == map_end ? default_int_ : map_to->second;
+    }
   } else {
     if (Y.DataType() != DataTypeImpl::GetType<std::string>())
       return Status(ONNXRUNTIME, FAIL, "Input of int64 must have output of string ");
 
     auto input = gsl::make_span(X.template Data<int64_t>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<std::string>(), shape.Size());
-    auto out = output.begin();
 
     const auto map_end = int_to_string_map_.end();
 
+    std::vector<StringView> mapped;
+    mapped.reserve(input.size());
+    size_t mapped_bytes = 0;
     std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const int64_t& value) {
+                  [&mapped, &mapped_bytes, &map_end, this](const int64_t& value) {
                     auto map_to = int_to_string_map_.find(value);
-                    *out = map_to == map_end ? default_string_ : map_to->second;
-                    ++out;
+                    mapped.push_back(map_to == map_end ? StringView(default_string_) : map_to->second);
+                    mapped_bytes += mapped.back().size();
                   });
+
+    // The output strings are written to an arena, so there is no allocation per string
+    auto& output = Y.InitStringArena();
+    output.Reserve(mapped.size(), mapped_bytes);
+    for (const auto& s : mapped) {
+      output.Append(s);
+    }
   }
 
   return Status::OK();
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/string_view.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/ml/ml_common.h"
 
@@ -13,16 +14,15 @@ namespace ml {
 class CategoryMapper final : public OpKernel {
  public:
   CategoryMapper(const OpKernelInfo& info) : OpKernel(info) {
-    std::vector<std::string> string_categories;
     std::vector<int64_t> int_categories;
 
-    ORT_ENFORCE(info.GetAttrs<std::string>("cats_strings", string_categories).IsOK());
+    ORT_ENFORCE(info.GetAttrs<std::string>("cats_strings", strings_).IsOK());
     ORT_ENFORCE(info.GetAttrs<int64_t>("cats_int64s", int_categories).IsOK());
 
     ORT_ENFORCE(info.GetAttr<std::string>("default_string", &default_string_).IsOK());
     ORT_ENFORCE(info.GetAttr<int64_t>("default_int64", &default_int_).IsOK());
 
-    auto num_entries = string_categories.size();
+    auto num_entries = strings_.size();
 
     ORT_ENFORCE(num_entries == int_categories.size());
 
@@ -30,7 +30,7 @@ class CategoryMapper final : public OpKernel {
     int_to_string_map_.reserve(num_entries);
 
     for (size_t i = 0; i < num_entries; ++i) {
-      const std::string& str = string_categories[i];
+      const std::string& str = strings_[i];
       int64_t index = int_categories[i];
 
       string_to_int_map_[str] = index;
@@ -41,8 +41,11 @@ class CategoryMapper final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  // The maps hold views of these strings, so the input strings are looked up
+  // and the output strings are written without a copy per element
+  std::vector<std::string> strings_;
+  std::unordered_map<StringView, int64_t, StringViewHash> string_to_int_map_;
+  std::unordered_map<int64_t, StringView> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/string_view.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/ml/ml_common.h"
 
@@ -13,20 +14,18 @@ namespace ml {
 class LabelEncoder final : public OpKernel {
  public:
   LabelEncoder(const OpKernelInfo& info) : OpKernel(info) {
-    std::vector<std::string> string_classes;
-
-    ORT_ENFORCE(info.GetAttrs<std::string>("classes_strings", string_classes).IsOK());
+    ORT_ENFORCE(info.GetAttrs<std::string>("classes_strings", strings_).IsOK());
 
     ORT_ENFORCE(info.GetAttr<std::string>("default_string", &default_string_).IsOK());
     ORT_ENFORCE(info.GetAttr<int64_t>("default_int64", &default_int_).IsOK());
 
-    auto num_entries = string_classes.size();
+    auto num_entries = strings_.size();
 
     string_to_int_map_.reserve(num_entries);
     int_to_string_map_.reserve(num_entries);
 
     for (size_t i = 0; i < num_entries; ++i) {
-      const std::string& str = string_classes[i];
+      const std::string& str = strings_[i];
 
       string_to_int_map_[str] = i;
       int_to_string_map_[i] = str;
@@ -36,8 +35,11 @@ class LabelEncoder final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  // The maps hold views of these strings, so the input strings are looked up
+  // and the output strings are written without a copy per element
+  std::vector<std::string> strings_;
+  std::unordered_map<StringView, int64_t, StringViewHash> string_to_int_map_;
+  std::unordered_map<int64_t, StringView> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
@@ -11,7 +11,10 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
   const Tensor* W = context->Input<Tensor>(1);
-  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+  const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
+  // FusedConv accepts an optional tensor that is added to the convolution
+  // output before the activation, such as the shortcut of a residual block.
+  const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
   const int64_t M = W->Shape()[0];
@@ -40,6 +43,20 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   Tensor* Y = context->Output(0, TensorShape(Y_dims));
   TensorShape output_shape = Y->Shape().Slice(2);
 
+  // The convolution accumulates into the output, so seed it with the sum
+  // tensor unless the allocation planner already reused its buffer for Y.
+  float Beta = 0.0f;
+  if (Sum != nullptr) {
+    ORT_RETURN_IF_NOT(Sum->Shape() == Y->Shape(), "Sum input shape ", Sum->Shape(),
+                      " does not match the output shape ", Y->Shape());
+    const float* sum_data = Sum->template Data<float>();
+    float* output_data = Y->template MutableData<float>();
+    if (sum_data != output_data) {
+      std::copy_n(sum_data, Y->Shape().Size(), output_data);
+    }
+    Beta = 1.0f;
+  }
+
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
@@ -80,14 +97,36 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     output_shape.GetDims().data(),
                     static_cast<size_t>(M / group_),
                     &Activation,
+                    Beta,
                     &WorkingBufferSize);
 
     auto working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * WorkingBufferSize) : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
 
+    const float* filter_data = W->template Data<float>();
+    BufferUniquePtr filter_transform_buffer;
+
+    if (Parameters.Algorithm == MlasConvAlgorithmWinograd) {
+      const size_t filter_transform_size = sizeof(float) * Parameters.u.Winograd.FilterTransformSize;
+
+      if (filter_is_constant_) {
+        std::lock_guard<std::mutex> lock(filter_transform_mutex_);
+        if (filter_transform_ == nullptr) {
+          BufferUniquePtr filter_transform(alloc->Alloc(filter_transform_size), BufferDeleter(alloc));
+          MlasConvWinogradTransformFilter(&Parameters, filter_data, static_cast<float*>(filter_transform.get()));
+          filter_transform_ = std::move(filter_transform);
+        }
+        filter_data = static_cast<const float*>(filter_transform_.get());
+      } else {
+        filter_transform_buffer = BufferUniquePtr(alloc->Alloc(filter_transform_size), BufferDeleter(alloc));
+        MlasConvWinogradTransformFilter(&Parameters, filter_data, static_cast<float*>(filter_transform_buffer.get()));
+        filter_data = static_cast<const float*>(filter_transform_buffer.get());
+      }
+    }
+
     MlasConv(&Parameters,
              Xdata,
-             W->template Data<float>(),
+             filter_data,
              B != nullptr ? B->template Data<float>() : nullptr,
              static_cast<float*>(working_buffer.get()),
              Ydata);
@@ -134,7 +173,7 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
             1,
             W->template Data<float>() + group_id * W_offset,
             col_buffer_data,
-            0,
+            Beta,
             Ydata + group_id * Y_offset,
             &CPUMathUtil::Instance());
       }
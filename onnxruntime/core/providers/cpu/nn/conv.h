@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "core/providers/cpu/nn/conv_base.h"
 
 namespace onnxruntime {
@@ -25,9 +27,19 @@ template <typename T>
 class Conv : public OpKernel, public ConvBase {
  public:
   Conv(const OpKernelInfo& info) : OpKernel(info), ConvBase(info) {
+    const Tensor* W;
+    filter_is_constant_ = info.TryGetConstantInput(1, &W);
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Some MLAS convolution algorithms consume a transformed copy of the filter.
+  // When the filter is an initializer, the transform is computed on the first
+  // run and reused afterwards.
+  bool filter_is_constant_;
+  mutable std::mutex filter_transform_mutex_;
+  mutable BufferUniquePtr filter_transform_;
 };
 
 }  // namespace onnxruntime
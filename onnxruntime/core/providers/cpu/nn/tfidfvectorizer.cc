@@ -4,8 +4,10 @@
 #include "tfidfvectorizer.h"
 #include "onnx/defs/schema.h"
 #include "core/common/common.h"
+#include "core/common/string_view.h"
 #include "core/framework/tensor.h"
 
+#include <algorithm>
 #include <functional>
 #include <unordered_set>
 #include <ostream>
@@ -60,16 +62,15 @@ class NgramEntry<int64_t> : public NgramEntryBase {
   std::vector<int64_t> items_;
   size_t hash_ = 0;
 
-  void RunningHash(int64_t v) {
-    std::hash<int64_t> hf{};
-    hash_ ^= hf(v) + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
+  void RunningHash(size_t item_hash) {
+    hash_ ^= item_hash + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
   }
 
  public:
   template <typename ForwardIter>
   explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntryBase(id) {
     while (first != last) {
-      RunningHash(*first);
+      RunningHash(std::hash<int64_t>{}(*first));
       items_.push_back(*first);
       ++first;
     }
@@ -77,9 +78,10 @@ class NgramEntry<int64_t> : public NgramEntryBase {
   }
   // For sampling
   explicit NgramEntry() : NgramEntryBase(0) {}
-  void AddItem(int64_t v) {
+  // item_hash is the hash of v, computed once per input item
+  void AddItem(int64_t v, size_t item_hash) {
     items_.push_back(v);
-    RunningHash(v);
+    RunningHash(item_hash);
   }
   void DebugPrint() const {
     std::copy(items_.cbegin(), items_.cend(), std::ostream_iterator<int64_t>(std::cout, ","));
@@ -108,31 +110,34 @@ class NgramEntry<int32_t> : public NgramEntry<int64_t> {
 template <>
 class NgramEntry<std::string> : public NgramEntryBase {
  private:
-  std::vector<std::reference_wrapper<const std::string>> items_;
+  std::vector<StringView> items_;
   size_t hash_ = 0;
 
-  void RunningHash(const std::string& s) {
-    std::hash<std::string> hf{};
-    hash_ ^= hf(s) + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
+  void RunningHash(size_t item_hash) {
+    hash_ ^= item_hash + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
   }
 
  public:
   template <typename ForwardIter>
   explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntryBase(id) {
     while (first != last) {
-      RunningHash(*first);
-      items_.push_back(std::cref(*first));
+      const StringView item(*first);
+      RunningHash(StringViewHash{}(item));
+      items_.push_back(item);
       ++first;
     }
     assert(!items_.empty());
   }
   explicit NgramEntry() : NgramEntryBase(0) {}
-  void AddItem(const std::string& s) {
-    items_.push_back(std::cref(s));
-    RunningHash(s);
+  // item_hash is the hash of s, computed once per input item
+  void AddItem(const StringView& s, size_t item_hash) {
+    items_.push_back(s);
+    RunningHash(item_hash);
   }
   void DebugPrint() const {
-    std::copy(items_.cbegin(), items_.cend(), std::ostream_iterator<std::string>(std::cout, ","));
+    for (const auto& item : items_) {
+      std::cout.write(item.data(), item.size()) << ",";
+    }
     std::cout << std::endl;
   }
   void Clear() {
@@ -143,8 +148,7 @@ class NgramEntry<std::string> : public NgramEntryBase {
   bool operator==(const NgramEntry& o) const {
     if (items_.size() == o.items_.size()) {
       return std::equal(items_.cbegin(), items_.cend(),
-                        o.items_.cbegin(), o.items_.cend(),
-                        std::equal_to<std::string>());
+                        o.items_.cbegin(), o.items_.cend());
     }
     return false;
   }
@@ -154,10 +158,57 @@ class NgramEntry<std::string> : public NgramEntryBase {
 };
 
 using IntegerPoolSet = std::unordered_set<NgramEntry<int64_t>>;
-// Does not own strings, contains references to them. This helps
-// to search by string references that point to the current input.
+// Does not own strings, contains views of them. This helps
+// to search by string views that point to the current input.
 using StringPoolSet = std::unordered_set<NgramEntry<std::string>>;
 
+// Hashes an input item the way the pool n-grams hash their items.
+// 32 bit integers are compared with the 64 bit integers of the pool.
+template <typename T>
+inline size_t ItemHash(const T& v) {
+  return std::hash<T>{}(v);
+}
+
+template <>
+inline size_t ItemHash<int32_t>(const int32_t& v) {
+  return std::hash<int64_t>{}(v);
+}
+
+template <>
+inline size_t ItemHash<StringView>(const StringView& v) {
+  return StringViewHash{}(v);
+}
+
+// The input items as they are added to the n-grams. Strings are
+// read as views, which does not copy them out of the input tensor.
+template <typename T>
+class InputItems {
+ public:
+  using Item = T;
+  explicit InputItems(const Tensor& X) : data_(X.template Data<T>()) {}
+  const Item* Data() const { return data_; }
+
+ private:
+  const T* data_;
+};
+
+template <>
+class InputItems<std::string> {
+ public:
+  using Item = StringView;
+  explicit InputItems(const Tensor& X) {
+    const size_t total_items = X.Shape().Size();
+    views_.reserve(total_items);
+    for (size_t i = 0; i < total_items; ++i) {
+      views_.push_back(X.StringAt(i));
+    }
+  }
+  const Item* Data() const { return views_.data(); }
+
+ private:
+  std::vector<StringView> views_;
+};
+
 template <typename ForwardIter, typename Cont>
 inline void Emplace(ForwardIter first, size_t ngrams, size_t ngram_size, size_t& ngram_id, Cont& c) {
   for (; ngrams > 0; --ngrams) {
@@ -480,10 +531,18 @@ Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
   const auto max_gram_length = impl.max_gram_length_;
   const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
   auto start_ngram_size = impl.min_gram_length_;
-  auto const input_data = X->template Data<T>();
+  using Item = typename InputItems<T>::Item;
+  const InputItems<T> input_items(*X);
+  auto const input_data = input_items.Data();
   auto const end_data = input_data + total_items;
   NgramEntry<T> sample;
 
+  // An item is part of up to max_gram_length n-grams for every skip distance,
+  // so hash every item once. This matters for strings.
+  std::vector<size_t> item_hashes;
+  item_hashes.reserve(total_items);
+  std::transform(input_data, end_data, std::back_inserter(item_hashes), ItemHash<Item>);
+
   // Treat 1-grams in a special way
   if (start_ngram_size == 1) {
     size_t row_num = 0;
@@ -492,7 +551,7 @@ Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
       auto const ngram_row_end = ngram_start + C;
       while (ngram_start < ngram_row_end) {
         sample.Clear();
-        sample.AddItem(*ngram_start);
+        sample.AddItem(*ngram_start, item_hashes[ngram_start - input_data]);
         auto hit = impl.PoolFind<T>(sample);
         if (hit != set_end) {
           // record frequency
@@ -532,7 +591,7 @@ Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
              ngram_size <= max_gram_length &&
              ngram_item < ngram_row_end;
              ++ngram_size, ngram_item += skip_distance) {
-          sample.AddItem(*ngram_item);
+          sample.AddItem(*ngram_item, item_hashes[ngram_item - input_data]);
 
           // Do not test anything before start_ngram_size
           if (ngram_size >= start_ngram_size) {
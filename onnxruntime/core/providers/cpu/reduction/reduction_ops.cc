@@ -4,6 +4,12 @@
 #include "core/providers/cpu/reduction/reduction_ops.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <type_traits>
+
 using namespace std;
 namespace onnxruntime {
 
@@ -35,391 +41,475 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(ReduceSumSquare, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMax, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMin, 1);
 
-// When all reduce axises located at the tail of the dims, quite general cases, transpose and extra
-// copy could be skiped to improve performance, if required by check_no_transpose = true;
-// return value: true means transposedInputData is not created/copied, input tensor data could
-//               be direct use as row major matrix [block_size, blocks], where blocks is the
-//               size of each reduce.
-template <typename T>
-bool PrepareForReduce(OpKernelContext* ctx,
-                      std::vector<T>& transposedInputData,
-                      Tensor** reducedTensor,
-                      int64_t& block_size,
-                      int64_t& blocks,
-                      const std::vector<int64_t>& axes_,
-                      bool keepdims_,
-                      bool check_no_transpose = false) {
+// The reduction is done directly on the input data. The input shape is simplified to alternating groups of kept
+// and reduced axes by removing axes with a dimension of 1 and merging adjacent axes that are both kept or both
+// reduced. If the innermost group is reduced, each output is reduced from contiguous rows of the input. If the
+// innermost group is kept, contiguous rows of the input are accumulated into contiguous outputs. Both use
+// vectorized Eigen operations on the rows.
+struct ReducePlan {
+  // dims and strides of the kept and reduced groups, from outermost to innermost
+  std::vector<int64_t> kept_dims;
+  std::vector<int64_t> kept_strides;
+  std::vector<int64_t> reduced_dims;
+  std::vector<int64_t> reduced_strides;
+
+  // true if the innermost group is reduced, false if it is kept
+  bool inner_reduced = false;
+  int64_t inner_size = 1;
+
+  int64_t num_outputs = 1;
+  int64_t num_reduced = 1;
+};
+
+// Create the output tensor and the plan for reducing the input over the provided axes.
+static void PrepareForReduce(OpKernelContext* ctx,
+                             ReducePlan& plan,
+                             Tensor** reducedTensor,
+                             const std::vector<int64_t>& axes_,
+                             bool keepdims_) {
   const Tensor* input_tensor_ptr = ctx->Input<Tensor>(0);
   ORT_ENFORCE(input_tensor_ptr != nullptr);
   const Tensor& input = *input_tensor_ptr;
 
-  size_t ndim = input.Shape().GetDims().size();
-  std::vector<int64_t> axes;
+  const auto& in_dims = input.Shape().GetDims();
+  size_t ndim = in_dims.size();
+
+  vector<bool> keep_axis(ndim, axes_.empty() ? false : true);
   for (int64_t axis : axes_) {
-    axes.push_back(HandleNegativeAxis(axis, static_cast<int64_t>(ndim)));
+    keep_axis[HandleNegativeAxis(axis, static_cast<int64_t>(ndim))] = false;
   }
 
-  if (axes.empty()) {
-    // This is the default case for non-arg kind reductions. Reduce on all dimensions.
-    for (size_t i = 0; i < ndim; i++)
-      axes.push_back(i);
+  //set to-be-reduced axes to one. squeeze is keepdims_ is false
+  std::vector<int64_t> reduced_dims;
+  for (size_t i = 0; i < ndim; i++) {
+    if (keep_axis[i]) {
+      reduced_dims.push_back(in_dims[i]);
+    } else if (keepdims_) {
+      reduced_dims.push_back(1);
+    }
   }
 
-  std::sort(axes.begin(), axes.end());
+  *reducedTensor = ctx->Output(0, reduced_dims);
 
-  // If all reduced axes are located at the tail of the input shape, then copy could be skipped is required
-  bool need_copy = true;
-  if (axes.size() <= ndim && axes.front() == static_cast<int64_t>(ndim - axes.size()) 
-      && axes.back() == static_cast<int64_t>(ndim) - 1) {
-    need_copy = false;
-  }
+  // group the axes, from innermost to outermost
+  plan = ReducePlan{};
+  int64_t stride = 1;
+  int last_group = -1;  // 1 for kept, 0 for reduced
+  for (int64_t i = static_cast<int64_t>(ndim) - 1; i >= 0; --i) {
+    int64_t dim = in_dims[i];
+    if (dim != 1) {
+      int group = keep_axis[i] ? 1 : 0;
+      auto& dims = group ? plan.kept_dims : plan.reduced_dims;
+      auto& strides = group ? plan.kept_strides : plan.reduced_strides;
+
+      if (group == last_group) {
+        dims.back() *= dim;
+      } else {
+        dims.push_back(dim);
+        strides.push_back(stride);
+      }
 
-  vector<bool> keep_axis(ndim, true);
-  for (auto i : axes) {
-    keep_axis[i] = false;
-  }
+      if (last_group == -1) {
+        plan.inner_reduced = group == 0;
+      }
 
-  //transpose the input so that all to-be-reduced axes are at the head
-  vector<int64_t> transposed_axes(axes.begin(), axes.end());
-  for (int i = 0; i < ndim; ++i) {
-    if (keep_axis[i]) {
-      transposed_axes.push_back(i);
+      last_group = group;
+      stride *= dim;
     }
   }
 
-  vector<int64_t> new_dims_(transposed_axes.size());
-  for (int i = 0; i < transposed_axes.size(); ++i) {
-    new_dims_[i] = input.Shape().GetDims().at(transposed_axes[i]);
+  // nothing to reduce. treat it as a single kept element.
+  if (last_group == -1) {
+    plan.kept_dims.push_back(1);
+    plan.kept_strides.push_back(1);
   }
 
-  int num_axes = static_cast<int>(transposed_axes.size());
-  auto in_dims = input.Shape().GetDims();
-
-  // Measure amount of contiguous data we can copy at once
-  int64_t blocksize = 1;
-  int n_shared_idxs = 0;
-  for (int i = num_axes - 1; i >= 0; --i) {
-    if (transposed_axes[i] == i) {
-      blocksize *= new_dims_[i];
-      ++n_shared_idxs;
-    } else {
-      break;
+  std::reverse(plan.kept_dims.begin(), plan.kept_dims.end());
+  std::reverse(plan.kept_strides.begin(), plan.kept_strides.end());
+  std::reverse(plan.reduced_dims.begin(), plan.reduced_dims.end());
+  std::reverse(plan.reduced_strides.begin(), plan.reduced_strides.end());
+
+  plan.inner_size = plan.inner_reduced ? plan.reduced_dims.back() : plan.kept_dims.back();
+  plan.num_outputs = std::accumulate(plan.kept_dims.begin(), plan.kept_dims.end(), int64_t{1},
+                                     std::multiplies<int64_t>());
+  plan.num_reduced = std::accumulate(plan.reduced_dims.begin(), plan.reduced_dims.end(), int64_t{1},
+                                     std::multiplies<int64_t>());
+}
+
+// Call func with the input offset for each combination of indexes in the first num_axes of dims.
+template <typename TFunc>
+static void ForEachOffset(const std::vector<int64_t>& dims, const std::vector<int64_t>& strides, size_t num_axes,
+                          TFunc&& func) {
+  for (size_t axis = 0; axis < num_axes; ++axis) {
+    if (dims[axis] == 0) {
+      return;
     }
   }
 
-  const T* from_data = input.template Data<T>();
-  size_t count = input.Shape().Size();
+  std::vector<int64_t> index(num_axes, 0);
+  int64_t offset = 0;
 
-  //set to-be-reduced axes to one. squeeze is keepdims_ is false
-  int64_t first_dim = 1;
-  std::vector<int64_t> reduced_dims;
-  for (int i = 0; i < in_dims.size(); i++) {
-    if (keep_axis[i]) {
-      reduced_dims.push_back(in_dims[i]);
-    } else {
-      first_dim *= in_dims[i];
-      if (keepdims_) {
-        reduced_dims.push_back(1);
+  for (;;) {
+    func(offset);
+
+    int64_t axis = static_cast<int64_t>(num_axes) - 1;
+    for (; axis >= 0; --axis) {
+      offset += strides[axis];
+      if (++index[axis] < dims[axis]) {
+        break;
       }
-    }
-  }
 
-  *reducedTensor = ctx->Output(0, reduced_dims);
-  block_size = input.Shape().Size() / first_dim;
-  blocks = first_dim;
+      offset -= strides[axis] * dims[axis];
+      index[axis] = 0;
+    }
 
-  if (!need_copy && check_no_transpose) {
-    return true;
+    if (axis < 0) {
+      break;
+    }
   }
+}
 
-  transposedInputData.resize(input.Shape().Size(), 0);
-  T* to_data = &transposedInputData[0];
-  if (num_axes < 2 || n_shared_idxs == num_axes) {
-    memcpy(to_data, from_data, count * sizeof(T));
-    return false;
+// Get the input offset of the first value for the output at index, using the first num_axes of the kept axes.
+static int64_t KeptOffset(const ReducePlan& plan, size_t num_axes, int64_t index) {
+  int64_t offset = 0;
+  for (int64_t axis = static_cast<int64_t>(num_axes) - 1; axis >= 0; --axis) {
+    offset += (index % plan.kept_dims[axis]) * plan.kept_strides[axis];
+    index /= plan.kept_dims[axis];
   }
 
-  int itr_axes = num_axes - n_shared_idxs;
+  return offset;
+}
 
-  // Calculate strides
-  std::vector<int64_t> stride_x(itr_axes, 0);
-  for (size_t i = 0; i < itr_axes; i++) {
-    stride_x[i] = 1;
-    for (size_t j = transposed_axes[i] + 1; j < itr_axes; j++) {
-      stride_x[i] *= in_dims[j];
-    }
+// Reduce the input using the aggregator, which provides:
+//   Init(): the initial accumulator value
+//   Reduce(acc, values, n): reduce n contiguous values into the accumulator
+//   Update(accs, values, n): update each of n contiguous accumulators with the matching value
+//   Finalize(acc, count): the output value from the accumulator, given the number of values reduced
+template <typename T, typename TAggregator>
+static void DoReduce(const ReducePlan& plan, const T* input_data, T* output_data, const TAggregator& agg) {
+  const int64_t inner_size = plan.inner_size;
+
+  if (plan.num_outputs == 0) {
+    return;
   }
 
-  std::vector<int64_t> itr_idxs(itr_axes, 0);
-
-  // Branch here to avoid branching within the loop
-  if (blocksize > 1) {
-    for (size_t index = 0; index < (count / blocksize); index++) {
-      int64_t from_index = 0;
-      for (int i = 0; i < itr_axes; ++i) {
-        from_index += stride_x[i] * itr_idxs[i];
-      }
+  if (plan.num_reduced == 0) {
+    std::fill_n(output_data, plan.num_outputs, agg.Finalize(agg.Init(), 0));
+    return;
+  }
 
-      memcpy(
-          to_data + blocksize * index,
-          from_data + blocksize * from_index,
-          blocksize * sizeof(T));
+  if (plan.inner_reduced) {
+    const size_t num_outer_reduced_axes = plan.reduced_dims.size() - 1;
 
-      ++itr_idxs[itr_axes - 1];
-      for (int i = itr_axes - 1; i >= 1; --i) {
-        auto expected_dim = new_dims_[i];
-        if (itr_idxs[i] < expected_dim) {
-          break;
-        }
-        itr_idxs[i] %= expected_dim;
-        ++itr_idxs[i - 1];
-      }
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t i = 0; i < plan.num_outputs; ++i) {
+      const T* input = input_data + KeptOffset(plan, plan.kept_dims.size(), i);
+      T acc = agg.Init();
+      ForEachOffset(plan.reduced_dims, plan.reduced_strides, num_outer_reduced_axes,
+                    [&](int64_t offset) { agg.Reduce(acc, input + offset, inner_size); });
+      output_data[i] = agg.Finalize(acc, plan.num_reduced);
     }
   } else {
-    for (size_t index = 0; index < count; index++) {
-      int64_t from_index = 0;
-      for (int i = 0; i < itr_axes; ++i) {
-        from_index += stride_x[i] * itr_idxs[i];
-      }
+    // split the contiguous outputs into chunks so there is enough work to parallelize when there are
+    // only a small number of outer outputs
+    const int64_t chunk_size = 256;
+    const int64_t num_chunks = (inner_size + chunk_size - 1) / chunk_size;
+    const int64_t num_outer = plan.num_outputs / inner_size;
+    const size_t num_outer_kept_axes = plan.kept_dims.size() - 1;
 
-      *(to_data + index) = *(from_data + from_index);
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t work = 0; work < num_outer * num_chunks; ++work) {
+      const int64_t outer = work / num_chunks;
+      const int64_t start = (work % num_chunks) * chunk_size;
+      const int64_t count = std::min(chunk_size, inner_size - start);
 
-      ++itr_idxs[itr_axes - 1];
-      for (int i = itr_axes - 1; i >= 1; --i) {
-        auto expected_dim = new_dims_[i];
-        if (itr_idxs[i] < expected_dim) {
-          break;
-        }
-        itr_idxs[i] %= expected_dim;
-        ++itr_idxs[i - 1];
+      const T* input = input_data + KeptOffset(plan, num_outer_kept_axes, outer) + start;
+      T* output = output_data + outer * inner_size + start;
+
+      std::fill_n(output, count, agg.Init());
+      ForEachOffset(plan.reduced_dims, plan.reduced_strides, plan.reduced_dims.size(),
+                    [&](int64_t offset) { agg.Update(output, input + offset, count); });
+
+      for (int64_t j = 0; j < count; ++j) {
+        output[j] = agg.Finalize(output[j], plan.num_reduced);
       }
     }
   }
-  return false;
 }
 
 template <typename T>
-Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+struct ReduceAggregatorSum {
+  T Init() const { return 0; }
+  void Reduce(T& acc, const T* values, int64_t n) const { acc += ConstEigenVectorMap<T>(values, n).sum(); }
+  void Update(T* accs, const T* values, int64_t n) const {
+    EigenVectorMap<T>(accs, n) += ConstEigenVectorMap<T>(values, n);
+  }
+  T Finalize(T acc, int64_t) const { return acc; }
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorSumSquare {
+  T Init() const { return 0; }
+  void Reduce(T& acc, const T* values, int64_t n) const { acc += ConstEigenVectorMap<T>(values, n).squaredNorm(); }
+  void Update(T* accs, const T* values, int64_t n) const {
+    EigenVectorArrayMap<T>(accs, n) += ConstEigenVectorArrayMap<T>(values, n).square();
+  }
+  T Finalize(T acc, int64_t) const { return acc; }
+};
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).cwiseAbs().rowwise().sum();
+template <typename T>
+struct ReduceAggregatorL1 : ReduceAggregatorSum<T> {
+  void Reduce(T& acc, const T* values, int64_t n) const {
+    acc += ConstEigenVectorArrayMap<T>(values, n).abs().sum();
+  }
+  void Update(T* accs, const T* values, int64_t n) const {
+    EigenVectorArrayMap<T>(accs, n) += ConstEigenVectorArrayMap<T>(values, n).abs();
+  }
+};
 
-  return Status::OK();
-}
+template <typename T>
+struct ReduceAggregatorL2 : ReduceAggregatorSumSquare<T> {
+  T Finalize(T acc, int64_t) const { return static_cast<T>(std::sqrt(acc)); }
+};
 
 template <typename T>
-Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+struct ReduceAggregatorLogSum : ReduceAggregatorSum<T> {
+  T Finalize(T acc, int64_t) const { return static_cast<T>(std::log(acc)); }
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorMean : ReduceAggregatorSum<T> {
+  T Finalize(T acc, int64_t count) const {
+    // avoid an integer division by zero if a reduced axis is empty
+    return std::is_integral<T>::value && count == 0 ? acc : acc / static_cast<T>(count);
+  }
+};
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().norm();
+template <typename T>
+struct ReduceAggregatorProd {
+  T Init() const { return 1; }
+  void Reduce(T& acc, const T* values, int64_t n) const { acc *= ConstEigenVectorMap<T>(values, n).prod(); }
+  void Update(T* accs, const T* values, int64_t n) const {
+    EigenVectorArrayMap<T>(accs, n) *= ConstEigenVectorArrayMap<T>(values, n);
+  }
+  T Finalize(T acc, int64_t) const { return acc; }
+};
 
-  return Status::OK();
-}
+template <typename T>
+struct ReduceAggregatorMax {
+  T Init() const { return std::numeric_limits<T>::lowest(); }
+  void Reduce(T& acc, const T* values, int64_t n) const {
+    acc = std::max(acc, ConstEigenVectorMap<T>(values, n).maxCoeff());
+  }
+  void Update(T* accs, const T* values, int64_t n) const {
+    EigenVectorArrayMap<T>(accs, n) = EigenVectorArrayMap<T>(accs, n).max(ConstEigenVectorArrayMap<T>(values, n));
+  }
+  T Finalize(T acc, int64_t) const { return acc; }
+};
 
 template <typename T>
-Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+struct ReduceAggregatorMin {
+  T Init() const { return std::numeric_limits<T>::max(); }
+  void Reduce(T& acc, const T* values, int64_t n) const {
+    acc = std::min(acc, ConstEigenVectorMap<T>(values, n).minCoeff());
+  }
+  void Update(T* accs, const T* values, int64_t n) const {
+    EigenVectorArrayMap<T>(accs, n) = EigenVectorArrayMap<T>(accs, n).min(ConstEigenVectorArrayMap<T>(values, n));
+  }
+  T Finalize(T acc, int64_t) const { return acc; }
+};
+
+template <typename T, template <typename> class TAggregator>
+static Status ReduceWithAggregator(OpKernelContext* ctx, const std::vector<int64_t>& axes, bool keepdims) {
+  ReducePlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForReduce(ctx, plan, &reduced, axes, keepdims);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  for (int j = 0; j < block_size; ++j) {
-    *(output_data) = static_cast<T>(std::log(*(output_data)));
-    ++output_data;
-  }
+  DoReduce(plan, input_data, output_data, TAggregator<T>());
 
   return Status::OK();
 }
 
 template <typename T>
-Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
+  return ReduceWithAggregator<T, ReduceAggregatorL1>(ctx, axes_, keepdims_);
+}
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
+  return ReduceWithAggregator<T, ReduceAggregatorL2>(ctx, axes_, keepdims_);
+}
 
-  for (int j = 0; j < block_size; ++j) {
-    T max_value = std::numeric_limits<T>::lowest();
-    for (int i = 0; i < blocks; ++i) {
-      max_value = std::max(max_value, transposedInputData[i * block_size + j]);
-    }
-    T scaled_exp_sum = 0;
-    for (int i = 0; i < blocks; ++i) {
-      scaled_exp_sum += static_cast<T>(std::exp(transposedInputData[i * block_size + j] - max_value));
-    }
-    *(output_data++) = static_cast<T>(std::log(scaled_exp_sum) + max_value);
-  }
-  return Status::OK();
+template <typename T>
+Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
+  return ReduceWithAggregator<T, ReduceAggregatorLogSum>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
-Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
+  ReducePlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().maxCoeff();
-
-  return Status::OK();
-}
+  if (plan.num_outputs == 0) {
+    return Status::OK();
+  }
 
-template <typename T>
-Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+  // find the maximum for each output first so the exponents can be scaled by it
+  std::vector<T> max_values(plan.num_outputs);
+  DoReduce(plan, input_data, max_values.data(), ReduceAggregatorMax<T>());
 
-  T* output_data = reduced->template MutableData<T>();
+  if (plan.inner_reduced) {
+    const int64_t inner_size = plan.inner_size;
+    const size_t num_outer_reduced_axes = plan.reduced_dims.size() - 1;
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t i = 0; i < plan.num_outputs; ++i) {
+      const T* input = input_data + KeptOffset(plan, plan.kept_dims.size(), i);
+      const T max_value = max_values[i];
+      T scaled_exp_sum = 0;
+      ForEachOffset(plan.reduced_dims, plan.reduced_strides, num_outer_reduced_axes, [&](int64_t offset) {
+        scaled_exp_sum += (ConstEigenVectorArrayMap<T>(input + offset, inner_size) - max_value).exp().sum();
+      });
+      output_data[i] = static_cast<T>(std::log(scaled_exp_sum) + max_value);
+    }
+  } else {
+    const int64_t inner_size = plan.inner_size;
+    const int64_t num_outer = plan.num_outputs / inner_size;
+    const size_t num_outer_kept_axes = plan.kept_dims.size() - 1;
 
 #ifdef USE_OPENMP
 #pragma omp parallel for
 #endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).mean();
+    for (int64_t outer = 0; outer < num_outer; ++outer) {
+      const T* input = input_data + KeptOffset(plan, num_outer_kept_axes, outer);
+      T* output = output_data + outer * inner_size;
+      ConstEigenVectorArrayMap<T> max_value(max_values.data() + outer * inner_size, inner_size);
+
+      EigenVectorArrayMap<T> scaled_exp_sum(output, inner_size);
+      scaled_exp_sum.setZero();
+      ForEachOffset(plan.reduced_dims, plan.reduced_strides, plan.reduced_dims.size(), [&](int64_t offset) {
+        scaled_exp_sum += (ConstEigenVectorArrayMap<T>(input + offset, inner_size) - max_value).exp();
+      });
+
+      for (int64_t j = 0; j < inner_size; ++j) {
+        output[j] = static_cast<T>(std::log(output[j]) + max_value[j]);
+      }
     }
   }
-  else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().mean();
-  }
 
   return Status::OK();
 }
 
 template <typename T>
-Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
+Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
+  return ReduceWithAggregator<T, ReduceAggregatorMax>(ctx, axes_, keepdims_);
+}
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().minCoeff();
+template <typename T>
+Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
+  return ReduceWithAggregator<T, ReduceAggregatorMean>(ctx, axes_, keepdims_);
+}
 
-  return Status::OK();
+template <typename T>
+Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
+  return ReduceWithAggregator<T, ReduceAggregatorMin>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().prod();
-
-  return Status::OK();
+  return ReduceWithAggregator<T, ReduceAggregatorProd>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  return ReduceWithAggregator<T, ReduceAggregatorSum>(ctx, axes_, keepdims_);
+}
+
+template <typename T>
+Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
+  return ReduceWithAggregator<T, ReduceAggregatorSumSquare>(ctx, axes_, keepdims_);
+}
+
+// ArgMax/ArgMin reduce a single axis so the plan has at most one reduced group.
+// The index of the best value seen so far is stored in the output, and the value is read back from the input.
+template <typename T, typename TCompare>
+static Status ArgReduce(OpKernelContext* ctx, const std::vector<int64_t>& axes, bool keepdims, TCompare is_better) {
+  ReducePlan plan;
   Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+  PrepareForReduce(ctx, plan, &reduced, axes, keepdims);
 
-  T* output_data = reduced->template MutableData<T>();
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+  int64_t* output_data = reduced->template MutableData<int64_t>();
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+  const int64_t num_reduced = plan.num_reduced;
+  const int64_t reduced_stride = plan.reduced_strides.empty() ? 0 : plan.reduced_strides.front();
 
+  if (plan.num_outputs == 0) {
+    return Status::OK();
+  }
+
+  if (plan.inner_reduced) {
 #ifdef USE_OPENMP
 #pragma omp parallel for
 #endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
+    for (int64_t i = 0; i < plan.num_outputs; ++i) {
+      const T* input = input_data + KeptOffset(plan, plan.kept_dims.size(), i);
+      int64_t best = 0;
+      for (int64_t r = 1; r < num_reduced; ++r) {
+        if (is_better(input[r], input[best])) {
+          best = r;
+        }
+      }
+      output_data[i] = best;
     }
-  }
-  else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  }
-
-  return Status::OK();
-}
-
-template <typename T>
-Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
+  } else {
+    const int64_t inner_size = plan.inner_size;
+    const int64_t num_outer = plan.num_outputs / inner_size;
+    const size_t num_outer_kept_axes = plan.kept_dims.size() - 1;
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().squaredNorm();
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t outer = 0; outer < num_outer; ++outer) {
+      const T* input = input_data + KeptOffset(plan, num_outer_kept_axes, outer);
+      int64_t* output = output_data + outer * inner_size;
+
+      std::fill_n(output, inner_size, int64_t{0});
+      for (int64_t r = 1; r < num_reduced; ++r) {
+        const T* values = input + r * reduced_stride;
+        for (int64_t j = 0; j < inner_size; ++j) {
+          if (is_better(values[j], input[output[j] * reduced_stride + j])) {
+            output[j] = r;
+          }
+        }
+      }
+    }
+  }
 
   return Status::OK();
 }
 
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  int64_t* output_data = reduced->template MutableData<int64_t>();
-
-  Eigen::MatrixXf::Index maxIndex;
-  auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
-  for (int i = 0; i < block_size; ++i) {
-    matrixData.row(i).maxCoeff(&maxIndex);
-    *(output_data++) = maxIndex;
-  }
-
-  return Status::OK();
+  return ArgReduce<T>(ctx, axes_, keepdims_, [](const T& a, const T& b) { return a > b; });
 }
 
 template <typename T>
 Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  int64_t* output_data = reduced->template MutableData<int64_t>();
-
-  Eigen::MatrixXf::Index minIndex;
-  auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
-  for (int i = 0; i < block_size; ++i) {
-    matrixData.row(i).minCoeff(&minIndex);
-    *(output_data++) = minIndex;
-  }
-
-  return Status::OK();
+  return ArgReduce<T>(ctx, axes_, keepdims_, [](const T& a, const T& b) { return a < b; });
 }
 
 }  // namespace onnxruntime
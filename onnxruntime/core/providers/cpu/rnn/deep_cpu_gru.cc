@@ -186,8 +186,9 @@ class UniDirectionalGru {
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
                const int num_directions,
-               const gsl::span<const T>& input_weights,
-               const gsl::span<const T>& recurrent_weights,
+               const GemmWeights<T>& input_weights,
+               const GemmWeights<T>& recurrent_weightsZR,
+               const GemmWeights<T>& recurrent_weightsH,
                gsl::span<T>& outputs,
                gsl::span<T>& final_hidden_state);
 
@@ -330,8 +331,17 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   const size_t recurrent_weights_size_per_direction = 3 * hidden_size_ * hidden_size_;
   const size_t bias_size_per_direction = 6 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, recurrent_weights_size_per_direction);
+  // the z and r recurrent weights are used in a separate GEMM from the h weights, so split them up front
+  const size_t recurrent_weightsZR_size_per_direction = 2 * hidden_size_ * hidden_size_;
+  const size_t recurrent_weightsH_size_per_direction = hidden_size_ * hidden_size_;
+
+  GemmWeights<T> input_weights_1 =
+      MakeGemmWeights(packed_W_, 0, input_weights.subspan(0, input_weights_size_per_direction));
+  GemmWeights<T> recurrent_weightsZR_1 =
+      MakeGemmWeights(packed_Rzr_, 0, recurrent_weights.subspan(0, recurrent_weightsZR_size_per_direction));
+  GemmWeights<T> recurrent_weightsH_1 =
+      MakeGemmWeights(packed_Rh_, 0, recurrent_weights.subspan(recurrent_weightsZR_size_per_direction,
+                                                               recurrent_weightsH_size_per_direction));
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
 
   gsl::span<const T> input = X.DataAsSpan<T>();
@@ -366,10 +376,16 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> recurrent_weights_2 = recurrent_weights.subspan(recurrent_weights_size_per_direction,
-                                                                       recurrent_weights_size_per_direction);
+    GemmWeights<T> input_weights_2 =
+        MakeGemmWeights(packed_W_, 1, input_weights.subspan(input_weights_size_per_direction,
+                                                            input_weights_size_per_direction));
+    GemmWeights<T> recurrent_weightsZR_2 =
+        MakeGemmWeights(packed_Rzr_, 1, recurrent_weights.subspan(recurrent_weights_size_per_direction,
+                                                                  recurrent_weightsZR_size_per_direction));
+    GemmWeights<T> recurrent_weightsH_2 =
+        MakeGemmWeights(packed_Rh_, 1, recurrent_weights.subspan(recurrent_weights_size_per_direction +
+                                                                     recurrent_weightsZR_size_per_direction,
+                                                                 recurrent_weightsH_size_per_direction));
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
 
     gsl::span<const T> initial_hidden_2 = initial_hidden.empty()
@@ -398,7 +414,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
               activation_funcs_.Entries()[0],
               activation_funcs_.Entries()[1],
               clip_, ttp_);
-          fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+          fw->Compute(input, sequence_lens_span, num_directions_,
+                      input_weights_1, recurrent_weightsZR_1, recurrent_weightsH_1, output_1, hidden_output_1);
 
 #if defined(USE_MLAS) && !defined(USE_OPENMP)
 #ifndef USE_EIGEN_THREADPOOL
@@ -428,7 +445,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
       activation_funcs_.Entries()[2],
       activation_funcs_.Entries()[3],
       clip_, ttp_);
-  bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2, output_2, hidden_output_2);
+  bw->Compute(input, sequence_lens_span, num_directions_,
+              input_weights_2, recurrent_weightsZR_2, recurrent_weightsH_2, output_2, hidden_output_2);
 
 #if defined(USE_MLAS) && !defined(USE_OPENMP)
 #ifdef USE_EIGEN_THREADPOOL
@@ -448,7 +466,8 @@ else {
       activation_funcs_.Entries()[1],
       clip_, ttp_);
 
-  gru_p->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+  gru_p->Compute(input, sequence_lens_span, num_directions_,
+                 input_weights_1, recurrent_weightsZR_1, recurrent_weightsH_1, output_1, hidden_output_1);
 }
 
 if (!output.empty())
@@ -556,8 +575,9 @@ template <typename T>
 void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                                    const gsl::span<const int>& sequence_lengths_arg,
                                    const int num_directions,
-                                   const gsl::span<const T>& input_weights,
-                                   const gsl::span<const T>& recurrent_weights,
+                                   const GemmWeights<T>& input_weights,
+                                   const GemmWeights<T>& recurrent_weightsZR,
+                                   const GemmWeights<T>& recurrent_weightsH,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state) {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
@@ -574,11 +594,12 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   }
 
   DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
-  DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
-  DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
-
-  gsl::span<const T> recurrent_weightsZR = recurrent_weights.subspan(0, 2 * hidden_size_ * hidden_size_);
-  gsl::span<const T> recurrent_weightsH = recurrent_weights.subspan(2 * hidden_size_ * hidden_size_, hidden_size_ * hidden_size_);
+  if (input_weights.packed == nullptr)
+    DumpMatrix("input_weights", input_weights.weights.data(), 3 * hidden_size_, input_size_);
+  if (recurrent_weightsZR.packed == nullptr)
+    DumpMatrix("recurrent_weightsZR", recurrent_weightsZR.weights.data(), 2 * hidden_size_, hidden_size_);
+  if (recurrent_weightsH.packed == nullptr)
+    DumpMatrix("recurrent_weightsH", recurrent_weightsH.weights.data(), hidden_size_, hidden_size_);
 
   gsl::span<T> original_outputs = outputs;
   const bool output_sequence = !outputs.empty();
@@ -610,7 +631,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
               inputs.cbegin(), inputs.cend(),
               input_size_,
-              input_weights.cbegin(), input_weights.cend(),
+              input_weights,
               input_size_, beta,
               outputZRH_.begin(), outputZRH_.end(),
               hidden_size_x3);
@@ -678,7 +699,9 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       }
 
       for (int step = 0; step < max_sequence_length; step++) {
+#if defined(DUMP_MATRIXES)
         const std::string row_str = " [row=" + std::to_string(row) + ",seqno=" + std::to_string(step) + "]";
+#endif
 
         DumpMatrix("Ht-1" + row_str, &*prev_Ht, local_fused_hidden_rows, hidden_size_);
 
@@ -688,7 +711,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         ComputeGemm(local_fused_hidden_rows, hidden_size_x2, hidden_size_, alpha,
                     prev_Ht, prev_Ht_end,
                     hidden_size_,
-                    recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
+                    recurrent_weightsZR,
                     hidden_size_, beta,
                     outputZRH_.begin() + out_added_offset, outputZRH_.end(),
                     hidden_size_x3);
@@ -705,7 +728,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
           ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
                       prev_Ht, prev_Ht_end,  // Ht-1
                       hidden_size_,
-                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                      recurrent_weightsH,  // Rh^T
                       hidden_size_, beta,
                       linear_output_local, linear_output_.end(),  // pre: Rbh, post:output
                       hidden_size_);
@@ -745,7 +768,9 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
           }
         }
 
+#if defined(DUMP_MATRIXES)
         std::string label = linear_before_reset_ ? "rt (.) (Ht-1 * (Rh^T) + Rbh)" : "rt (.) Ht-1";
+#endif
         DumpMatrix(label + row_str, &*cur_h_local, local_fused_hidden_rows, hidden_size_);
 
         if (linear_before_reset_) {
@@ -764,11 +789,13 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
             }
           }
         } else {
+#if defined(DUMP_MATRIXES)
           label += " * Rh^T";
+#endif
           ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
                       cur_h_local, cur_h_local_end,
                       hidden_size_,
-                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),
+                      recurrent_weightsH,
                       hidden_size_, beta,
                       outputZRH_.begin() + out_added_offset + hidden_size_x2, outputZRH_.end(),
                       hidden_size_x3);
@@ -883,7 +910,9 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
     // for each item in sequence run all calculations
     for (int step = 0; step < max_sequence_length; step++) {
+#if defined(DUMP_MATRIXES)
       const std::string seqno_str = " [seqno=" + std::to_string(step) + "]";
+#endif
 
       DumpMatrix("Ht-1" + seqno_str, &*prev_Ht, batch_size_, hidden_size_);
 
@@ -894,7 +923,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
                   prev_Ht, prev_Ht_end,
                   hidden_size_,
-                  recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
+                  recurrent_weightsZR,
                   hidden_size_, beta,
                   outputZRH_.begin() + out_added_offset, outputZRH_.end(),
                   hidden_size_x3);
@@ -910,7 +939,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
                     prev_Ht, prev_Ht_end,  // Ht-1
                     hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                    recurrent_weightsH,  // Rh^T
                     hidden_size_, beta,
                     linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
                     hidden_size_);
@@ -949,7 +978,9 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         }
       }
 
+#if defined(DUMP_MATRIXES)
       std::string label = linear_before_reset_ ? "rt (.) (Ht-1 * (Rh^T) + Rbh)" : "rt (.) Ht-1";
+#endif
       DumpMatrix(label + seqno_str, &*cur_h_local, batch_size_, hidden_size_);
 
       if (linear_before_reset_) {
@@ -968,7 +999,9 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
           }
         }
       } else {
+#if defined(DUMP_MATRIXES)
         label += " * Rh^T";
+#endif
 
         // out_H currently contains Xt*(Wh^T).
         auto out_H = outputZRH_.begin() + out_added_offset + hidden_size_x2;
@@ -977,7 +1010,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
                     cur_h_local, cur_h_local_end,  // rt (.) Ht-1
                     hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                    recurrent_weightsH,  // Rh^T
                     hidden_size_, beta,
                     out_H, outputZRH_.end(),
                     hidden_size_x3);
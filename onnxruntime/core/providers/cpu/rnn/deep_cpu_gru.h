@@ -50,6 +50,18 @@ class DeepCpuGruOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
+
+    // pack constant weights once here instead of in every GEMM that uses them. the recurrent weights for
+    // the z and r gates are used separately from those for the h gate so are packed separately.
+    AllocatorPtr alloc = info.GetAllocator(0, OrtMemTypeDefault);
+    const Tensor* weights;
+    if (info.TryGetConstantInput(1, &weights))
+      rnn::detail::PackWeights(alloc, *weights, num_directions_, 3 * hidden_size_, 0, 3 * hidden_size_, packed_W_);
+    if (info.TryGetConstantInput(2, &weights)) {
+      rnn::detail::PackWeights(alloc, *weights, num_directions_, 3 * hidden_size_, 0, 2 * hidden_size_, packed_Rzr_);
+      rnn::detail::PackWeights(alloc, *weights, num_directions_, 3 * hidden_size_, 2 * hidden_size_, hidden_size_,
+                               packed_Rh_);
+    }
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -66,6 +78,11 @@ class DeepCpuGruOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W and R packed by MlasSgemmPackB if they are constant
+  rnn::detail::PackedWeights packed_W_;
+  rnn::detail::PackedWeights packed_Rzr_;
+  rnn::detail::PackedWeights packed_Rh_;
+
   // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
   // across them. mutable due to this.
   // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
@@ -52,6 +52,14 @@ class DeepCpuLstmOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
+
+    // pack constant weights once here instead of in every GEMM that uses them
+    AllocatorPtr alloc = info.GetAllocator(0, OrtMemTypeDefault);
+    const Tensor* weights;
+    if (info.TryGetConstantInput(1, &weights))
+      rnn::detail::PackWeights(alloc, *weights, num_directions_, 4 * hidden_size_, 0, 4 * hidden_size_, packed_W_);
+    if (info.TryGetConstantInput(2, &weights))
+      rnn::detail::PackWeights(alloc, *weights, num_directions_, 4 * hidden_size_, 0, 4 * hidden_size_, packed_R_);
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -81,6 +89,10 @@ class DeepCpuLstmOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W and R packed by MlasSgemmPackB if they are constant
+  rnn::detail::PackedWeights packed_W_;
+  rnn::detail::PackedWeights packed_R_;
+
   // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
   // across them. mutable due to this.
   // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
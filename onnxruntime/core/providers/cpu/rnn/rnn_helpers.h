@@ -19,6 +19,8 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -180,6 +182,74 @@ void ComputeGemm(const int M,
       &*C, ldc, &CPUMathUtil::Instance());
 }
 
+/// Weights for all directions of a W or R input, packed once with MlasSgemmPackB when the kernel is
+/// created so that ComputeGemm does not transpose and pack them again on every call.
+struct PackedWeights {
+  BufferUniquePtr buffer;
+  size_t weights_size = 0;  // size in bytes of the packed weights for one direction
+
+  const void* Direction(int direction) const {
+    return static_cast<const uint8_t*>(buffer.get()) + direction * weights_size;
+  }
+};
+
+/** Pack rows [row_offset, row_offset + num_rows) of each direction of a float W or R input with shape
+[num_directions, rows, columns]. The packed weights give the same result as using those rows as B in
+ComputeGemm.
+@returns false if the weights do not have the expected type and shape and were not packed.
+*/
+bool PackWeights(const AllocatorPtr& allocator, const Tensor& weights, int64_t num_directions, int64_t rows,
+                 int row_offset, int num_rows, PackedWeights& packed_weights);
+
+/// The B input to ComputeGemm. Either a span of the weights with shape N x K, or the same weights
+/// packed by PackWeights.
+template <typename T>
+struct GemmWeights {
+  GemmWeights() = default;
+  GemmWeights(const gsl::span<const T>& weights_arg) : weights(weights_arg) {}
+  GemmWeights(const void* packed_arg) : packed(packed_arg) {}
+
+  gsl::span<const T> weights;
+  const void* packed = nullptr;
+};
+
+/// Select the weights for a direction, preferring the packed weights if the kernel created them.
+template <typename T>
+GemmWeights<T> MakeGemmWeights(const PackedWeights& packed_weights, int direction,
+                               const gsl::span<const T>& weights) {
+  if (packed_weights.buffer != nullptr)
+    return GemmWeights<T>(packed_weights.Direction(direction));
+
+  return GemmWeights<T>(weights);
+}
+
+// A has size M x K, B has size N x K (transposed) or is packed, and C has size M x N
+template <typename TSpanAIter, typename TSpanCIter>
+void ComputeGemm(const int M,
+                 const int N,
+                 const int K,
+                 const float alpha,
+                 TSpanAIter A,
+                 TSpanAIter A_end,
+                 const int lda,
+                 const GemmWeights<float>& B,
+                 const int ldb,
+                 const float beta,
+                 TSpanCIter C,
+                 TSpanCIter C_end,
+                 const int ldc) {
+  if (B.packed == nullptr) {
+    ComputeGemm(M, N, K, alpha, A, A_end, lda, B.weights.cbegin(), B.weights.cend(), ldb, beta, C, C_end, ldc);
+    return;
+  }
+
+  ORT_ENFORCE(lda >= K && ldc >= N);
+  ORT_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
+  ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
+
+  MlasSgemm(CblasNoTrans, M, N, K, alpha, &*A, lda, B.packed, beta, &*C, ldc);
+}
+
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
 template <typename T>
@@ -3,15 +3,29 @@
 
 #include "core/providers/cpu/tensor/concat.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_KERNEL(
     Concat,
     4,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
+        .MayStridedInput(-1),
     Concat);
 
+namespace {
+// Copies a strided input into its block of the output, which has the output strides.
+// T only needs to match the element size, as the data is moved without conversion.
+template <typename T>
+void CopyStridedInput(const Tensor& input, const void* input_data,
+                      const std::vector<int64_t>& output_strides, void* output) {
+  StridedCopy(static_cast<T*>(output), output_strides,
+              static_cast<const T*>(input_data), input.Strides(), input.Shape().GetDims());
+}
+}  // namespace
+
 Status ConcatBase::PrepareForCompute(OpKernelContext* ctx, int input_count, Prepare& p) const {
   ORT_RETURN_IF_NOT(input_count >= 1, "Must have 1 or more inputs");
   const Tensor* tensor_pointer = ctx->Input<Tensor>(0);
@@ -85,14 +99,43 @@ Status Concat::Compute(OpKernelContext* ctx) const {
 
   int64_t output_offset = 0;
   auto element_bytes = p.output_tensor->DataType()->Size();
+  const auto output_strides = p.output_tensor->Strides();
   for (int input_index = 0; input_index < input_count; input_index++) {
     const auto& prep = p.inputs[input_index];
     auto input_axis_pitch = prep.axis_pitch;
-    const uint8_t* input = static_cast<const uint8_t*>(prep.tensor->DataRaw());
+    const uint8_t* input = static_cast<const uint8_t*>(prep.tensor->DataRaw()) + prep.tensor->ByteOffset();
     auto input_size = prep.tensor->Shape().Size();
 
     // Copy the data across. For every 'input_axis_pitch' values copied, we move over by the 'output_axis_pitch'
     uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
+
+    if (!prep.tensor->IsContiguous()) {
+      // The input is a strided view. Its elements are copied straight into the output block instead of
+      // materializing a contiguous copy first.
+      void* output_block = output + output_offset * element_bytes;
+      if (is_string_type)
+        CopyStridedInput<std::string>(*prep.tensor, input, output_strides, output_block);
+      else if (element_bytes == sizeof(uint8_t))
+        CopyStridedInput<uint8_t>(*prep.tensor, input, output_strides, output_block);
+      else if (element_bytes == sizeof(uint16_t))
+        CopyStridedInput<uint16_t>(*prep.tensor, input, output_strides, output_block);
+      else if (element_bytes == sizeof(uint32_t))
+        CopyStridedInput<uint32_t>(*prep.tensor, input, output_strides, output_block);
+      else if (element_bytes == sizeof(uint64_t))
+        CopyStridedInput<uint64_t>(*prep.tensor, input, output_strides, output_block);
+      else
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unsupported element size for a strided Concat input: ", element_bytes);
+      output_offset += input_axis_pitch;
+      continue;
+    }
+
+    // The allocation planner may have placed the input inside the output buffer, in which case
+    // its producer already wrote it to the right place.
+    if (input_size == input_axis_pitch && input == output + output_offset * element_bytes) {
+      output_offset += input_axis_pitch;
+      continue;
+    }
+
     for (int idxCopy = 0; idxCopy < input_size / input_axis_pitch; ++idxCopy) {
       if (is_string_type) {
         for (int idxItem = 0; idxItem < input_axis_pitch; ++idxItem)
@@ -30,41 +30,119 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   return Status::OK();
 }
 
+namespace {
+
+// Copies the rows of the gathered tensor in [begin, end). Each row is a block of block_size bytes.
+// BlockBytes is block_size when it is a small constant, so that the copy is a few moves instead of
+// a call to memcpy, or 0 for the generic case.
+template <size_t BlockBytes, typename Tin>
+int64_t GatherRows(const Tin* indices_data, const uint8_t* src_base, uint8_t* dst_base,
+                   const int64_t block_size, const int64_t N, const int64_t data_batch_bytes,
+                   const int64_t gathered_batch_bytes, const int64_t axis_dim, int64_t begin, int64_t end) {
+  for (int64_t index = begin; index < end; ++index) {
+    const int64_t batch = index / N, i = index % N;
+    const Tin idx = indices_data[i];
+    if (idx < 0 || idx >= axis_dim) {
+      return index;
+    }
+
+    if (block_size >= 64 && index + kGatherPrefetchDistance < end) {
+      const int64_t prefetch_index = index + kGatherPrefetchDistance;
+      const Tin prefetch_idx = indices_data[prefetch_index % N];
+      if (prefetch_idx >= 0 && prefetch_idx < axis_dim) {
+        GatherPrefetchRow(src_base + (prefetch_index / N) * data_batch_bytes + prefetch_idx * block_size, block_size);
+      }
+    }
+
+    const uint8_t* src = src_base + batch * data_batch_bytes + idx * block_size;
+    uint8_t* dst = dst_base + batch * gathered_batch_bytes + i * block_size;
+    memcpy(dst, src, BlockBytes != 0 ? BlockBytes : static_cast<size_t>(block_size));
+  }
+
+  return end;
+}
+
+template <typename Tin>
+int64_t GatherStrings(const Tin* indices_data, const std::string* src_base, std::string* dst_base,
+                      const int64_t block, const int64_t N, const int64_t data_batch, const int64_t gathered_batch,
+                      const int64_t axis_dim, int64_t begin, int64_t end) {
+  for (int64_t index = begin; index < end; ++index) {
+    const int64_t batch = index / N, i = index % N;
+    const Tin idx = indices_data[i];
+    if (idx < 0 || idx >= axis_dim) {
+      return index;
+    }
+
+    const std::string* src = src_base + batch * data_batch + idx * block;
+    std::string* dst = dst_base + batch * gathered_batch + i * block;
+    std::copy(src, src + block, dst);
+  }
+
+  return end;
+}
+
+}  // namespace
+
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
                       const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
-                      const TensorShape& input_data_shape, const int64_t axis) {
+                      const TensorShape& input_data_shape, const int64_t axis, KernelThreadPool& thread_pool) {
   const Tin* indices_data = indices_tensor->template Data<Tin>();
+  const int64_t axis_dim = input_data_shape[axis];
 
-  // Check the indices first in case there's a out of bound index.
-  // We can't merge this code in the omp loop below as omp does not allow return in the loop
-  for (int64_t i = 0; i < N; ++i) {
-    Tin idx = indices_data[i];
-    if (idx < 0 || idx >= input_data_shape[axis]) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", idx,
-                             " data_dim=", input_data_shape[axis]);
-    }
-  }
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t index = 0; index < M * N; ++index) {
-    int64_t batch = index / N, i = index % N;
-
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
+  // The indices are checked while copying. A range stops at the first index out of bounds and
+  // the lowest such position across the ranges is reported once they are all done.
+  std::mutex invalid_mutex;
+  int64_t invalid_index = M * N;
 
+  thread_pool.ParallelFor(M * N, block_size, [&](int64_t begin, int64_t end) {
+    int64_t stopped_at;
     if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
+      const int64_t block = block_size / static_cast<int64_t>(element_bytes);
+      stopped_at = GatherStrings(indices_data, reinterpret_cast<const std::string*>(src_base),
+                                 reinterpret_cast<std::string*>(dst_base), block, N,
+                                 data_batch_bytes / static_cast<int64_t>(element_bytes),
+                                 gathered_batch_bytes / static_cast<int64_t>(element_bytes), axis_dim, begin, end);
     } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
+      switch (block_size) {
+        case 1:
+          stopped_at = GatherRows<1>(indices_data, src_base, dst_base, block_size, N, data_batch_bytes,
+                                     gathered_batch_bytes, axis_dim, begin, end);
+          break;
+        case 2:
+          stopped_at = GatherRows<2>(indices_data, src_base, dst_base, block_size, N, data_batch_bytes,
+                                     gathered_batch_bytes, axis_dim, begin, end);
+          break;
+        case 4:
+          stopped_at = GatherRows<4>(indices_data, src_base, dst_base, block_size, N, data_batch_bytes,
+                                     gathered_batch_bytes, axis_dim, begin, end);
+          break;
+        case 8:
+          stopped_at = GatherRows<8>(indices_data, src_base, dst_base, block_size, N, data_batch_bytes,
+                                     gathered_batch_bytes, axis_dim, begin, end);
+          break;
+        case 16:
+          stopped_at = GatherRows<16>(indices_data, src_base, dst_base, block_size, N, data_batch_bytes,
+                                      gathered_batch_bytes, axis_dim, begin, end);
+          break;
+        default:
+          stopped_at = GatherRows<0>(indices_data, src_base, dst_base, block_size, N, data_batch_bytes,
+                                     gathered_batch_bytes, axis_dim, begin, end);
+          break;
+      }
     }
+
+    if (stopped_at != end) {
+      std::lock_guard<std::mutex> lock(invalid_mutex);
+      invalid_index = std::min(invalid_index, stopped_at);
+    }
+  });
+
+  if (invalid_index != M * N) {
+    Tin idx = indices_data[invalid_index % N];
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", idx,
+                           " data_dim=", axis_dim);
   }
 
   return Status::OK();
@@ -92,10 +170,12 @@ Status Gather::Compute(OpKernelContext* context) const {
   MLDataType Tind_type = p.indices_tensor->DataType();
   if (Tind_type == DataTypeImpl::GetType<int32_t>()) {
     return GatherCopyData<int32_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis,
+                                   thread_pool_);
   } else if (Tind_type == DataTypeImpl::GetType<int64_t>()) {
     return GatherCopyData<int64_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis,
+                                   thread_pool_);
   }
 
   return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type for Tind not supported yet in Gather.");
@@ -3,9 +3,16 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/kernel_thread_pool.h"
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
 
 namespace onnxruntime {
 
@@ -28,10 +35,34 @@ class GatherBase {
   int64_t axis_;
 };
 
+// Number of rows ahead of the current one to prefetch when gathering rows of a table.
+constexpr int64_t kGatherPrefetchDistance = 8;
+
+// Prefetches the start of a row of a table that is read soon. The rows selected from a large table
+// are spread across memory so the hardware prefetcher can't anticipate them, but it takes over
+// once the first cache lines of a row are read.
+inline void GatherPrefetchRow(const void* row, int64_t row_bytes) {
+  constexpr int64_t kMaxPrefetchBytes = 512;
+  const char* address = static_cast<const char*>(row);
+  for (int64_t offset = 0; offset < std::min(row_bytes, kMaxPrefetchBytes); offset += 64) {
+#if defined(__GNUC__)
+    __builtin_prefetch(address + offset);
+#elif defined(_M_IX86) || defined(_M_X64)
+    _mm_prefetch(address + offset, _MM_HINT_T0);
+#else
+    ORT_UNUSED_PARAMETER(address);
+#endif
+  }
+}
+
 class Gather final : public OpKernel, public GatherBase {
  public:
-  Gather(const OpKernelInfo& info) : OpKernel(info), GatherBase(info) {}
+  Gather(const OpKernelInfo& info) : OpKernel(info), GatherBase(info), thread_pool_(GetKernelThreadPool(info)) {}
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Shared by all the kernels of the execution provider.
+  KernelThreadPool& thread_pool_;
 };
 }  // namespace onnxruntime
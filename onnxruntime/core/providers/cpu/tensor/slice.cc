@@ -13,7 +13,10 @@ namespace onnxruntime {
       Slice,                                                                            \
       1,                                                                                \
       data_type,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()), \
+      KernelDefBuilder()                                                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>())                \
+          .MayStridedInput(0)                                                           \
+          .MayStridedOutput(0, 0),                                                      \
       Slice<data_type, indice_type, false>);
 
 ADD_TYPED_SLICE_OP(uint8_t,  int64_t);
@@ -36,7 +39,9 @@ ADD_TYPED_SLICE_OP(string,   int64_t);
       1,                                                                                     \
       data_type##_##indice_type,                                                             \
       KernelDefBuilder().TypeConstraint("T",    DataTypeImpl::GetTensorType<data_type>())    \
-                        .TypeConstraint("Tind", DataTypeImpl::GetTensorType<indice_type>()), \
+                        .TypeConstraint("Tind", DataTypeImpl::GetTensorType<indice_type>())  \
+                        .MayStridedInput(0)                                                  \
+                        .MayStridedOutput(0, 0),                                             \
       Slice<data_type, indice_type, true>);
 
 ADD_TYPED_DYNAMIC_SLICE_OP(uint8_t,  int32_t);
@@ -162,6 +167,24 @@ Status Slice<T, Tind, dynamic>::Compute(OpKernelContext* ctx) const {
 
   TensorShape output_shape(output_dims);
   auto& output_tensor = *ctx->Output(0, output_shape);
+
+  // the slice keeps the input strides and starts at the first selected element
+  bool is_view = IsStridedViewOf(output_tensor, input_tensor);
+  if (is_view || !input_tensor.IsContiguous()) {
+    auto input_strides = input_tensor.Strides();
+    int64_t start_offset = 0;
+    for (size_t i = 0; i < dimension_count; ++i)
+      start_offset += starts[i] * input_strides[i];
+
+    if (is_view)
+      output_tensor.SetStridedView(output_shape, input_strides,
+                                   input_tensor.ByteOffset() + start_offset * static_cast<int64_t>(sizeof(T)));
+    else
+      StridedCopy(output_tensor.template MutableData<T>(), output_tensor.Strides(),
+                  input_tensor.template Data<T>() + start_offset, input_strides, output_dims);
+    return Status::OK();
+  }
+
   auto* output = output_tensor.template MutableData<T>();
   const auto* output_end = output + output_shape.Size();
 
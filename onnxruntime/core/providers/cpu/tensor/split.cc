@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/split.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/utils.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -17,7 +18,9 @@ ONNX_CPU_OPERATOR_KERNEL(
                                       std::vector<MLDataType>{
                                           DataTypeImpl::GetTensorType<float>(),
                                           DataTypeImpl::GetTensorType<double>(),
-                                      }),
+                                      })
+        .MayStridedInput(0)
+        .MayStridedOutput(0, -1),
     Split);
 
 Status Split::Compute(OpKernelContext* context) const {
@@ -85,24 +88,39 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
   int64_t input_offset = 0;
   const T* input_data = input.template Data<T>();
 
+  // outputs that are views (or copies from a strided input) keep the input strides
+  const auto input_strides = input.Strides();
+  int64_t axis_offset = 0;
+
   for (int i = 0; i < num_outputs; ++i) {
     // update size of dimension for axis we're splitting on
     auto split_size = gsl::narrow<int>(split_sizes[i]);
     output_dimensions[axis] = split_size;
 
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
-    T* output_data = output->template MutableData<T>();
-
-    ::onnxruntime::math::CopyMatrix<T>(
-        before_dims,                                       // M
-        split_size * after_dims_excluding_split,           // N
-        static_cast<const T*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                   // lda
-        static_cast<T*>(output_data),                      // B
-        split_size * after_dims_excluding_split,           // ldb
-        [](const T* src, T* dst, size_t count) {
-          memcpy(dst, src, count * sizeof(T));
-        });
+    const int64_t start_offset = axis_offset * input_strides[axis];
+    axis_offset += split_size;
+
+    if (IsStridedViewOf(*output, input)) {
+      output->SetStridedView(TensorShape{output_dimensions}, input_strides,
+                             input.ByteOffset() + start_offset * static_cast<int64_t>(sizeof(T)));
+    } else if (!input.IsContiguous()) {
+      StridedCopy(output->template MutableData<T>(), output->Strides(),
+                  input_data + start_offset, input_strides, output_dimensions);
+    } else {
+      T* output_data = output->template MutableData<T>();
+
+      ::onnxruntime::math::CopyMatrix<T>(
+          before_dims,                                       // M
+          split_size * after_dims_excluding_split,           // N
+          static_cast<const T*>(input_data + input_offset),  // A
+          after_dims_including_split_axis,                   // lda
+          static_cast<T*>(output_data),                      // B
+          split_size * after_dims_excluding_split,           // ldb
+          [](const T* src, T* dst, size_t count) {
+            memcpy(dst, src, count * sizeof(T));
+          });
+    }
 
     input_offset += split_size * after_dims_excluding_split;  // offset by the N data we used in this iteration
   }
@@ -2,7 +2,15 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/transpose.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <type_traits>
+
 #include "core/framework/utils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 
@@ -39,7 +47,6 @@ template <typename T>
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
                             const T* source, T* target) {
-  size_t blocksize = num_elts_in_block * sizeof(float);
   // index used to iterate over target iteration-space
   std::vector<int64_t> target_index(num_axes, 0);
   for (size_t i = 0; i < num_blocks; ++i) {
@@ -47,7 +54,7 @@ static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target
     size_t source_offset = ComputeOffset(target_index, stride, num_axes);
 
     // copy
-    memcpy(target, source + source_offset, blocksize);
+    std::copy_n(source + source_offset, num_elts_in_block, target);
 
     // increment target_index:
     IncrementIndex(target_index, target_dims, num_axes);
@@ -80,24 +87,170 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
 // copies source tensor to target, transposing elements.
 template <typename T>
 static void DoTransposeSingleBlock(size_t num_elts_in_block, const T* source, T* target) {
-  size_t blocksize = num_elts_in_block * sizeof(T);
   // copy
-  memcpy(target, source, blocksize);
+  std::copy_n(source, num_elts_in_block, target);
+}
+
+// DoTransposeBatched2D: specialization of DoTranspose for a permutation that swaps two adjacent axes,
+// i.e. [batch, M, N, block] -> [batch, N, M, block].
+// The source is copied in tiles so the reads and writes for a tile stay within a small number of cache lines.
+// The tiles are split across the threads of thread_pool if it is given.
+template <typename T>
+static void DoTransposeBatched2D(size_t batch_count, size_t M, size_t N, size_t num_elts_in_block,
+                                 const T* source, T* target, KernelThreadPool* thread_pool) {
+  // a 2D transpose of 4 byte values can use the vectorized and threaded MLAS implementation
+  if (num_elts_in_block == 1 && sizeof(T) == sizeof(float) && std::is_trivially_copyable<T>::value) {
+    MlasTranspose(reinterpret_cast<const float*>(source), reinterpret_cast<float*>(target), batch_count, M, N);
+    return;
+  }
+
+  const size_t tile_size = 16;
+  const size_t num_tiles_per_batch = (M + tile_size - 1) / tile_size;
+  const size_t matrix_size = M * N * num_elts_in_block;
+  const int64_t num_tiles = static_cast<int64_t>(batch_count * num_tiles_per_batch);
+
+  auto copy_tiles = [&](int64_t begin, int64_t end) {
+    for (int64_t tile = begin; tile < end; ++tile) {
+      const size_t batch = static_cast<size_t>(tile) / num_tiles_per_batch;
+      const size_t m_start = (static_cast<size_t>(tile) % num_tiles_per_batch) * tile_size;
+      const size_t m_end = std::min(m_start + tile_size, M);
+
+      const T* batch_source = source + batch * matrix_size;
+      T* batch_target = target + batch * matrix_size;
+
+      for (size_t n_start = 0; n_start < N; n_start += tile_size) {
+        const size_t n_end = std::min(n_start + tile_size, N);
+
+        for (size_t n = n_start; n < n_end; ++n) {
+          for (size_t m = m_start; m < m_end; ++m) {
+            std::copy_n(batch_source + (m * N + n) * num_elts_in_block, num_elts_in_block,
+                        batch_target + (n * M + m) * num_elts_in_block);
+          }
+        }
+      }
+    }
+  };
+
+  if (thread_pool == nullptr) {
+    copy_tiles(0, num_tiles);
+    return;
+  }
+
+  // each tile reads and writes up to tile_size rows of the source
+  const int64_t tile_bytes = static_cast<int64_t>(2 * tile_size * N * num_elts_in_block * sizeof(T));
+  thread_pool->ParallelFor(num_tiles, tile_bytes, copy_tiles);
+}
+
+// SimplifyPermutation: removes the axes with a dimension of 1, and merges input axes that remain adjacent and in
+// the same order in the output. e.g. NCHW -> NHWC ([0, 2, 3, 1]) becomes [0, 2, 1] with input dims [N, C, H*W].
+// This reduces the index arithmetic required, and exposes the common permutations that are a batched 2D transpose.
+static void SimplifyPermutation(const std::vector<int64_t>& permutations, const std::vector<int64_t>& input_dims,
+                                std::vector<int64_t>& simplified_permutations,
+                                std::vector<int64_t>& simplified_input_dims) {
+  const size_t rank = input_dims.size();
+
+  // map the input axes to their index once the axes with a dimension of 1 are removed
+  std::vector<int64_t> remaining_axis(rank, -1);
+  std::vector<int64_t> dims;
+  for (size_t i = 0; i < rank; ++i) {
+    if (input_dims[i] != 1) {
+      remaining_axis[i] = static_cast<int64_t>(dims.size());
+      dims.push_back(input_dims[i]);
+    }
+  }
+
+  std::vector<int64_t> perm;
+  for (auto axis : permutations) {
+    if (remaining_axis[axis] >= 0) {
+      perm.push_back(remaining_axis[axis]);
+    }
+  }
+
+  // group the output axes into runs of consecutive input axes
+  std::vector<int64_t> group_first_axis;
+  std::vector<int64_t> group_dims;
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (i > 0 && perm[i] == perm[i - 1] + 1) {
+      group_dims.back() *= dims[perm[i]];
+    } else {
+      group_first_axis.push_back(perm[i]);
+      group_dims.push_back(dims[perm[i]]);
+    }
+  }
+
+  // each group is an axis of the simplified input. number them in input order.
+  const size_t num_groups = group_first_axis.size();
+  std::vector<size_t> input_order(num_groups);
+  std::iota(input_order.begin(), input_order.end(), size_t{0});
+  std::sort(input_order.begin(), input_order.end(),
+            [&group_first_axis](size_t a, size_t b) { return group_first_axis[a] < group_first_axis[b]; });
+
+  simplified_permutations.resize(num_groups);
+  simplified_input_dims.resize(num_groups);
+  for (size_t i = 0; i < num_groups; ++i) {
+    simplified_input_dims[i] = group_dims[input_order[i]];
+    simplified_permutations[input_order[i]] = static_cast<int64_t>(i);
+  }
+}
+
+// PermuteStrides: the strides of the transposed view of a tensor with the given strides.
+static std::vector<int64_t> PermuteStrides(const std::vector<int64_t>& permutations,
+                                           const std::vector<int64_t>& input_strides) {
+  std::vector<int64_t> output_strides(permutations.size());
+  for (size_t i = 0; i < permutations.size(); ++i) {
+    output_strides[i] = input_strides[permutations[i]];
+  }
+  return output_strides;
 }
 
 template <typename T>
-static Status DoTypedTranspose(const std::vector<int64_t>& permutations, const Tensor& input, Tensor& output) {
-  const auto& input_shape = input.Shape();
-  const auto& input_dims = input_shape.GetDims();
-  auto rank = input_shape.NumDimensions();
+static Status DoTypedTranspose(const std::vector<int64_t>& permutations, const Tensor& input, Tensor& output,
+                               KernelThreadPool* thread_pool) {
+  // a strided input is read directly through the permuted strides
+  if (!input.IsContiguous()) {
+    StridedCopy(output.MutableData<T>(), output.Strides(),
+                input.Data<T>(), PermuteStrides(permutations, input.Strides()), output.Shape().GetDims());
+    return Status::OK();
+  }
+
+  std::vector<int64_t> perm;
+  std::vector<int64_t> input_dims;
+  SimplifyPermutation(permutations, input.Shape().GetDims(), perm, input_dims);
+
+  const T* input_data = input.Data<T>();
+  T* output_data = output.MutableData<T>();
+
+  const int64_t rank = static_cast<int64_t>(input_dims.size());
+
+  // nothing is moved
+  if (rank <= 1) {
+    DoTransposeSingleBlock<T>(input.Shape().Size(), input_data, output_data);
+    return Status::OK();
+  }
+
+  // check for a swap of two adjacent axes, with optional leading batch and trailing block axes.
+  // this covers the common layout changes such as NCHW <-> NHWC and [B, S, H, D] -> [B, H, S, D].
+  int64_t first = perm[0] == 0 ? 1 : 0;
+  int64_t last = perm[rank - 1] == rank - 1 ? rank - 1 : rank;
+  if (last - first == 2 && perm[first] == first + 1 && perm[first + 1] == first) {
+    size_t batch_count = first == 1 ? input_dims[0] : 1;
+    size_t num_elts_in_block = last < rank ? input_dims[rank - 1] : 1;
+    DoTransposeBatched2D<T>(batch_count, input_dims[first], input_dims[first + 1], num_elts_in_block,
+                            input_data, output_data, thread_pool);
+    return Status::OK();
+  }
+
+  // Other permutations, e.g. a reversal of 3 or more axes, are copied by blocks of the unchanged trailing axes,
+  // or element by element, on the calling thread. This is intentional: once the permutation is simplified they
+  // are rare in models, and they don't have the two adjacent axes the tiled copy above relies on.
 
+  std::vector<int64_t> output_dims(rank);
   std::vector<size_t> stride(rank);
-  for (int i = 0; i < rank; i++) {
-    size_t inpdim = permutations[i];
-    if (inpdim + 1 < rank)
-      stride[i] = input_shape.SizeFromDimension(inpdim + 1);
-    else
-      stride[i] = 1;
+  for (int64_t i = 0; i < rank; i++) {
+    int64_t inpdim = perm[i];
+    output_dims[i] = input_dims[inpdim];
+    stride[i] = std::accumulate(input_dims.begin() + inpdim + 1, input_dims.end(), size_t{1},
+                                std::multiplies<size_t>());
   }
 
   // Partition the permutation into a prefix and the largest suffix such that
@@ -108,7 +261,7 @@ static Status DoTypedTranspose(const std::vector<int64_t>& permutations, const T
   bool is_suffix = true;
 
   for (int64_t i = rank - 1; i >= 0; --i) {
-    int64_t input_axis = permutations[i];
+    int64_t input_axis = perm[i];
     if (is_suffix && (input_axis == i)) {
       suffix_blocksize *= input_dims[input_axis];
     } else {
@@ -118,22 +271,17 @@ static Status DoTypedTranspose(const std::vector<int64_t>& permutations, const T
     }
   }
 
-  const T* input_data = input.Data<T>();
-  T* output_data = output.MutableData<T>();
-
-  if (1 == prefix_blocksize)
-    DoTransposeSingleBlock<T>(suffix_blocksize, input_data, output_data);
-  else if (1 == suffix_blocksize)
-    DoTransposeEltWise<T>(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                          input_data, output_data);
+  if (1 == suffix_blocksize)
+    DoTransposeEltWise<T>(num_axes_in_prefix, output_dims, prefix_blocksize, stride, input_data, output_data);
   else
-    DoTransposeImpl<T>(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
+    DoTransposeImpl<T>(num_axes_in_prefix, output_dims, prefix_blocksize, suffix_blocksize, stride,
                        input_data, output_data);
 
   return Status::OK();
 }
 
-Status TransposeBase::DoTranspose(const std::vector<int64_t>& permutations, const Tensor& input, Tensor& output) {
+Status TransposeBase::DoTranspose(const std::vector<int64_t>& permutations, const Tensor& input, Tensor& output,
+                                  KernelThreadPool* thread_pool) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -143,7 +291,7 @@ Status TransposeBase::DoTranspose(const std::vector<int64_t>& permutations, cons
     status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Mismatched data types between input and output Tensors. ",
                              input_type, " != ", output_type);
   } else {
-    DispatchOnTensorTypeWithReturn(input_type, status, DoTypedTranspose, permutations, input, output);
+    DispatchOnTensorTypeWithReturn(input_type, status, DoTypedTranspose, permutations, input, output, thread_pool);
   }
 
   return status;
@@ -167,7 +315,7 @@ Status Transpose<float>::Compute(OpKernelContext* ctx) const {
   TensorShape output_shape{output_dims};
   Tensor& Y = *ctx->Output(0, output_shape);
 
-  DoTypedTranspose<float>(*p_perm, X, Y);
+  DoTypedTranspose<float>(*p_perm, X, Y, &thread_pool_);
 
   return Status::OK();
 }
@@ -175,7 +323,9 @@ Status Transpose<float>::Compute(OpKernelContext* ctx) const {
 ONNX_CPU_OPERATOR_KERNEL(
     Transpose,
     1,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .MayStridedInput(0),
     Transpose<float>);
 
 }  // namespace onnxruntime
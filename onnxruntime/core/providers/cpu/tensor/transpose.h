@@ -6,6 +6,7 @@
 #include "gsl/gsl_util"
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/kernel_thread_pool.h"
 
 namespace onnxruntime {
 
@@ -14,8 +15,10 @@ class TransposeBase {
   /**
   Transpose the input Tensor into the output Tensor using the provided permutations.
   Both Tensors must have the same data type. 
+  If thread_pool is given, the copy of a batched 2D transpose is split across its threads.
   */
-  static Status DoTranspose(const std::vector<int64_t>& permutations, const Tensor& input, Tensor& output);
+  static Status DoTranspose(const std::vector<int64_t>& permutations, const Tensor& input, Tensor& output,
+                            KernelThreadPool* thread_pool = nullptr);
 
  protected:
   TransposeBase(const OpKernelInfo& info) {
@@ -68,8 +71,12 @@ class TransposeBase {
 template <typename T>
 class Transpose final : public OpKernel, public TransposeBase {
  public:
-  Transpose(const OpKernelInfo& info) : OpKernel(info), TransposeBase(info) {}
+  Transpose(const OpKernelInfo& info)
+      : OpKernel(info), TransposeBase(info), thread_pool_(GetKernelThreadPool(info)) {}
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  KernelThreadPool& thread_pool_;
 };
 }  // namespace onnxruntime
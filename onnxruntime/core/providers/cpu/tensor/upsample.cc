@@ -3,6 +3,12 @@
 
 #include "core/providers/cpu/tensor/upsample.h"
 #include <math.h>  //for fabs
+#include <algorithm>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
 
 using namespace ::onnxruntime::common;
 using namespace std;
@@ -29,63 +35,111 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<uint8_t>()),
     Upsample<uint8_t>);
 
+namespace {
+
+// Writes each element of an input row twice.
+template <typename T>
+void UpsampleNearest2xRow(const T* input, int64_t input_width, T* output) {
+  for (int64_t x = 0; x < input_width; ++x) {
+    output[2 * x] = input[x];
+    output[2 * x + 1] = input[x];
+  }
+}
+
+#if defined(_M_X64) || defined(__x86_64__)
+template <>
+void UpsampleNearest2xRow<float>(const float* input, int64_t input_width, float* output) {
+  int64_t x = 0;
+  for (; x + 4 <= input_width; x += 4) {
+    const __m128 v = _mm_loadu_ps(input + x);
+    _mm_storeu_ps(output + 2 * x, _mm_unpacklo_ps(v, v));
+    _mm_storeu_ps(output + 2 * x + 4, _mm_unpackhi_ps(v, v));
+  }
+  for (; x < input_width; ++x) {
+    output[2 * x] = input[x];
+    output[2 * x + 1] = input[x];
+  }
+}
+#endif
+
+// Interpolates an input row at twice its width: the even outputs are the input values and the odd
+// outputs the mean of two neighbours, with the last input value repeated.
+void UpsampleBilinear2xRow(const float* input, int64_t input_width, float* output) {
+  int64_t x = 0;
+#if defined(_M_X64) || defined(__x86_64__)
+  const __m128 half = _mm_set1_ps(0.5f);
+  for (; x + 5 <= input_width; x += 4) {
+    const __m128 v = _mm_loadu_ps(input + x);
+    const __m128 mean = _mm_mul_ps(_mm_add_ps(v, _mm_loadu_ps(input + x + 1)), half);
+    _mm_storeu_ps(output + 2 * x, _mm_unpacklo_ps(v, mean));
+    _mm_storeu_ps(output + 2 * x + 4, _mm_unpackhi_ps(v, mean));
+  }
+#endif
+  for (; x + 1 < input_width; ++x) {
+    output[2 * x] = input[x];
+    output[2 * x + 1] = (input[x] + input[x + 1]) * 0.5f;
+  }
+  if (input_width > 0) {
+    output[2 * input_width - 2] = input[input_width - 1];
+    output[2 * input_width - 1] = input[input_width - 1];
+  }
+}
+
+}  // namespace
+
 template <typename T>
 void UpsampleNearest2x(
-    int64_t batch_size,
-    int64_t num_channels,
+    int64_t num_planes,
     int64_t input_height,
     int64_t input_width,
     const T* input,
     T* output) {
-  const int64_t output_height = input_height * 2;
   const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
-        for (int64_t x = 0; x < input_width; ++x) {
-          const T v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
-        }
-      }
-      input += input_height * input_width;
-      output += output_height * output_width;
+  for (int64_t plane = 0; plane < num_planes; ++plane) {
+    for (int64_t y = 0; y < input_height; ++y) {
+      T* output_row = output + 2 * y * output_width;
+      UpsampleNearest2xRow(input + y * input_width, input_width, output_row);
+      std::copy(output_row, output_row + output_width, output_row + output_width);
     }
+    input += input_height * input_width;
+    output += 4 * input_height * input_width;
   }
 }
 
+// Computes the output rows [begin_row, end_row), where a row spans the innermost axis.
 template <typename T>
-Status UpsampleNearest(const T* input,
-                       T* output,
-                       const TensorShape& input_shape,
-                       const TensorShape& output_shape,
-                       const vector<float>& scales) {
-  if (!input || !output)
-    return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value is nullptr");
-  if (input_shape.NumDimensions() != output_shape.NumDimensions())
-    return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value's dimension mismatch");
-  auto n_dim = input_shape.NumDimensions();
-  if (scales.size() == 4 && scales[0] == 1 && scales[1] == 1 && scales[2] == 2 && scales[3] == 2) {
-    UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output);
-  } else {
-    for (size_t i = 0, size = output_shape.Size(); i < size; i++) {
-      size_t old_idx = 0;
-      size_t cur_idx = i;
+void UpsampleNearest(const UpsampleTables& tables,
+                     const TensorShape& output_shape,
+                     int64_t begin_row,
+                     int64_t end_row,
+                     const T* input,
+                     T* output) {
+  const auto n_dim = static_cast<int64_t>(output_shape.NumDimensions());
+  const int64_t output_width = output_shape[n_dim - 1];
+  const int64_t* x_offsets = tables.nearest_offsets[n_dim - 1].data();
 
-      int64_t base = 1;
-      for (int64_t j = static_cast<int64_t>(n_dim - 1); j >= 0; j--) {
-        auto tmp = cur_idx % output_shape[j];
-        old_idx += (std::min(static_cast<int64_t>(tmp / scales[j]), input_shape[j] - 1)) * base;
-        base *= input_shape[j];
-        cur_idx /= output_shape[j];
-      }
+  int64_t previous_input_offset = -1;
+  for (int64_t row = begin_row; row < end_row; ++row) {
+    int64_t input_offset = 0;
+    int64_t cur_idx = row;
+    for (int64_t j = n_dim - 2; j >= 0; j--) {
+      input_offset += tables.nearest_offsets[j][cur_idx % output_shape[j]];
+      cur_idx /= output_shape[j];
+    }
+
+    T* output_row = output + row * output_width;
+    if (input_offset == previous_input_offset) {
+      // the row repeats the previous one when upsampling an outer axis
+      std::copy(output_row - output_width, output_row, output_row);
+      continue;
+    }
 
-      output[i] = input[old_idx];
+    const T* input_row = input + input_offset;
+    for (int64_t x = 0; x < output_width; ++x) {
+      output_row[x] = input_row[x_offsets[x]];
     }
+    previous_input_offset = input_offset;
   }
-  return Status::OK();
 }
 
 //This is a generic upsample in linear mode for N-D tensor.
@@ -144,62 +198,151 @@ Status upsampleLiner(const T* input,
   return Status::OK();
 }
 
+// Interpolates the planes of a 4-D tensor with the tables of the plane shape.
 template <typename T>
-void upsampleBilinear(
-    int64_t batch_size,
-    int64_t num_channels,
+void UpsampleBilinear(
+    const UpsampleTables& tables,
+    int64_t num_planes,
     int64_t input_height,
     int64_t input_width,
-    float height_scale,
-    float width_scale,
+    int64_t output_height,
+    int64_t output_width,
     const T* Xdata,
     T* Ydata) {
-  int64_t output_width = static_cast<int64_t>(input_width * width_scale);
-  int64_t output_height = static_cast<int64_t>(input_height * height_scale);
-
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        float in_y = std::min(y / height_scale, static_cast<float>(input_height - 1));
-        const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-        const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-        float dy1 = fabs(in_y - in_y1);
-        float dy2 = fabs(in_y - in_y2);
-        if (in_y1 == in_y2) {
-          dy1 = 0.5f;
-          dy2 = 0.5f;
-        }
+  const int64_t* in_x1 = tables.in_x1.data();
+  const int64_t* in_x2 = tables.in_x2.data();
+  const float* dx1 = tables.dx1.data();
+  const float* dx2 = tables.dx2.data();
 
-        const int64_t input_width_mul_y1 = input_width * in_y1;
-        const int64_t input_width_mul_y2 = input_width * in_y2;
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          float in_x = std::min(x / width_scale, static_cast<float>(input_width - 1));
-          const int64_t in_x1 = std::min(static_cast<int64_t>(in_x), input_width - 1);
-          const int64_t in_x2 = std::min(in_x1 + 1, input_width - 1);
-
-          float dx1 = std::abs(in_x - in_x1);
-          float dx2 = std::abs(in_x - in_x2);
-          if (in_x1 == in_x2) {
-            dx1 = 0.5f;
-            dx2 = 0.5f;
-          }
-
-          T X11 = Xdata[input_width_mul_y1 + in_x1];
-          T X21 = Xdata[input_width_mul_y1 + in_x2];
-          T X12 = Xdata[input_width_mul_y2 + in_x1];
-          T X22 = Xdata[input_width_mul_y2 + in_x2];
-
-          Ydata[output_width * y + x] = static_cast<T>(dx2 * dy2 * X11 +
-                                                       dx1 * dy2 * X21 +
-                                                       dx2 * dy1 * X12 +
-                                                       dx1 * dy1 * X22);
+  for (int64_t plane = 0; plane < num_planes; ++plane) {
+    for (int64_t y = 0; y < output_height; ++y) {
+      const T* row1 = Xdata + tables.in_y1_offsets[y];
+      const T* row2 = Xdata + tables.in_y2_offsets[y];
+      const float dy1 = tables.dy1[y];
+      const float dy2 = tables.dy2[y];
+      T* output_row = Ydata + output_width * y;
+
+      for (int64_t x = 0; x < output_width; ++x) {
+        T X11 = row1[in_x1[x]];
+        T X21 = row1[in_x2[x]];
+        T X12 = row2[in_x1[x]];
+        T X22 = row2[in_x2[x]];
+
+        output_row[x] = static_cast<T>(dx2[x] * dy2 * X11 +
+                                       dx1[x] * dy2 * X21 +
+                                       dx2[x] * dy1 * X12 +
+                                       dx1[x] * dy1 * X22);
+      }
+    }
+    Xdata += input_height * input_width;
+    Ydata += output_width * output_height;
+  }
+}
+
+// Bilinear interpolation of the planes of a 4-D float tensor at twice their height and width.
+// The even output rows interpolate an input row, and the odd ones the mean of two input rows.
+void UpsampleBilinear2x(
+    int64_t num_planes,
+    int64_t input_height,
+    int64_t input_width,
+    const float* Xdata,
+    float* Ydata) {
+  const int64_t output_width = input_width * 2;
+  std::vector<float> mean_row(static_cast<size_t>(input_width));
+
+  for (int64_t plane = 0; plane < num_planes; ++plane) {
+    for (int64_t y = 0; y < input_height; ++y) {
+      const float* input_row = Xdata + y * input_width;
+      float* output_row = Ydata + 2 * y * output_width;
+      UpsampleBilinear2xRow(input_row, input_width, output_row);
+
+      if (y + 1 < input_height) {
+        const float* next_input_row = input_row + input_width;
+        for (int64_t x = 0; x < input_width; ++x) {
+          mean_row[x] = (input_row[x] + next_input_row[x]) * 0.5f;
         }
+        UpsampleBilinear2xRow(mean_row.data(), input_width, output_row + output_width);
+      } else {
+        std::copy(output_row, output_row + output_width, output_row + output_width);
       }
-      Xdata += input_height * input_width;
-      Ydata += output_width * output_height;
     }
+    Xdata += input_height * input_width;
+    Ydata += 4 * input_height * input_width;
+  }
+}
+
+namespace {
+
+std::shared_ptr<UpsampleTables> BuildNearestTables(const TensorShape& input_shape,
+                                                   const TensorShape& output_shape,
+                                                   const std::vector<float>& scales) {
+  auto tables = std::make_shared<UpsampleTables>();
+  const auto n_dim = input_shape.NumDimensions();
+  tables->nearest_offsets.resize(n_dim);
+
+  int64_t input_pitch = 1;
+  for (int64_t j = static_cast<int64_t>(n_dim) - 1; j >= 0; j--) {
+    auto& offsets = tables->nearest_offsets[j];
+    offsets.resize(static_cast<size_t>(output_shape[j]));
+    for (int64_t i = 0; i < output_shape[j]; ++i) {
+      offsets[i] = std::min(static_cast<int64_t>(i / scales[j]), input_shape[j] - 1) * input_pitch;
+    }
+    input_pitch *= input_shape[j];
+  }
+  return tables;
+}
+
+// Fills the input indices interpolated for each output index of an axis, and their weights.
+void BuildLinearAxisTables(int64_t input_size, int64_t output_size, float scale, int64_t pitch,
+                           std::vector<int64_t>& in_1, std::vector<int64_t>& in_2,
+                           std::vector<float>& d1, std::vector<float>& d2) {
+  in_1.resize(static_cast<size_t>(output_size));
+  in_2.resize(static_cast<size_t>(output_size));
+  d1.resize(static_cast<size_t>(output_size));
+  d2.resize(static_cast<size_t>(output_size));
+
+  for (int64_t i = 0; i < output_size; ++i) {
+    float in = std::min(i / scale, static_cast<float>(input_size - 1));
+    const int64_t in1 = std::min(static_cast<int64_t>(in), input_size - 1);
+    const int64_t in2 = std::min(in1 + 1, input_size - 1);
+    d1[i] = std::abs(in - in1);
+    d2[i] = std::abs(in - in2);
+    if (in1 == in2) {
+      d1[i] = 0.5f;
+      d2[i] = 0.5f;
+    }
+    in_1[i] = in1 * pitch;
+    in_2[i] = in2 * pitch;
+  }
+}
+
+std::shared_ptr<UpsampleTables> BuildBilinearTables(const TensorShape& input_shape,
+                                                    const TensorShape& output_shape,
+                                                    const std::vector<float>& scales) {
+  auto tables = std::make_shared<UpsampleTables>();
+  const int64_t input_width = input_shape[3];
+  BuildLinearAxisTables(input_shape[2], output_shape[2], scales[2], input_width,
+                        tables->in_y1_offsets, tables->in_y2_offsets, tables->dy1, tables->dy2);
+  BuildLinearAxisTables(input_width, output_shape[3], scales[3], 1,
+                        tables->in_x1, tables->in_x2, tables->dx1, tables->dx2);
+  return tables;
+}
+
+}  // namespace
+
+template <typename T>
+std::shared_ptr<const UpsampleTables> Upsample<T>::GetTables(const TensorShape& input_shape,
+                                                             const TensorShape& output_shape,
+                                                             const std::vector<float>& scales) const {
+  std::lock_guard<std::mutex> lock(tables_mutex_);
+  if (tables_ == nullptr || tables_->input_dims != input_shape.GetDims() || tables_->scales != scales) {
+    auto tables = mode_ == UpsampleMode::NN ? BuildNearestTables(input_shape, output_shape, scales)
+                                            : BuildBilinearTables(input_shape, output_shape, scales);
+    tables->input_dims = input_shape.GetDims();
+    tables->scales = scales;
+    tables_ = std::move(tables);
   }
+  return tables_;
 }
 
 template <typename T>
@@ -217,21 +360,69 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context, const std::vector<floa
     Y_dims.push_back(static_cast<int64_t>(scales[i] * dims[i]));
   }
   Tensor* Y = context->Output(0, Y_dims);
+  const TensorShape& output_shape = Y->Shape();
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  const T* Xdata = X->template Data<T>();
+  T* Ydata = Y->template MutableData<T>();
 
   switch (mode_) {
-    case UpsampleMode::NN:
-      return UpsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales);
+    case UpsampleMode::NN: {
+      if (dims.empty()) {
+        Ydata[0] = Xdata[0];
+        return Status::OK();
+      }
+
+      if (scales.size() == 4 && scales[0] == 1 && scales[1] == 1 && scales[2] == 2 && scales[3] == 2) {
+        const int64_t input_height = dims[2], input_width = dims[3];
+        const int64_t plane_size = input_height * input_width;
+        thread_pool_.ParallelFor(dims[0] * dims[1], 4 * plane_size * static_cast<int64_t>(sizeof(T)),
+                                 [&](int64_t begin, int64_t end) {
+                                   UpsampleNearest2x<T>(end - begin, input_height, input_width,
+                                                        Xdata + begin * plane_size, Ydata + begin * 4 * plane_size);
+                                 });
+        return Status::OK();
+      }
+
+      auto tables = GetTables(X->Shape(), output_shape, scales);
+      const int64_t output_width = output_shape[dims.size() - 1];
+      thread_pool_.ParallelFor(output_shape.Size() / output_width, output_width * static_cast<int64_t>(sizeof(T)),
+                               [&](int64_t begin, int64_t end) {
+                                 UpsampleNearest<T>(*tables, output_shape, begin, end, Xdata, Ydata);
+                               });
+      return Status::OK();
+    }
     case UpsampleMode::LINEAR: {
       //What's the correct behavior of linear mode is not clear right now,
       //Only support bilinear with 4D tensor to keep consistent with previous behavior
       if (dims.size() != 4)
         return Status(ONNXRUNTIME, FAIL, "Upsample: linear mode upsample only support 4-D tensor with NCHW layout");
 
-      const int64_t batch_size = dims[0], num_channels = dims[1];
+      const int64_t num_planes = dims[0] * dims[1];
       const int64_t input_height = dims[2], input_width = dims[3];
+      const int64_t input_plane_size = input_height * input_width;
+      const int64_t output_height = output_shape[2], output_width = output_shape[3];
+      const int64_t output_plane_size = output_height * output_width;
+
+      if (std::is_same<T, float>::value && scales[2] == 2 && scales[3] == 2) {
+        thread_pool_.ParallelFor(num_planes, output_plane_size * static_cast<int64_t>(sizeof(T)),
+                                 [&](int64_t begin, int64_t end) {
+                                   UpsampleBilinear2x(end - begin, input_height, input_width,
+                                                      reinterpret_cast<const float*>(Xdata) + begin * input_plane_size,
+                                                      reinterpret_cast<float*>(Ydata) + begin * output_plane_size);
+                                 });
+        return Status::OK();
+      }
 
-      upsampleBilinear(batch_size, num_channels, input_height, input_width,
-                       scales[2], scales[3], X->template Data<T>(), Y->template MutableData<T>());
+      auto tables = GetTables(X->Shape(), output_shape, scales);
+      thread_pool_.ParallelFor(num_planes, output_plane_size * static_cast<int64_t>(sizeof(T)),
+                               [&](int64_t begin, int64_t end) {
+                                 UpsampleBilinear(*tables, end - begin, input_height, input_width,
+                                                  output_height, output_width,
+                                                  Xdata + begin * input_plane_size, Ydata + begin * output_plane_size);
+                               });
       return Status::OK();
     }
     default:
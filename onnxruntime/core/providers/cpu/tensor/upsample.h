@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/kernel_thread_pool.h"
 
 namespace onnxruntime {
 
@@ -79,15 +83,44 @@ class UpsampleBase {
   }
 };
 
+// Input positions and weights read for each output position, which only depend on the input shape
+// and the scales.
+struct UpsampleTables {
+  std::vector<int64_t> input_dims;
+  std::vector<float> scales;
+
+  // nearest mode: for each axis, the input offset read for each output index
+  std::vector<std::vector<int64_t>> nearest_offsets;
+
+  // linear mode: for each output row and column, the offsets of the two input rows and
+  // columns interpolated, and their weights
+  std::vector<int64_t> in_y1_offsets, in_y2_offsets;
+  std::vector<float> dy1, dy2;
+  std::vector<int64_t> in_x1, in_x2;
+  std::vector<float> dx1, dx2;
+};
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
-  Upsample(OpKernelInfo info) : UpsampleBase(info), OpKernel(info) {
+  Upsample(OpKernelInfo info) : UpsampleBase(info), OpKernel(info), thread_pool_(GetKernelThreadPool(info)) {
   }
 
   Status Compute(OpKernelContext* context) const override;
 
   Status BaseCompute(OpKernelContext* context, const std::vector<float>& scales) const;
+
+ private:
+  // Returns the tables of the last input shape and scales, computing them again if they changed.
+  std::shared_ptr<const UpsampleTables> GetTables(const TensorShape& input_shape,
+                                                  const TensorShape& output_shape,
+                                                  const std::vector<float>& scales) const;
+
+  mutable std::mutex tables_mutex_;
+  mutable std::shared_ptr<const UpsampleTables> tables_;
+
+  // Shared by all the kernels of the execution provider.
+  KernelThreadPool& thread_pool_;
 };
 
 }  // namespace onnxruntime
@@ -206,6 +206,55 @@ struct SliceIterator {
   std::vector<int64_t> indices_;  // There is no index for innermost axis since it's a special case
 };
 
+// Copies a tensor of the given dims between two strided layouts. Strides are in elements.
+// This is used to materialize a strided view (see Tensor::SetStridedView) into contiguous memory.
+template <typename T>
+void StridedCopy(T* dst, const std::vector<int64_t>& dst_strides,
+                 const T* src, const std::vector<int64_t>& src_strides,
+                 const std::vector<int64_t>& dims) {
+  const size_t rank = dims.size();
+  if (rank == 0) {
+    *dst = *src;
+    return;
+  }
+  if (std::find(dims.cbegin(), dims.cend(), 0) != dims.cend())
+    return;
+
+  const int64_t inner_extent = dims[rank - 1];
+  const int64_t dst_inner_stride = dst_strides[rank - 1];
+  const int64_t src_inner_stride = src_strides[rank - 1];
+  std::vector<int64_t> indices(rank - 1, 0);  // There is no index for innermost axis since it's a special case
+
+  for (;;) {
+    if (dst_inner_stride == 1 && src_inner_stride == 1) {
+      std::copy(src, src + inner_extent, dst);
+    } else {
+      for (int64_t i = 0; i < inner_extent; i++)
+        dst[i * dst_inner_stride] = src[i * src_inner_stride];
+    }
+
+    size_t axis = rank - 1;
+    for (;;) {
+      if (axis-- == 0)
+        return;
+      src += src_strides[axis];
+      dst += dst_strides[axis];
+      if (++indices[axis] != dims[axis])
+        break;
+      src -= src_strides[axis] * dims[axis];
+      dst -= dst_strides[axis] * dims[axis];
+      indices[axis] = 0;
+    }
+  }
+}
+
+// Returns true if the allocation planner placed the output on the buffer of the input, which it only
+// does for kernels declaring KernelDefBuilder::MayStridedOutput. The kernel must then describe its
+// result with Tensor::SetStridedView instead of writing to the buffer.
+inline bool IsStridedViewOf(const Tensor& output, const Tensor& input) {
+  return output.DataRaw() == input.DataRaw() && output.Shape().Size() != 0;
+}
+
 inline void CopyCpuTensor(const Tensor* src, Tensor* tgt) {
   void* target = tgt->MutableDataRaw();
   const void* source = src->DataRaw();
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/session/IOBinding.h"
+#include <algorithm>
 #include "core/common/logging/logging.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel.h"
@@ -11,15 +12,27 @@ namespace onnxruntime {
 IOBinding::IOBinding(const SessionState& session_state) : session_state_(session_state) {
 }
 
+static std::pair<bool, size_t> Contains(const std::vector<std::string>& names, const std::string& name) {
+  auto it = std::find(std::begin(names), std::end(names), name);
+  if (it == std::end(names)) {
+    return {false, 0};
+  }
+  return {true, it - std::begin(names)};
+}
+
 common::Status IOBinding::BindInput(const std::string& name, const MLValue& ml_value) {
-  if (!ml_value.IsTensor()) {
-    feed_names_.push_back(name);
-    feeds_.push_back(ml_value);
+  MLValue new_mlvalue = ml_value;
+  if (ml_value.IsTensor()) {
+    ORT_RETURN_IF_ERROR(utils::CopyOneInputAcrossDevices(session_state_, name, ml_value, new_mlvalue));
+  }
+
+  // binding the same name again replaces the previous value so the binding can be reused across runs
+  auto rc = Contains(feed_names_, name);
+  if (rc.first) {
+    feeds_[rc.second] = new_mlvalue;
     return Status::OK();
   }
 
-  MLValue new_mlvalue;
-  ORT_RETURN_IF_ERROR(utils::CopyOneInputAcrossDevices(session_state_, name, ml_value, new_mlvalue));
   feed_names_.push_back(name);
   feeds_.push_back(new_mlvalue);
 
@@ -57,18 +70,11 @@ common::Status IOBinding::SynchronizeOutputs() {
   return Status::OK();
 }
 
-static std::pair<bool, size_t> Contains(const std::vector<std::string>& output_names, const std::string& oname) {
-  auto it = std::find(std::begin(output_names), std::end(output_names), oname);
-  if (it == std::end(output_names)) {
-    return {false, 0};
-  }
-  return {true, it - std::begin(output_names)};
-}
-
 common::Status IOBinding::BindOutput(const std::string& name, const MLValue& ml_value) {
   auto rc = Contains(output_names_, name);
   if (rc.first) {
     outputs_[rc.second] = ml_value;
+    output_allocators_.erase(rc.second);
     return Status::OK();
   }
 
@@ -77,6 +83,208 @@ common::Status IOBinding::BindOutput(const std::string& name, const MLValue& ml_
   return Status::OK();
 }
 
+common::Status IOBinding::BindOutput(const std::string& name, const OrtAllocatorInfo& location) {
+  auto allocator = utils::GetAllocator(session_state_, location);
+  if (!allocator) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No allocator is registered for location ",
+                           location.ToString(), " requested by output ", name);
+  }
+
+  ORT_RETURN_IF_ERROR(BindOutput(name, MLValue()));
+  output_allocators_[Contains(output_names_, name).second] = allocator;
+  return Status::OK();
+}
+
+common::Status IOBinding::BindState(const std::string& input_name, const std::string& output_name,
+                                    const MLValue& initial_value) {
+  // the initial value is copied to the device required by the input once here, rather than on every reset
+  MLValue new_mlvalue = initial_value;
+  if (initial_value.IsAllocated() && initial_value.IsTensor()) {
+    ORT_RETURN_IF_ERROR(utils::CopyOneInputAcrossDevices(session_state_, input_name, initial_value, new_mlvalue));
+  }
+
+  auto it = std::find_if(states_.begin(), states_.end(),
+                         [&input_name](const State& state) { return state.input_name == input_name; });
+  if (it == states_.end()) {
+    it = states_.insert(states_.end(), State());
+    it->input_name = input_name;
+  }
+
+  it->output_name = output_name;
+  it->initial_value = new_mlvalue;
+  it->buffers[0] = MLValue();
+  it->buffers[1] = MLValue();
+  it->current = -1;
+
+  return Status::OK();
+}
+
+void IOBinding::ResetStates() {
+  // the buffers are kept so the runs after a reset don't allocate them again
+  for (auto& state : states_) {
+    state.current = -1;
+  }
+}
+
+void IOBinding::ClearStates() {
+  // remove the inputs and outputs bound for the states by the previous runs, so the next run neither feeds the
+  // last state nor writes into its buffers
+  for (const auto& state : states_) {
+    auto rc = Contains(feed_names_, state.input_name);
+    if (rc.first) {
+      feed_names_.erase(feed_names_.begin() + rc.second);
+      feeds_.erase(feeds_.begin() + rc.second);
+    }
+
+    rc = Contains(output_names_, state.output_name);
+    if (rc.first) {
+      output_names_.erase(output_names_.begin() + rc.second);
+      outputs_.erase(outputs_.begin() + rc.second);
+
+      // the outputs bound after it move down by one
+      std::unordered_map<size_t, AllocatorPtr> output_allocators;
+      for (auto& entry : output_allocators_) {
+        if (entry.first != rc.second) {
+          output_allocators[entry.first > rc.second ? entry.first - 1 : entry.first] = std::move(entry.second);
+        }
+      }
+      output_allocators_ = std::move(output_allocators);
+    }
+  }
+
+  states_.clear();
+}
+
+common::Status IOBinding::PrepareStates() {
+  for (auto& state : states_) {
+    const MLValue& feed = state.current < 0 ? state.initial_value : state.buffers[state.current];
+    auto rc = Contains(feed_names_, state.input_name);
+    if (feed.IsAllocated()) {
+      if (rc.first) {
+        feeds_[rc.second] = feed;
+      } else {
+        feed_names_.push_back(state.input_name);
+        feeds_.push_back(feed);
+      }
+    } else if (rc.first) {
+      // let the model provide the default value
+      feed_names_.erase(feed_names_.begin() + rc.second);
+      feeds_.erase(feeds_.begin() + rc.second);
+    }
+
+    // write the new state into the buffer that isn't being read. it is allocated by the first runs that use it
+    // and reused as a pre-allocated output after that.
+    ORT_RETURN_IF_ERROR(BindOutput(state.output_name, state.buffers[state.current == 0 ? 1 : 0]));
+  }
+
+  return Status::OK();
+}
+
+void IOBinding::UpdateStates() {
+  for (auto& state : states_) {
+    auto rc = Contains(output_names_, state.output_name);
+    if (!rc.first) {
+      continue;
+    }
+
+    // keep the output in case the executor replaced the buffer, e.g. because the shape of the state changed
+    int next = state.current == 0 ? 1 : 0;
+    state.buffers[next] = outputs_[rc.second];
+    state.current = next;
+  }
+}
+
+void IOBinding::ClearInputs() {
+  feed_names_.clear();
+  feeds_.clear();
+}
+
+void IOBinding::ClearOutputs() {
+  output_names_.clear();
+  outputs_.clear();
+  output_allocators_.clear();
+}
+
+common::Status IOBinding::CopyOutputsToBoundLocations() {
+  const auto& execution_providers = session_state_.GetExecutionProviders();
+  for (auto& entry : output_allocators_) {
+    MLValue& output = outputs_[entry.first];
+    if (!output.IsTensor()) {
+      continue;
+    }
+
+    const Tensor& fetched_tensor = output.Get<Tensor>();
+    const OrtAllocatorInfo& target_location = entry.second->Info();
+    if (fetched_tensor.Location() == target_location) {
+      continue;
+    }
+
+    // the copy is done by the provider which is not the CPU one
+    const auto* p_copy_provider = execution_providers.Get(target_location);
+    if (!p_copy_provider || p_copy_provider->Type() == onnxruntime::kCpuExecutionProvider) {
+      p_copy_provider = execution_providers.Get(fetched_tensor.Location());
+    }
+    if (!p_copy_provider) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "No execution provider can copy output ", output_names_[entry.first],
+                             " to ", target_location.ToString());
+    }
+
+    const AllocatorPtr& allocator = entry.second;
+    void* buffer = fetched_tensor.Size() == 0 ? nullptr : allocator->Alloc(fetched_tensor.Size());
+    std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(fetched_tensor.DataType(),
+                                                                fetched_tensor.Shape(),
+                                                                buffer,
+                                                                target_location,
+                                                                allocator);
+    ORT_RETURN_IF_ERROR(p_copy_provider->CopyTensor(fetched_tensor, *p_tensor));
+
+    output.Init(p_tensor.release(),
+                DataTypeImpl::GetType<Tensor>(),
+                DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  }
+
+  return Status::OK();
+}
+
+std::unordered_map<size_t, IExecutor::CustomAllocator> IOBinding::CreateFetchAllocators() const {
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  for (size_t i = 0, end = outputs_.size(); i < end; ++i) {
+    const MLValue& output = outputs_[i];
+    if (!output.IsAllocated() || !output.IsTensor()) {
+      continue;
+    }
+
+    const Tensor& bound_tensor = output.Get<Tensor>();
+    AllocatorPtr allocator = utils::GetAllocator(session_state_, bound_tensor.Location());
+    if (!allocator) {
+      continue;
+    }
+
+    const DataTypeImpl* element_type = bound_tensor.DataType();
+    fetch_allocators[i] = [allocator, element_type](const TensorShape& shape, MLValue& mlvalue) {
+      int64_t len = shape.Size();
+      if (len < 0) {
+        return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor shape cannot contain any negative value");
+      }
+
+      size_t size;
+      if (!IAllocator::CalcMemSizeForArrayWithAlignment<64>(len, element_type->Size(), &size)) {
+        return Status(ONNXRUNTIME, FAIL, "size overflow");
+      }
+
+      void* buffer = size == 0 ? nullptr : allocator->Alloc(size);
+      std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(element_type, shape, buffer, allocator->Info(),
+                                                                  allocator);
+      mlvalue.Init(p_tensor.release(),
+                   DataTypeImpl::GetType<Tensor>(),
+                   DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+      return Status::OK();
+    };
+  }
+
+  return fetch_allocators;
+}
+
 const std::vector<std::string>& IOBinding::GetOutputNames() const {
   return output_names_;
 }
@@ -85,6 +293,10 @@ std::vector<MLValue>& IOBinding::GetOutputs() {
   return outputs_;
 }
 
+const std::vector<MLValue>& IOBinding::GetOutputs() const {
+  return outputs_;
+}
+
 const std::vector<std::string>& IOBinding::GetInputNames() const {
   return feed_names_;
 }
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "core/framework/execution_provider.h"
+#include "core/framework/iexecutor.h"
 #include "core/common/status.h"
 #include "core/graph/basic_types.h"
 #include "core/framework/ml_value.h"
@@ -59,14 +60,48 @@ class IOBinding {
   common::Status SynchronizeOutputs();
   /**
     * This simply provides the names and optionally allocated output containers.
+    * If the output container is allocated and its shape matches the one produced by the model,
+    * the output is written directly into it.
     */
   common::Status BindOutput(const std::string& name, const MLValue& ml_value);
 
+  /**
+    * Binds an output to a device without pre-allocating it. The output is allocated on the first Run()
+    * using the allocator registered for @param location and is reused by the following calls to Run().
+    */
+  common::Status BindOutput(const std::string& name, const OrtAllocatorInfo& location);
+
+  /**
+    * Binds the graph output @param output_name to the graph input @param input_name as state which is kept
+    * between calls to Run(), e.g. the Y_h output of an LSTM and its initial_h input when a stream is fed one frame
+    * at a time. Each Run() feeds the state to the input and writes the new state directly into a second buffer,
+    * and the two buffers are swapped afterwards, so the state stays resident without being copied or reallocated.
+    * @param initial_value is fed until the first Run() and after ResetStates(). If it is not allocated the input is
+    * not fed in those runs and gets its default value from the model.
+    * The output is also available from GetOutputs() after each Run(). It is overwritten by the Run() after next.
+    */
+  common::Status BindState(const std::string& input_name, const std::string& output_name,
+                           const MLValue& initial_value);
+
+  /**
+    * Restarts all the states bound so far from their initial value, e.g. at the start of a new stream.
+    */
+  void ResetStates();
+
+  /**
+    * Removes all the inputs, outputs or states bound so far.
+    * Clearing the states also removes the state inputs and outputs bound by Run().
+    */
+  void ClearInputs();
+  void ClearOutputs();
+  void ClearStates();
+
   /**
     * This simply collects the outputs obtained after calling Run() inside the @param outputs.
     */
   const std::vector<std::string>& GetOutputNames() const;
   std::vector<MLValue>& GetOutputs();
+  const std::vector<MLValue>& GetOutputs() const;
 
   const std::vector<std::string>& GetInputNames() const;
   const std::vector<MLValue>& GetInputs() const;
@@ -82,11 +117,42 @@ class IOBinding {
   friend InferenceSession;
 
   IOBinding(const SessionState& session_state);
+
+  /**
+    * Called by InferenceSession::Run() to move the outputs bound to a device which were produced
+    * somewhere else.
+    */
+  common::Status CopyOutputsToBoundLocations();
+
+  /**
+    * Called by InferenceSession::Run() to get the custom allocators of the pre-allocated outputs, which replace an
+    * output by a new one at the same location if the shape produced differs.
+    */
+  std::unordered_map<size_t, IExecutor::CustomAllocator> CreateFetchAllocators() const;
+
+  /**
+    * Called by InferenceSession::Run() to feed the states and bind the buffers the new states are written to,
+    * and after a successful run to make those buffers the current states.
+    */
+  common::Status PrepareStates();
+  void UpdateStates();
+
+  struct State {
+    std::string input_name;
+    std::string output_name;
+    MLValue initial_value;
+    MLValue buffers[2];
+    int current = -1;  // index in buffers of the state fed to the next Run(), -1 to feed initial_value
+  };
+
   const SessionState& session_state_;
   std::vector<std::string> feed_names_;
   std::vector<MLValue> feeds_;
   std::vector<std::string> output_names_;
   std::vector<MLValue> outputs_;
+  // allocators requested for the outputs bound with a location, key is the index in outputs_
+  std::unordered_map<size_t, AllocatorPtr> output_allocators_;
+  std::vector<State> states_;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 };
@@ -90,6 +90,13 @@ ORT_API(int, OrtSetSessionThreadPoolSize, _In_ OrtSessionOptions* options, int s
   return 0;
 }
 
+///How many threads the kernels of the default CPU execution provider split their work across.
+ORT_API(int, OrtSetIntraOpNumThreads, _In_ OrtSessionOptions* options, int intra_op_num_threads) {
+  if (intra_op_num_threads <= 0) return -1;
+  options->value.intra_op_num_threads = intra_op_num_threads;
+  return 0;
+}
+
 ORT_API(void, OrtAppendCustomOpLibPath, _In_ OrtSessionOptions* options, const char* lib_path) {
   options->custom_op_paths.emplace_back(lib_path);
 }
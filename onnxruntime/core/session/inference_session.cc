@@ -341,7 +341,7 @@ class InferenceSession::Impl {
       // Register default CPUExecutionProvider if user didn't provide it through the Register() calls
       if (!execution_providers_.Get(onnxruntime::kCpuExecutionProvider)) {
         LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
-        CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+        CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena, session_options_.intra_op_num_threads};
         ORT_RETURN_IF_ERROR(execution_providers_.Add(onnxruntime::kCpuExecutionProvider,
                                                      std::make_unique<CPUExecutionProvider>(epi)));
       }
@@ -551,11 +551,14 @@ class InferenceSession::Impl {
     return common::Status::OK();
   }
 
+  // fetch_allocators are optional custom allocators for the fetches, the key is the index in *p_fetches.
+  // A pre-allocated fetch with a custom allocator is replaced by a new value if the output has another shape.
   Status Run(const RunOptions& run_options,
              const std::vector<std::string>& feed_names,
              const std::vector<MLValue>& feeds,
              const std::vector<std::string>& output_names,
-             std::vector<MLValue>* p_fetches) {
+             std::vector<MLValue>* p_fetches,
+             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators = {}) {
     auto tp = session_profiler_.StartTime();
     Status retval = Status::OK();
 
@@ -645,13 +648,14 @@ class InferenceSession::Impl {
       if (cached_feeds_fetches_manager) {
         // used the const cached_feeds_fetches_manager to execute the graph
         ORT_CHECK_AND_SET_RETVAL(
-            utils::ExecuteGraphWithCachedInfo(session_state_, *cached_feeds_fetches_manager, feeds, *p_fetches, {},
+            utils::ExecuteGraphWithCachedInfo(session_state_, *cached_feeds_fetches_manager, feeds, *p_fetches,
+                                              fetch_allocators,
                                               session_options_.enable_sequential_execution, run_options.terminate,
                                               run_logger));
       } else {
         // execute the graph and update feeds_fetches_manager
         ORT_CHECK_AND_SET_RETVAL(
-            utils::ExecuteGraph(session_state_, *feeds_fetches_manager, feeds, *p_fetches, {},
+            utils::ExecuteGraph(session_state_, *feeds_fetches_manager, feeds, *p_fetches, fetch_allocators,
                                 session_options_.enable_sequential_execution, run_options.terminate, run_logger,
                                 run_options.cache_feeds_fetches_info));
       }
@@ -730,7 +734,11 @@ class InferenceSession::Impl {
   common::Status Run(const RunOptions& run_options, IOBinding& io_binding) {
     // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
     // io_binding.SynchronizeInputs();
-    return Run(run_options, io_binding.feed_names_, io_binding.feeds_, io_binding.output_names_, &io_binding.outputs_);
+    ORT_RETURN_IF_ERROR(io_binding.PrepareStates());
+    ORT_RETURN_IF_ERROR(Run(run_options, io_binding.feed_names_, io_binding.feeds_, io_binding.output_names_,
+                            &io_binding.outputs_, io_binding.CreateFetchAllocators()));
+    io_binding.UpdateStates();
+    return io_binding.CopyOutputsToBoundLocations();
   }
 
   common::Status Run(IOBinding& io_binding) {
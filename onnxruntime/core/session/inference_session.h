@@ -61,6 +61,10 @@ struct SessionOptions {
 
   // How many threads in the session thread pool.
   int session_thread_pool_size = 0;
+
+  // How many threads the kernels of the default CPU execution provider split their work across.
+  // 0 uses one thread per hardware thread.
+  int intra_op_num_threads = 0;
 };
 
 /**
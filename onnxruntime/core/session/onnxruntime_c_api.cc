@@ -20,6 +20,7 @@
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/onnxruntime_typeinfo.h"
 #include "core/session/inference_session.h"
+#include "core/session/IOBinding.h"
 #include "core/framework/data_types.h"
 #include "abi_session_options_impl.h"
 
@@ -133,12 +134,11 @@ ORT_API_STATUS_IMPL(OrtCreateEnv, OrtLoggingLevel default_warning_level,
 
 ORT_API_STATUS_IMPL(OrtGetStringTensorDataLength, _In_ const OrtValue* value, _Out_ size_t* out) {
   TENSOR_READ_API_BEGIN
-  const auto* src = tensor.Data<std::string>();
   int64_t len = tensor.Shape().Size();
   if (len >= 0) {
     size_t ret = 0;
     for (int64_t i = 0; i != len; ++i) {
-      ret += src[i].size();
+      ret += tensor.StringAt(i).size();
     }
     *out = ret;
   } else
@@ -149,14 +149,21 @@ ORT_API_STATUS_IMPL(OrtGetStringTensorDataLength, _In_ const OrtValue* value, _O
 
 ORT_API_STATUS_IMPL(OrtFillStringTensor, _In_ OrtValue* value, _In_ const char* const* s, size_t s_len) {
   TENSOR_READWRITE_API_BEGIN
-  auto* dst = tensor->MutableData<std::string>();
   auto len = static_cast<size_t>(tensor->Shape().Size());
   if (s_len < len) {
     return OrtCreateStatus(ORT_INVALID_ARGUMENT, "input array is too short");
   }
+  std::vector<size_t> lengths(len);
+  size_t total_len = 0;
   for (size_t i = 0; i != len; ++i) {
-    //allocate and copy
-    dst[i] = s[i];
+    lengths[i] = strlen(s[i]);
+    total_len += lengths[i];
+  }
+  // copied once into the arena of the tensor instead of allocating every string
+  auto& dst = tensor->InitStringArena();
+  dst.Reserve(len, total_len);
+  for (size_t i = 0; i != len; ++i) {
+    dst.Append(s[i], lengths[i]);
   }
   return nullptr;
   API_IMPL_END
@@ -456,6 +463,111 @@ ORT_API_STATUS_IMPL(OrtRun, _In_ OrtSession* sess,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtCreateIoBinding, _Inout_ OrtSession* sess, _Out_ OrtIoBinding** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  std::unique_ptr<::onnxruntime::IOBinding> binding;
+  auto status = session->NewIOBinding(&binding);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  *out = reinterpret_cast<OrtIoBinding*>(binding.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtBindInput, _Inout_ OrtIoBinding* binding, _In_ const char* name, _In_ const OrtValue* value) {
+  API_IMPL_BEGIN
+  auto status = reinterpret_cast<::onnxruntime::IOBinding*>(binding)->BindInput(
+      name, *reinterpret_cast<const ::onnxruntime::MLValue*>(value));
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtBindOutput, _Inout_ OrtIoBinding* binding, _In_ const char* name, _In_ const OrtValue* value) {
+  API_IMPL_BEGIN
+  auto status = reinterpret_cast<::onnxruntime::IOBinding*>(binding)->BindOutput(
+      name, *reinterpret_cast<const ::onnxruntime::MLValue*>(value));
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtBindOutputToDevice, _Inout_ OrtIoBinding* binding, _In_ const char* name,
+                    _In_ const OrtAllocatorInfo* info) {
+  API_IMPL_BEGIN
+  auto status = reinterpret_cast<::onnxruntime::IOBinding*>(binding)->BindOutput(name, *info);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtClearBoundInputs, _Inout_ OrtIoBinding* binding) {
+  reinterpret_cast<::onnxruntime::IOBinding*>(binding)->ClearInputs();
+}
+
+ORT_API(void, OrtClearBoundOutputs, _Inout_ OrtIoBinding* binding) {
+  reinterpret_cast<::onnxruntime::IOBinding*>(binding)->ClearOutputs();
+}
+
+ORT_API_STATUS_IMPL(OrtBindState, _Inout_ OrtIoBinding* binding, _In_ const char* input_name,
+                    _In_ const char* output_name, _In_opt_ const OrtValue* initial_value) {
+  API_IMPL_BEGIN
+  auto status = reinterpret_cast<::onnxruntime::IOBinding*>(binding)->BindState(
+      input_name, output_name,
+      initial_value == nullptr ? MLValue() : *reinterpret_cast<const ::onnxruntime::MLValue*>(initial_value));
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtResetBoundStates, _Inout_ OrtIoBinding* binding) {
+  reinterpret_cast<::onnxruntime::IOBinding*>(binding)->ResetStates();
+}
+
+ORT_API_STATUS_IMPL(OrtRunWithBinding, _Inout_ OrtSession* sess, _In_opt_ OrtRunOptions* run_options,
+                    _Inout_ OrtIoBinding* binding) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  auto& io_binding = *reinterpret_cast<::onnxruntime::IOBinding*>(binding);
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->Run(op, io_binding);
+  } else {
+    status = session->Run(*run_options, io_binding);
+  }
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtGetBoundOutputCount, _In_ const OrtIoBinding* binding, _Out_ size_t* out) {
+  API_IMPL_BEGIN
+  *out = reinterpret_cast<const ::onnxruntime::IOBinding*>(binding)->GetOutputNames().size();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtGetBoundOutputValue, _In_ const OrtIoBinding* binding, size_t index, _Out_ OrtValue** out) {
+  API_IMPL_BEGIN
+  const auto& outputs = reinterpret_cast<const ::onnxruntime::IOBinding*>(binding)->GetOutputs();
+  if (index >= outputs.size()) {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "output index is out of range");
+  }
+  if (!outputs[index].IsAllocated()) {
+    return OrtCreateStatus(ORT_FAIL, "output is not computed yet, call OrtRunWithBinding first");
+  }
+  *out = reinterpret_cast<OrtValue*>(new MLValue(outputs[index]));
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtGetTensorMutableData, _In_ OrtValue* value, _Out_ void** output) {
   TENSOR_READWRITE_API_BEGIN
   //TODO: test if it's a string tensor
@@ -467,7 +579,6 @@ ORT_API_STATUS_IMPL(OrtGetTensorMutableData, _In_ OrtValue* value, _Out_ void**
 ORT_API_STATUS_IMPL(OrtGetStringTensorContent, _In_ const OrtValue* value,
                     _Out_ void* s, size_t s_len, _Out_ size_t* offsets, size_t offsets_len) {
   TENSOR_READ_API_BEGIN
-  const auto* input = tensor.Data<std::string>();
   auto len = static_cast<size_t>(tensor.Shape().Size());
   if (offsets_len < len) {
     return OrtCreateStatus(ORT_FAIL, "space is not enough");
@@ -475,7 +586,7 @@ ORT_API_STATUS_IMPL(OrtGetStringTensorContent, _In_ const OrtValue* value,
   {
     size_t ret = 0;
     for (size_t i = 0; i != len; ++i) {
-      ret += input[i].size();
+      ret += tensor.StringAt(i).size();
     }
     if (s_len < ret) {
       return OrtCreateStatus(ORT_FAIL, "space is not enough");
@@ -483,11 +594,12 @@ ORT_API_STATUS_IMPL(OrtGetStringTensorContent, _In_ const OrtValue* value,
   }
   size_t f = 0;
   char* p = static_cast<char*>(s);
-  for (size_t i = 0; i != offsets_len; ++i, ++offsets) {
-    memcpy(p, input[i].data(), input[i].size());
-    p += input[i].size();
+  for (size_t i = 0; i != len; ++i, ++offsets) {
+    const StringView input = tensor.StringAt(i);
+    memcpy(p, input.data(), input.size());
+    p += input.size();
     *offsets = f;
-    f += input[i].size();
+    f += input.size();
   }
   return nullptr;
   API_IMPL_END
@@ -744,13 +856,18 @@ OrtStatus* PopulateTensorWithData<std::string>(OrtValue* oval, const std::string
                                                size_t num_elems) {
   auto v = reinterpret_cast<MLValue*>(oval);
   auto tensor = v->GetMutable<Tensor>();
-  auto* dst = tensor->MutableData<std::string>();
   auto len = static_cast<size_t>(tensor->Shape().Size());
   if (num_elems < len) {
     return OrtCreateStatus(ORT_INVALID_ARGUMENT, "input array is too short");
   }
+  size_t total_len = 0;
+  for (size_t i = 0; i < len; ++i) {
+    total_len += data_elem[i].size();
+  }
+  auto& dst = tensor->InitStringArena();
+  dst.Reserve(len, total_len);
   for (size_t i = 0; i < len; ++i) {
-    dst[i] = data_elem[i];
+    dst.Append(data_elem[i]);
   }
   return nullptr;
 }
@@ -1061,4 +1178,5 @@ DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Env, OrtEnv)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Value, MLValue)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(RunOptions, OrtRunOptions)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Session, ::onnxruntime::InferenceSession)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(IoBinding, ::onnxruntime::IOBinding)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION_FOR_ARRAY(Status, char)
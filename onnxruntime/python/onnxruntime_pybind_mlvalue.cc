@@ -12,6 +12,8 @@
 #include "core/framework/tensor_shape.h"
 #include "core/framework/tensor.h"
 
+#include <algorithm>
+
 using namespace std;
 namespace onnxruntime {
 namespace python {
@@ -75,7 +77,43 @@ bool PyObjectCheck_Array(PyObject* o) {
   return PyObject_HasAttrString(o, "__array_finalize__");
 }
 
+// A numeric array which is already C-contiguous, aligned and in native byte order
+// can be used in place by the CPU execution provider without any copy.
+static bool IsNumpyArrayZeroCopyCompatible(PyArrayObject* pyObject) {
+  const int npy_type = PyArray_TYPE(pyObject);
+  if (npy_type == NPY_UNICODE || npy_type == NPY_STRING || npy_type == NPY_VOID || npy_type == NPY_OBJECT) {
+    return false;
+  }
+  return PyArray_IS_C_CONTIGUOUS(pyObject) && PyArray_ISALIGNED(pyObject) && PyArray_ISNOTSWAPPED(pyObject);
+}
+
+static std::vector<int64_t> GetNumpyArrayShape(PyArrayObject* pyObject) {
+  // numpy requires long int as its dims.
+  int ndim = PyArray_NDIM(pyObject);
+  npy_intp* npy_dims = PyArray_DIMS(pyObject);
+  std::vector<int64_t> dims(ndim);
+  for (int i = 0; i < ndim; ++i) {
+    dims[i] = npy_dims[i];
+  }
+  return dims;
+}
+
 void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyArrayObject* pyObject, MLValue* p_mlvalue) {
+  if (IsNumpyArrayZeroCopyCompatible(pyObject)) {
+    // The tensor does not own the buffer, it points to the numpy data.
+    // The caller must hold a reference to the array until the MLValue is released.
+    TensorShape shape(GetNumpyArrayShape(pyObject));
+    auto element_type = NumpyToOnnxRuntimeTensorType(PyArray_TYPE(pyObject));
+    std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(element_type,
+                                                                shape,
+                                                                PyArray_DATA(pyObject),
+                                                                alloc->Info());
+    p_mlvalue->Init(p_tensor.release(),
+                    DataTypeImpl::GetType<Tensor>(),
+                    DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    return;
+  }
+
   PyArrayObject* darray = PyArray_GETCONTIGUOUS(pyObject);
   if (darray == NULL) {
     throw std::runtime_error(std::string("The object must be a contiguous array for input '") + name_input + std::string("'."));
@@ -84,19 +122,13 @@ void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyAr
   try {
     const int npy_type = PyArray_TYPE(darray);
 
-    // numpy requires long int as its dims.
-    int ndim = PyArray_NDIM(darray);
-    npy_intp* npy_dims = PyArray_DIMS(darray);
-    std::vector<int64_t> dims(ndim);
-    for (int i = 0; i < ndim; ++i) {
-      dims[i] = npy_dims[i];
-    }
-
-    TensorShape shape(dims);
+    TensorShape shape(GetNumpyArrayShape(darray));
     auto element_type = NumpyToOnnxRuntimeTensorType(npy_type);
     void* buffer = alloc->Alloc(element_type->Size() * shape.Size());
 
-    if (npy_type != NPY_UNICODE && npy_type != NPY_OBJECT) {
+    const bool is_string = npy_type == NPY_UNICODE || npy_type == NPY_STRING ||
+                           npy_type == NPY_VOID || npy_type == NPY_OBJECT;
+    if (!is_string) {
       memcpy(buffer, static_cast<void*>(PyArray_DATA(darray)), element_type->Size() * shape.Size());
     }
 
@@ -108,9 +140,11 @@ void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyAr
     if (npy_type == NPY_UNICODE) {
       // Copy string data which needs to be done after Tensor is allocated.
       // Strings are Python strings or numpy.unicode string.
-      std::string* dst = static_cast<std::string*>(buffer);
+      // They are copied once, into the arena of the tensor.
+      StringArena& dst = p_tensor->InitStringArena();
       auto item_size = PyArray_ITEMSIZE(darray);
       auto num_chars = item_size / PyUnicode_4BYTE_KIND;
+      dst.Reserve(shape.Size(), num_chars * shape.Size());
       char* src = static_cast<char*>(PyArray_DATA(darray));
       const char* str;
       Py_ssize_t size;
@@ -120,11 +154,11 @@ void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyAr
         pStr = PyUnicode_FromKindAndData(PyUnicode_4BYTE_KIND, src, num_chars);
         str = PyUnicode_AsUTF8AndSize(pStr, &size);
         if (str == NULL) {
-          dst[i] = "";
+          dst.Append("", 0);
         } else {
           // Size is equal to the longest string size, numpy stores
           // strings in a single array. Those code assumes a string ends with a final 0.
-          dst[i] = str;
+          dst.Append(str, strlen(str));
         }
         Py_XDECREF(pStr);
       }
@@ -132,29 +166,38 @@ void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyAr
       // Copy string data which needs to be done after Tensor is allocated.
       // Strings are given as bytes (encoded strings).
       // NPY_VOID does not trim final 0.
-      // NPY_STRING assumes bytes string ends with a final 0.
-      std::string* dst = static_cast<std::string*>(buffer);
+      // NPY_STRING ends with a final 0 unless the string fills the whole item.
+      StringArena& dst = p_tensor->InitStringArena();
       auto item_size = PyArray_ITEMSIZE(darray);
+      dst.Reserve(shape.Size(), item_size * shape.Size());
       char* src = static_cast<char*>(PyArray_DATA(darray));
       for (int i = 0; i < shape.Size(); i++, src += item_size) {
         if (npy_type == NPY_STRING) {
-          dst[i] = src;
+          dst.Append(src, std::find(src, src + item_size, '\0') - src);
         } else {
-          dst[i].resize(item_size);
-          memcpy((void*)dst[i].c_str(), src, item_size);
+          dst.Append(src, item_size);
         }
       }
     } else if (npy_type == NPY_OBJECT) {
       // Converts object into string.
-      std::string* dst = static_cast<std::string*>(buffer);
+      StringArena& dst = p_tensor->InitStringArena();
+      dst.Reserve(shape.Size(), 0);
       auto item_size = PyArray_ITEMSIZE(darray);
       char* src = static_cast<char*>(PyArray_DATA(darray));
       PyObject *item, *pStr;
+      const char* str;
+      Py_ssize_t size;
       for (int i = 0; i < shape.Size(); ++i, src += item_size) {
         // Python unicode strings are assumed to be USC-4. Strings are stored as UTF-8.
         item = PyArray_GETITEM(darray, src);
         pStr = PyObject_Str(item);
-        dst[i] = py::reinterpret_borrow<py::str>(pStr);
+        Py_XDECREF(item);
+        str = (pStr == NULL) ? NULL : PyUnicode_AsUTF8AndSize(pStr, &size);
+        if (str == NULL) {
+          Py_XDECREF(pStr);
+          throw py::error_already_set();
+        }
+        dst.Append(str, static_cast<size_t>(size));
         Py_XDECREF(pStr);
       }
     }
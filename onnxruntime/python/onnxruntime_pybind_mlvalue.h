@@ -24,6 +24,8 @@ namespace py = pybind11;
 
 int OnnxRuntimeTensorToNumpyType(const DataTypeImpl* tensor_type);
 
+// Contiguous numeric numpy arrays are wrapped without copying their data,
+// the caller must keep 'value' alive as long as 'p_mlvalue' is in use.
 void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue);
 
 }  // namespace python
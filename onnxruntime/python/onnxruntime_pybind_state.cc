@@ -68,7 +68,12 @@ std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_BrainS
 #pragma warning(disable : 4267 4996 4503 4003)
 #endif  // _MSC_VER
 
+#include <chrono>
+#include <future>
 #include <iterator>
+#include <thread>
+
+#include "core/common/task_thread_pool.h"
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4267 4996 4503 4003)
@@ -142,6 +147,23 @@ void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
 
   MLDataType dtype = rtensor.DataType();
   const int numpy_type = OnnxRuntimeTensorToNumpyType(dtype);
+
+  if (numpy_type != NPY_OBJECT && rtensor.OwnsBuffer() && strcmp(rtensor.Location().name, CPU) == 0) {
+    // The numpy array uses the tensor buffer directly. A copy of the MLValue is kept
+    // in a capsule set as the array base so the buffer lives as long as the array.
+    py::capsule owner(new MLValue(val), [](void* p) { delete static_cast<MLValue*>(p); });
+    py::object obj = py::reinterpret_steal<py::object>(PyArray_SimpleNewFromData(
+        shape.NumDimensions(), npy_dims.data(), numpy_type, const_cast<void*>(rtensor.DataRaw(dtype))));
+    if (!obj) {
+      throw std::runtime_error("Unable to create a numpy array from the output tensor.");
+    }
+    if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), owner.release().ptr()) != 0) {
+      throw std::runtime_error("Unable to attach the output tensor to its numpy array.");
+    }
+    pyobjs.push_back(obj);
+    return;
+  }
+
   py::object obj = py::reinterpret_steal<py::object>(PyArray_SimpleNew(
       shape.NumDimensions(), npy_dims.data(), numpy_type));
 
@@ -152,10 +174,11 @@ void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
     memcpy(outPtr, rtensor.DataRaw(dtype), dtype->Size() * shape.Size());
   } else {
     // Handle string type.
+    // The strings are read as views, so they are not copied out of an arena first.
     py::object* outObj = static_cast<py::object*>(outPtr);
-    const std::string* src = rtensor.template Data<std::string>();
-    for (int i = 0; i < rtensor.Shape().Size(); i++, src++) {
-      outObj[i] = py::cast(*src);
+    for (int i = 0; i < rtensor.Shape().Size(); i++) {
+      const StringView src = rtensor.StringAt(i);
+      outObj[i] = py::str(src.data(), src.size());
     }
   }
   pyobjs.push_back(obj);
@@ -217,6 +240,119 @@ void InitializeSession(InferenceSession* sess) {
   }
 }  // namespace python
 
+NameMLValMap CreateFeeds(std::map<std::string, py::object>& pyfeeds) {
+  NameMLValMap feeds;
+  for (auto& _ : pyfeeds) {
+    MLValue ml_value;
+    CreateGenericMLValue(GetAllocator(), _.first, _.second, &ml_value);
+    if (PyErr_Occurred()) {
+      PyObject *ptype, *pvalue, *ptraceback;
+      PyErr_Fetch(&ptype, &pvalue, &ptraceback);
+
+      PyObject* pStr = PyObject_Str(ptype);
+      std::string sType = py::reinterpret_borrow<py::str>(pStr);
+      Py_XDECREF(pStr);
+      pStr = PyObject_Str(pvalue);
+      sType += ": ";
+      sType += py::reinterpret_borrow<py::str>(pStr);
+      Py_XDECREF(pStr);
+      throw std::runtime_error(sType);
+    }
+    feeds.insert(std::make_pair(_.first, ml_value));
+  }
+  return feeds;
+}
+
+std::vector<py::object> CreatePyFetches(std::vector<MLValue>& fetches) {
+  std::vector<py::object> rfetch;
+  rfetch.reserve(fetches.size());
+  for (auto& _ : fetches) {
+    if (_.IsTensor()) {
+      AddTensorAsPyObj(_, rfetch);
+    } else {
+      AddNonTensorAsPyObj(_, rfetch);
+    }
+  }
+  return rfetch;
+}
+
+// Must be called without holding the GIL.
+common::Status RunSession(InferenceSession* sess, const RunOptions* run_options, const NameMLValMap& feeds,
+                          const std::vector<std::string>& output_names, std::vector<MLValue>& fetches) {
+  if (run_options != nullptr) {
+    return sess->Run(*run_options, feeds, output_names, &fetches);
+  }
+  return sess->Run(feeds, output_names, &fetches);
+}
+
+// Thread pool shared by all sessions to execute run_async requests.
+static TaskThreadPool& GetRunAsyncThreadPool() {
+  static TaskThreadPool pool{std::max<size_t>(1, std::thread::hardware_concurrency())};
+  return pool;
+}
+
+/**
+ * Result of InferenceSession.run_async.
+ * The inputs are converted in the calling thread, the inference runs on a native thread
+ * without the GIL and the outputs are converted to python objects when result() is called.
+ * The python session and run options are kept alive by the binding until the future is released.
+ */
+class RunFuture {
+ public:
+  RunFuture(InferenceSession* sess, std::vector<std::string> output_names,
+            std::map<std::string, py::object> pyfeeds, const RunOptions* run_options)
+      : pyfeeds_(std::move(pyfeeds)), state_(std::make_shared<State>()) {
+    state_->output_names = std::move(output_names);
+    state_->feeds = CreateFeeds(pyfeeds_);
+
+    std::shared_ptr<State> state = state_;
+    std::packaged_task<void()> task{[sess, run_options, state]() {
+      state->status = RunSession(sess, run_options, state->feeds, state->output_names, state->fetches);
+    }};
+    future_ = task.get_future();
+    GetRunAsyncThreadPool().RunTask(std::move(task));
+  }
+
+  ~RunFuture() {
+    // The native thread may still read the numpy buffers held by pyfeeds_.
+    if (future_.valid()) {
+      py::gil_scoped_release release;
+      future_.wait();
+    }
+  }
+
+  bool Done() const {
+    return !future_.valid() ||
+           future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
+
+  std::vector<py::object> Result() {
+    if (future_.valid()) {
+      py::gil_scoped_release release;
+      future_.get();
+    }
+
+    if (!state_->status.IsOK()) {
+      auto mes = state_->status.ToString();
+      throw std::runtime_error(std::string("Method run_async failed due to: ") + std::string(mes.c_str()));
+    }
+
+    return CreatePyFetches(state_->fetches);
+  }
+
+ private:
+  struct State {
+    std::vector<std::string> output_names;
+    NameMLValMap feeds;
+    std::vector<MLValue> fetches;
+    common::Status status;
+  };
+
+  std::map<std::string, py::object> pyfeeds_;
+  std::shared_ptr<State> state_;
+  std::future<void> future_;
+};
+
 void addGlobalMethods(py::module& m) {
   m.def("get_session_initializer", &SessionObjectInitializer::Get, "Return a default session object initializer.");
   m.def(
@@ -249,7 +385,9 @@ Set this option to false if you don't want it. Default is True.)pbdoc")
                      R"pbdoc(Applies to session load, initialization, etc. Default is 0.)pbdoc")
       .def_readwrite("session_thread_pool_size", &SessionOptions::session_thread_pool_size,
                      R"pbdoc(How many threads in the session thread pool. Default is 0 to let onnxruntime choose.
-This parameter is unused unless *enable_sequential_execution* is false.)pbdoc");
+This parameter is unused unless *enable_sequential_execution* is false.)pbdoc")
+      .def_readwrite("intra_op_num_threads", &SessionOptions::intra_op_num_threads,
+                     R"pbdoc(How many threads the operators split their work across. Default is 0 to use one thread per hardware thread.)pbdoc");
 
   py::class_<RunOptions>(m, "RunOptions", R"pbdoc(Configuration information for a single Run.)pbdoc")
       .def(py::init())
@@ -326,6 +464,11 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           },
           "node shape (assuming the node holds a tensor)");
 
+  py::class_<RunFuture>(m, "RunFuture", R"pbdoc(Pending result of InferenceSession.run_async.)pbdoc")
+      .def("done", &RunFuture::Done, "Returns True if the inference is finished.")
+      .def("result", &RunFuture::Result,
+           R"pbdoc(Waits for the inference to finish and returns the outputs. Raises an exception if it failed.)pbdoc");
+
   py::class_<SessionObjectInitializer>(m, "SessionObjectInitializer");
   py::class_<InferenceSession>(m, "InferenceSession", R"pbdoc(This is the main class used to run a model.)pbdoc")
       .def(py::init<SessionObjectInitializer, SessionObjectInitializer>())
@@ -350,33 +493,16 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           },
           R"pbdoc(Load a model serialized in ONNX format.)pbdoc")
       .def("run", [](InferenceSession* sess, std::vector<std::string> output_names, std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr) -> std::vector<py::object> {
-        NameMLValMap feeds;
-        for (auto _ : pyfeeds) {
-          MLValue ml_value;
-          CreateGenericMLValue(GetAllocator(), _.first, _.second, &ml_value);
-          if (PyErr_Occurred()) {
-            PyObject *ptype, *pvalue, *ptraceback;
-            PyErr_Fetch(&ptype, &pvalue, &ptraceback);
-
-            PyObject* pStr = PyObject_Str(ptype);
-            std::string sType = py::reinterpret_borrow<py::str>(pStr);
-            Py_XDECREF(pStr);
-            pStr = PyObject_Str(pvalue);
-            sType += ": ";
-            sType += py::reinterpret_borrow<py::str>(pStr);
-            Py_XDECREF(pStr);
-            throw std::runtime_error(sType);
-          }
-          feeds.insert(std::make_pair(_.first, ml_value));
-        }
+        // pyfeeds holds a reference on every input array until the end of the run,
+        // the feeds may point directly to the numpy buffers.
+        NameMLValMap feeds = CreateFeeds(pyfeeds);
 
         std::vector<MLValue> fetches;
         common::Status status;
-
-        if (run_options != nullptr) {
-          status = sess->Run(*run_options, feeds, output_names, &fetches);
-        } else {
-          status = sess->Run(feeds, output_names, &fetches);
+        {
+          // The inference does not touch any python object, other python threads can run meanwhile.
+          py::gil_scoped_release release;
+          status = RunSession(sess, run_options, feeds, output_names, fetches);
         }
 
         if (!status.IsOK()) {
@@ -384,17 +510,14 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           throw std::runtime_error(std::string("Method run failed due to: ") + std::string(mes.c_str()));
         }
 
-        std::vector<py::object> rfetch;
-        rfetch.reserve(fetches.size());
-        for (auto _ : fetches) {
-          if (_.IsTensor()) {
-            AddTensorAsPyObj(_, rfetch);
-          } else {
-            AddNonTensorAsPyObj(_, rfetch);
-          }
-        }
-        return rfetch;
+        return CreatePyFetches(fetches);
       })
+      .def(
+          "run_async", [](InferenceSession* sess, std::vector<std::string> output_names, std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr) -> std::unique_ptr<RunFuture> {
+            return std::make_unique<RunFuture>(sess, std::move(output_names), std::move(pyfeeds), run_options);
+          },
+          py::keep_alive<0, 1>(), py::keep_alive<0, 4>(),
+          R"pbdoc(Starts the inference on a native thread and returns a RunFuture.)pbdoc")
       .def("end_profiling", [](InferenceSession* sess) -> std::string {
         return sess->EndProfiling();
       })
@@ -71,6 +71,30 @@ class InferenceSession:
             output_names = [output.name for output in self._outputs_meta]
         return self._sess.run(output_names, input_feed, run_options)
 
+    def run_async(self, output_names, input_feed, run_options=None):
+        """
+        Start computing the predictions on a native thread and return
+        immediately. The GIL is not held during the inference.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: a future, ``result()`` waits for the inference and
+            returns the outputs, ``done()`` tells if it is finished
+
+        ::
+
+            future = sess.run_async([output_name], {input_name: x})
+            res = future.result()
+        """
+        num_required_inputs = len(self._inputs_meta)
+        num_inputs = len(input_feed)
+        if num_inputs < num_required_inputs:
+            raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, num_inputs))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        return self._sess.run_async(output_names, input_feed, run_options)
+
     def end_profiling(self):
         """
         End profiling and return results in a file.
@@ -0,0 +1,130 @@
+#-------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+#--------------------------------------------------------------------------
+
+import argparse
+import numpy as np
+import onnx
+from onnx import helper, numpy_helper, TensorProto
+
+# Converts the float embedding tables of a model to 8 bit integers with a scale and zero point
+# per row, or to float16. The Gather nodes reading a table are replaced by the GatherDequantize
+# contrib operator, which converts only the gathered rows back to float.
+
+ms_domain = 'com.microsoft'
+
+
+def quantize_rows_uint8(table):
+    rows = table.reshape(table.shape[0], -1)
+    # include 0 in the range of each row so that it is represented exactly
+    row_min = np.minimum(rows.min(axis=1), 0.0) if rows.shape[1] else np.zeros(rows.shape[0])
+    row_max = np.maximum(rows.max(axis=1), 0.0) if rows.shape[1] else np.zeros(rows.shape[0])
+    scale = (row_max - row_min) / 255.0
+    scale[scale == 0.0] = 1.0
+    zero_point = np.clip(np.round(-row_min / scale), 0, 255)
+    quantized = np.clip(np.round(rows / scale[:, None]) + zero_point[:, None], 0, 255)
+    return (quantized.astype(np.uint8).reshape(table.shape), scale.astype(np.float32),
+            zero_point.astype(np.uint8))
+
+
+def quantize_rows_int8(table):
+    rows = table.reshape(table.shape[0], -1)
+    row_max = np.abs(rows).max(axis=1) if rows.shape[1] else np.zeros(rows.shape[0])
+    scale = row_max / 127.0
+    scale[scale == 0.0] = 1.0
+    quantized = np.clip(np.round(rows / scale[:, None]), -127, 127)
+    return quantized.astype(np.int8).reshape(table.shape), scale.astype(np.float32), None
+
+
+def find_tables(graph, min_elements):
+    initializers = {init.name: init for init in graph.initializer}
+    graph_outputs = set(output.name for output in graph.output)
+
+    consumers = {}
+    for node in graph.node:
+        for input_name in node.input:
+            consumers.setdefault(input_name, []).append(node)
+
+    tables = []
+    for name, init in initializers.items():
+        if init.data_type != TensorProto.FLOAT or len(init.dims) < 1 or name in graph_outputs:
+            continue
+        if np.prod(init.dims) < min_elements:
+            continue
+        # the float table can only be dropped if it is only read by Gather along the first axis
+        nodes = consumers.get(name, [])
+        is_table = lambda node: (node.op_type == 'Gather' and node.domain in ('', 'ai.onnx') and
+                                 node.input[0] == name and name not in node.input[1:] and
+                                 all(attr.name != 'axis' or attr.i == 0 for attr in node.attribute))
+        if nodes and all(is_table(node) for node in nodes):
+            tables.append((init, nodes))
+    return tables
+
+
+def convert_model(model, table_format, min_elements):
+    graph = model.graph
+    graph_inputs = {graph_input.name: graph_input for graph_input in graph.input}
+
+    tables = find_tables(graph, min_elements)
+    for init, nodes in tables:
+        table = numpy_helper.to_array(init).astype(np.float32)
+
+        if table_format == 'uint8':
+            quantized, scale, zero_point = quantize_rows_uint8(table)
+        elif table_format == 'int8':
+            quantized, scale, zero_point = quantize_rows_int8(table)
+        else:
+            quantized, scale, zero_point = table.astype(np.float16), None, None
+
+        new_initializers = [numpy_helper.from_array(quantized, init.name + '_' + table_format)]
+        if scale is not None:
+            new_initializers.append(numpy_helper.from_array(scale, init.name + '_scale'))
+        if zero_point is not None:
+            new_initializers.append(numpy_helper.from_array(zero_point, init.name + '_zero_point'))
+
+        graph.initializer.remove(init)
+        graph.initializer.extend(new_initializers)
+
+        # models with IR version < 4 list the initializers as graph inputs as well
+        if init.name in graph_inputs:
+            graph.input.remove(graph_inputs[init.name])
+            graph.input.extend([helper.make_tensor_value_info(new_init.name, new_init.data_type, new_init.dims)
+                                for new_init in new_initializers])
+
+        for node in nodes:
+            node.op_type = 'GatherDequantize'
+            node.domain = ms_domain
+            del node.attribute[:]
+            inputs = [new_init.name for new_init in new_initializers]
+            node.input[:] = [inputs[0], node.input[1]] + inputs[1:]
+
+        print('Converted {} {} to {}, used by {} node(s).'.format(init.name, list(init.dims), table_format,
+                                                                   len(nodes)))
+
+    if tables and not any(opset.domain == ms_domain for opset in model.opset_import):
+        model.opset_import.extend([helper.make_opsetid(ms_domain, 1)])
+
+    return len(tables)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert the float embedding tables of an ONNX model to '
+                                     '8 bit integers or float16, read with the GatherDequantize operator.')
+    parser.add_argument('input_model', help='input model path')
+    parser.add_argument('output_model', help='output model path')
+    parser.add_argument('--format', choices=['uint8', 'int8', 'float16'], default='uint8',
+                        help='storage of the tables. uint8 has a scale and zero point per row, int8 a scale '
+                        'per row. default=uint8')
+    parser.add_argument('--min_elements', type=int, default=1024,
+                        help='minimum number of elements of a table to convert it. default=1024')
+    args = parser.parse_args()
+
+    model = onnx.load(args.input_model)
+    if convert_model(model, args.format, args.min_elements) == 0:
+        print('No embedding table found.')
+    onnx.save(model, args.output_model)
+
+
+if __name__ == '__main__':
+    main()
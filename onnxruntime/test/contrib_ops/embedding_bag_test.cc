@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(EmbeddingBagOpTest, Sum) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<int64_t>("indices", {2, 2}, {0LL, 2LL, 1LL, 1LL});
+  test.AddOutput<float>("output", {2, 2}, {6.0f, 8.0f, 6.0f, 8.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, Mean) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<float>("data", {3, 1, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<int32_t>("indices", {1, 2, 3}, {0, 1, 2, 2, 2, 0});
+  test.AddOutput<float>("output", {1, 2, 1, 2}, {3.0f, 4.0f, 11.0f / 3.0f, 14.0f / 3.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, InvalidIndex) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<int64_t>("indices", {2, 2}, {0LL, 2LL, 1LL, 3LL});
+  test.AddOutput<float>("output", {2, 2}, {6.0f, 8.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds, idx=3");
+}
+
+TEST(EmbeddingBagOpTest, LargeTable) {
+  // enough work to be split across threads
+  const int64_t num_rows = 1000, row_size = 64, num_bags = 512, bag_size = 8;
+  std::vector<float> data(num_rows * row_size);
+  for (int64_t i = 0; i < num_rows * row_size; ++i) {
+    data[i] = static_cast<float>(i % 97);
+  }
+  std::vector<int64_t> indices(num_bags * bag_size);
+  for (int64_t i = 0; i < num_bags * bag_size; ++i) {
+    indices[i] = (i * 37) % num_rows;
+  }
+  std::vector<float> output(num_bags * row_size, 0.0f);
+  for (int64_t bag = 0; bag < num_bags; ++bag) {
+    for (int64_t i = 0; i < bag_size; ++i) {
+      for (int64_t j = 0; j < row_size; ++j) {
+        output[bag * row_size + j] += data[indices[bag * bag_size + i] * row_size + j];
+      }
+    }
+  }
+
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {num_rows, row_size}, data);
+  test.AddInput<int64_t>("indices", {num_bags, bag_size}, indices);
+  test.AddOutput<float>("output", {num_bags, row_size}, output);
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "core/util/math.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(GatherDequantizeOpTest, Uint8) {
+  OpTester test("GatherDequantize", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("data", {3, 2}, {0, 255, 10, 20, 128, 130});
+  test.AddInput<int64_t>("indices", {2}, {2LL, 0LL});
+  test.AddInput<float>("scale", {3}, {1.0f, 0.5f, 0.25f});
+  test.AddInput<uint8_t>("zero_point", {3}, {0, 10, 128});
+  test.AddOutput<float>("output", {2, 2}, {0.0f, 0.5f, 0.0f, 255.0f});
+  test.Run();
+}
+
+TEST(GatherDequantizeOpTest, Int8NoZeroPoint) {
+  OpTester test("GatherDequantize", 1, onnxruntime::kMSDomain);
+  test.AddInput<int8_t>("data", {2, 1, 2}, {-4, 4, 127, -127});
+  test.AddInput<int32_t>("indices", {1, 2}, {1, 0});
+  test.AddInput<float>("scale", {2}, {0.5f, 2.0f});
+  test.AddOutput<float>("output", {1, 2, 1, 2}, {254.0f, -254.0f, -2.0f, 2.0f});
+  test.Run();
+}
+
+TEST(GatherDequantizeOpTest, Float16) {
+  OpTester test("GatherDequantize", 1, onnxruntime::kMSDomain);
+  test.AddInput<MLFloat16>("data", {3, 2},
+                           {MLFloat16(math::floatToHalf(1.0f)), MLFloat16(math::floatToHalf(-2.0f)),
+                            MLFloat16(math::floatToHalf(0.5f)), MLFloat16(math::floatToHalf(4.0f)),
+                            MLFloat16(math::floatToHalf(-0.25f)), MLFloat16(math::floatToHalf(8.0f))});
+  test.AddInput<int64_t>("indices", {3}, {1LL, 1LL, 2LL});
+  test.AddOutput<float>("output", {3, 2}, {0.5f, 4.0f, 0.5f, 4.0f, -0.25f, 8.0f});
+  test.Run();
+}
+
+// more indices than the prefetch distance, rows of an odd size, and values that are not normal floats in half
+TEST(GatherDequantizeOpTest, Float16WideRows) {
+  const int64_t num_rows = 12;
+  const int64_t row_size = 5;
+  std::vector<float> table(num_rows * row_size);
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<float>(i) * 0.25f - 7.0f;
+  }
+  table[3] = std::numeric_limits<float>::infinity();
+  table[4] = -0.0f;
+  table[7] = 65504.0f;        // largest half
+  table[8] = 5.9604645e-08f;  // smallest subnormal half
+
+  std::vector<MLFloat16> data;
+  for (float value : table) {
+    data.push_back(MLFloat16(math::floatToHalf(value)));
+  }
+
+  std::vector<int32_t> indices = {11, 0, 1, 5, 5, 3, 10, 2, 9, 8, 7, 6, 4, 1, 0};
+  std::vector<float> expected;
+  for (int32_t idx : indices) {
+    expected.insert(expected.end(), table.begin() + idx * row_size, table.begin() + (idx + 1) * row_size);
+  }
+
+  OpTester test("GatherDequantize", 1, onnxruntime::kMSDomain);
+  test.AddInput<MLFloat16>("data", {num_rows, row_size}, data);
+  test.AddInput<int32_t>("indices", {static_cast<int64_t>(indices.size())}, indices);
+  test.AddOutput<float>("output", {static_cast<int64_t>(indices.size()), row_size}, expected);
+  test.Run();
+}
+
+TEST(GatherDequantizeOpTest, InvalidIndex) {
+  OpTester test("GatherDequantize", 1, onnxruntime::kMSDomain);
+  test.AddInput<int8_t>("data", {2, 2}, {1, 2, 3, 4});
+  test.AddInput<int64_t>("indices", {2}, {0LL, 2LL});
+  test.AddInput<float>("scale", {2}, {1.0f, 1.0f});
+  test.AddOutput<float>("output", {2, 2}, {1.0f, 2.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds, idx=2");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
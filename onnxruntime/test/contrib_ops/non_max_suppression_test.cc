@@ -239,5 +239,132 @@ TEST(NonMaxSuppressionOpTest, WithScoreThresholdPadToSixOutput) {
   test.Run();
 }
 
+TEST(BatchedNonMaxSuppressionOpTest, TwoBatchesTwoClasses) {
+  OpTester test("BatchedNonMaxSuppression", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("boxes", {2, 6, 4},
+                       {0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 0.1f, 1.0f, 1.1f,
+                        0.0f, -0.1f, 1.0f, 0.9f,
+                        0.0f, 10.0f, 1.0f, 11.0f,
+                        0.0f, 10.1f, 1.0f, 11.1f,
+                        0.0f, 100.0f, 1.0f, 101.0f,
+
+                        0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 0.1f, 1.0f, 1.1f,
+                        0.0f, -0.1f, 1.0f, 0.9f,
+                        0.0f, 10.0f, 1.0f, 11.0f,
+                        0.0f, 10.1f, 1.0f, 11.1f,
+                        0.0f, 100.0f, 1.0f, 101.0f});
+  test.AddInput<float>("scores", {2, 2, 6},
+                       {0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.3f, 0.5f, 0.95f, 0.6f, 0.75f, 0.9f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f});
+  test.AddInput<int64_t>("max_output_boxes_per_class", {1}, {2L});
+  test.AddInput<float>("iou_threshold", {1}, {0.5f});
+  test.AddInput<float>("score_threshold", {1}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {8, 3},
+                          {0L, 0L, 3L,
+                           0L, 0L, 0L,
+                           0L, 1L, 2L,
+                           0L, 1L, 5L,
+                           1L, 0L, 3L,
+                           1L, 0L, 0L,
+                           1L, 1L, 5L,
+                           1L, 1L, 4L});
+  test.Run();
+}
+
+TEST(BatchedNonMaxSuppressionOpTest, CenterPointBox) {
+  OpTester test("BatchedNonMaxSuppression", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("center_point_box", 1LL);
+  test.AddInput<float>("boxes", {1, 6, 4},
+                       {0.5f, 0.5f, 1.0f, 1.0f,
+                        0.5f, 0.6f, 1.0f, 1.0f,
+                        0.5f, 0.4f, 1.0f, 1.0f,
+                        0.5f, 10.5f, 1.0f, 1.0f,
+                        0.5f, 10.6f, 1.0f, 1.0f,
+                        0.5f, 100.5f, 1.0f, 1.0f});
+  test.AddInput<float>("scores", {1, 1, 6}, {0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f});
+  test.AddInput<int64_t>("max_output_boxes_per_class", {1}, {3L});
+  test.AddInput<float>("iou_threshold", {1}, {0.5f});
+  test.AddOutput<int64_t>("selected_indices", {3, 3},
+                          {0L, 0L, 3L,
+                           0L, 0L, 0L,
+                           0L, 0L, 5L});
+  test.Run();
+}
+
+TEST(BatchedNonMaxSuppressionOpTest, WithScoreThreshold) {
+  OpTester test("BatchedNonMaxSuppression", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("boxes", {1, 6, 4},
+                       {0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 0.1f, 1.0f, 1.1f,
+                        0.0f, -0.1f, 1.0f, 0.9f,
+                        0.0f, 10.0f, 1.0f, 11.0f,
+                        0.0f, 10.1f, 1.0f, 11.1f,
+                        0.0f, 100.0f, 1.0f, 101.0f});
+  test.AddInput<float>("scores", {1, 1, 6}, {0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f});
+  test.AddInput<int64_t>("max_output_boxes_per_class", {1}, {3L});
+  test.AddInput<float>("iou_threshold", {1}, {0.5f});
+  test.AddInput<float>("score_threshold", {1}, {0.4f});
+  test.AddOutput<int64_t>("selected_indices", {2, 3},
+                          {0L, 0L, 3L,
+                           0L, 0L, 0L});
+  test.Run();
+}
+
+TEST(BatchedNonMaxSuppressionOpTest, DefaultMaxOutputSelectsNothing) {
+  OpTester test("BatchedNonMaxSuppression", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("boxes", {1, 1, 4}, {0.0f, 0.0f, 1.0f, 1.0f});
+  test.AddInput<float>("scores", {1, 1, 1}, {0.9f});
+  test.AddOutput<int64_t>("selected_indices", {0, 3}, {});
+  test.Run();
+}
+
+TEST(BatchedNonMaxSuppressionOpTest, ManyClasses) {
+  // boxes on a grid that don't overlap, so every box above the score threshold is selected
+  constexpr int64_t num_classes = 80;
+  constexpr int64_t num_boxes = 200;
+  std::vector<float> boxes;
+  for (int64_t i = 0; i < num_boxes; ++i) {
+    const float x = static_cast<float>(i % 20) * 2.0f;
+    const float y = static_cast<float>(i / 20) * 2.0f;
+    boxes.insert(boxes.end(), {y, x, y + 1.0f, x + 1.0f});
+  }
+
+  std::vector<float> scores;
+  std::vector<int64_t> expected;
+  for (int64_t c = 0; c < num_classes; ++c) {
+    // class c scores box i with ((i + c) % num_boxes) / num_boxes, so the boxes of a class are
+    // selected from index num_boxes - 1 - c downwards, wrapping around
+    for (int64_t i = 0; i < num_boxes; ++i) {
+      scores.push_back(static_cast<float>((i + c) % num_boxes) / num_boxes);
+    }
+    for (int64_t k = 0; k < 10; ++k) {
+      expected.insert(expected.end(), {0, c, (2 * num_boxes - 1 - c - k) % num_boxes});
+    }
+  }
+
+  OpTester test("BatchedNonMaxSuppression", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("boxes", {1, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {1, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {1}, {10L});
+  test.AddInput<float>("iou_threshold", {1}, {0.5f});
+  test.AddOutput<int64_t>("selected_indices", {num_classes * 10, 3}, expected);
+  test.Run();
+}
+
+TEST(BatchedNonMaxSuppressionOpTest, InconsistentBoxAndScoreShapes) {
+  OpTester test("BatchedNonMaxSuppression", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("boxes", {1, 2, 4},
+                       {0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 0.1f, 1.0f, 1.1f});
+  test.AddInput<float>("scores", {1, 1, 3}, {0.9f, 0.75f, 0.6f});
+  test.AddInput<int64_t>("max_output_boxes_per_class", {1}, {3L});
+  test.AddOutput<int64_t>("selected_indices", {0, 3}, {});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "boxes and scores should have same spatial_dimension.");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -249,5 +249,42 @@ TEST(ROIAlignTest, AvgModeNegativeInvalidSecondRoiDims) {
 
   test.Run(OpTester::ExpectResult::kExpectFailure, "Second dimension for rois should be exactly 5");
 }
+
+TEST(ROIAlignTest, AvgModeManyChannels) {
+  OpTester test("ROIAlign", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("pooled_h", 7);
+  test.AddAttribute<int64_t>("pooled_w", 7);
+  test.AddAttribute<int64_t>("sampling_ratio", 2);
+  test.AddAttribute<float>("spatial_scale", 1.0f);
+
+  // several blocks of channels per ROI, with channels of constant value c so that the average of the
+  // interpolated samples of every bin is c
+  const int64_t N = 2;
+  const int64_t C = 40;
+  const int64_t H = 16;
+  const int64_t W = 16;
+  const int64_t num_rois = 3;
+
+  std::vector<float> X;
+  for (int64_t n = 0; n < N; ++n) {
+    for (int64_t c = 0; c < C; ++c) {
+      X.insert(X.end(), H * W, static_cast<float>(c));
+    }
+  }
+  std::vector<float> rois{0.f, 1.f, 1.f, 9.f, 12.f,
+                          1.f, 0.f, 0.f, 15.f, 15.f,
+                          1.f, 4.f, 2.f, 6.f, 5.f};
+  std::vector<float> Y;
+  for (int64_t n = 0; n < num_rois; ++n) {
+    for (int64_t c = 0; c < C; ++c) {
+      Y.insert(Y.end(), 7 * 7, static_cast<float>(c));
+    }
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("rois", {num_rois, 5}, rois);
+  test.AddOutput<float>("Y", {num_rois, C, 7, 7}, Y);
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
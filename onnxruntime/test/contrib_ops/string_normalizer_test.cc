@@ -179,6 +179,26 @@ TEST(ContribOpTest, StringNormalizerTest) {
     test.AddOutput<std::string>("Y", {6}, output);
     test.Run(OpTester::ExpectResult::kExpectSuccess);
   }
+  // - case-INSENSETIVE approach en_US locale
+  // - ASCII and non-ASCII stopwords in a different case than the input
+  // - LOWER, the compared strings are output
+  {
+    OpTester test("StringNormalizer", opset_ver, domain);
+    InitTestAttr(test, "LOWER", false, {u8"MONDAY", u8"понедельник"}, test_locale);
+    std::vector<int64_t> dims{1, 5};
+    std::vector<std::string> input = {std::string(u8"Monday"),
+                                      std::string(u8"TUESDAY"),
+                                      std::string(u8"ПОНЕДЕЛЬНИК"),
+                                      std::string(u8"Вторник"),
+                                      std::string(u8"École")};
+    test.AddInput<std::string>("T", dims, input);
+
+    std::vector<std::string> output = {std::string(u8"tuesday"),
+                                       std::string(u8"вторник"),
+                                       std::string(u8"école")};
+    test.AddOutput<std::string>("Y", {1, 3}, output);
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
 
   // Empty output case
   // - casesensitive approach
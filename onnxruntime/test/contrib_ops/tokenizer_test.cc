@@ -693,6 +693,60 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, TokenizerWithSeparators_MultiByteCharsAroundSeparatorsC) {
+  // Separators of 2 and 3 bytes next to tokens of multi-byte chars, at the start and end of
+  // the strings and following each other. The tokens are output as byte ranges of the input.
+  // [C] dimensions
+  // Output [C][D]
+  std::vector<std::string> separators = {
+      u8"、",
+      u8"–",
+      u8"ß"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, true, separators, 1);
+
+  std::vector<int64_t> dims{3};
+  std::vector<std::string> input{u8"日本、語–éx", u8"ßaß–é、中", u8"Ж、"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(5));
+  std::vector<std::string> output{
+      start_mark, u8"日本", u8"語", u8"éx", end_mark,
+      start_mark, u8"a", u8"é", u8"中", end_mark,
+      start_mark, u8"Ж", end_mark, padval, padval};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
+TEST(ContribOpTest, TokenizerWithSeparators_MultiByteCharsMinCharNumC) {
+  // Same as above with mincharnum counting chars, not bytes: u8"é" is 2 bytes but
+  // a single char so it is dropped. The trailing tokens are always kept.
+  std::vector<std::string> separators = {
+      u8"、",
+      u8"–",
+      u8"ß"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 2);
+
+  std::vector<int64_t> dims{3};
+  std::vector<std::string> input{u8"日本、語–éx", u8"ßaß–é、中", u8"Ж、"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(2));
+  std::vector<std::string> output{
+      u8"日本", u8"éx",
+      u8"中", padval,
+      padval, padval};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, TokenizerExpression_SimpleSep) {
   OpTester test("Tokenizer", opset_ver, domain);
   const std::string tokenexp(";");
@@ -149,6 +149,8 @@ class PlannerTest : public ::testing::Test {
 
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;       // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;  // a unary kernel with in-place
+  std::unique_ptr<::onnxruntime::KernelDef> strided_view_kernel_;  // a unary kernel that may output a strided view
+  std::unique_ptr<::onnxruntime::KernelDef> concat_kernel_;        // the cpu Concat kernel
 
   std::unordered_map<std::string, onnxruntime::NodeArg*> name_to_arg_;
   std::vector<std::unique_ptr<UnaryNode>> nodes_;
@@ -163,6 +165,8 @@ class PlannerTest : public ::testing::Test {
   PlannerTest() : model_("test"), graph_{model_.MainGraph()}, state_{execution_providers_} {
     std_kernel_ = KernelDefBuilder().SetName("Transpose").Build();
     in_place_kernel_ = KernelDefBuilder().SetName("Clip").MayInplace(0, 0).Build();
+    strided_view_kernel_ = KernelDefBuilder().SetName("Split").MayStridedInput(0).MayStridedOutput(0, -1).Build();
+    concat_kernel_ = KernelDefBuilder().SetName("Concat").Build();
     CPUExecutionProviderInfo epi;
     auto execution_provider = std::make_unique<CPUExecutionProvider>(epi);
     execution_providers_.Add("CPUExecutionProvider", std::move(execution_provider));
@@ -193,6 +197,21 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*in_place_kernel_, input, output);
   }
 
+  onnxruntime::Node* AddStridedViewNode(std::string& input, std::string& output) {
+    return AddNode(*strided_view_kernel_, input, output);
+  }
+
+  onnxruntime::Node* AddConcatNode(std::string& input1, std::string& input2, std::string& output, int64_t axis) {
+    std::vector<onnxruntime::NodeArg*> input_args{Arg(input1), Arg(input2)};
+    std::vector<onnxruntime::NodeArg*> output_args{Arg(output)};
+    auto* p_node = &graph_.AddNode("node" + std::to_string(NodeCounter::Next()), "Concat", "test op",
+                                   input_args, output_args);
+    p_node->AddAttribute("axis", axis);
+    p_node->SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+    kernel_bindings_.emplace_back(p_node, *concat_kernel_);
+    return p_node;
+  }
+
   void BindKernel(onnxruntime::Node* p_node, ::onnxruntime::KernelDef& kernel_def) {
     auto info = std::make_unique<OpKernelInfo>(*p_node,
                                                kernel_def,
@@ -413,6 +432,77 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// StridedViewTest: Check that an output is planned as a view of its input only when
+// every consumer of the output can read a strided tensor.
+TEST_F(PlannerTest, StridedViewTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddStridedViewNode(X1, X2);  // X1: input; X2: view of X1 as transpose reads strided input
+  AddNormalNode(X2, X3);       // X3: temporary
+  AddStridedViewNode(X3, X4);  // X4: temporary, not a view as clip needs contiguous input
+  AddInplaceNode(X4, X5);      // X5: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}, {X5, shape}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kReuse);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+}
+
+// ConcatSubBufferTest: Check that the inputs of a Concat with static shapes are placed
+// inside the Concat output, so that their producers write the concatenated result directly.
+TEST_F(PlannerTest, ConcatSubBufferTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);         // X1: input; X2: temporary, first block of X4
+  AddNormalNode(X1, X3);         // X3: temporary, second block of X4
+  AddConcatNode(X2, X3, X4, 0);  // X4: temporary, holds X2 and X3
+  AddNormalNode(X4, X5);         // X5: output
+
+  // simulate shape-inference results:
+  Shape shape1{2, 3};
+  Shape shape2{4, 3};
+  SetShape({{X1, &shape1.value}, {X2, &shape1.value}, {X3, &shape1.value}, {X4, &shape2.value}, {X5, &shape2.value}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kSubBuffer);
+  CheckAllocKind(X3, AllocKind::kSubBuffer);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+
+  int x2, x3, x4;
+  ASSERT_TRUE(GetState().GetMLValueNameIdxMap().GetIdx(X2, x2).IsOK());
+  ASSERT_TRUE(GetState().GetMLValueNameIdxMap().GetIdx(X3, x3).IsOK());
+  ASSERT_TRUE(GetState().GetMLValueNameIdxMap().GetIdx(X4, x4).IsOK());
+  auto& plan = GetPlan().allocation_plan;
+  EXPECT_EQ(plan[x2].reused_buffer, x4);
+  EXPECT_EQ(plan[x2].sub_buffer_offset, 0u);
+  EXPECT_EQ(plan[x3].reused_buffer, x4);
+  EXPECT_EQ(plan[x3].sub_buffer_offset, 6 * sizeof(float));
+  EXPECT_EQ(plan[x4].planned_shape, std::vector<int64_t>({4, 3}));
+
+  // the Concat output is freed once the last of its users is done
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {});
+  CheckFreed(3, {X4});
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/inference_session.h"
+
+#include <sstream>
+
+#include "core/framework/customregistry.h"
+#include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
+#include "test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+// Neg kernel which records where it writes its output, to check which values are placed inside
+// the output of the Concat consuming them.
+class RecordingNegKernel : public OpKernel {
+ public:
+  RecordingNegKernel(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override {
+    const auto* X = context->Input<Tensor>(0);
+    auto* Y = context->Output(0, X->Shape());
+    const float* x = X->Data<float>();
+    float* y = Y->MutableData<float>();
+    for (int64_t i = 0, end = X->Shape().Size(); i < end; ++i) {
+      y[i] = -x[i];
+    }
+
+    output_buffers[Node().OutputDefs()[0]->Name()] = y;
+    return Status::OK();
+  }
+
+  static std::unordered_map<std::string, const float*> output_buffers;
+};
+
+std::unordered_map<std::string, const float*> RecordingNegKernel::output_buffers;
+
+static OpKernel* CreateRecordingNegKernel(const OpKernelInfo& kernel_info) {
+  return new RecordingNegKernel(kernel_info);
+}
+
+// Graph:
+//   A = Neg(X1), B = Neg(X2), Y = Concat(A, X3, B) along axis 0, all with static shapes.
+// A and B can be placed inside Y, X3 is a graph input so it is copied by Concat.
+// If add_other_consumer is set, Z = Neg(A) is also an output of the graph, so A has to keep a buffer of its own.
+static ModelProto CreateConcatModel(bool add_other_consumer) {
+  Model model("ConcatSubBuffers");
+  auto& graph = model.MainGraph();
+
+  auto float_tensor = [](std::initializer_list<int64_t> dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    for (auto dim : dims) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    return type;
+  };
+
+  auto shape_2_3 = float_tensor({2, 3});
+  auto shape_1_3 = float_tensor({1, 3});
+  auto shape_5_3 = float_tensor({5, 3});
+
+  auto& x1 = graph.GetOrCreateNodeArg("X1", &shape_2_3);
+  auto& x2 = graph.GetOrCreateNodeArg("X2", &shape_2_3);
+  auto& x3 = graph.GetOrCreateNodeArg("X3", &shape_1_3);
+  auto& a = graph.GetOrCreateNodeArg("A", &shape_2_3);
+  auto& b = graph.GetOrCreateNodeArg("B", &shape_2_3);
+  auto& y = graph.GetOrCreateNodeArg("Y", &shape_5_3);
+
+  graph.AddNode("neg_a", "Neg", "A = -X1", {&x1}, {&a});
+  graph.AddNode("neg_b", "Neg", "B = -X2", {&x2}, {&b});
+  auto& concat = graph.AddNode("concat", "Concat", "Y = [A, X3, B]", {&a, &x3, &b}, {&y});
+  concat.AddAttribute("axis", int64_t{0});
+
+  if (add_other_consumer) {
+    auto& z = graph.GetOrCreateNodeArg("Z", &shape_2_3);
+    graph.AddNode("neg_z", "Neg", "Z = -A", {&a}, {&z});
+  }
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  return model.ToProto();
+}
+
+// Runs the model with X1 of shape {x1_rows, 3} and checks the outputs. Returns the output Y.
+static MLValue RunConcatModel(bool add_other_consumer, int64_t x1_rows) {
+  SessionOptions so;
+  so.session_logid = "ConcatSubBufferTest";
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+
+  auto registry = std::make_shared<CustomRegistry>();
+  KernelDefBuilder def;
+  def.SetName("Neg")
+      .SetDomain(onnxruntime::kOnnxDomain)
+      .SinceVersion(6)
+      .Provider(onnxruntime::kCpuExecutionProvider)
+      .TypeConstraint("T", DataTypeImpl::GetTensorType<float>());
+  EXPECT_TRUE(registry->RegisterCustomKernel(def, CreateRecordingNegKernel).IsOK());
+  EXPECT_TRUE(session_object.RegisterCustomRegistry(registry).IsOK());
+
+  std::stringstream model_stream;
+  CreateConcatModel(add_other_consumer).SerializeToOstream(&model_stream);
+  auto status = session_object.Load(model_stream);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  status = session_object.Initialize();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  std::vector<float> x1(static_cast<size_t>(x1_rows * 3));
+  for (size_t i = 0; i < x1.size(); ++i) x1[i] = static_cast<float>(i + 1);
+  std::vector<float> x2 = {10.f, 11.f, 12.f, 13.f, 14.f, 15.f};
+  std::vector<float> x3 = {20.f, 21.f, 22.f};
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  NameMLValMap feeds;
+  MLValue x1_value, x2_value, x3_value;
+  CreateMLValue<float>(allocator, {x1_rows, 3}, x1, &x1_value);
+  CreateMLValue<float>(allocator, {2, 3}, x2, &x2_value);
+  CreateMLValue<float>(allocator, {1, 3}, x3, &x3_value);
+  feeds.insert({"X1", x1_value});
+  feeds.insert({"X2", x2_value});
+  feeds.insert({"X3", x3_value});
+
+  std::vector<std::string> output_names{"Y"};
+  if (add_other_consumer) output_names.push_back("Z");
+  std::vector<MLValue> fetches;
+
+  RecordingNegKernel::output_buffers.clear();
+  status = session_object.Run(feeds, output_names, &fetches);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  if (!status.IsOK()) return MLValue();
+
+  std::vector<float> expected_y;
+  for (auto v : x1) expected_y.push_back(-v);
+  expected_y.insert(expected_y.end(), x3.begin(), x3.end());
+  for (auto v : x2) expected_y.push_back(-v);
+
+  const auto& y = fetches[0].Get<Tensor>();
+  EXPECT_EQ(TensorShape({x1_rows + 3, 3}), y.Shape());
+  EXPECT_EQ(expected_y, std::vector<float>(y.Data<float>(), y.Data<float>() + y.Shape().Size()));
+
+  if (add_other_consumer) {
+    const auto& z = fetches[1].Get<Tensor>();
+    EXPECT_EQ(x1, std::vector<float>(z.Data<float>(), z.Data<float>() + z.Shape().Size()));
+  }
+
+  return fetches[0];
+}
+
+// the producers of A and B write directly into their block of Y, and Concat only copies X3
+TEST(ConcatSubBufferTest, ProducersWriteIntoConcatOutput) {
+  MLValue y = RunConcatModel(false, 2);
+  ASSERT_TRUE(y.IsAllocated());
+  const float* y_data = y.Get<Tensor>().Data<float>();
+
+  EXPECT_EQ(y_data, RecordingNegKernel::output_buffers["A"]);
+  EXPECT_EQ(y_data + 9, RecordingNegKernel::output_buffers["B"]);
+}
+
+// A is read again after Concat so it is not placed in Y. B still is.
+TEST(ConcatSubBufferTest, InputWithOtherConsumerIsNotPlaced) {
+  MLValue y = RunConcatModel(true, 2);
+  ASSERT_TRUE(y.IsAllocated());
+  const float* y_data = y.Get<Tensor>().Data<float>();
+
+  EXPECT_NE(y_data, RecordingNegKernel::output_buffers["A"]);
+  EXPECT_EQ(y_data + 9, RecordingNegKernel::output_buffers["B"]);
+}
+
+// X1 has another shape than the one in the model. A buffer for Y with the planned shape is allocated when the
+// first of A and B is produced. A doesn't fit in its block so it gets a buffer of its own, and B is placed in the
+// planned buffer. Concat then allocates Y with the right shape and copies A and B, the planned buffer being kept
+// until the end of the run.
+TEST(ConcatSubBufferTest, ShapeMismatchFallsBackToCopy) {
+  MLValue y = RunConcatModel(false, 1);
+  ASSERT_TRUE(y.IsAllocated());
+  const float* y_data = y.Get<Tensor>().Data<float>();
+
+  EXPECT_NE(y_data, RecordingNegKernel::output_buffers["A"]);
+  EXPECT_NE(y_data + 6, RecordingNegKernel::output_buffers["B"]);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
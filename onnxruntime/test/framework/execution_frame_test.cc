@@ -156,6 +156,68 @@ TEST(ExecutionFrameTest, FeedInDataTest) {
   EXPECT_EQ(p_tensor_arg_0->template MutableData<float>(), buffer);
 }
 
+TEST(ExecutionFrameTest, ResetTest) {
+  onnxruntime::Model model("test");
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Clip", "Clip operator", ArgMap{&input_def}, ArgMap{&output_def});
+  graph.Resolve();
+  auto cpu_allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  auto element_type = DataTypeImpl::GetType<float>();
+  TensorShape shape({3, 2});
+
+  auto create_value = [&](void* buffer) {
+    MLValue value;
+    value.Init(std::make_unique<Tensor>(element_type, shape, buffer, cpu_allocator->Info(), cpu_allocator).release(),
+               DataTypeImpl::GetType<Tensor>(),
+               DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    return value;
+  };
+
+  void* buffer1 = cpu_allocator->Alloc(element_type->Size() * shape.Size());
+  void* buffer2 = cpu_allocator->Alloc(element_type->Size() * shape.Size());
+  MLValue value1 = create_value(buffer1);
+  MLValue value2 = create_value(buffer2);
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+
+  KernelRegistryManager kernel_registry_manager;
+  ExecutionProviders execution_providers;
+  execution_providers.Add(xp_typ, std::move(cpu_xp));
+  EXPECT_TRUE(kernel_registry_manager.RegisterKernels(execution_providers).IsOK());
+
+  SessionState state{execution_providers};
+  state.SetGraphViewer(std::make_unique<GraphViewer>(graph));
+
+  MLValueNameIdxMap& mlvalue_name_idx_map{state.GetMLValueNameIdxMap()};
+  auto x_idx = mlvalue_name_idx_map.Add("X");
+  auto y_idx = mlvalue_name_idx_map.Add("Y");
+
+  state.CalculateNodeIndexInfo();
+
+  // the frame keeps a reference to the fetch indexes so they need to outlive it
+  std::vector<int> feed_idxs{x_idx};
+  std::vector<int> fetch_idxs{y_idx};
+  vector<MLValue> outputs;
+  ExecutionFrame frame(feed_idxs, {value1}, fetch_idxs, outputs, {}, state);
+
+  MLValue* p_ml_value = frame.GetMutableNodeInputOrOutputMLValue(0);
+  ASSERT_TRUE(p_ml_value);
+  EXPECT_EQ(p_ml_value->GetMutable<Tensor>()->template MutableData<float>(), buffer1);
+
+  // a reset frame sees the new feeds and no longer holds the old ones
+  frame.Reset(feed_idxs, {value2}, outputs, {});
+
+  p_ml_value = frame.GetMutableNodeInputOrOutputMLValue(0);
+  ASSERT_TRUE(p_ml_value);
+  EXPECT_EQ(p_ml_value->GetMutable<Tensor>()->template MutableData<float>(), buffer2);
+  EXPECT_FALSE(frame.GetMutableNodeInputOrOutputMLValue(1)->IsAllocated());
+}
+
 TEST(ExecutionFrameTest, MemPatternTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
   auto xp_type = cpu_xp->Type();
@@ -1137,13 +1137,11 @@ TEST(ExecutionProviderTest, FunctionInlineTest) {
   VerifyOutputs(fetches, expected_dims_mul_m, expected_values_mul_m);
 }
 
-TEST(InferenceSessionTests, TestTruncatedSequence) {
-  // model/data generated by <repo>/onnxruntime/test/testdata/CNTK/gen.py GenScan()
-  static const std::string LSTM_MODEL_URI = "testdata/scan_1.pb";
-  // This model is a 4x forward LSTM. Parse it to find out mapping between init_state input/output
-  ONNX_NAMESPACE::ModelProto model_proto;
+// Parse a model with Scan nodes to find the mapping from the state outputs to the initial state inputs
+static void GetScanInitStateMap(const std::string& model_uri, ONNX_NAMESPACE::ModelProto& model_proto,
+                                std::unordered_map<std::string, std::string>& init_state_map) {
   int model_fd;
-  auto status = Env::Default().FileOpenRd(LSTM_MODEL_URI, model_fd);
+  auto status = Env::Default().FileOpenRd(model_uri, model_fd);
   ASSERT_TRUE(status.IsOK());
   google::protobuf::io::FileInputStream f(model_fd);
   f.SetCloseOnDelete(true);
@@ -1159,7 +1157,6 @@ TEST(InferenceSessionTests, TestTruncatedSequence) {
     return nullptr;
   };
 
-  std::unordered_map<std::string, std::string> init_state_map;
   for (int i_node = 0; i_node < graph_proto.node_size(); ++i_node) {
     auto& node = *graph_proto.mutable_node(i_node);
     if (node.op_type() == "Scan") {
@@ -1184,6 +1181,16 @@ TEST(InferenceSessionTests, TestTruncatedSequence) {
       }
     }
   }
+}
+
+TEST(InferenceSessionTests, TestTruncatedSequence) {
+  // model/data generated by <repo>/onnxruntime/test/testdata/CNTK/gen.py GenScan()
+  static const std::string LSTM_MODEL_URI = "testdata/scan_1.pb";
+  // This model is a 4x forward LSTM. Parse it to find out mapping between init_state input/output
+  ONNX_NAMESPACE::ModelProto model_proto;
+  std::unordered_map<std::string, std::string> init_state_map;
+  GetScanInitStateMap(LSTM_MODEL_URI, model_proto, init_state_map);
+  GraphProto& graph_proto = *model_proto.mutable_graph();
 
   // now run the truncated model
   SessionOptions so;
@@ -1291,6 +1298,95 @@ TEST(InferenceSessionTests, TestTruncatedSequence) {
   }
 }
 
+// run the model from TestTruncatedSequence one step at a time with its states bound in an IOBinding
+TEST(InferenceSessionTests, TestStreamingStateWithIOBinding) {
+  static const std::string LSTM_MODEL_URI = "testdata/scan_1.pb";
+  ONNX_NAMESPACE::ModelProto model_proto;
+  std::unordered_map<std::string, std::string> init_state_map;
+  GetScanInitStateMap(LSTM_MODEL_URI, model_proto, init_state_map);
+  const GraphProto& graph_proto = model_proto.graph();
+
+  SessionOptions so;
+  InferenceSession session_object(so);
+  ASSERT_TRUE(session_object.Load(LSTM_MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_TRUE(session_object.NewIOBinding(&io_binding).IsOK());
+
+  // the initial states aren't bound so the first step and the step after a reset use the model's initializers
+  for (const auto& entry : init_state_map) {
+    ASSERT_TRUE(io_binding->BindState(entry.second, entry.first, MLValue()).IsOK());
+  }
+
+  std::string final_output_name;
+  for (int i = 0; i < graph_proto.output_size(); ++i) {
+    if (init_state_map.find(graph_proto.output(i).name()) == init_state_map.end()) {
+      final_output_name = graph_proto.output(i).name();
+    }
+  }
+  ASSERT_TRUE(io_binding->BindOutput(final_output_name, MLValue()).IsOK());
+
+  std::vector<int64_t> X_dims = {5, 1, 3};
+  std::vector<float> X = {0.5488135f, 0.71518934f, 0.60276335f,
+                          0.5448832f, 0.4236548f, 0.6458941f,
+                          0.4375872f, 0.891773f, 0.96366274f,
+                          0.3834415f, 0.79172504f, 0.5288949f,
+                          0.56804454f, 0.92559665f, 0.07103606f};
+
+  std::vector<float> Y_data = {-1.1730184e-04f, -3.1204990e-04f,
+                               -2.9978977e-04f, -1.0602647e-03f,
+                               -3.8115133e-04f, -2.0684483e-03f,
+                               -2.5120965e-04f, -2.9920202e-03f,
+                               3.0980256e-05f, -3.5933927e-03f};
+
+  const auto& output_names = io_binding->GetOutputNames();
+  const auto final_output_index = std::find(output_names.cbegin(), output_names.cend(), final_output_name) -
+                                  output_names.cbegin();
+
+  // stream the sequence twice, resetting the states in between
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int64_t step = 0; step < X_dims[0]; ++step) {
+      std::vector<float> frame(X.begin() + step * 3, X.begin() + (step + 1) * 3);
+      MLValue ml_value;
+      CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 3}, frame,
+                           &ml_value);
+      ASSERT_TRUE(io_binding->BindInput("Input13165", ml_value).IsOK());
+
+      common::Status st = session_object.Run(*io_binding);
+      ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+      auto& rtensor = io_binding->GetOutputs()[final_output_index].Get<Tensor>();
+      ASSERT_EQ(TensorShape({1, 1, 2}), rtensor.Shape());
+      for (int i = 0; i < 2; ++i)
+        EXPECT_NEAR(Y_data[step * 2 + i], rtensor.template Data<float>()[i], FLT_EPSILON);
+    }
+
+    io_binding->ResetStates();
+  }
+
+  // once the states are cleared every run starts from the model's initial states, even after the states advanced
+  std::vector<float> first_frame(X.begin(), X.begin() + 3);
+  MLValue first_ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 3}, first_frame,
+                       &first_ml_value);
+  ASSERT_TRUE(io_binding->BindInput("Input13165", first_ml_value).IsOK());
+  ASSERT_TRUE(session_object.Run(*io_binding).IsOK());
+
+  io_binding->ClearStates();
+  ASSERT_EQ(std::vector<std::string>{final_output_name}, io_binding->GetOutputNames());
+
+  for (int run = 0; run < 2; ++run) {
+    common::Status st = session_object.Run(*io_binding);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+    auto& rtensor = io_binding->GetOutputs()[0].Get<Tensor>();
+    ASSERT_EQ(TensorShape({1, 1, 2}), rtensor.Shape());
+    for (int i = 0; i < 2; ++i)
+      EXPECT_NEAR(Y_data[i], rtensor.template Data<float>()[i], FLT_EPSILON);
+  }
+}
+
 // create the feeds and fetches using the dummy allocator so that we have to copy to CPU to execute, and from
 // CPU to return in utils::ExecuteGraph. Call InferenceSession::Run twice to test the caching of the copy logic.
 TEST(InferenceSessionTests, TestCopyToFromDevices) {
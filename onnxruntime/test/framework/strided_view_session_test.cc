@@ -0,0 +1,225 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/inference_session.h"
+
+#include <sstream>
+
+#include "core/framework/customregistry.h"
+#include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
+#include "core/providers/cpu/tensor/utils.h"
+#include "test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+// Identity kernel accepting a strided input, which records whether its input was a strided view.
+class StridedProbeKernel : public OpKernel {
+ public:
+  StridedProbeKernel(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override {
+    const auto* X = context->Input<Tensor>(0);
+    auto* Y = context->Output(0, X->Shape());
+    StridedCopy(Y->MutableData<float>(), Y->Strides(), X->Data<float>(), X->Strides(), X->Shape().GetDims());
+
+    input_contiguous[Node().InputDefs()[0]->Name()] = X->IsContiguous();
+    return Status::OK();
+  }
+
+  static std::unordered_map<std::string, bool> input_contiguous;
+};
+
+std::unordered_map<std::string, bool> StridedProbeKernel::input_contiguous;
+
+static OpKernel* CreateStridedProbeKernel(const OpKernelInfo& kernel_info) {
+  return new StridedProbeKernel(kernel_info);
+}
+
+static TypeProto FloatTensor(std::initializer_list<int64_t> dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return type;
+}
+
+// Graph:
+//   N = Neg(X), S = Slice(N) on columns [1, 3), Y = Concat(S, W) along axis 1, P = Identity(S)
+// S is a strided view of N, read by Concat and by the probe.
+// If copy_intermediate is set, S is also read by Relu, which needs contiguous input, so S is a copy.
+static ModelProto CreateSliceConcatModel(bool copy_intermediate) {
+  Model model("SliceConcatViews");
+  auto& graph = model.MainGraph();
+
+  auto shape_4_4 = FloatTensor({4, 4});
+  auto shape_4_2 = FloatTensor({4, 2});
+  auto shape_4_3 = FloatTensor({4, 3});
+  auto shape_4_1 = FloatTensor({4, 1});
+
+  auto& x = graph.GetOrCreateNodeArg("X", &shape_4_4);
+  auto& w = graph.GetOrCreateNodeArg("W", &shape_4_1);
+  auto& n = graph.GetOrCreateNodeArg("N", &shape_4_4);
+  auto& s = graph.GetOrCreateNodeArg("S", &shape_4_2);
+  auto& y = graph.GetOrCreateNodeArg("Y", &shape_4_3);
+  auto& p = graph.GetOrCreateNodeArg("P", &shape_4_2);
+
+  graph.AddNode("neg", "Neg", "N = -X", {&x}, {&n});
+  auto& slice = graph.AddNode("slice", "Slice", "S = N[:, 1:3]", {&n}, {&s});
+  slice.AddAttribute("starts", std::vector<int64_t>{0, 1});
+  slice.AddAttribute("ends", std::vector<int64_t>{4, 3});
+  auto& concat = graph.AddNode("concat", "Concat", "Y = [S, W]", {&s, &w}, {&y});
+  concat.AddAttribute("axis", int64_t{1});
+  graph.AddNode("probe", "Identity", "P = S", {&s}, {&p});
+
+  if (copy_intermediate) {
+    auto& z = graph.GetOrCreateNodeArg("Z", &shape_4_2);
+    graph.AddNode("relu", "Relu", "Z = Relu(S)", {&s}, {&z});
+  }
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  return model.ToProto();
+}
+
+// Graph:
+//   A, B = Split(X) along axis 1 in two halves, Y = Transpose(A), P = Identity(B)
+// A and B are strided views of X.
+// If copy_intermediate is set, A and B are also read by Relu, which needs contiguous input, so they are copies.
+static ModelProto CreateSplitTransposeModel(bool copy_intermediate) {
+  Model model("SplitTransposeViews");
+  auto& graph = model.MainGraph();
+
+  auto shape_4_4 = FloatTensor({4, 4});
+  auto shape_4_2 = FloatTensor({4, 2});
+  auto shape_2_4 = FloatTensor({2, 4});
+
+  auto& x = graph.GetOrCreateNodeArg("X", &shape_4_4);
+  auto& n = graph.GetOrCreateNodeArg("N", &shape_4_4);
+  auto& a = graph.GetOrCreateNodeArg("A", &shape_4_2);
+  auto& b = graph.GetOrCreateNodeArg("B", &shape_4_2);
+  auto& y = graph.GetOrCreateNodeArg("Y", &shape_2_4);
+  auto& p = graph.GetOrCreateNodeArg("P", &shape_4_2);
+
+  graph.AddNode("neg", "Neg", "N = -X", {&x}, {&n});
+  auto& split = graph.AddNode("split", "Split", "A, B = N[:, :2], N[:, 2:]", {&n}, {&a, &b});
+  split.AddAttribute("axis", int64_t{1});
+  auto& transpose = graph.AddNode("transpose", "Transpose", "Y = A^T", {&a}, {&y});
+  transpose.AddAttribute("perm", std::vector<int64_t>{1, 0});
+  graph.AddNode("probe", "Identity", "P = B", {&b}, {&p});
+
+  if (copy_intermediate) {
+    auto& z_a = graph.GetOrCreateNodeArg("ZA", &shape_4_2);
+    auto& z_b = graph.GetOrCreateNodeArg("ZB", &shape_4_2);
+    graph.AddNode("relu_a", "Relu", "ZA = Relu(A)", {&a}, {&z_a});
+    graph.AddNode("relu_b", "Relu", "ZB = Relu(B)", {&b}, {&z_b});
+  }
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  return model.ToProto();
+}
+
+// Runs the model with the strided probe registered for Identity, and returns the values of Y and P.
+static std::vector<std::vector<float>> RunModel(const ModelProto& model_proto, bool with_w) {
+  SessionOptions so;
+  so.session_logid = "StridedViewSessionTest";
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+
+  auto registry = std::make_shared<CustomRegistry>();
+  KernelDefBuilder def;
+  def.SetName("Identity")
+      .SetDomain(onnxruntime::kOnnxDomain)
+      .SinceVersion(1)
+      .Provider(onnxruntime::kCpuExecutionProvider)
+      .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+      .MayStridedInput(0);
+  EXPECT_TRUE(registry->RegisterCustomKernel(def, CreateStridedProbeKernel).IsOK());
+  EXPECT_TRUE(session_object.RegisterCustomRegistry(registry).IsOK());
+
+  std::stringstream model_stream;
+  model_proto.SerializeToOstream(&model_stream);
+  auto status = session_object.Load(model_stream);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  status = session_object.Initialize();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  std::vector<float> x(16);
+  for (size_t i = 0; i < x.size(); ++i) x[i] = static_cast<float>(i + 1);
+  std::vector<float> w = {100.f, 101.f, 102.f, 103.f};
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  NameMLValMap feeds;
+  MLValue x_value, w_value;
+  CreateMLValue<float>(allocator, {4, 4}, x, &x_value);
+  feeds.insert({"X", x_value});
+  if (with_w) {
+    CreateMLValue<float>(allocator, {4, 1}, w, &w_value);
+    feeds.insert({"W", w_value});
+  }
+
+  std::vector<std::string> output_names{"Y", "P"};
+  std::vector<MLValue> fetches;
+
+  StridedProbeKernel::input_contiguous.clear();
+  status = session_object.Run(feeds, output_names, &fetches);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  if (!status.IsOK()) return {};
+
+  std::vector<std::vector<float>> results;
+  for (auto& fetch : fetches) {
+    const auto& tensor = fetch.Get<Tensor>();
+    EXPECT_TRUE(tensor.IsContiguous());
+    results.emplace_back(tensor.Data<float>(), tensor.Data<float>() + tensor.Shape().Size());
+  }
+  return results;
+}
+
+// Slice produces a view read by Concat and the probe, with the same results as the copy
+TEST(StridedViewSessionTest, SliceToConcat) {
+  auto view_results = RunModel(CreateSliceConcatModel(false), true);
+  ASSERT_EQ(2u, view_results.size());
+  EXPECT_FALSE(StridedProbeKernel::input_contiguous["S"]);
+
+  auto copy_results = RunModel(CreateSliceConcatModel(true), true);
+  ASSERT_EQ(2u, copy_results.size());
+  EXPECT_TRUE(StridedProbeKernel::input_contiguous["S"]);
+
+  std::vector<float> expected_y = {-2.f, -3.f, 100.f,
+                                   -6.f, -7.f, 101.f,
+                                   -10.f, -11.f, 102.f,
+                                   -14.f, -15.f, 103.f};
+  std::vector<float> expected_p = {-2.f, -3.f, -6.f, -7.f, -10.f, -11.f, -14.f, -15.f};
+  EXPECT_EQ(expected_y, view_results[0]);
+  EXPECT_EQ(expected_p, view_results[1]);
+  EXPECT_EQ(copy_results, view_results);
+}
+
+// Split produces views read by Transpose and the probe, with the same results as the copy
+TEST(StridedViewSessionTest, SplitToTranspose) {
+  auto view_results = RunModel(CreateSplitTransposeModel(false), false);
+  ASSERT_EQ(2u, view_results.size());
+  EXPECT_FALSE(StridedProbeKernel::input_contiguous["B"]);
+
+  auto copy_results = RunModel(CreateSplitTransposeModel(true), false);
+  ASSERT_EQ(2u, copy_results.size());
+  EXPECT_TRUE(StridedProbeKernel::input_contiguous["B"]);
+
+  std::vector<float> expected_y = {-1.f, -5.f, -9.f, -13.f,
+                                   -2.f, -6.f, -10.f, -14.f};
+  std::vector<float> expected_p = {-3.f, -4.f, -7.f, -8.f, -11.f, -12.f, -15.f, -16.f};
+  EXPECT_EQ(expected_y, view_results[0]);
+  EXPECT_EQ(expected_p, view_results[1]);
+  EXPECT_EQ(copy_results, view_results);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -140,6 +140,36 @@ TEST(TensorTest, EmptyTensorTest) {
   EXPECT_EQ(location.type, OrtAllocatorType::OrtArenaAllocator);
 }
 
+TEST(TensorTest, StridedViewTest) {
+  std::vector<float> buffer(4 * 6);
+  auto info = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault)->Info();
+  Tensor t(DataTypeImpl::GetType<float>(), TensorShape({4, 6}), buffer.data(), info);
+  EXPECT_TRUE(t.IsContiguous());
+  EXPECT_THAT(t.Strides(), testing::ElementsAre(6, 1));
+
+  // columns 2..4 of rows 1..2
+  t.SetStridedView(TensorShape({2, 3}), {6, 1}, (6 + 2) * sizeof(float));
+  EXPECT_FALSE(t.IsContiguous());
+  EXPECT_THAT(t.Strides(), testing::ElementsAre(6, 1));
+  EXPECT_EQ(t.ByteOffset(), static_cast<int64_t>(8 * sizeof(float)));
+  EXPECT_EQ(t.Data<float>(), buffer.data() + 8);
+
+  // whole rows 1..2 are contiguous, and the stride of a single row does not matter
+  t.SetStridedView(TensorShape({2, 6}), {6, 1}, 6 * sizeof(float));
+  EXPECT_TRUE(t.IsContiguous());
+  t.SetStridedView(TensorShape({1, 6}), {100, 1}, 6 * sizeof(float));
+  EXPECT_TRUE(t.IsContiguous());
+
+  // transposed view
+  t.SetStridedView(TensorShape({6, 4}), {1, 6}, 0);
+  EXPECT_FALSE(t.IsContiguous());
+  EXPECT_THAT(t.Strides(), testing::ElementsAre(1, 6));
+
+  Tensor moved(std::move(t));
+  EXPECT_FALSE(moved.IsContiguous());
+  EXPECT_TRUE(t.IsContiguous());
+}
+
 TEST(TensorTest, StringTensorTest) {
 //add scope to explicitly delete tensor
 #ifdef _MSC_VER
@@ -180,6 +210,55 @@ TEST(TensorTest, StringTensorTest) {
 #endif
 }
 
+TEST(TensorTest, StringArenaTest) {
+  TensorShape shape({3});
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  auto buffer = alloc->Alloc(sizeof(std::string) * (shape.Size()));
+  Tensor t(DataTypeImpl::GetType<std::string>(), shape, buffer, alloc->Info(), alloc);
+  EXPECT_FALSE(t.HasStringArena());
+
+  // longer than the internal buffer of std::string
+  const std::string long_string(100, 'x');
+  auto& arena = t.InitStringArena();
+  arena.Reserve(3, 2 + long_string.size());
+  arena.Append("ab", 2);
+  arena.Append(long_string);
+  arena.Append("", 0);
+  EXPECT_TRUE(t.HasStringArena());
+  EXPECT_EQ(arena.NumStrings(), 3u);
+  EXPECT_EQ(arena.NumBytes(), 2 + long_string.size());
+
+  // read from the arena without the std::string elements
+  EXPECT_EQ(t.StringAt(0).ToString(), "ab");
+  EXPECT_EQ(t.StringAt(1).ToString(), long_string);
+  EXPECT_TRUE(t.StringAt(2).empty());
+
+  // moving the tensor keeps the arena
+  Tensor moved(std::move(t));
+  EXPECT_TRUE(moved.HasStringArena());
+  EXPECT_EQ(moved.StringAt(1).ToString(), long_string);
+
+  // accessing the data assigns the std::string elements
+  const std::string* data = moved.template Data<std::string>();
+  EXPECT_EQ(data[0], "ab");
+  EXPECT_EQ(data[1], long_string);
+  EXPECT_EQ(data[2], "");
+
+  // written elements are visible to StringAt
+  moved.template MutableData<std::string>()[2] = "c";
+  EXPECT_EQ(moved.StringAt(2).ToString(), "c");
+  EXPECT_EQ(moved.StringAt(0).ToString(), "ab");
+}
+
+TEST(TensorTest, StringArenaSizeMismatch) {
+  TensorShape shape({2});
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  auto buffer = alloc->Alloc(sizeof(std::string) * (shape.Size()));
+  Tensor t(DataTypeImpl::GetType<std::string>(), shape, buffer, alloc->Info(), alloc);
+  t.InitStringArena().Append("a", 1);
+  EXPECT_THROW(t.template Data<std::string>(), OnnxRuntimeException);
+}
+
 TEST(TensorTest, ConvertToString) {
   TensorShape shape({2, 3, 4});
 
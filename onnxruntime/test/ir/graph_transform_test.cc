@@ -13,8 +13,10 @@
 #include "core/optimizer/conv_mul_fusion.h"
 #include "core/optimizer/conv_add_fusion.h"
 #include "core/optimizer/conv_activation_fusion.h"
+#include "core/optimizer/conv_residual_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/gemm_activation_fusion.h"
+#include "core/optimizer/nchwc_transformer.h"
 #include "core/framework/data_types.h"
 #include "core/framework/ml_value.h"
 #include "core/util/math.h"
@@ -24,6 +26,8 @@
 #include "test/test_environment.h"
 #include "gtest/gtest.h"
 
+#include <sstream>
+
 using namespace std;
 using namespace ONNX_NAMESPACE;
 
@@ -340,5 +344,210 @@ TEST(GraphTransformationTests, FuseConvBnAddMulFloat16) {
   ASSERT_EQ(expected_values_prod, found);
 }
 
+static TypeProto FloatTensorType(std::initializer_list<int64_t> dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return type;
+}
+
+static NodeArg* AddFloatInitializer(Graph& graph, const std::string& name, std::initializer_list<int64_t> dims) {
+  TensorProto tensor;
+  tensor.set_name(name);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  int64_t size = 1;
+  for (auto dim : dims) {
+    tensor.add_dims(dim);
+    size *= dim;
+  }
+  for (int64_t i = 0; i < size; i++) {
+    tensor.add_float_data(static_cast<float>((i * 37) % 17 - 8) / 64.0f);
+  }
+  graph.AddInitializedTensor(tensor);
+  TypeProto type = FloatTensorType(dims);
+  return &graph.GetOrCreateNodeArg(name, &type);
+}
+
+static NodeArg* AddFloatValue(Graph& graph, const std::string& name) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  return &graph.GetOrCreateNodeArg(name, &type);
+}
+
+// Builds a model with a chain of Conv/Relu/Add/MaxPool/GlobalAveragePool nodes
+// that is fed by an input tensor and consumed by a Sigmoid node and the graph output.
+static std::string BuildNchwcTestModel() {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 9;
+  Model model("NchwcTransformer", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  Graph& graph = model.MainGraph();
+
+  TypeProto input_type = FloatTensorType({1, 16, 10, 10});
+  NodeArg* X = &graph.GetOrCreateNodeArg("X", &input_type);
+  NodeArg* W1 = AddFloatInitializer(graph, "W1", {20, 16, 3, 3});
+  NodeArg* B1 = AddFloatInitializer(graph, "B1", {20});
+  NodeArg* W2 = AddFloatInitializer(graph, "W2", {20, 20, 3, 3});
+  NodeArg* conv1 = AddFloatValue(graph, "conv1");
+  NodeArg* relu1 = AddFloatValue(graph, "relu1");
+  NodeArg* conv2 = AddFloatValue(graph, "conv2");
+  NodeArg* sum = AddFloatValue(graph, "sum");
+  NodeArg* pool = AddFloatValue(graph, "pool");
+  NodeArg* Y = AddFloatValue(graph, "Y");
+  NodeArg* Z = AddFloatValue(graph, "Z");
+
+  const std::vector<int64_t> pads{1, 1, 1, 1};
+  graph.AddNode("conv1", "Conv", "", {X, W1, B1}, {conv1}).AddAttribute("pads", pads);
+  graph.AddNode("relu1", "Relu", "", {conv1}, {relu1});
+  graph.AddNode("conv2", "Conv", "", {relu1, W2}, {conv2}).AddAttribute("pads", pads);
+  graph.AddNode("add", "Add", "", {relu1, conv2}, {sum});
+  Node& maxpool = graph.AddNode("maxpool", "MaxPool", "", {sum}, {pool});
+  maxpool.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+  maxpool.AddAttribute("strides", std::vector<int64_t>{2, 2});
+  graph.AddNode("gap", "GlobalAveragePool", "", {pool}, {Y});
+  graph.AddNode("sigmoid", "Sigmoid", "", {pool}, {Z});
+
+  EXPECT_TRUE(graph.Resolve().IsOK());
+
+  std::string serialized_model;
+  model.ToProto().SerializeToString(&serialized_model);
+  return serialized_model;
+}
+
+// Runs a model built by one of the builders above with input X of shape {1, 16, 10, 10}
+// and returns the outputs Y and Z.
+static std::vector<MLValue> RunTransformerTestModel(const std::string& serialized_model,
+                                                     std::unique_ptr<GraphTransformer> transformer) {
+  SessionOptions so;
+  so.session_logid = "GraphTransformationTests.RunTransformerTestModel";
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  std::istringstream model_istream(serialized_model);
+  EXPECT_TRUE(session_object.Load(model_istream).IsOK());
+  if (transformer != nullptr) {
+    session_object.RegisterGraphTransformer(std::move(transformer));
+  }
+  EXPECT_TRUE(session_object.Initialize().IsOK());
+
+  std::vector<float> values_x(1 * 16 * 10 * 10);
+  for (size_t i = 0; i < values_x.size(); i++) {
+    values_x[i] = static_cast<float>(static_cast<int>(i * 13) % 11 - 5) / 4.0f;
+  }
+  MLValue ml_value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 16, 10, 10}, values_x,
+                       &ml_value_x);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+
+  RunOptions run_options;
+  std::vector<MLValue> fetches;
+  EXPECT_TRUE(session_object.Run(run_options, feeds, {"Y", "Z"}, &fetches).IsOK());
+  return fetches;
+}
+
+static void ExpectSameOutputs(const std::vector<MLValue>& expected, const std::vector<MLValue>& actual) {
+  ASSERT_EQ(expected.size(), 2u);
+  ASSERT_EQ(actual.size(), 2u);
+
+  for (size_t i = 0; i < expected.size(); i++) {
+    const auto& expected_tensor = expected[i].Get<Tensor>();
+    const auto& actual_tensor = actual[i].Get<Tensor>();
+    ASSERT_EQ(expected_tensor.Shape(), actual_tensor.Shape());
+    const float* expected_data = expected_tensor.Data<float>();
+    const float* actual_data = actual_tensor.Data<float>();
+    for (int64_t j = 0; j < expected_tensor.Shape().Size(); j++) {
+      EXPECT_NEAR(expected_data[j], actual_data[j], 1e-3f);
+    }
+  }
+}
+
+TEST(GraphTransformationTests, NchwcTransformer) {
+  const std::string serialized_model = BuildNchwcTestModel();
+
+  ModelProto model_proto;
+  ASSERT_TRUE(model_proto.ParseFromString(serialized_model));
+  std::shared_ptr<Model> model;
+  ASSERT_TRUE(Model::Load(model_proto, model).IsOK());
+  Graph& graph = model->MainGraph();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+  graph_transformation_mgr.Register(std::make_unique<NchwcTransformer>());
+  ASSERT_TRUE(graph_transformation_mgr.ApplyAll(graph).IsOK());
+
+  // The tensors are only reordered where they enter and leave the chain.
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Conv"], 0);
+  EXPECT_EQ(op_to_count["MaxPool"], 0);
+  EXPECT_EQ(op_to_count["GlobalAveragePool"], 0);
+  EXPECT_EQ(op_to_count["NchwcConv"], 2);
+  EXPECT_EQ(op_to_count["NchwcMaxPool"], 1);
+  EXPECT_EQ(op_to_count["NchwcGlobalAveragePool"], 1);
+  EXPECT_EQ(op_to_count["Relu"], 1);
+  EXPECT_EQ(op_to_count["Add"], 1);
+  EXPECT_EQ(op_to_count["Sigmoid"], 1);
+  EXPECT_EQ(op_to_count["ReorderInput"], 1);
+  EXPECT_EQ(op_to_count["ReorderOutput"], 2);
+
+  std::vector<MLValue> expected = RunTransformerTestModel(serialized_model, nullptr);
+  std::vector<MLValue> actual = RunTransformerTestModel(serialized_model, std::make_unique<NchwcTransformer>());
+  ExpectSameOutputs(expected, actual);
+}
+
+// Builds a model with two residual block tails. The first is Conv -> Add -> Relu and the
+// second is Conv -> Add without an activation, whose output is a graph output.
+static std::string BuildConvResidualTestModel() {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 9;
+  Model model("ConvResidualFusion", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  Graph& graph = model.MainGraph();
+
+  TypeProto input_type = FloatTensorType({1, 16, 10, 10});
+  NodeArg* X = &graph.GetOrCreateNodeArg("X", &input_type);
+  NodeArg* W1 = AddFloatInitializer(graph, "W1", {16, 16, 3, 3});
+  NodeArg* B1 = AddFloatInitializer(graph, "B1", {16});
+  NodeArg* W2 = AddFloatInitializer(graph, "W2", {16, 16, 1, 1});
+  NodeArg* conv1 = AddFloatValue(graph, "conv1");
+  NodeArg* sum1 = AddFloatValue(graph, "sum1");
+  NodeArg* Y = AddFloatValue(graph, "Y");
+  NodeArg* conv2 = AddFloatValue(graph, "conv2");
+  NodeArg* Z = AddFloatValue(graph, "Z");
+
+  graph.AddNode("conv1", "Conv", "", {X, W1, B1}, {conv1}).AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+  graph.AddNode("add1", "Add", "", {conv1, X}, {sum1});
+  graph.AddNode("relu1", "Relu", "", {sum1}, {Y});
+  graph.AddNode("conv2", "Conv", "", {Y, W2}, {conv2});
+  graph.AddNode("add2", "Add", "", {Y, conv2}, {Z});
+
+  EXPECT_TRUE(graph.Resolve().IsOK());
+
+  std::string serialized_model;
+  model.ToProto().SerializeToString(&serialized_model);
+  return serialized_model;
+}
+
+TEST(GraphTransformationTests, FuseConvResidual) {
+  const std::string serialized_model = BuildConvResidualTestModel();
+
+  ModelProto model_proto;
+  ASSERT_TRUE(model_proto.ParseFromString(serialized_model));
+  std::shared_ptr<Model> model;
+  ASSERT_TRUE(Model::Load(model_proto, model).IsOK());
+  Graph& graph = model->MainGraph();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+  graph_transformation_mgr.Register(std::make_unique<ConvResidualFusion>());
+  ASSERT_TRUE(graph_transformation_mgr.ApplyAll(graph).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Conv"], 0);
+  EXPECT_EQ(op_to_count["Add"], 0);
+  EXPECT_EQ(op_to_count["Relu"], 0);
+  EXPECT_EQ(op_to_count["FusedConv"], 2);
+
+  std::vector<MLValue> expected = RunTransformerTestModel(serialized_model, nullptr);
+  std::vector<MLValue> actual = RunTransformerTestModel(serialized_model, std::make_unique<ConvResidualFusion>());
+  ExpectSameOutputs(expected, actual);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
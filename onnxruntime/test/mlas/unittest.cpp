@@ -367,6 +367,94 @@ ExecuteSgemmTests(
     }
 }
 
+void
+TrialSgemmPacked(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    float beta,
+    MatrixGuardBuffer& BufferA,
+    MatrixGuardBuffer& BufferB,
+    MatrixGuardBuffer& BufferPackedB,
+    MatrixGuardBuffer& BufferC,
+    MatrixGuardBuffer& BufferCReference
+    )
+{
+    const float* A = BufferA.GetBuffer(K * M);
+    const float* B = BufferB.GetBuffer(N * K);
+    float* C = BufferC.GetBuffer(N * M);
+    float* CReference = BufferCReference.GetBuffer(N * M);
+
+    size_t lda = (TransA == CblasNoTrans) ? K : M;
+    size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+    //
+    // The packed size is a multiple of 16 floats, so the guarded buffer is
+    // aligned to 64 bytes.
+    //
+
+    size_t PackedBSize = MlasSgemmPackBSize(N, K);
+    void* PackedB = BufferPackedB.GetBuffer(PackedBSize / sizeof(float));
+
+    MlasSgemmPackB(TransB, N, K, B, ldb, PackedB);
+
+    for (size_t f = 0; f < M * N; f++) {
+        C[f] = -0.5f;
+        CReference[f] = -0.5f;
+    }
+
+    MlasSgemm(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, N);
+    ReferenceSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, CReference, N);
+
+    for (size_t f = 0; f < M * N; f++) {
+        // Sensitive to comparing positive/negative zero.
+        if (C[f] != CReference[f]) {
+            printf("mismatch packed TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f!\n", TransA, TransB, M, N, K, alpha, beta);
+            break;
+        }
+    }
+}
+
+void
+ExecuteSgemmPackedTests(
+    void
+    )
+{
+    constexpr size_t MaximumDimension = 320;
+
+    MatrixGuardBuffer BufferA(MaximumDimension * MaximumDimension, true);
+    MatrixGuardBuffer BufferB(MaximumDimension * MaximumDimension, true);
+    MatrixGuardBuffer BufferPackedB((MaximumDimension + 16) * MaximumDimension, false);
+    MatrixGuardBuffer BufferC(MaximumDimension * MaximumDimension, false);
+    MatrixGuardBuffer BufferCReference(MaximumDimension * MaximumDimension, false);
+
+    static const float multipliers[] = { 0.0f, 0.25f, 1.0f, -1.0f };
+    static const size_t ms[] = { 1, 2, 3, 4, 5, 7, 8, 13, 16, 31, 64 };
+    static const size_t ns[] = { 1, 3, 15, 16, 17, 32, 48, 100, 128, 129, 200, 320 };
+    static const size_t ks[] = { 1, 2, 7, 16, 64, 127, 128, 129, 200, 256, 320 };
+
+    for (size_t a = 0; a < _countof(multipliers); a++) {
+        for (size_t b = 0; b < _countof(multipliers); b++) {
+            for (size_t m = 0; m < _countof(ms); m++) {
+                for (size_t n = 0; n < _countof(ns); n++) {
+                    for (size_t k = 0; k < _countof(ks); k++) {
+                        for (int TransA = CblasNoTrans; TransA <= CblasTrans; TransA++) {
+                            for (int TransB = CblasNoTrans; TransB <= CblasTrans; TransB++) {
+                                TrialSgemmPacked(CBLAS_TRANSPOSE(TransA), CBLAS_TRANSPOSE(TransB),
+                                    ms[m], ns[n], ks[k], multipliers[a], multipliers[b],
+                                    BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 void
 ReferenceConv2D(
     size_t BatchCount,
@@ -476,7 +564,8 @@ TrialConv2D(
     size_t DilationHeight,
     size_t DilationWidth,
     size_t StrideHeight,
-    size_t StrideWidth
+    size_t StrideWidth,
+    float Beta = 0.0f
     )
 {
     int64_t OutputHeight64 =
@@ -516,6 +605,7 @@ TrialConv2D(
                     OutputShape,
                     FilterCount,
                     &Activation,
+                    Beta,
                     &WorkingBufferSize);
 
     size_t OutputHeight = size_t(OutputHeight64);
@@ -544,9 +634,40 @@ TrialConv2D(
 
     MatrixGuardBuffer BufferWorking(WorkingBufferSize, false);
 
+    //
+    // Seed the output with a residual tensor that the convolution accumulates
+    // into when beta is non-zero.
+    //
+
+    MatrixGuardBuffer BufferResidual(Beta != 0.0f ? OutputBufferElements : 0, true);
+
+    const float* Residual = nullptr;
+
+    if (Beta != 0.0f) {
+        Residual = BufferResidual.GetBuffer(OutputBufferElements);
+        std::copy_n(Residual, OutputBufferElements, Output);
+    }
+
+    //
+    // The Winograd algorithm consumes a transformed filter.
+    //
+
+    const bool UseFilterTransform = (Parameters.Algorithm == MlasConvAlgorithmWinograd);
+    size_t FilterTransformSize = UseFilterTransform ? Parameters.u.Winograd.FilterTransformSize : 0;
+
+    MatrixGuardBuffer BufferFilterTransform(FilterTransformSize, false);
+
+    const float* ConvFilter = Filter;
+
+    if (UseFilterTransform) {
+        float* FilterTransform = BufferFilterTransform.GetBuffer(FilterTransformSize);
+        MlasConvWinogradTransformFilter(&Parameters, Filter, FilterTransform);
+        ConvFilter = FilterTransform;
+    }
+
     MlasConv(&Parameters,
              Input,
-             Filter,
+             ConvFilter,
              Bias,
              BufferWorking.GetBuffer(WorkingBufferSize),
              Output);
@@ -566,10 +687,16 @@ TrialConv2D(
                     Bias,
                     OutputReference);
 
+    if (Residual != nullptr) {
+        for (size_t i = 0; i < OutputBufferElements; i++) {
+            OutputReference[i] += Beta * Residual[i];
+        }
+    }
+
     if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
-        printf("mismatch: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd)!!!\n",
+        printf("mismatch: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd),beta=%g!!!\n",
             BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
-            KernelHeight, KernelWidth);
+            KernelHeight, KernelWidth, Beta);
     }
 }
 
@@ -601,6 +728,33 @@ ExecuteConvTests(
         TrialConv2D(b, 1, 64, 11, 11, 128, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
     }
 
+    for (unsigned i = 1; i <= 33; i += 4) {
+        TrialConv2D(1, 1, 16, i, i, 16, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+        TrialConv2D(2, 2, 24, i, i + 3, 40, 3, 3, 0, 1, 1, 0, 1, 1, 1, 1);
+        TrialConv2D(1, 1, 64, i + 6, i, 64, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+    }
+
+    for (unsigned i = 1; i <= 33; i += 4) {
+        TrialConv2D(1, 1, 64, i, i, 64, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1.0f);
+        TrialConv2D(3, 1, 32, i, i, 48, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1.0f);
+        TrialConv2D(1, 1, 16, i, i + 3, 32, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1.0f);
+        TrialConv2D(2, 2, 24, i, i, 40, 3, 3, 0, 1, 1, 0, 1, 1, 1, 1, 2.0f);
+        TrialConv2D(1, 1, 8, i, i, 96, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2, 1.0f);
+        TrialConv2D(1, 24, 1, i, i, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1.0f);
+    }
+
+    for (unsigned k = 3; k <= 5; k += 2) {
+        for (unsigned i = 1; i <= 37; i += 3) {
+            for (unsigned p = 0; p < k; p++) {
+                for (unsigned s = 1; s <= 2; s++) {
+                    TrialConv2D(1, 24, 1, i, i, 1, k, k, p, p, p, p, 1, 1, s, s);
+                    TrialConv2D(3, 5, 1, i, i + 7, 1, k, k, p, 0, 0, p, 1, 1, s, 1);
+                    TrialConv2D(2, 7, 1, i + 5, i, 1, k, k, 0, p, p, 0, 1, 1, 1, s);
+                }
+            }
+        }
+    }
+
     for (unsigned ic = 0; ic < _countof(cs); ic++) {
         for (unsigned ih = 0; ih < _countof(is); ih++) {
             for (unsigned iw = 0; iw < _countof(is); iw++) {
@@ -635,6 +789,282 @@ ExecuteConvTests(
     }
 }
 
+void
+ReferenceConvTranspose2D(
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t FilterCount,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    size_t PaddingLeftHeight,
+    size_t PaddingLeftWidth,
+    size_t DilationHeight,
+    size_t DilationWidth,
+    size_t StrideHeight,
+    size_t StrideWidth,
+    size_t OutputHeight,
+    size_t OutputWidth,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output
+    )
+{
+    size_t InputSize = InputHeight * InputWidth;
+    size_t OutputSize = OutputHeight * OutputWidth;
+    size_t KernelSize = KernelHeight * KernelWidth;
+
+    for (size_t b = 0; b < BatchCount; b++) {
+
+        const float* filter = Filter;
+        const float* bias = Bias;
+
+        for (size_t g = 0; g < GroupCount; g++) {
+
+            //
+            // Initialize the output with the bias.
+            //
+
+            for (size_t f = 0; f < FilterCount; f++) {
+                std::fill_n(Output + f * OutputSize, OutputSize, bias[f]);
+            }
+
+            //
+            // Scatter each input element through the kernel to the output.
+            //
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                for (size_t f = 0; f < FilterCount; f++) {
+
+                    const float* kernel = filter + (c * FilterCount + f) * KernelSize;
+
+                    for (size_t ih = 0; ih < InputHeight; ih++) {
+
+                        for (size_t iw = 0; iw < InputWidth; iw++) {
+
+                            float InputValue = Input[c * InputSize + ih * InputWidth + iw];
+
+                            for (size_t ky = 0; ky < KernelHeight; ky++) {
+
+                                size_t oh = ih * StrideHeight + ky * DilationHeight - PaddingLeftHeight;
+
+                                if (oh >= OutputHeight) {
+                                    continue;
+                                }
+
+                                for (size_t kx = 0; kx < KernelWidth; kx++) {
+
+                                    size_t ow = iw * StrideWidth + kx * DilationWidth - PaddingLeftWidth;
+
+                                    if (ow < OutputWidth) {
+                                        Output[f * OutputSize + oh * OutputWidth + ow] +=
+                                            InputValue * kernel[ky * KernelWidth + kx];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            Input += InputChannels * InputSize;
+            Output += FilterCount * OutputSize;
+            filter += InputChannels * FilterCount * KernelSize;
+            bias += FilterCount;
+        }
+    }
+}
+
+void
+TrialConvTranspose2D(
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t FilterCount,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    size_t PaddingLeftHeight,
+    size_t PaddingLeftWidth,
+    size_t PaddingRightHeight,
+    size_t PaddingRightWidth,
+    size_t DilationHeight,
+    size_t DilationWidth,
+    size_t StrideHeight,
+    size_t StrideWidth,
+    size_t OutputPadding
+    )
+{
+    int64_t OutputHeight64 =
+        (int64_t(InputHeight) - 1) * int64_t(StrideHeight) +
+        int64_t(DilationHeight) * (int64_t(KernelHeight) - 1) + 1 + int64_t(OutputPadding) -
+        int64_t(PaddingLeftHeight) - int64_t(PaddingRightHeight);
+    int64_t OutputWidth64 =
+        (int64_t(InputWidth) - 1) * int64_t(StrideWidth) +
+        int64_t(DilationWidth) * (int64_t(KernelWidth) - 1) + 1 + int64_t(OutputPadding) -
+        int64_t(PaddingLeftWidth) - int64_t(PaddingRightWidth);
+
+    if (OutputHeight64 <= 0 || OutputWidth64 <= 0) {
+        return;
+    }
+
+    int64_t InputShape[] = { int64_t(InputHeight), int64_t(InputWidth) };
+    int64_t KernelShape[] = { int64_t(KernelHeight), int64_t(KernelWidth) };
+    int64_t DilationShape[] = { int64_t(DilationHeight), int64_t(DilationWidth) };
+    int64_t Padding[] = { int64_t(PaddingLeftHeight), int64_t(PaddingLeftWidth), int64_t(PaddingRightHeight), int64_t(PaddingRightWidth) };
+    int64_t StrideShape[] = { int64_t(StrideHeight), int64_t(StrideWidth) };
+    int64_t OutputShape[] = { OutputHeight64, OutputWidth64 };
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasIdentityActivation;
+
+    MLAS_CONV_TRANSPOSE_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvTransposePrepare(&Parameters,
+                             BatchCount,
+                             GroupCount,
+                             InputChannels,
+                             InputShape,
+                             KernelShape,
+                             DilationShape,
+                             Padding,
+                             StrideShape,
+                             OutputShape,
+                             FilterCount,
+                             &Activation,
+                             &WorkingBufferSize);
+
+    size_t OutputHeight = size_t(OutputHeight64);
+    size_t OutputWidth = size_t(OutputWidth64);
+
+    size_t InputSize = InputHeight * InputWidth;
+    size_t KernelSize = KernelHeight * KernelWidth;
+    size_t OutputSize = OutputHeight * OutputWidth;
+
+    size_t InputBufferElements = BatchCount * GroupCount * InputChannels * InputSize;
+    size_t FilterBufferElements = GroupCount * InputChannels * FilterCount * KernelSize;
+    size_t BiasBufferElements = GroupCount * FilterCount;
+    size_t OutputBufferElements = BatchCount * GroupCount * FilterCount * OutputSize;
+
+    MatrixGuardBuffer BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer BufferFilter(FilterBufferElements, true);
+    MatrixGuardBuffer BufferBias(BiasBufferElements, true);
+    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+    MatrixGuardBuffer BufferWorking(WorkingBufferSize, false);
+
+    const float* Input = BufferInput.GetBuffer(InputBufferElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterBufferElements);
+    const float* Bias = BufferBias.GetBuffer(BiasBufferElements);
+    float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+
+    MlasConvTranspose(&Parameters,
+                      Input,
+                      Filter,
+                      Bias,
+                      BufferWorking.GetBuffer(WorkingBufferSize),
+                      Output);
+
+    ReferenceConvTranspose2D(BatchCount,
+                             GroupCount,
+                             InputChannels,
+                             InputHeight, InputWidth,
+                             FilterCount,
+                             KernelHeight, KernelWidth,
+                             PaddingLeftHeight, PaddingLeftWidth,
+                             DilationHeight, DilationWidth,
+                             StrideHeight, StrideWidth,
+                             OutputHeight, OutputWidth,
+                             Input,
+                             Filter,
+                             Bias,
+                             OutputReference);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch: convtranspose batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd),stride(%zd,%zd)!!!\n",
+            BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
+            KernelHeight, KernelWidth, StrideHeight, StrideWidth);
+    }
+}
+
+void
+ExecuteConvTransposeTests(
+    void
+    )
+{
+    for (unsigned i = 1; i <= 33; i += 4) {
+        for (unsigned p = 0; p <= 1; p++) {
+            TrialConvTranspose2D(1, 1, 16, i, i, 8, 2, 2, 0, 0, 0, 0, 1, 1, 2, 2, p);
+            TrialConvTranspose2D(2, 2, 8, i, i + 3, 12, 2, 2, 0, 0, 0, 0, 1, 1, 2, 2, p);
+            TrialConvTranspose2D(1, 1, 16, i, i, 8, 4, 4, 1, 1, 1, 1, 1, 1, 2, 2, p);
+            TrialConvTranspose2D(3, 3, 4, i + 2, i, 5, 4, 4, 1, 0, 0, 1, 1, 1, 2, 2, p);
+            TrialConvTranspose2D(1, 1, 16, i, i, 32, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, p);
+            TrialConvTranspose2D(2, 4, 3, i, i + 1, 7, 3, 3, 0, 1, 1, 0, 2, 2, 2, 1, p);
+            TrialConvTranspose2D(1, 1, 5, i, i, 9, 5, 3, 2, 1, 2, 1, 1, 1, 3, 2, p);
+        }
+    }
+
+    for (unsigned i = 1; i <= 32; i++) {
+        TrialConvTranspose2D(1, 1, 64, 16, 16, i, 2, 2, 0, 0, 0, 0, 1, 1, 2, 2, 0);
+        TrialConvTranspose2D(2, 1, 32, 16, 16, i, 4, 4, 1, 1, 1, 1, 1, 1, 2, 2, 0);
+    }
+
+    TrialConvTranspose2D(1, 1, 64, 64, 64, 256, 4, 4, 1, 1, 1, 1, 1, 1, 2, 2, 0);
+}
+
+void
+TrialTranspose(
+    size_t BatchCount,
+    size_t M,
+    size_t N
+    )
+{
+    size_t BufferElements = BatchCount * M * N;
+
+    MatrixGuardBuffer BufferInput(BufferElements, true);
+    MatrixGuardBuffer BufferOutput(BufferElements, false);
+
+    const float* Input = BufferInput.GetBuffer(BufferElements);
+    float* Output = BufferOutput.GetBuffer(BufferElements);
+
+    MlasTranspose(Input, Output, BatchCount, M, N);
+
+    for (size_t b = 0; b < BatchCount; b++) {
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                if (Output[(b * N + n) * M + m] != Input[(b * M + m) * N + n]) {
+                    printf("mismatch: transpose batch=%zd,M=%zd,N=%zd!!!\n", BatchCount, M, N);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void
+ExecuteTransposeTests(
+    void
+    )
+{
+    for (unsigned m = 1; m <= 35; m++) {
+        for (unsigned n = 1; n <= 35; n++) {
+            TrialTranspose(1, m, n);
+            TrialTranspose(3, m, n);
+        }
+    }
+
+    TrialTranspose(1, 1024, 1024);
+    TrialTranspose(16, 128, 197);
+    TrialTranspose(64, 3, 4096);
+}
+
 void
 ReferenceMaximumPool2D(
     const int64_t* InputShape,
@@ -1152,6 +1582,246 @@ ExecutePool3DTests(
     }
 }
 
+void
+TrialNchwcConv2D(
+    size_t BatchCount,
+    size_t InputChannels,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t FilterCount,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    size_t PaddingLeftHeight,
+    size_t PaddingLeftWidth,
+    size_t PaddingRightHeight,
+    size_t PaddingRightWidth,
+    size_t DilationHeight,
+    size_t DilationWidth,
+    size_t StrideHeight,
+    size_t StrideWidth
+    )
+{
+    int64_t OutputHeight64 =
+        ((int64_t(InputHeight) + int64_t(PaddingLeftHeight) + int64_t(PaddingRightHeight)) -
+        (int64_t(DilationHeight) * (int64_t(KernelHeight) - 1) + 1)) / int64_t(StrideHeight) + 1;
+    int64_t OutputWidth64 =
+        ((int64_t(InputWidth) + int64_t(PaddingLeftWidth) + int64_t(PaddingRightWidth)) -
+        (int64_t(DilationWidth) * (int64_t(KernelWidth) - 1) + 1)) / int64_t(StrideWidth) + 1;
+
+    if (OutputHeight64 <= 0 || OutputWidth64 <= 0) {
+        return;
+    }
+
+    int64_t InputShape[] = { int64_t(BatchCount), int64_t(InputChannels), int64_t(InputHeight), int64_t(InputWidth) };
+    int64_t FilterShape[] = { int64_t(FilterCount), int64_t(InputChannels), int64_t(KernelHeight), int64_t(KernelWidth) };
+    int64_t KernelShape[] = { int64_t(KernelHeight), int64_t(KernelWidth) };
+    int64_t DilationShape[] = { int64_t(DilationHeight), int64_t(DilationWidth) };
+    int64_t Padding[] = { int64_t(PaddingLeftHeight), int64_t(PaddingLeftWidth), int64_t(PaddingRightHeight), int64_t(PaddingRightWidth) };
+    int64_t StrideShape[] = { int64_t(StrideHeight), int64_t(StrideWidth) };
+    int64_t OutputShape[] = { int64_t(BatchCount), int64_t(FilterCount), OutputHeight64, OutputWidth64 };
+
+    size_t OutputHeight = size_t(OutputHeight64);
+    size_t OutputWidth = size_t(OutputWidth64);
+
+    size_t BlockSize = MlasNchwcGetBlockSize();
+    size_t AlignedInputChannels = (InputChannels + BlockSize - 1) & ~(BlockSize - 1);
+    size_t AlignedFilterCount = (FilterCount + BlockSize - 1) & ~(BlockSize - 1);
+
+    size_t InputSize = InputHeight * InputWidth;
+    size_t KernelSize = KernelHeight * KernelWidth;
+    size_t OutputSize = OutputHeight * OutputWidth;
+
+    size_t InputBufferElements = BatchCount * InputChannels * InputSize;
+    size_t FilterBufferElements = FilterCount * InputChannels * KernelSize;
+    size_t BiasBufferElements = FilterCount;
+    size_t OutputBufferElements = BatchCount * FilterCount * OutputSize;
+
+    size_t NchwcInputElements = BatchCount * AlignedInputChannels * InputSize;
+    size_t NchwcFilterElements = AlignedFilterCount * AlignedInputChannels * KernelSize;
+    size_t NchwcOutputElements = BatchCount * AlignedFilterCount * OutputSize;
+
+    MatrixGuardBuffer BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer BufferFilter(FilterBufferElements, true);
+    MatrixGuardBuffer BufferBias(BiasBufferElements, true);
+    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+    MatrixGuardBuffer BufferNchwcInput(NchwcInputElements, false);
+    MatrixGuardBuffer BufferNchwcFilter(NchwcFilterElements, false);
+    MatrixGuardBuffer BufferNchwcBias(AlignedFilterCount, false);
+    MatrixGuardBuffer BufferNchwcOutput(NchwcOutputElements, false);
+
+    const float* Input = BufferInput.GetBuffer(InputBufferElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterBufferElements);
+    const float* Bias = BufferBias.GetBuffer(BiasBufferElements);
+    float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+    float* NchwcInput = BufferNchwcInput.GetBuffer(NchwcInputElements);
+    float* NchwcFilter = BufferNchwcFilter.GetBuffer(NchwcFilterElements);
+    float* NchwcBias = BufferNchwcBias.GetBuffer(AlignedFilterCount);
+    float* NchwcOutput = BufferNchwcOutput.GetBuffer(NchwcOutputElements);
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasIdentityActivation;
+
+    std::fill_n(NchwcBias, AlignedFilterCount, 0.0f);
+    std::copy_n(Bias, FilterCount, NchwcBias);
+
+    MlasReorderInput(InputShape, Input, NchwcInput);
+    MlasReorderFilterOIHWBiBo(FilterShape, Filter, NchwcFilter);
+
+    MlasNchwcConv(2,
+                  InputShape,
+                  KernelShape,
+                  DilationShape,
+                  Padding,
+                  StrideShape,
+                  OutputShape,
+                  NchwcInput,
+                  NchwcFilter,
+                  NchwcBias,
+                  NchwcOutput,
+                  &Activation);
+
+    MlasReorderOutput(OutputShape, NchwcOutput, Output);
+
+    ReferenceConv2D(BatchCount,
+                    1,
+                    InputChannels,
+                    InputHeight, InputWidth,
+                    FilterCount,
+                    KernelHeight, KernelWidth,
+                    PaddingLeftHeight, PaddingLeftWidth,
+                    DilationHeight, DilationWidth,
+                    StrideHeight, StrideWidth,
+                    OutputHeight, OutputWidth,
+                    Input,
+                    Filter,
+                    Bias,
+                    OutputReference);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch: nchwc batch=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd)!!!\n",
+            BatchCount, InputChannels, InputHeight, InputWidth, FilterCount,
+            KernelHeight, KernelWidth);
+    }
+}
+
+void
+TrialNchwcPool2D(
+    size_t BatchCount,
+    size_t InputChannels,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    size_t PaddingLeftHeight,
+    size_t PaddingLeftWidth,
+    size_t PaddingRightHeight,
+    size_t PaddingRightWidth,
+    size_t StrideHeight,
+    size_t StrideWidth
+    )
+{
+    int64_t InputShape[] = { int64_t(BatchCount), int64_t(InputChannels), int64_t(InputHeight), int64_t(InputWidth) };
+    int64_t KernelShape[] = { int64_t(KernelHeight), int64_t(KernelWidth) };
+    int64_t Padding[] = { int64_t(PaddingLeftHeight), int64_t(PaddingLeftWidth), int64_t(PaddingRightHeight), int64_t(PaddingRightWidth) };
+    int64_t StrideShape[] = { int64_t(StrideHeight), int64_t(StrideWidth) };
+    int64_t OutputShape[] = { int64_t(BatchCount), int64_t(InputChannels), 0, 0 };
+
+    OutputShape[2] = (InputShape[2] + Padding[0] + Padding[2] - KernelShape[0]) / StrideShape[0] + 1;
+    OutputShape[3] = (InputShape[3] + Padding[1] + Padding[3] - KernelShape[1]) / StrideShape[1] + 1;
+
+    size_t BlockSize = MlasNchwcGetBlockSize();
+    size_t AlignedInputChannels = (InputChannels + BlockSize - 1) & ~(BlockSize - 1);
+
+    size_t InputBufferElements = size_t(InputShape[0] * InputShape[1] * InputShape[2] * InputShape[3]);
+    size_t OutputBufferElements = size_t(OutputShape[0] * OutputShape[1] * OutputShape[2] * OutputShape[3]);
+    size_t NchwcInputElements = BatchCount * AlignedInputChannels * InputHeight * InputWidth;
+    size_t NchwcOutputElements = size_t(OutputShape[0] * AlignedInputChannels * OutputShape[2] * OutputShape[3]);
+
+    MatrixGuardBuffer BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+    MatrixGuardBuffer BufferNchwcInput(NchwcInputElements, false);
+    MatrixGuardBuffer BufferNchwcOutput(NchwcOutputElements, false);
+
+    const float* Input = BufferInput.GetBuffer(InputBufferElements);
+    float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+    float* NchwcInput = BufferNchwcInput.GetBuffer(NchwcInputElements);
+    float* NchwcOutput = BufferNchwcOutput.GetBuffer(NchwcOutputElements);
+
+    MlasReorderInput(InputShape, Input, NchwcInput);
+
+    MlasNchwcPool(MlasMaximumPooling, 2, InputShape, KernelShape, Padding, StrideShape, OutputShape, NchwcInput, NchwcOutput);
+    MlasReorderOutput(OutputShape, NchwcOutput, Output);
+    ReferenceMaximumPool2D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch: nchwc maximum input(%zd,%zd,%zd),kernel(%zd,%zd)!!!\n",
+            InputChannels, InputHeight, InputWidth, KernelHeight, KernelWidth);
+    }
+
+    MlasNchwcPool(MlasAveragePoolingExcludePad, 2, InputShape, KernelShape, Padding, StrideShape, OutputShape, NchwcInput, NchwcOutput);
+    MlasReorderOutput(OutputShape, NchwcOutput, Output);
+    ReferenceAveragePool2D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference, false);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch: nchwc averageexcpad input(%zd,%zd,%zd),kernel(%zd,%zd)!!!\n",
+            InputChannels, InputHeight, InputWidth, KernelHeight, KernelWidth);
+    }
+
+    MlasNchwcPool(MlasAveragePoolingIncludePad, 2, InputShape, KernelShape, Padding, StrideShape, OutputShape, NchwcInput, NchwcOutput);
+    MlasReorderOutput(OutputShape, NchwcOutput, Output);
+    ReferenceAveragePool2D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference, true);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch: nchwc averageincpad input(%zd,%zd,%zd),kernel(%zd,%zd)!!!\n",
+            InputChannels, InputHeight, InputWidth, KernelHeight, KernelWidth);
+    }
+}
+
+void
+ExecuteNchwcTests(
+    void
+    )
+{
+    static const unsigned cs[] = { 32, 17, 8, 3 };
+    static const unsigned is[] = { 53, 11, 5, 1 };
+
+    for (unsigned ic = 0; ic < _countof(cs); ic++) {
+        for (unsigned ih = 0; ih < _countof(is); ih++) {
+            for (unsigned iw = 0; iw < _countof(is); iw++) {
+                fprintf(stderr, "Handling nchwc %dx%dx%d\n", cs[ic], is[ih], is[iw]);
+                for (unsigned fc = 0; fc < _countof(cs); fc++) {
+                    for (unsigned k = 1; k <= 5; k += 2) {
+                        for (unsigned p = 0; p <= k / 2; p++) {
+                            for (unsigned d = 1; d <= 2; d++) {
+                                for (unsigned s = 1; s <= 2; s++) {
+                                    TrialNchwcConv2D(1, cs[ic], is[ih], is[iw], cs[fc], k, k, p, p, p, p, d, d, s, s);
+                                }
+                            }
+                        }
+                    }
+                }
+                for (unsigned kh = 1; kh <= 3; kh++) {
+                    if (kh > is[ih]) break;
+                    for (unsigned kw = 1; kw <= 3; kw++) {
+                        if (kw > is[iw]) break;
+                        for (unsigned s = 1; s <= 2; s++) {
+                            for (unsigned p = 0; p < (std::min)(kh, kw); p++) {
+                                TrialNchwcPool2D(2, cs[ic], is[ih], is[iw], kh, kw, p, p, p, p, s, s);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    TrialNchwcConv2D(3, 24, 9, 13, 40, 3, 5, 1, 2, 0, 1, 1, 1, 2, 1);
+}
+
 #if 0
 #if defined(_WIN32)
 
@@ -1239,9 +1909,13 @@ main(
     )
 {
 //    ExecuteSgemmTests();
+    ExecuteSgemmPackedTests();
     ExecuteConvTests();
+    ExecuteConvTransposeTests();
 //    ExecutePool2DTests();
 //    ExecutePool3DTests();
+    ExecuteNchwcTests();
+    ExecuteTransposeTests();
 //    EvaluateThreadingPerformance();
 
     return 0;
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace onnxruntime {
+namespace benchmark_utils {
+
+// Thread counts every kernel benchmark is registered with. The count is the size of the
+// session's kernel thread pool (SessionOptions::intra_op_num_threads) and, in a USE_OPENMP
+// build, the number of OpenMP threads used by MLAS and the kernels with OpenMP loops.
+static const std::vector<int64_t> kThreadCounts = {1, 2, 4, 8};
+
+// Thread counts the MLAS benchmarks are registered with. MLAS splits its work over OpenMP
+// threads, or the Windows thread pool in builds without OpenMP which can't be sized from here,
+// so counts above one are only measured in a USE_OPENMP build.
+#ifdef USE_OPENMP
+static const std::vector<int64_t> kMlasThreadCounts = {1, 2, 4, 8};
+#else
+static const std::vector<int64_t> kMlasThreadCounts = {1};
+#endif
+
+// Apply the thread count carried in state.range(arg_index) to OpenMP, report it as a counter
+// and return it.
+inline int SetThreadCount(benchmark::State& state, int arg_index) {
+  const int threads = static_cast<int>(state.range(arg_index));
+#ifdef USE_OPENMP
+  omp_set_num_threads(threads);
+#endif
+  state.counters["threads"] = static_cast<double>(threads);
+  return threads;
+}
+
+template <typename T>
+std::vector<T> RandomValues(size_t count, T min_value, T max_value, uint32_t seed = 42) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> distribution(static_cast<double>(min_value), static_cast<double>(max_value));
+  std::vector<T> values(count);
+  for (auto& v : values) {
+    v = static_cast<T>(distribution(generator));
+  }
+  return values;
+}
+
+}  // namespace benchmark_utils
+}  // namespace onnxruntime
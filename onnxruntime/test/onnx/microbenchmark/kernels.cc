@@ -0,0 +1,551 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks for individual CPU kernels. Each benchmark builds a model holding a single node,
+// loads it into an InferenceSession and times InferenceSession::Run, so the numbers include the
+// per-node execution overhead seen by real models.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/model.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/providers/cpu/cpu_execution_provider.h>
+#include <core/session/inference_session.h>
+#include <cstring>
+#include <sstream>
+#include "benchmark_utils.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::benchmark_utils;
+
+namespace {
+
+class SingleNodeModel {
+ public:
+  SingleNodeModel(const char* op_type, int opset_version, const char* domain = kOnnxDomain)
+      : op_type_(op_type), opset_version_(opset_version), domain_(domain) {}
+
+  template <typename T>
+  void AddInput(const std::string& name, const std::vector<int64_t>& dims, const std::vector<T>& values,
+                bool is_initializer = false) {
+    inputs_.push_back({name, dims, DataTypeImpl::GetType<T>(), ElementType<T>(), is_initializer, {}});
+    auto& data = inputs_.back().data;
+    data.resize(values.size() * sizeof(T));
+    memcpy(data.data(), values.data(), data.size());
+  }
+
+  template <typename T>
+  void AddOutput(const std::string& name) {
+    outputs_.push_back({name, ElementType<T>()});
+  }
+
+  template <typename T>
+  void AddAttribute(const std::string& name, const T& value) {
+    attributes_.push_back([name, value](Node& node) { node.AddAttribute(name, value); });
+  }
+
+  // num_threads is the size of the thread pool shared by the kernels of the session
+  Status Initialize(int num_threads) {
+    std::unordered_map<std::string, int> domain_to_version{{domain_, opset_version_}};
+    if (domain_ != kOnnxDomain) {
+      domain_to_version[kOnnxDomain] = 9;
+    }
+    Model model("benchmark", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+    Graph& graph = model.MainGraph();
+
+    std::vector<NodeArg*> input_defs;
+    for (const auto& input : inputs_) {
+      ONNX_NAMESPACE::TypeProto type;
+      type.mutable_tensor_type()->set_elem_type(input.elem_type);
+      for (auto dim : input.dims) {
+        type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+      }
+      input_defs.push_back(&graph.GetOrCreateNodeArg(input.name, &type));
+
+      if (input.is_initializer) {
+        ONNX_NAMESPACE::TensorProto tensor_proto;
+        tensor_proto.set_name(input.name);
+        tensor_proto.set_data_type(input.elem_type);
+        for (auto dim : input.dims) {
+          tensor_proto.add_dims(dim);
+        }
+        tensor_proto.set_raw_data(input.data.data(), input.data.size());
+        graph.AddInitializedTensor(tensor_proto);
+      }
+    }
+
+    std::vector<NodeArg*> output_defs;
+    for (const auto& output : outputs_) {
+      ONNX_NAMESPACE::TypeProto type;
+      type.mutable_tensor_type()->set_elem_type(output.elem_type);
+      output_defs.push_back(&graph.GetOrCreateNodeArg(output.name, &type));
+      output_names_.push_back(output.name);
+    }
+
+    auto& node = graph.AddNode("node1", op_type_, op_type_, input_defs, output_defs, nullptr, domain_);
+    for (auto& add_attribute : attributes_) {
+      add_attribute(node);
+    }
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+
+    std::stringstream model_stream;
+    model.ToProto().SerializeToOstream(&model_stream);
+
+    SessionOptions so;
+    so.session_logid = op_type_;
+    so.intra_op_num_threads = num_threads;
+    session_ = std::make_unique<InferenceSession>(so);
+    ORT_RETURN_IF_ERROR(session_->Load(model_stream));
+    ORT_RETURN_IF_ERROR(session_->Initialize());
+
+    auto allocator = std::make_shared<CPUAllocator>();
+    for (const auto& input : inputs_) {
+      if (input.is_initializer) {
+        continue;
+      }
+      void* buffer = allocator->Alloc(input.data.size());
+      memcpy(buffer, input.data.data(), input.data.size());
+      std::unique_ptr<Tensor> tensor = std::make_unique<Tensor>(input.type, TensorShape(input.dims), buffer,
+                                                                allocator->Info(), allocator);
+      MLValue value;
+      value.Init(tensor.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+      feeds_.insert({input.name, value});
+    }
+
+    // the first run pays for allocation planning and kernel caches
+    return Run();
+  }
+
+  Status Run() {
+    fetches_.clear();
+    return session_->Run(feeds_, output_names_, &fetches_);
+  }
+
+ private:
+  struct Input {
+    std::string name;
+    std::vector<int64_t> dims;
+    MLDataType type;
+    int32_t elem_type;
+    bool is_initializer;
+    std::vector<uint8_t> data;
+  };
+
+  struct Output {
+    std::string name;
+    int32_t elem_type;
+  };
+
+  template <typename T>
+  static int32_t ElementType();
+
+  std::string op_type_;
+  int opset_version_;
+  std::string domain_;
+  std::vector<Input> inputs_;
+  std::vector<Output> outputs_;
+  std::vector<std::function<void(Node&)>> attributes_;
+
+  std::unique_ptr<InferenceSession> session_;
+  NameMLValMap feeds_;
+  std::vector<std::string> output_names_;
+  std::vector<MLValue> fetches_;
+};
+
+template <>
+int32_t SingleNodeModel::ElementType<float>() {
+  return ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
+
+template <>
+int32_t SingleNodeModel::ElementType<int64_t>() {
+  return ONNX_NAMESPACE::TensorProto_DataType_INT64;
+}
+
+void RunSingleNodeModel(benchmark::State& state, SingleNodeModel& model, int num_threads,
+                        int64_t items_per_iteration) {
+  auto status = model.Initialize(num_threads);
+  if (!status.IsOK()) {
+    state.SkipWithError(status.ErrorMessage().c_str());
+    return;
+  }
+  for (auto _ : state) {
+    status = model.Run();
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * items_per_iteration);
+}
+
+int64_t Product(const std::vector<int64_t>& dims) {
+  int64_t size = 1;
+  for (auto dim : dims) size *= dim;
+  return size;
+}
+
+// Register every shape in `shapes` once per thread count, appending the thread count as the last argument.
+void AddShapesAndThreads(benchmark::internal::Benchmark* b, std::vector<std::string> names,
+                         const std::vector<std::vector<int64_t>>& shapes) {
+  names.push_back("threads");
+  b->ArgNames(names);
+  for (const auto& shape : shapes) {
+    for (int64_t threads : kThreadCounts) {
+      auto args = shape;
+      args.push_back(threads);
+      b->Args(args);
+    }
+  }
+  b->UseRealTime();
+}
+
+}  // namespace
+
+// Conv with a 2-D kernel runs through MlasConv, a 1-D kernel through Im2colNd + Gemm.
+// args: batch, input channels, spatial size, filter count, kernel size, rank, threads
+static void BM_Conv(benchmark::State& state) {
+  const int64_t N = state.range(0), C = state.range(1), HW = state.range(2), M = state.range(3),
+                K = state.range(4), rank = state.range(5);
+  const int threads = SetThreadCount(state, 6);
+
+  std::vector<int64_t> x_dims{N, C}, w_dims{M, C}, pads, out_spatial;
+  for (int64_t i = 0; i < rank; ++i) {
+    x_dims.push_back(HW);
+    w_dims.push_back(K);
+    out_spatial.push_back(HW);
+  }
+  for (int64_t i = 0; i < 2 * rank; ++i) {
+    pads.push_back(K / 2);
+  }
+
+  SingleNodeModel model("Conv", 9);
+  model.AddInput<float>("X", x_dims, RandomValues<float>(Product(x_dims), -1.0f, 1.0f));
+  model.AddInput<float>("W", w_dims, RandomValues<float>(Product(w_dims), -1.0f, 1.0f), true);
+  model.AddInput<float>("B", {M}, RandomValues<float>(M, -1.0f, 1.0f), true);
+  model.AddOutput<float>("Y");
+  model.AddAttribute("pads", pads);
+  RunSingleNodeModel(state, model, threads, 2 * N * Product(out_spatial) * Product(w_dims));
+}
+
+static void ConvArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"N", "C", "HW", "M", "K", "rank"},
+                         {{1, 64, 56, 64, 1, 2},
+                          {1, 64, 56, 64, 3, 2},
+                          {1, 256, 14, 256, 3, 2},
+                          {1, 3, 224, 64, 7, 2},
+                          {1, 64, 4096, 64, 3, 1},
+                          {1, 256, 1024, 256, 5, 1}});
+}
+
+BENCHMARK(BM_Conv)->Apply(ConvArgs);
+
+// args: batch * channels, spatial size, kernel size, threads
+static void BM_MaxPool(benchmark::State& state) {
+  const int64_t C = state.range(0), HW = state.range(1), K = state.range(2);
+  const int threads = SetThreadCount(state, 3);
+
+  SingleNodeModel model("MaxPool", 9);
+  model.AddInput<float>("X", {1, C, HW, HW}, RandomValues<float>(C * HW * HW, -1.0f, 1.0f));
+  model.AddOutput<float>("Y");
+  model.AddAttribute("kernel_shape", std::vector<int64_t>{K, K});
+  model.AddAttribute("strides", std::vector<int64_t>{2, 2});
+  RunSingleNodeModel(state, model, threads, C * HW * HW);
+}
+
+static void MaxPoolArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"C", "HW", "K"}, {{64, 112, 3}, {256, 56, 2}, {512, 28, 2}});
+}
+
+BENCHMARK(BM_MaxPool)->Apply(MaxPoolArgs);
+
+static void BM_GlobalAveragePool(benchmark::State& state) {
+  const int64_t C = state.range(0), HW = state.range(1);
+  const int threads = SetThreadCount(state, 2);
+
+  SingleNodeModel model("GlobalAveragePool", 9);
+  model.AddInput<float>("X", {1, C, HW, HW}, RandomValues<float>(C * HW * HW, -1.0f, 1.0f));
+  model.AddOutput<float>("Y");
+  RunSingleNodeModel(state, model, threads, C * HW * HW);
+}
+
+static void GlobalAveragePoolArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"C", "HW"}, {{2048, 7}, {512, 28}});
+}
+
+BENCHMARK(BM_GlobalAveragePool)->Apply(GlobalAveragePoolArgs);
+
+// args: rows, columns, threads
+static void BM_Softmax(benchmark::State& state) {
+  const int64_t rows = state.range(0), cols = state.range(1);
+  const int threads = SetThreadCount(state, 2);
+
+  SingleNodeModel model("Softmax", 9);
+  model.AddInput<float>("X", {rows, cols}, RandomValues<float>(rows * cols, -4.0f, 4.0f));
+  model.AddOutput<float>("Y");
+  RunSingleNodeModel(state, model, threads, rows * cols);
+}
+
+static void SoftmaxArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"rows", "cols"}, {{1, 1000}, {64, 1000}, {512, 128}, {4096, 64}});
+}
+
+BENCHMARK(BM_Softmax)->Apply(SoftmaxArgs);
+
+// Add of a [N, C, H, W] tensor with a tensor broadcast along the given pattern.
+// args: N, C, HW, broadcast kind (0 = same shape, 1 = per channel, 2 = scalar), threads
+static void BM_AddBroadcast(benchmark::State& state) {
+  const int64_t N = state.range(0), C = state.range(1), HW = state.range(2), kind = state.range(3);
+  const int threads = SetThreadCount(state, 4);
+
+  std::vector<int64_t> a_dims{N, C, HW, HW};
+  std::vector<int64_t> b_dims = kind == 0 ? a_dims : (kind == 1 ? std::vector<int64_t>{C, 1, 1} : std::vector<int64_t>{1});
+
+  SingleNodeModel model("Add", 7);
+  model.AddInput<float>("A", a_dims, RandomValues<float>(Product(a_dims), -1.0f, 1.0f));
+  model.AddInput<float>("B", b_dims, RandomValues<float>(Product(b_dims), -1.0f, 1.0f));
+  model.AddOutput<float>("C");
+  RunSingleNodeModel(state, model, threads, Product(a_dims));
+}
+
+static void AddBroadcastArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"N", "C", "HW", "kind"},
+                         {{1, 64, 56, 0},
+                          {1, 64, 56, 1},
+                          {1, 64, 56, 2},
+                          {8, 256, 14, 1}});
+}
+
+BENCHMARK(BM_AddBroadcast)->Apply(AddBroadcastArgs);
+
+// args: dim0, dim1, dim2, dim3, permutation id (0 = NCHW->NHWC, 1 = swap last two, 2 = reverse), threads
+static void BM_Transpose(benchmark::State& state) {
+  std::vector<int64_t> dims{state.range(0), state.range(1), state.range(2), state.range(3)};
+  const int64_t perm_id = state.range(4);
+  const int threads = SetThreadCount(state, 5);
+
+  static const std::vector<int64_t> perms[] = {{0, 2, 3, 1}, {0, 1, 3, 2}, {3, 2, 1, 0}};
+
+  SingleNodeModel model("Transpose", 9);
+  model.AddInput<float>("X", dims, RandomValues<float>(Product(dims), -1.0f, 1.0f));
+  model.AddOutput<float>("Y");
+  model.AddAttribute("perm", perms[perm_id]);
+  RunSingleNodeModel(state, model, threads, Product(dims));
+}
+
+static void TransposeArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"d0", "d1", "d2", "d3", "perm"},
+                         {{1, 64, 56, 56, 0},
+                          {1, 64, 56, 56, 1},
+                          {1, 64, 56, 56, 2},
+                          {16, 12, 128, 64, 1}});
+}
+
+BENCHMARK(BM_Transpose)->Apply(TransposeArgs);
+
+// Embedding style lookup. args: vocabulary size, embedding width, number of indices, threads
+static void BM_Gather(benchmark::State& state) {
+  const int64_t vocab = state.range(0), width = state.range(1), count = state.range(2);
+  const int threads = SetThreadCount(state, 3);
+
+  SingleNodeModel model("Gather", 9);
+  model.AddInput<float>("data", {vocab, width}, RandomValues<float>(vocab * width, -1.0f, 1.0f), true);
+  model.AddInput<int64_t>("indices", {count}, RandomValues<int64_t>(count, 0, vocab));
+  model.AddOutput<float>("output");
+  RunSingleNodeModel(state, model, threads, count * width);
+}
+
+static void GatherArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"vocab", "width", "indices"},
+                         {{30000, 128, 128}, {30000, 768, 512}, {1000000, 64, 4096}});
+}
+
+BENCHMARK(BM_Gather)->Apply(GatherArgs);
+
+// args: number of inputs, channels per input, spatial size, axis, threads
+static void BM_Concat(benchmark::State& state) {
+  const int64_t count = state.range(0), C = state.range(1), HW = state.range(2), axis = state.range(3);
+  const int threads = SetThreadCount(state, 4);
+
+  SingleNodeModel model("Concat", 4);
+  std::vector<int64_t> dims{1, C, HW, HW};
+  for (int64_t i = 0; i < count; ++i) {
+    model.AddInput<float>("X" + std::to_string(i), dims, RandomValues<float>(Product(dims), -1.0f, 1.0f));
+  }
+  model.AddOutput<float>("Y");
+  model.AddAttribute("axis", axis);
+  RunSingleNodeModel(state, model, threads, count * Product(dims));
+}
+
+static void ConcatArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"inputs", "C", "HW", "axis"},
+                         {{2, 64, 56, 1}, {4, 128, 28, 1}, {4, 128, 28, 3}});
+}
+
+BENCHMARK(BM_Concat)->Apply(ConcatArgs);
+
+// args: dim0, dim1, dim2, reduced axis, threads
+static void BM_ReduceSum(benchmark::State& state) {
+  std::vector<int64_t> dims{state.range(0), state.range(1), state.range(2)};
+  const int64_t axis = state.range(3);
+  const int threads = SetThreadCount(state, 4);
+
+  SingleNodeModel model("ReduceSum", 1);
+  model.AddInput<float>("data", dims, RandomValues<float>(Product(dims), -1.0f, 1.0f));
+  model.AddOutput<float>("reduced");
+  model.AddAttribute("axes", std::vector<int64_t>{axis});
+  RunSingleNodeModel(state, model, threads, Product(dims));
+}
+
+static void ReduceSumArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"d0", "d1", "d2", "axis"},
+                         {{64, 256, 256, 0},
+                          {64, 256, 256, 1},
+                          {64, 256, 256, 2}});
+}
+
+BENCHMARK(BM_ReduceSum)->Apply(ReduceSumArgs);
+
+static void BM_ReduceMean(benchmark::State& state) {
+  std::vector<int64_t> dims{state.range(0), state.range(1), state.range(2)};
+  const int64_t axis = state.range(3);
+  const int threads = SetThreadCount(state, 4);
+
+  SingleNodeModel model("ReduceMean", 1);
+  model.AddInput<float>("data", dims, RandomValues<float>(Product(dims), -1.0f, 1.0f));
+  model.AddOutput<float>("reduced");
+  model.AddAttribute("axes", std::vector<int64_t>{axis});
+  RunSingleNodeModel(state, model, threads, Product(dims));
+}
+
+static void ReduceMeanArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"d0", "d1", "d2", "axis"},
+                         {{64, 256, 256, 0}, {64, 256, 256, 2}});
+}
+
+BENCHMARK(BM_ReduceMean)->Apply(ReduceMeanArgs);
+
+// args: sequence length, batch size, input size, hidden size, threads
+template <int gates>
+static void RunRecurrent(benchmark::State& state, const char* op_type) {
+  const int64_t seq = state.range(0), batch = state.range(1), input = state.range(2), hidden = state.range(3);
+  const int threads = SetThreadCount(state, 4);
+
+  SingleNodeModel model(op_type, 7);
+  model.AddInput<float>("X", {seq, batch, input}, RandomValues<float>(seq * batch * input, -1.0f, 1.0f));
+  model.AddInput<float>("W", {1, gates * hidden, input},
+                        RandomValues<float>(gates * hidden * input, -0.1f, 0.1f), true);
+  model.AddInput<float>("R", {1, gates * hidden, hidden},
+                        RandomValues<float>(gates * hidden * hidden, -0.1f, 0.1f), true);
+  model.AddInput<float>("B", {1, 2 * gates * hidden}, RandomValues<float>(2 * gates * hidden, -0.1f, 0.1f), true);
+  model.AddOutput<float>("Y");
+  model.AddAttribute("hidden_size", hidden);
+  RunSingleNodeModel(state, model, threads, seq * batch * gates * hidden * (input + hidden) * 2);
+}
+
+static void BM_LSTM(benchmark::State& state) {
+  RunRecurrent<4>(state, "LSTM");
+}
+
+static void BM_GRU(benchmark::State& state) {
+  RunRecurrent<3>(state, "GRU");
+}
+
+static const std::vector<std::vector<int64_t>> recurrent_shapes = {
+    {1, 1, 128, 128},  // single streaming step
+    {32, 1, 128, 128},
+    {32, 16, 256, 256},
+    {100, 64, 512, 512},
+};
+
+static void LSTMArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"seq", "batch", "input", "hidden"}, recurrent_shapes);
+}
+
+BENCHMARK(BM_LSTM)->Apply(LSTMArgs);
+static void GRUArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"seq", "batch", "input", "hidden"}, recurrent_shapes);
+}
+
+BENCHMARK(BM_GRU)->Apply(GRUArgs);
+
+// Forest of complete binary trees. args: rows, features, trees, depth, threads
+static void BM_TreeEnsembleRegressor(benchmark::State& state) {
+  const int64_t rows = state.range(0), features = state.range(1), trees = state.range(2), depth = state.range(3);
+  const int threads = SetThreadCount(state, 4);
+
+  std::vector<int64_t> nodes_treeids, nodes_nodeids, nodes_featureids, nodes_truenodeids, nodes_falsenodeids;
+  std::vector<float> nodes_values;
+  std::vector<std::string> nodes_modes;
+  std::vector<int64_t> target_treeids, target_nodeids, target_ids;
+  std::vector<float> target_weights;
+
+  const int64_t branches = (int64_t(1) << depth) - 1;
+  const int64_t leaves = int64_t(1) << depth;
+  auto thresholds = RandomValues<float>(trees * branches, -1.0f, 1.0f);
+  auto feature_ids = RandomValues<int64_t>(trees * branches, 0, features);
+  auto weights = RandomValues<float>(trees * leaves, -1.0f, 1.0f);
+  for (int64_t t = 0; t < trees; ++t) {
+    for (int64_t n = 0; n < branches + leaves; ++n) {
+      const bool is_leaf = n >= branches;
+      nodes_treeids.push_back(t);
+      nodes_nodeids.push_back(n);
+      nodes_featureids.push_back(is_leaf ? 0 : feature_ids[t * branches + n]);
+      nodes_values.push_back(is_leaf ? 0.0f : thresholds[t * branches + n]);
+      nodes_modes.push_back(is_leaf ? "LEAF" : "BRANCH_LEQ");
+      nodes_truenodeids.push_back(is_leaf ? 0 : 2 * n + 1);
+      nodes_falsenodeids.push_back(is_leaf ? 0 : 2 * n + 2);
+      if (is_leaf) {
+        target_treeids.push_back(t);
+        target_nodeids.push_back(n);
+        target_ids.push_back(0);
+        target_weights.push_back(weights[t * leaves + n - branches]);
+      }
+    }
+  }
+
+  SingleNodeModel model("TreeEnsembleRegressor", 1, kMLDomain);
+  model.AddInput<float>("X", {rows, features}, RandomValues<float>(rows * features, -1.0f, 1.0f));
+  model.AddOutput<float>("Y");
+  model.AddAttribute("n_targets", int64_t(1));
+  model.AddAttribute("nodes_treeids", nodes_treeids);
+  model.AddAttribute("nodes_nodeids", nodes_nodeids);
+  model.AddAttribute("nodes_featureids", nodes_featureids);
+  model.AddAttribute("nodes_values", nodes_values);
+  model.AddAttribute("nodes_modes", nodes_modes);
+  model.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  model.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  model.AddAttribute("target_treeids", target_treeids);
+  model.AddAttribute("target_nodeids", target_nodeids);
+  model.AddAttribute("target_ids", target_ids);
+  model.AddAttribute("target_weights", target_weights);
+  RunSingleNodeModel(state, model, threads, rows * trees);
+}
+
+static void TreeEnsembleRegressorArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"rows", "features", "trees", "depth"},
+                         {{1, 32, 100, 6},
+                          {1000, 32, 100, 6},
+                          {10000, 100, 300, 8}});
+}
+
+BENCHMARK(BM_TreeEnsembleRegressor)->Apply(TreeEnsembleRegressorArgs);
+
+// args: rows, columns, k, threads
+static void BM_TopK(benchmark::State& state) {
+  const int64_t rows = state.range(0), cols = state.range(1), k = state.range(2);
+  const int threads = SetThreadCount(state, 3);
+
+  SingleNodeModel model("TopK", 1);
+  model.AddInput<float>("X", {rows, cols}, RandomValues<float>(rows * cols, -1.0f, 1.0f));
+  model.AddOutput<float>("Values");
+  model.AddOutput<int64_t>("Indices");
+  model.AddAttribute("k", k);
+  RunSingleNodeModel(state, model, threads, rows * cols);
+}
+
+static void TopKArgs(benchmark::internal::Benchmark* b) {
+  AddShapesAndThreads(b, {"rows", "cols", "k"},
+                         {{1, 1000, 5}, {64, 1000, 5}, {1, 100000, 100}, {128, 30000, 1}});
+}
+
+BENCHMARK(BM_TopK)->Apply(TopKArgs);
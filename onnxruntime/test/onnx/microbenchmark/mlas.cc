@@ -0,0 +1,309 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/mlas/inc/mlas.h>
+#include <vector>
+#include "benchmark_utils.h"
+
+using namespace onnxruntime::benchmark_utils;
+
+// args: M, N, K, threads
+static void BM_MlasSgemm(benchmark::State& state) {
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  SetThreadCount(state, 3);
+
+  std::vector<float> A = RandomValues<float>(M * K, -1.0f, 1.0f);
+  std::vector<float> B = RandomValues<float>(K * N, -1.0f, 1.0f);
+  std::vector<float> C(M * N);
+
+  for (auto _ : state) {
+    MlasSgemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A.data(), K, B.data(), N, 0.0f, C.data(), N);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(2 * M * N * K));
+}
+
+static void SgemmArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N", "K", "threads"});
+  const std::vector<std::vector<int64_t>> shapes = {
+      {1, 1024, 1024},   // matrix-vector, e.g. fully connected layer with batch 1
+      {16, 1024, 1024},  // small batch
+      {64, 64, 64},
+      {128, 128, 128},
+      {256, 256, 256},
+      {512, 512, 512},
+      {1024, 1024, 1024},
+      {64, 3136, 576},   // 3x3 convolution lowered to GEMM
+      {256, 196, 2304},
+  };
+  for (const auto& shape : shapes) {
+    for (int64_t threads : kMlasThreadCounts) {
+      b->Args({shape[0], shape[1], shape[2], threads});
+    }
+  }
+}
+
+BENCHMARK(BM_MlasSgemm)->Apply(SgemmArgs)->UseRealTime();
+
+// args: batch, input channels, image size, filter count, kernel size, stride, threads
+static void BM_MlasConv2D(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const int64_t channels = state.range(1);
+  const int64_t image = state.range(2);
+  const int64_t filters = state.range(3);
+  const int64_t kernel = state.range(4);
+  const int64_t stride = state.range(5);
+  SetThreadCount(state, 6);
+
+  const int64_t pad = kernel / 2;
+  const int64_t output = (image + 2 * pad - kernel) / stride + 1;
+
+  const int64_t input_shape[] = {image, image};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t dilation_shape[] = {1, 1};
+  const int64_t padding[] = {pad, pad, pad, pad};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {output, output};
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasReluActivation;
+
+  MLAS_CONV_PARAMETERS parameters;
+  size_t working_buffer_size;
+  MlasConvPrepare(&parameters, 2, static_cast<size_t>(batch), 1, static_cast<size_t>(channels),
+                  input_shape, kernel_shape, dilation_shape, padding, stride_shape, output_shape,
+                  static_cast<size_t>(filters), &activation, 0.0f, &working_buffer_size);
+
+  std::vector<float> X = RandomValues<float>(static_cast<size_t>(batch * channels * image * image), -1.0f, 1.0f);
+  std::vector<float> W = RandomValues<float>(static_cast<size_t>(filters * channels * kernel * kernel), -1.0f, 1.0f);
+  std::vector<float> B = RandomValues<float>(static_cast<size_t>(filters), -1.0f, 1.0f);
+  std::vector<float> working_buffer(working_buffer_size);
+  std::vector<float> Y(static_cast<size_t>(batch * filters * output * output));
+
+  // The Winograd filter transform is cached by the Conv kernel, so it is not timed.
+  const float* filter = W.data();
+  std::vector<float> filter_transform;
+  if (parameters.Algorithm == MlasConvAlgorithmWinograd) {
+    filter_transform.resize(parameters.u.Winograd.FilterTransformSize);
+    MlasConvWinogradTransformFilter(&parameters, W.data(), filter_transform.data());
+    filter = filter_transform.data();
+  }
+
+  for (auto _ : state) {
+    MlasConv(&parameters, X.data(), filter, B.data(), working_buffer.data(), Y.data());
+  }
+  state.counters["algorithm"] = static_cast<double>(parameters.Algorithm);
+  state.SetItemsProcessed(state.iterations() * 2 * batch * filters * output * output * channels * kernel * kernel);
+}
+
+static void Conv2DArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "C", "HW", "M", "K", "S", "threads"});
+  const std::vector<std::vector<int64_t>> shapes = {
+      {1, 64, 56, 64, 1, 1},    // pointwise, GEMM direct
+      {1, 64, 56, 64, 3, 1},    // Winograd
+      {1, 128, 28, 128, 3, 1},
+      {1, 256, 14, 256, 3, 1},
+      {1, 512, 7, 512, 3, 1},
+      {1, 3, 224, 64, 7, 2},    // typical network stem, im2col then GEMM
+      {8, 64, 56, 64, 3, 1},
+  };
+  for (const auto& shape : shapes) {
+    for (int64_t threads : kMlasThreadCounts) {
+      b->Args({shape[0], shape[1], shape[2], shape[3], shape[4], shape[5], threads});
+    }
+  }
+}
+
+BENCHMARK(BM_MlasConv2D)->Apply(Conv2DArgs)->UseRealTime();
+
+// args: batch, channels, image size, kernel size, stride, threads
+static void BM_MlasDepthwiseConv2D(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const int64_t channels = state.range(1);
+  const int64_t image = state.range(2);
+  const int64_t kernel = state.range(3);
+  const int64_t stride = state.range(4);
+  SetThreadCount(state, 5);
+
+  const int64_t pad = kernel / 2;
+  const int64_t output = (image + 2 * pad - kernel) / stride + 1;
+
+  const int64_t input_shape[] = {image, image};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t dilation_shape[] = {1, 1};
+  const int64_t padding[] = {pad, pad, pad, pad};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {output, output};
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasReluActivation;
+
+  MLAS_CONV_PARAMETERS parameters;
+  size_t working_buffer_size;
+  MlasConvPrepare(&parameters, 2, static_cast<size_t>(batch), static_cast<size_t>(channels), 1,
+                  input_shape, kernel_shape, dilation_shape, padding, stride_shape, output_shape,
+                  1, &activation, 0.0f, &working_buffer_size);
+
+  std::vector<float> X = RandomValues<float>(static_cast<size_t>(batch * channels * image * image), -1.0f, 1.0f);
+  std::vector<float> W = RandomValues<float>(static_cast<size_t>(channels * kernel * kernel), -1.0f, 1.0f);
+  std::vector<float> B = RandomValues<float>(static_cast<size_t>(channels), -1.0f, 1.0f);
+  std::vector<float> working_buffer(working_buffer_size);
+  std::vector<float> Y(static_cast<size_t>(batch * channels * output * output));
+
+  for (auto _ : state) {
+    MlasConv(&parameters, X.data(), W.data(), B.data(), working_buffer.data(), Y.data());
+  }
+  state.counters["algorithm"] = static_cast<double>(parameters.Algorithm);
+  state.SetItemsProcessed(state.iterations() * 2 * batch * channels * output * output * kernel * kernel);
+}
+
+static void DepthwiseConv2DArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "C", "HW", "K", "S", "threads"});
+  const std::vector<std::vector<int64_t>> shapes = {
+      {1, 32, 112, 3, 1},  // MobileNet depthwise layers
+      {1, 64, 112, 3, 2},
+      {1, 128, 56, 3, 1},
+      {1, 256, 28, 3, 2},
+      {1, 512, 14, 3, 1},
+      {1, 96, 56, 5, 1},
+      {1, 240, 28, 5, 2},
+  };
+  for (const auto& shape : shapes) {
+    for (int64_t threads : kMlasThreadCounts) {
+      b->Args({shape[0], shape[1], shape[2], shape[3], shape[4], threads});
+    }
+  }
+}
+
+BENCHMARK(BM_MlasDepthwiseConv2D)->Apply(DepthwiseConv2DArgs)->UseRealTime();
+
+// args: batch, input channels, image size, output channels, kernel size, stride, threads
+static void BM_MlasConvTranspose2D(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const int64_t input_channels = state.range(1);
+  const int64_t image = state.range(2);
+  const int64_t output_channels = state.range(3);
+  const int64_t kernel = state.range(4);
+  const int64_t stride = state.range(5);
+  SetThreadCount(state, 6);
+
+  const int64_t pad = (kernel - stride) / 2;
+  const int64_t output = (image - 1) * stride + kernel - 2 * pad;
+
+  const int64_t input_shape[] = {image, image};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t dilation_shape[] = {1, 1};
+  const int64_t padding[] = {pad, pad, pad, pad};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {output, output};
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasReluActivation;
+
+  MLAS_CONV_TRANSPOSE_PARAMETERS parameters;
+  size_t working_buffer_size;
+  MlasConvTransposePrepare(&parameters, static_cast<size_t>(batch), 1, static_cast<size_t>(input_channels),
+                           input_shape, kernel_shape, dilation_shape, padding, stride_shape, output_shape,
+                           static_cast<size_t>(output_channels), &activation, &working_buffer_size);
+
+  std::vector<float> X = RandomValues<float>(static_cast<size_t>(batch * input_channels * image * image), -1.0f, 1.0f);
+  std::vector<float> W = RandomValues<float>(static_cast<size_t>(input_channels * output_channels * kernel * kernel), -1.0f, 1.0f);
+  std::vector<float> B = RandomValues<float>(static_cast<size_t>(output_channels), -1.0f, 1.0f);
+  std::vector<float> working_buffer(working_buffer_size);
+  std::vector<float> Y(static_cast<size_t>(batch * output_channels * output * output));
+
+  for (auto _ : state) {
+    MlasConvTranspose(&parameters, X.data(), W.data(), B.data(), working_buffer.data(), Y.data());
+  }
+  state.counters["algorithm"] = static_cast<double>(parameters.Algorithm);
+  state.SetItemsProcessed(state.iterations() * 2 * batch * input_channels * output_channels * image * image * kernel * kernel);
+}
+
+static void ConvTranspose2DArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "C", "HW", "M", "K", "S", "threads"});
+  const std::vector<std::vector<int64_t>> shapes = {
+      {1, 256, 16, 128, 2, 2},  // U-Net style upsampling
+      {1, 128, 32, 64, 2, 2},
+      {1, 256, 16, 128, 4, 2},  // DCGAN style upsampling
+      {1, 128, 32, 64, 4, 2},
+      {1, 64, 64, 64, 3, 1},
+  };
+  for (const auto& shape : shapes) {
+    for (int64_t threads : kMlasThreadCounts) {
+      b->Args({shape[0], shape[1], shape[2], shape[3], shape[4], shape[5], threads});
+    }
+  }
+}
+
+BENCHMARK(BM_MlasConvTranspose2D)->Apply(ConvTranspose2DArgs)->UseRealTime();
+
+// args: pooling kind, batch * channels, image size, kernel size, stride, threads
+static void BM_MlasPool2D(benchmark::State& state) {
+  const auto kind = static_cast<MLAS_POOLING_KIND>(state.range(0));
+  const int64_t channels = state.range(1);
+  const int64_t image = state.range(2);
+  const int64_t kernel = state.range(3);
+  const int64_t stride = state.range(4);
+  SetThreadCount(state, 5);
+
+  const int64_t output = (image - kernel) / stride + 1;
+
+  const int64_t input_shape[] = {1, channels, image, image};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t padding[] = {0, 0, 0, 0};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {1, channels, output, output};
+
+  std::vector<float> X = RandomValues<float>(static_cast<size_t>(channels * image * image), -1.0f, 1.0f);
+  std::vector<float> Y(static_cast<size_t>(channels * output * output));
+
+  for (auto _ : state) {
+    MlasPool(kind, 2, input_shape, kernel_shape, padding, stride_shape, output_shape, X.data(), Y.data());
+  }
+  state.SetItemsProcessed(state.iterations() * channels * output * output);
+}
+
+static void Pool2DArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"kind", "C", "HW", "K", "S", "threads"});
+  const std::vector<std::vector<int64_t>> shapes = {
+      {64, 112, 3, 2},
+      {256, 56, 2, 2},
+      {512, 14, 3, 1},
+      {2048, 7, 7, 1},  // global average pooling
+  };
+  for (int64_t kind : {MlasMaximumPooling, MlasAveragePoolingExcludePad}) {
+    for (const auto& shape : shapes) {
+      for (int64_t threads : kMlasThreadCounts) {
+        b->Args({kind, shape[0], shape[1], shape[2], shape[3], threads});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_MlasPool2D)->Apply(Pool2DArgs)->UseRealTime();
+
+static void BM_MlasComputeLogistic(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  std::vector<float> X = RandomValues<float>(count, -8.0f, 8.0f);
+  std::vector<float> Y(count);
+  for (auto _ : state) {
+    MlasComputeLogistic(X.data(), Y.data(), count);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_MlasComputeLogistic)->Arg(256)->Arg(4096)->Arg(65536);
+
+static void BM_MlasComputeTanh(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  std::vector<float> X = RandomValues<float>(count, -8.0f, 8.0f);
+  std::vector<float> Y(count);
+  for (auto _ : state) {
+    MlasComputeTanh(X.data(), Y.data(), count);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_MlasComputeTanh)->Arg(256)->Arg(4096)->Arg(65536);
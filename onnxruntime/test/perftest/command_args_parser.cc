@@ -34,12 +34,16 @@ namespace perftest {
       "\t-s: Show statistics result, like P75, P90.\n"
       "\t-v: Show verbose information.\n"
       "\t-x: Use parallel executor, default (without -x): sequential executor.\n"
+      "\t-c [concurrent_session_runs]: Specifies the number of client threads running the session concurrently. Default:1.\n"
+      "\t-q [target_qps]: Issues the requests at a fixed rate (open loop) instead of back to back. Default:0 (back to back).\n"
+      "\t-w [warm_up_times]: Specifies the number of iterations run before measuring. Default:1.\n"
+      "\t-j [json_file]: Writes throughput, latency percentiles and CPU usage to the file in JSON format.\n"
       "\t-h: help\n");
 }
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, char* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, "m:e:r:t:p:xvhs")) != -1) {
+  while ((ch = getopt(argc, argv, "m:e:r:t:p:c:q:w:j:xvhs")) != -1) {
     switch (ch) {
       case 'm':
         if (!strcmp(optarg, "duration")) {
@@ -91,6 +95,32 @@ namespace perftest {
       case 'x':
         test_config.run_config.enable_sequential_execution = false;
         break;
+      case 'c': {
+        // parse as signed so that a negative count is rejected instead of wrapping around
+        long concurrent_session_runs = strtol(optarg, nullptr, 10);
+        if (concurrent_session_runs <= 0) {
+          return false;
+        }
+        test_config.run_config.concurrent_session_runs = static_cast<size_t>(concurrent_session_runs);
+        break;
+      }
+      case 'q':
+        test_config.run_config.target_qps = strtod(optarg, nullptr);
+        if (test_config.run_config.target_qps <= 0) {
+          return false;
+        }
+        break;
+      case 'w': {
+        long warm_up_times = strtol(optarg, nullptr, 10);
+        if (warm_up_times < 0) {
+          return false;
+        }
+        test_config.run_config.warm_up_times = static_cast<size_t>(warm_up_times);
+        break;
+      }
+      case 'j':
+        test_config.run_config.json_result_file = optarg;
+        break;
       case '?':
       case 'h':
       default:
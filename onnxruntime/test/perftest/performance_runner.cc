@@ -7,6 +7,8 @@
 #ifdef _MSC_VER
 #include <filesystem>
 #endif
+#include <atomic>
+#include <thread>
 #include "core/graph/graph_viewer.h"  //for onnxruntime::NodeArg
 #include "utils.h"
 #include "testenv.h"
@@ -22,35 +24,112 @@ Status PerformanceRunner::Run() {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
   }
 
-  // warm up
-  RunOneIteration(true /*isWarmup*/);
+  const auto& run_config = performance_test_config_.run_config;
+  const bool run_concurrently = run_config.concurrent_session_runs > 1 || run_config.target_qps > 0;
 
-  if (!performance_test_config_.run_config.profile_file.empty())
-    session_object_->StartProfiling(performance_test_config_.run_config.profile_file);
+  // warm up. the first run also initializes the cached feeds/fetches info which is required before
+  // running concurrently.
+  size_t warm_up_times = run_concurrently ? std::max<size_t>(1, run_config.warm_up_times) : run_config.warm_up_times;
+  for (size_t i = 0; i < warm_up_times; ++i) {
+    ORT_RETURN_IF_ERROR(RunOneIteration(true /*isWarmup*/));
+  }
+
+  if (!run_config.profile_file.empty())
+    session_object_->StartProfiling(run_config.profile_file);
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(RunFixDuration());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RunRepeatedTimes());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  auto start = std::chrono::high_resolution_clock::now();
+  if (run_concurrently) {
+    ORT_RETURN_IF_ERROR(RunConcurrently());
+  } else {
+    switch (run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(RunFixDuration());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RunRepeatedTimes());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
   }
+  std::chrono::duration<double> wall_time = std::chrono::high_resolution_clock::now() - start;
+  performance_result_.wall_time_cost = wall_time.count();
+  performance_result_.concurrent_session_runs = run_config.concurrent_session_runs;
+  performance_result_.target_qps = run_config.target_qps;
   performance_result_.average_CPU_usage = p_ICPUUsage->GetUsage();
   performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
 
-  if (!performance_test_config_.run_config.profile_file.empty())
+  if (!run_config.profile_file.empty())
     session_object_->EndProfiling();
 
   std::cout << "Total time cost:" << performance_result_.total_time_cost << std::endl
             << "Total iterations:" << performance_result_.time_costs.size() << std::endl
             << "Average time cost:" << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms" << std::endl;
+  if (run_concurrently) {
+    std::cout << "Concurrent session runs:" << run_config.concurrent_session_runs << std::endl
+              << "Wall time cost:" << performance_result_.wall_time_cost << std::endl
+              << "Throughput:" << performance_result_.GetThroughput() << " inferences/sec" << std::endl;
+  }
   return Status::OK();
 }
 
+Status PerformanceRunner::RunConcurrently() {
+  using clock = std::chrono::high_resolution_clock;
+  const auto& run_config = performance_test_config_.run_config;
+  const bool fixed_times = run_config.test_mode == TestMode::KFixRepeatedTimesMode;
+  const auto start = clock::now();
+  const auto deadline = start + std::chrono::duration_cast<clock::duration>(
+                                    std::chrono::duration<double>(run_config.duration_in_seconds));
+
+  // requests are numbered, each client thread takes the next one until the test is over
+  std::atomic<size_t> next_request{0};
+  std::atomic<bool> failed{false};
+  Status error_status;
+  std::mutex error_mutex;
+
+  auto client = [&](size_t client_id) {
+    IOBinding& io_binding = *io_bindings_[client_id];
+    while (!failed) {
+      size_t request = next_request++;
+      if (fixed_times && request >= run_config.repeated_times) {
+        break;
+      }
+
+      // in open loop mode the latency is measured from the time the request should have been issued,
+      // so it includes the time waiting for a free client
+      auto issue_time = clock::now();
+      if (run_config.target_qps > 0) {
+        issue_time = start + std::chrono::duration_cast<clock::duration>(
+                                 std::chrono::duration<double>(request / run_config.target_qps));
+        std::this_thread::sleep_until(issue_time);
+      }
+
+      if (!fixed_times && issue_time >= deadline) {
+        break;
+      }
+
+      auto status = RunOneIteration(io_binding, issue_time);
+      if (!status.IsOK()) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        error_status = status;
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> clients;
+  clients.reserve(run_config.concurrent_session_runs);
+  for (size_t i = 0; i < run_config.concurrent_session_runs; ++i) {
+    clients.emplace_back(client, i);
+  }
+  for (auto& t : clients) {
+    t.join();
+  }
+
+  return error_status;
+}
+
 bool PerformanceRunner::Initialize() {
   path model_path(performance_test_config_.model_info.model_file_path);
   if (model_path.extension() != ".onnx") {
@@ -96,10 +175,13 @@ bool PerformanceRunner::Initialize() {
 
   sf.Create(session_object_, test_case->GetModelUrl(), test_case->GetTestCaseName());
 
-  // Initialize IO Binding
-  if (!session_object_->NewIOBinding(&io_binding_).IsOK()) {
-    LOGF_DEFAULT(ERROR, "Failed to init session and IO binding");
-    return false;
+  // Initialize IO Binding, one per client thread
+  io_bindings_.resize(std::max<size_t>(1, performance_test_config_.run_config.concurrent_session_runs));
+  for (auto& io_binding : io_bindings_) {
+    if (!session_object_->NewIOBinding(&io_binding).IsOK()) {
+      LOGF_DEFAULT(ERROR, "Failed to init session and IO binding");
+      return false;
+    }
   }
 
   auto provider_type = performance_test_config_.machine_config.provider_type_name;
@@ -108,7 +190,7 @@ bool PerformanceRunner::Initialize() {
   if (provider_type == onnxruntime::kMklDnnExecutionProvider) {
     provider_type = onnxruntime::kCpuExecutionProvider;
   }
-  AllocatorPtr cpu_allocator = io_binding_->GetCPUAllocator(0, provider_type);
+  AllocatorPtr cpu_allocator = io_bindings_[0]->GetCPUAllocator(0, provider_type);
   test_case->SetAllocator(cpu_allocator);
 
   if (test_case->GetDataCount() <= 0) {
@@ -118,8 +200,10 @@ bool PerformanceRunner::Initialize() {
 
   std::unordered_map<std::string, ::onnxruntime::MLValue> feeds;
   test_case->LoadTestData(0 /* id */, feeds, true);
-  for (auto feed : feeds) {
-    io_binding_->BindInput(feed.first, feed.second);
+  for (auto& io_binding : io_bindings_) {
+    for (auto feed : feeds) {
+      io_binding->BindInput(feed.first, feed.second);
+    }
   }
   auto outputs = session_object_->GetModelOutputs();
   auto status = outputs.first;
@@ -131,10 +215,12 @@ bool PerformanceRunner::Initialize() {
   }
 
   std::vector<MLValue> output_mlvalues(outputs.second->size());
-  for (size_t i_output = 0; i_output < outputs.second->size(); ++i_output) {
-    auto output = outputs.second->at(i_output);
-    if (!output) continue;
-    io_binding_->BindOutput(output->Name(), output_mlvalues[i_output]);
+  for (auto& io_binding : io_bindings_) {
+    for (size_t i_output = 0; i_output < outputs.second->size(); ++i_output) {
+      auto output = outputs.second->at(i_output);
+      if (!output) continue;
+      io_binding->BindOutput(output->Name(), output_mlvalues[i_output]);
+    }
   }
 
   return true;
@@ -7,6 +7,9 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
 
 // onnxruntime dependencies
 #include <core/common/common.h>
@@ -27,9 +30,23 @@ struct PerformanceResult {
   size_t peak_workingset_size{0};
   short average_CPU_usage{0};
   double total_time_cost{0};
+  // wall clock time of the measured run, differs from total_time_cost when requests run concurrently
+  double wall_time_cost{0};
+  size_t concurrent_session_runs{1};
+  double target_qps{0};
   std::vector<double> time_costs;
   std::string model_name;
 
+  double GetThroughput() const {
+    return wall_time_cost > 0 ? time_costs.size() / wall_time_cost : 0;
+  }
+
+  // sorted_time must be sorted and non empty
+  static double GetPercentile(const std::vector<double>& sorted_time, double percentile) {
+    size_t n = static_cast<size_t>(sorted_time.size() * percentile);
+    return sorted_time[std::min(n, sorted_time.size() - 1)];
+  }
+
   void DumpToFile(const std::string& path, bool f_include_statistics = false) const {
     std::ofstream outfile;
     outfile.open(path, std::ofstream::out | std::ofstream::app);
@@ -44,26 +61,69 @@ struct PerformanceResult {
 
     if (time_costs.size() > 0 && f_include_statistics) {
       std::vector<double> sorted_time = time_costs;
-
-      size_t total = sorted_time.size();
-      size_t n50 = static_cast<size_t>(total * 0.5);
-      size_t n90 = static_cast<size_t>(total * 0.9);
-      size_t n95 = static_cast<size_t>(total * 0.95);
-      size_t n99 = static_cast<size_t>(total * 0.99);
-      size_t n999 = static_cast<size_t>(total * 0.999);
-
       std::sort(sorted_time.begin(), sorted_time.end());
 
       outfile << std::endl;
-      outfile << "P50 Latency is " << sorted_time[n50] << "sec" << std::endl;
-      outfile << "P90 Latency is " << sorted_time[n90] << "sec" << std::endl;
-      outfile << "P95 Latency is " << sorted_time[n95] << "sec" << std::endl;
-      outfile << "P99 Latency is " << sorted_time[n99] << "sec" << std::endl;
-      outfile << "P999 Latency is " << sorted_time[n999] << "sec" << std::endl;
+      outfile << "P50 Latency is " << GetPercentile(sorted_time, 0.5) << "sec" << std::endl;
+      outfile << "P90 Latency is " << GetPercentile(sorted_time, 0.9) << "sec" << std::endl;
+      outfile << "P95 Latency is " << GetPercentile(sorted_time, 0.95) << "sec" << std::endl;
+      outfile << "P99 Latency is " << GetPercentile(sorted_time, 0.99) << "sec" << std::endl;
+      outfile << "P999 Latency is " << GetPercentile(sorted_time, 0.999) << "sec" << std::endl;
+      outfile << "Throughput is " << GetThroughput() << " inferences/sec" << std::endl;
     }
 
     outfile.close();
   }
+
+  // Returns s as the content of a JSON string: quotes, backslashes and control chars are escaped.
+  static std::string JsonEscape(const std::string& s) {
+    std::string escaped;
+    escaped.reserve(s.size());
+    for (char c : s) {
+      if (c == '"' || c == '\\') {
+        escaped += '\\';
+        escaped += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        char buffer[8];
+        snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+        escaped += buffer;
+      } else {
+        escaped += c;
+      }
+    }
+    return escaped;
+  }
+
+  // Summary of the run in a machine readable form, for regression tracking.
+  void DumpToJsonFile(const std::string& path) const {
+    std::ofstream outfile(path, std::ofstream::out | std::ofstream::trunc);
+    if (!outfile.good()) {
+      LOGF_DEFAULT(ERROR, "failed to open json result file");
+      return;
+    }
+
+    std::vector<double> sorted_time = time_costs;
+    std::sort(sorted_time.begin(), sorted_time.end());
+    auto percentile_ms = [&sorted_time](double percentile) {
+      return sorted_time.empty() ? 0 : GetPercentile(sorted_time, percentile) * 1000;
+    };
+
+    outfile << "{" << std::endl
+            << "  \"model_name\": \"" << JsonEscape(model_name) << "\"," << std::endl
+            << "  \"concurrent_session_runs\": " << concurrent_session_runs << "," << std::endl
+            << "  \"target_qps\": " << target_qps << "," << std::endl
+            << "  \"iterations\": " << time_costs.size() << "," << std::endl
+            << "  \"wall_time_sec\": " << wall_time_cost << "," << std::endl
+            << "  \"throughput_qps\": " << GetThroughput() << "," << std::endl
+            << "  \"latency_avg_ms\": " << (time_costs.empty() ? 0 : total_time_cost / time_costs.size() * 1000) << "," << std::endl
+            << "  \"latency_p50_ms\": " << percentile_ms(0.5) << "," << std::endl
+            << "  \"latency_p90_ms\": " << percentile_ms(0.9) << "," << std::endl
+            << "  \"latency_p99_ms\": " << percentile_ms(0.99) << "," << std::endl
+            << "  \"latency_p999_ms\": " << percentile_ms(0.999) << "," << std::endl
+            << "  \"average_cpu_usage\": " << average_CPU_usage << "," << std::endl
+            << "  \"peak_workingset_size\": " << peak_workingset_size << std::endl
+            << "}" << std::endl;
+  }
 };
 
 class PerformanceRunner {
@@ -77,21 +137,26 @@ class PerformanceRunner {
   inline void SerializeResult() const {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
+    if (!performance_test_config_.run_config.json_result_file.empty()) {
+      performance_result_.DumpToJsonFile(performance_test_config_.run_config.json_result_file);
+    }
   }
 
  private:
   bool Initialize();
 
-  inline Status RunOneIteration(bool isWarmup = false) {
-    auto start = std::chrono::high_resolution_clock::now();
+  inline Status RunOneIteration(IOBinding& io_binding,
+                                std::chrono::high_resolution_clock::time_point start,
+                                bool isWarmup = false) {
     OrtRunOptions run_options;
     run_options.cache_feeds_fetches_info = true;
 
-    ORT_RETURN_IF_ERROR(session_object_->Run(run_options, *io_binding_));
+    ORT_RETURN_IF_ERROR(session_object_->Run(run_options, io_binding));
     auto end = std::chrono::high_resolution_clock::now();
 
     if (!isWarmup) {
       std::chrono::duration<double> duration_seconds = end - start;
+      std::lock_guard<std::mutex> lock(result_mutex_);
       performance_result_.time_costs.emplace_back(duration_seconds.count());
       performance_result_.total_time_cost += duration_seconds.count();
       if (performance_test_config_.run_config.f_verbose) {
@@ -102,6 +167,10 @@ class PerformanceRunner {
     return Status::OK();
   }
 
+  inline Status RunOneIteration(bool isWarmup = false) {
+    return RunOneIteration(*io_bindings_[0], std::chrono::high_resolution_clock::now(), isWarmup);
+  }
+
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
       ORT_RETURN_IF_ERROR(RunOneIteration());
@@ -116,12 +185,17 @@ class PerformanceRunner {
     return Status::OK();
   }
 
+  // Runs the requests from concurrent_session_runs threads, and at target_qps if set.
+  Status RunConcurrently();
+
  private:
   PerformanceResult performance_result_;
   PerformanceTestConfig performance_test_config_;
+  std::mutex result_mutex_;
 
   std::shared_ptr<::onnxruntime::InferenceSession> session_object_;
-  std::unique_ptr<IOBinding> io_binding_;
+  // one binding per client thread, they share the inputs
+  std::vector<std::unique_ptr<IOBinding>> io_bindings_;
 };
 }  // namespace perftest
 }  // namespace onnxruntime
@@ -41,6 +41,13 @@ struct RunConfig {
   bool f_dump_statistics{false};
   bool f_verbose{false};
   bool enable_sequential_execution{true};
+  // number of client threads running the session concurrently
+  size_t concurrent_session_runs{1};
+  // if non zero, requests are issued at this rate whatever the latency is (open loop)
+  double target_qps{0};
+  size_t warm_up_times{1};
+  // if not empty, a summary of the run is written to this file in JSON format
+  std::string json_result_file;
 };
 
 struct PerformanceTestConfig {
@@ -644,6 +644,55 @@ TEST(Scan8, MixedSequenceLens) {
              iteration_count_out, output_0, output_1, output_2, output_3);
 }
 
+// batch entries after the first are executed concurrently so check a batch large enough to do that
+TEST(Scan8, MixedSequenceLensLargerBatch) {
+  const int64_t batch_size = 4;
+  const int64_t max_sequence_len = 2;
+  const int64_t input_size = 2;
+
+  std::vector<int64_t> sequence_lens{2, 1, 2, 1};
+
+  std::vector<float> iteration_count_in{0.f, 10.f, 20.f, 30.f};
+
+  // batch_size, max_sequence_len, input_size
+  std::vector<float> input_0{1.f, 2.f,
+                             3.f, 4.f,
+
+                             11.f, 12.f,
+                             99.f, 99.f,  // <- this should be ignored
+
+                             -1.f, -2.f,
+                             -3.f, -4.f,
+
+                             21.f, 22.f,
+                             99.f, 99.f};  // <- this should be ignored
+
+  std::vector<float> input_1{5.f, 6.f,
+                             7.f, 8.f,
+
+                             13.f, 14.f,
+                             99.f, 99.f,  // <- this should be ignored
+
+                             -5.f, -6.f,
+                             -7.f, -8.f,
+
+                             23.f, 24.f,
+                             99.f, 99.f};  // <- this should be ignored
+
+  std::vector<float> iteration_count_out{2.f, 11.f, 22.f, 31.f};
+
+  // batch_size, max_sequence_len, 1
+  std::vector<float> output_0{1.f, 3.f, 11.f, 0.f, -1.f, -3.f, 21.f, 0.f};
+  std::vector<float> output_1{2.f, 4.f, 12.f, 0.f, -2.f, -4.f, 22.f, 0.f};
+  std::vector<float> output_2{5.f, 7.f, 13.f, 0.f, -5.f, -7.f, 23.f, 0.f};
+  std::vector<float> output_3{6.f, 8.f, 14.f, 0.f, -6.f, -8.f, 24.f, 0.f};
+
+  RunTest_v8("MixedSequenceLensLargerBatch", batch_size, max_sequence_len, input_size,
+             nullptr, &sequence_lens,
+             iteration_count_in, input_0, input_1,
+             iteration_count_out, output_0, output_1, output_2, output_3);
+}
+
 TEST(Scan8, MixedSequenceLensReverse) {
   const int64_t batch_size = 2;
   const int64_t max_sequence_len = 2;
@@ -1145,6 +1194,68 @@ void UnknownDimInSubgraphOutput(bool is_v8) {
 
 TEST_8_AND_9(UnknownDimInSubgraphOutput);
 
+// create a subgraph whose scan output has a different shape in each iteration. the slices of the Scan output are
+// pre-allocated using the shape from the first iteration, so the second iteration must fail rather than
+// write its output somewhere else.
+void SubgraphOutputShapeChanges(bool is_v8) {
+  Model model("ScanBody");
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("param");
+  TypeProto int_tensor;
+  int_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto& state_in_1 = graph.GetOrCreateNodeArg("state_in_1", &float_tensor);
+  auto& scan_in_1 = graph.GetOrCreateNodeArg("scan_in_1", &int_tensor);
+
+  auto& state_out_1 = graph.GetOrCreateNodeArg("state_out_1", &float_tensor);
+  auto& scan_out_1 = graph.GetOrCreateNodeArg("scan_out_1", &float_tensor);
+
+  graph.AddNode("node1", "Identity", "Copy state_in_1 to state_out_1", {&state_in_1}, {&state_out_1});
+  graph.AddNode("node2", "Expand", "Expand state_in_1 to the shape in scan_in_1", {&state_in_1, &scan_in_1},
+                {&scan_out_1});
+
+  graph.SetInputOrder({&state_in_1, &scan_in_1});
+  graph.SetOutputOrder({&state_out_1, &scan_out_1});
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  auto& scan_body = graph.ToGraphProto();
+
+  ScanOpTester test{is_v8 ? 8 : 9};
+
+  int64_t batch_size = 1, sequence_len = 2;
+  std::vector<int64_t> seq_shape{sequence_len, 1};
+  std::vector<int64_t> state_shape{1};
+  // the shape of the first iteration output
+  std::vector<int64_t> output_shape{sequence_len, 2};
+
+  if (is_v8) {
+    seq_shape.insert(seq_shape.begin(), batch_size);
+    state_shape.insert(state_shape.begin(), batch_size);
+    output_shape.insert(output_shape.begin(), batch_size);
+
+    test.AddMissingOptionalInput<int64_t>();
+  }
+
+  test.AddAttribute("body", scan_body);
+  test.AddAttribute<int64_t>("num_scan_inputs", 1);
+
+  test.AddInput<float>("initial_state_1", state_shape, {1.0});
+  test.AddInput<int64_t>("scan_input_1", seq_shape, {2, 3});
+
+  test.AddOutput<float>("final_state_1", state_shape, {1.0});
+  test.AddOutput<float>("scan_output_1", output_shape, {1.0, 1.0, 1.0, 1.0});
+
+  test.Run(OpTester::ExpectResult::kExpectFailure, "MLValue shape verification failed");
+}
+
+TEST_8_AND_9(SubgraphOutputShapeChanges);
+
 #ifdef USE_CUDA
 TEST(Scan, MixedExecutionProviders) {
   RunOptions options{};
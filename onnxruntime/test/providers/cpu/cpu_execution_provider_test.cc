@@ -4,6 +4,8 @@
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "gtest/gtest.h"
 
+#include <atomic>
+
 namespace onnxruntime {
 namespace test {
 TEST(CPUExecutionProviderTest, MetadataTest) {
@@ -12,5 +14,39 @@ TEST(CPUExecutionProviderTest, MetadataTest) {
   EXPECT_TRUE(provider != nullptr);
   ASSERT_STREQ(provider->GetAllocator(0, OrtMemTypeDefault)->Info().name, CPU);
 }
+
+TEST(CPUExecutionProviderTest, KernelThreadPoolSize) {
+  CPUExecutionProviderInfo info;
+  info.intra_op_num_threads = 3;
+  auto provider = std::make_unique<CPUExecutionProvider>(info);
+  EXPECT_EQ(provider->GetKernelThreadPool().NumThreads(), 3);
+
+  CPUExecutionProviderInfo default_info;
+  auto default_provider = std::make_unique<CPUExecutionProvider>(default_info);
+  EXPECT_GE(default_provider->GetKernelThreadPool().NumThreads(), 1);
+}
+
+// a ParallelFor inside a range of another one runs on the thread of that range
+TEST(CPUExecutionProviderTest, KernelThreadPoolNestedParallelFor) {
+  KernelThreadPool thread_pool(4);
+  const int64_t total = 8;
+  std::atomic<int64_t> outer_ranges{0};
+  std::atomic<int64_t> inner_ranges{0};
+  std::atomic<int64_t> items{0};
+
+  thread_pool.ParallelFor(total, KernelThreadPool::kMinCostPerThread, [&](int64_t begin, int64_t end) {
+    ++outer_ranges;
+    for (int64_t i = begin; i < end; ++i) {
+      thread_pool.ParallelFor(total, KernelThreadPool::kMinCostPerThread, [&](int64_t inner_begin, int64_t inner_end) {
+        ++inner_ranges;
+        items += inner_end - inner_begin;
+      });
+    }
+  });
+
+  EXPECT_EQ(outer_ranges, 4);
+  EXPECT_EQ(inner_ranges, total);
+  EXPECT_EQ(items, total * total);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -143,5 +144,41 @@ TEST(TopKOperator, InvalidK) {
           "Invalid value for attribute k");
 }
 
+TEST(TopKOperator, Top2DoubleInput) {
+  OpTester test("TopK");
+  test.AddAttribute("k", int64_t{2});
+  test.AddAttribute("axis", int64_t{0});
+  test.AddInput<double>("X", {4, 2}, {0.1, 0.3, 0.4, 0.2, 0.4, 0.3, 0.2, 0.5});
+  test.AddOutput<double>("Values", {2, 2}, {0.4, 0.5, 0.4, 0.3});
+  test.AddOutput<int64_t>("Indices", {2, 2}, {1, 3, 2, 0});
+  test.Run();
+}
+
+TEST(TopKOperator, Top100LongRows) {
+  // rows long enough to be split across threads, with many equal values
+  const int64_t rows = 2, cols = 100000, k = 100;
+  std::vector<float> input_vals(rows * cols);
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    input_vals[i] = static_cast<float>((i * 7919) % 1000);
+  }
+
+  std::vector<float> expected_vals;
+  std::vector<int64_t> expected_indices;
+  for (int64_t i = 0; i < rows; ++i) {
+    std::vector<int64_t> order(cols);
+    for (int64_t j = 0; j < cols; ++j) {
+      order[j] = j;
+    }
+    const float* row = input_vals.data() + i * cols;
+    std::stable_sort(order.begin(), order.end(), [row](int64_t lhs, int64_t rhs) { return row[lhs] > row[rhs]; });
+    for (int64_t l = 0; l < k; ++l) {
+      expected_vals.push_back(row[order[l]]);
+      expected_indices.push_back(order[l]);
+    }
+  }
+
+  RunTest(k, input_vals, {rows, cols}, expected_vals, expected_indices, {rows, k});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
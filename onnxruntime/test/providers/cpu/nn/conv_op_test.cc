@@ -542,5 +542,57 @@ TEST(ConvTest, Conv2D_group) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+// 3x3 convolutions with enough channels use the MLAS Winograd algorithm, which
+// caches a transformed copy of the filter when the filter is an initializer.
+TEST(ConvTest, Conv2D_Winograd) {
+  const int64_t C = 16, M = 16, H = 6, W_ = 7;
+
+  vector<float> X(C * H * W_);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+  vector<float> W(M * C * 9);
+  for (size_t i = 0; i < W.size(); i++) {
+    W[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.5f;
+  }
+  vector<float> B(M);
+  for (size_t i = 0; i < B.size(); i++) {
+    B[i] = static_cast<float>(i) * 0.25f;
+  }
+
+  // Pads of 1 keep the spatial size unchanged.
+  vector<float> expected(M * H * W_);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t oh = 0; oh < H; oh++) {
+      for (int64_t ow = 0; ow < W_; ow++) {
+        float sum = B[m];
+        for (int64_t c = 0; c < C; c++) {
+          for (int64_t kh = 0; kh < 3; kh++) {
+            for (int64_t kw = 0; kw < 3; kw++) {
+              int64_t ih = oh + kh - 1;
+              int64_t iw = ow + kw - 1;
+              if (ih >= 0 && ih < H && iw >= 0 && iw < W_) {
+                sum += X[(c * H + ih) * W_ + iw] * W[((m * C + c) * 3 + kh) * 3 + kw];
+              }
+            }
+          }
+        }
+        expected[(m * H + oh) * W_ + ow] = sum;
+      }
+    }
+  }
+
+  for (bool filter_is_initializer : {false, true}) {
+    OpTester test("Conv");
+    test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+    test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+    test.AddInput<float>("X", {1, C, H, W_}, X);
+    test.AddInput<float>("W", {M, C, 3, 3}, W, filter_is_initializer);
+    test.AddInput<float>("B", {M}, B);
+    test.AddOutput<float>("Y", {1, M, H, W_}, expected);
+    test.Run();
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
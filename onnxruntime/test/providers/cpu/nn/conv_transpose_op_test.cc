@@ -327,6 +327,30 @@ TEST(ConvTransposeTest, ConvTranspose_onnx2) {
   TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+TEST(ConvTransposeTest, ConvTranspose_Stride_Equals_Kernel) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{2, 2},        // kernel_shape
+      {},                           // output_padding
+      {},                           // output_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{2, 2},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      1                             // group
+  };
+  vector<float> X = {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f};
+  vector<int64_t> X_shape = {1, 2, 2, 2};
+  vector<float> W = {1.f, -1.f, 2.f, 0.5f, 0.f, 1.f, -2.f, 3.f};
+  vector<int64_t> W_shape = {2, 1, 2, 2};
+  vector<float> B = {1.f};
+  vector<int64_t> B_shape = {1};
+  vector<int64_t> Y_shape = {1, 1, 4, 4};
+  auto expected_vals = {2.f, 5.f, 3.f, 5.f,
+                        -7.f, 16.5f, -7.f, 20.f,
+                        4.f, 5.f, 5.f, 5.f,
+                        -7.f, 23.5f, -7.f, 27.f};
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 TEST(ConvTransposeTest, ConvTranspose_onnx_group) {
   ConvTransposeOpAttributes attrs = {
       vector<int64_t>{1, 1},        // kernel_shape
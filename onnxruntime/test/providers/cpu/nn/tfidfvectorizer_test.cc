@@ -555,5 +555,31 @@ TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(TfIdfVectorizerTest, String_TF_BatchUniBiAndTrigrams_Skip1_Utf8) {
+  OpTester test("TfIdfVectorizer", opset_ver, domain);
+  // s=1, Min=1, Max=3, weights empty, multi-byte utf8 strings
+  // the n-grams must not span the rows of the batch
+  InitTestAttr(test, "TF", 1, 3, 1,
+               {0, 2, 6},
+               {0, 1, 2, 3, 4},  //5 output indexes
+               {},
+               {},
+               {u8"日本", u8"ß",                        //1-grams
+                u8"日本", u8"語", u8"語", u8"日本",     //bi-grams
+                u8"日本", u8"語", u8"ß"});              //tri-grams
+
+  std::vector<int64_t> dims{2, 4};
+  std::vector<std::string> input{u8"日本", u8"語", u8"ß", u8"日本",
+                                 u8"語", u8"x", u8"日本", u8"ß"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> out_dims{2, 5};
+  std::vector<float> output = {2, 1, 1, 1, 1,
+                               1, 1, 0, 1, 0};
+  test.AddOutput<float>("Y", out_dims, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -696,6 +696,31 @@ TEST(ReductionOpTest, ReduceSum_axes02) {
   test.Run();
 }
 
+// reduce a middle axis with a kept inner axis large enough to be split into multiple chunks
+TEST(ReductionOpTest, ReduceSum_middle_axis_large_inner) {
+  const int64_t outer = 2, reduced = 3, inner = 300;
+  std::vector<float> input(outer * reduced * inner);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i % 7);
+  }
+
+  std::vector<float> expected(outer * inner, 0.0f);
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t r = 0; r < reduced; ++r) {
+      for (int64_t i = 0; i < inner; ++i) {
+        expected[o * inner + i] += input[(o * reduced + r) * inner + i];
+      }
+    }
+  }
+
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {outer, reduced, inner}, input);
+  test.AddOutput<float>("reduced", {outer, inner}, expected);
+  test.Run();
+}
+
 TEST(ReductionOpTest, ReduceSum_int32) {
   OpTester test("ReduceSum");
   test.AddAttribute("axes", std::vector<int64_t>{0, 2});
@@ -1003,6 +1028,23 @@ TEST(ReductionOpTest, ArgMax_do_not_keepdims_2) {
   test.Run();
 }
 
+TEST(ReductionOpTest, ArgMax_middle_axis) {
+  OpTester test("ArgMax");
+  test.AddAttribute("axis", (int64_t)1);
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {2, 3, 2},
+                       {1.0f, 6.0f,
+                        5.0f, 2.0f,
+                        3.0f, 6.0f,
+
+                        9.0f, 1.0f,
+                        8.0f, 4.0f,
+                        9.0f, 7.0f});
+  // the first index is used for ties
+  test.AddOutput<int64_t>("reduced", {2, 2}, {1, 0, 0, 2});
+  test.Run();
+}
+
 TEST(ReductionOpTest, ArgMax_int32) {
   OpTester test("ArgMax");
   test.AddAttribute("axis", (int64_t)1);
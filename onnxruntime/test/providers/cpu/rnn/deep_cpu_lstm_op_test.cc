@@ -45,7 +45,8 @@ static void RunLstmTest(const std::vector<float>& X_data,
                         // copy the following vectors as we may modify them
                         std::vector<string> activations = {},
                         std::vector<float> activation_alphas = {},
-                        std::vector<float> activation_betas = {}) {
+                        std::vector<float> activation_betas = {},
+                        bool weights_are_initializers = false) {
   OpTester test("LSTM");
 
   int num_directions = (direction == "bidirectional") ? 2 : 1;
@@ -75,8 +76,8 @@ static void RunLstmTest(const std::vector<float>& X_data,
   std::vector<int64_t> R_dims = {num_directions, 4 * hidden_size, hidden_size};
 
   test.AddInput<float>("X", X_dims, X_data);
-  test.AddInput<float>("W", W_dims, W_data);
-  test.AddInput<float>("R", R_dims, R_data);
+  test.AddInput<float>("W", W_dims, W_data, weights_are_initializers);
+  test.AddInput<float>("R", R_dims, R_data, weights_are_initializers);
 
   if (B_data) {
     std::vector<int64_t> B_dims = {num_directions, 8 * hidden_size};
@@ -175,6 +176,12 @@ void SimpleWeightsNoBiasTwoRows(std::string direction,
     RunLstmTest(X_data, W_data, R_data, Y_data, Y_h_data, Y_c_data,
                 input_size, batch_size, hidden_size, seq_length,
                 nullptr, nullptr, nullptr, nullptr, seq_lengths, direction, 999.f, /* output_sequence*/ false);
+
+  // constant weights are packed when the kernel is created
+  RunLstmTest(X_data, W_data, R_data, Y_data, Y_h_data, Y_c_data,
+              input_size, batch_size, hidden_size, seq_length,
+              nullptr, nullptr, nullptr, nullptr, seq_lengths, direction, 9999.f, true, false, {}, {}, {},
+              /* weights_are_initializers */ true);
 }
 
 TEST(LSTMTest, ForwardSimpleWeightsNoBiasTwoRows) {
@@ -392,6 +399,11 @@ static void LargeBatchWithClip(const std::vector<float>& Y_h_data, float clip =
   RunLstmTest(X_data, W_data, R_data, {}, Y_h_data, {},
               input_size, batch_size, hidden_size, seq_length,
               nullptr, nullptr, nullptr, nullptr, nullptr, direction, clip);
+
+  RunLstmTest(X_data, W_data, R_data, {}, Y_h_data, {},
+              input_size, batch_size, hidden_size, seq_length,
+              nullptr, nullptr, nullptr, nullptr, nullptr, direction, clip, true, false, {}, {}, {},
+              /* weights_are_initializers */ true);
 }
 
 TEST(LSTMTest, LargeBatchNoClipping) {
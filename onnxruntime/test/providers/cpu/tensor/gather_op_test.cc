@@ -302,5 +302,41 @@ TEST(GatherOpTest, Gather_perf) {
   test.AddOutput<int32_t>("output", {800, 1, 100}, output);
   test.Run();
 }
+
+TEST(GatherOpTest, Gather_axis0_large_table) {
+  // enough rows to be gathered by several threads
+  const int64_t num_rows = 10000, row_size = 64, num_indices = 4096;
+  std::vector<float> data(num_rows * row_size);
+  for (int64_t i = 0; i < num_rows * row_size; ++i) {
+    data[i] = static_cast<float>(i);
+  }
+  std::vector<int64_t> indices(num_indices);
+  std::vector<float> output(num_indices * row_size);
+  for (int64_t i = 0; i < num_indices; ++i) {
+    indices[i] = (i * 7919) % num_rows;
+    std::copy_n(data.begin() + indices[i] * row_size, row_size, output.begin() + i * row_size);
+  }
+
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<float>("data", {num_rows, row_size}, data);
+  test.AddInput<int64_t>("indices", {num_indices}, indices);
+  test.AddOutput<float>("output", {num_indices, row_size}, output);
+  test.Run();
+}
+
+TEST(GatherOpTest, Gather_axis0_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"A", "B",
+                              "C", "D",
+                              "E", "F"});
+  test.AddInput<int32_t>("indices", {2}, {2, 0});
+  test.AddOutput<std::string>("output", {2, 2},
+                              {"E", "F",
+                               "A", "B"});
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -105,5 +107,64 @@ TEST(TransposeOpTest, ThreeDim) {
   TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals);
 }
 
+// Test a NCHW -> NHWC transpose, which is a batched 2D transpose once H and W are merged
+TEST(TransposeOpTest, NCHWToNHWC) {
+  std::vector<int64_t> input_shape({2, 3, 2, 2});
+  std::vector<float> input_vals(24);
+  std::iota(input_vals.begin(), input_vals.end(), 0.0f);
+
+  std::vector<int64_t> perm = {0, 2, 3, 1};
+  std::vector<int64_t> expected_shape({2, 2, 2, 3});
+  auto expected_vals = {
+      0.0f, 4.0f, 8.0f,
+      1.0f, 5.0f, 9.0f,
+      2.0f, 6.0f, 10.0f,
+      3.0f, 7.0f, 11.0f,
+
+      12.0f, 16.0f, 20.0f,
+      13.0f, 17.0f, 21.0f,
+      14.0f, 18.0f, 22.0f,
+      15.0f, 19.0f, 23.0f};
+
+  TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals);
+}
+
+// Test swapping the middle two axes, as done for attention heads, which moves blocks of the innermost axis
+TEST(TransposeOpTest, SwapMiddleAxes) {
+  std::vector<int64_t> input_shape({1, 2, 3, 2});
+  std::vector<float> input_vals(12);
+  std::iota(input_vals.begin(), input_vals.end(), 0.0f);
+
+  std::vector<int64_t> perm = {0, 2, 1, 3};
+  std::vector<int64_t> expected_shape({1, 3, 2, 2});
+  auto expected_vals = {
+      0.0f, 1.0f, 6.0f, 7.0f,
+      2.0f, 3.0f, 8.0f, 9.0f,
+      4.0f, 5.0f, 10.0f, 11.0f};
+
+  TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals);
+}
+
+// Test a 2D transpose with dimensions that aren't a multiple of the tile sizes
+TEST(TransposeOpTest, TwoDimLarge) {
+  const int64_t rows = 37;
+  const int64_t cols = 19;
+
+  std::vector<float> input_vals(rows * cols);
+  std::iota(input_vals.begin(), input_vals.end(), 0.0f);
+
+  std::vector<float> expected_vals(rows * cols);
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t c = 0; c < cols; ++c) {
+      expected_vals[c * rows + r] = input_vals[r * cols + c];
+    }
+  }
+
+  OpTester test("Transpose");
+  test.AddInput<float>("X", {rows, cols}, input_vals);
+  test.AddOutput<float>("Y", {cols, rows}, expected_vals);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
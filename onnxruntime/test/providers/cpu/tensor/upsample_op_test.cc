@@ -381,5 +381,85 @@ TEST(UpsampleOpTest, UpsampleOpNearest2XTest_opset9) {
   test.AddOutput<int32_t>("Y", {N, C, (int64_t)(H * scales[2]), (int64_t)(W * scales[3])}, Y);
   test.Run();
 }
+
+TEST(UpsampleOpTest, UpsampleOpBilinear2XTest) {
+  OpTester test("Upsample");
+
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("scales", scales);
+
+  const int64_t N = 1, C = 1, H = 2, W = 5;
+  std::vector<float> X = {1.0f, 3.0f, 5.0f, 7.0f, 9.0f,
+                          3.0f, 5.0f, 7.0f, 9.0f, 11.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+
+  std::vector<float> Y = {
+      1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 9.0f,
+      2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 10.0f,
+      3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 11.0f,
+      3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 11.0f};
+
+  test.AddOutput<float>("Y", {N, C, (int64_t)(H * scales[2]), (int64_t)(W * scales[3])}, Y);
+  test.Run();
+}
+
+TEST(UpsampleOpTest, UpsampleOpNearest2XTest_ManyPlanes) {
+  OpTester test("Upsample");
+
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+  test.AddAttribute("mode", "nearest");
+  test.AddAttribute("scales", scales);
+
+  // large enough for the planes to be split across threads
+  const int64_t N = 2, C = 8, H = 33, W = 33;
+  std::vector<float> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(i);
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+
+  std::vector<float> Y;
+  for (int64_t plane = 0; plane < N * C; ++plane) {
+    for (int64_t y = 0; y < 2 * H; ++y) {
+      for (int64_t x = 0; x < 2 * W; ++x) {
+        Y.push_back(X[(plane * H + y / 2) * W + x / 2]);
+      }
+    }
+  }
+
+  test.AddOutput<float>("Y", {N, C, 2 * H, 2 * W}, Y);
+  test.Run();
+}
+
+TEST(UpsampleOpTest, UpsampleOpNearest3XTest_ManyPlanes) {
+  OpTester test("Upsample");
+
+  std::vector<float> scales{1.0f, 1.0f, 3.0f, 3.0f};
+  test.AddAttribute("mode", "nearest");
+  test.AddAttribute("scales", scales);
+
+  const int64_t N = 1, C = 16, H = 20, W = 20;
+  std::vector<int32_t> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<int32_t>(i);
+  }
+
+  test.AddInput<int32_t>("X", {N, C, H, W}, X);
+
+  std::vector<int32_t> Y;
+  for (int64_t plane = 0; plane < N * C; ++plane) {
+    for (int64_t y = 0; y < 3 * H; ++y) {
+      for (int64_t x = 0; x < 3 * W; ++x) {
+        Y.push_back(X[(plane * H + y / 3) * W + x / 3]);
+      }
+    }
+  }
+
+  test.AddOutput<int32_t>("Y", {N, C, 3 * H, 3 * W}, Y);
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
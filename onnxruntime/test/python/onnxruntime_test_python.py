@@ -72,6 +72,50 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[5.0], [11.0], [17.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelNonContiguousInput(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        x = np.array([[1.0, 3.0, 5.0], [2.0, 4.0, 6.0]], dtype=np.float32).T
+        self.assertFalse(x.flags['C_CONTIGUOUS'])
+        res = sess.run(["Y"], {"X": x})
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+    def testRunModelOutputOutlivesSession(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res = sess.run(["Y"], {"X": x})
+        res2 = sess.run(["Y"], {"X": x + 1})
+        del sess
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+        np.testing.assert_allclose((x + 1) * (x + 1), res2[0], rtol=1e-05, atol=1e-08)
+
+    def testRunModelAsync(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        futures = [sess.run_async(["Y"], {"X": x * (i + 1)}) for i in range(4)]
+        for i, future in enumerate(futures):
+            res = future.result()
+            self.assertTrue(future.done())
+            np.testing.assert_allclose((x * (i + 1)) ** 2, res[0], rtol=1e-05, atol=1e-08)
+
+    def testRunModelMultipleThreads(self):
+        import threading
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        results = [None] * 4
+
+        def run(i):
+            results[i] = sess.run(["Y"], {"X": x * (i + 1)})[0]
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(len(results))]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for i, res in enumerate(results):
+            np.testing.assert_allclose((x * (i + 1)) ** 2, res, rtol=1e-05, atol=1e-08)
+
     def testRunDevice(self):
         device = onnxrt.get_device()
         self.assertTrue('CPU' in device or 'GPU' in device)
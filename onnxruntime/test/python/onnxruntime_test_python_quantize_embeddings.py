@@ -0,0 +1,71 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+# -*- coding: UTF-8 -*-
+import unittest
+import numpy as np
+import onnxruntime as onnxrt
+from onnx import helper, numpy_helper, TensorProto
+from onnxruntime.tools import quantize_embeddings
+
+
+class TestQuantizeEmbeddings(unittest.TestCase):
+
+    def create_model(self, table):
+        # Y = Gather(table, indices)
+        node = helper.make_node('Gather', ['table', 'indices'], ['Y'])
+        graph = helper.make_graph(
+            [node], 'embedding',
+            [helper.make_tensor_value_info('indices', TensorProto.INT64, [None])],
+            [helper.make_tensor_value_info('Y', TensorProto.FLOAT, [None, table.shape[1]])],
+            [numpy_helper.from_array(table, 'table')])
+        model = helper.make_model(graph, opset_imports=[helper.make_opsetid('', 8)])
+        model.ir_version = 4
+        return model
+
+    def run_model(self, model, indices):
+        sess = onnxrt.InferenceSession(model.SerializeToString())
+        return sess.run(['Y'], {'indices': indices})[0]
+
+    def check_round_trip(self, table_format, atol_per_row):
+        np.random.seed(0)
+        table = np.random.uniform(-2.0, 3.0, (64, 32)).astype(np.float32)
+        table[5, :] = 0.0
+        table[7, :] = np.abs(table[7, :])
+        indices = np.array([3, 5, 7, 63, 0, 3, 12, 40, 41, 42, 43], dtype=np.int64)
+
+        model = self.create_model(table)
+        expected = self.run_model(model, indices)
+        np.testing.assert_allclose(expected, table[indices])
+
+        self.assertEqual(quantize_embeddings.convert_model(model, table_format, 1024), 1)
+        self.assertEqual([node.op_type for node in model.graph.node], ['GatherDequantize'])
+        self.assertEqual(model.graph.node[0].domain, 'com.microsoft')
+        self.assertNotIn('table', [init.name for init in model.graph.initializer])
+
+        actual = self.run_model(model, indices)
+        self.assertEqual(actual.shape, expected.shape)
+        # a row is within half a quantization step of the float values, and zeros are exact
+        atol = atol_per_row(table)[indices][:, None]
+        self.assertTrue(np.all(np.abs(actual - expected) <= atol + 1e-5))
+        np.testing.assert_array_equal(actual[1], np.zeros(32, dtype=np.float32))
+
+    def testRoundTripUInt8(self):
+        self.check_round_trip('uint8', lambda table: (np.maximum(table.max(axis=1), 0.0) -
+                                                      np.minimum(table.min(axis=1), 0.0)) / 255.0 / 2)
+
+    def testRoundTripInt8(self):
+        self.check_round_trip('int8', lambda table: np.abs(table).max(axis=1) / 127.0 / 2)
+
+    def testRoundTripFloat16(self):
+        self.check_round_trip('float16', lambda table: np.abs(table).max(axis=1) * 2.0**-11)
+
+    def testSmallTableIsKept(self):
+        table = np.random.uniform(-1.0, 1.0, (4, 8)).astype(np.float32)
+        model = self.create_model(table)
+        self.assertEqual(quantize_embeddings.convert_model(model, 'uint8', 1024), 0)
+        self.assertEqual([node.op_type for node in model.graph.node], ['Gather'])
+
+
+if __name__ == '__main__':
+    unittest.main(module=__name__, buffer=True)
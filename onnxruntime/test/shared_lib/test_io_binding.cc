@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/onnxruntime_cxx_api.h"
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include "test_fixture.h"
+
+using namespace onnxruntime;
+
+static constexpr PATH_TYPE MODEL_URI = TSTR("testdata/mul_1.pb");
+
+static std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> CreateFloatTensor(OrtAllocatorInfo* info,
+                                                                              std::vector<float>& data,
+                                                                              const std::vector<size_t>& shape) {
+  OrtValue* value = nullptr;
+  ORT_THROW_ON_ERROR(OrtCreateTensorWithDataAsOrtValue(info, data.data(), data.size() * sizeof(float),
+                                                        shape.data(), shape.size(),
+                                                        ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &value));
+  return std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)>(value, OrtReleaseValue);
+}
+
+TEST_F(CApiTest, io_binding_preallocated_output) {
+  SessionOptionsWrapper sf(env);
+  std::unique_ptr<OrtSession, decltype(&OrtReleaseSession)> session(sf.OrtCreateSession(MODEL_URI),
+                                                                     OrtReleaseSession);
+  OrtAllocatorInfo* info_ptr;
+  ORT_THROW_ON_ERROR(OrtCreateCpuAllocatorInfo(OrtDeviceAllocator, OrtMemTypeDefault, &info_ptr));
+  std::unique_ptr<OrtAllocatorInfo, decltype(&OrtReleaseAllocatorInfo)> info(info_ptr, OrtReleaseAllocatorInfo);
+
+  const std::vector<size_t> shape = {3, 2};
+  std::vector<float> x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<float> y(6);
+  auto value_x = CreateFloatTensor(info.get(), x, shape);
+  auto value_y = CreateFloatTensor(info.get(), y, shape);
+
+  OrtIoBinding* binding_ptr;
+  ORT_THROW_ON_ERROR(OrtCreateIoBinding(session.get(), &binding_ptr));
+  std::unique_ptr<OrtIoBinding> binding(binding_ptr);
+  ORT_THROW_ON_ERROR(OrtBindInput(binding.get(), "X", value_x.get()));
+  ORT_THROW_ON_ERROR(OrtBindOutput(binding.get(), "Y", value_y.get()));
+
+  // the binding is reused, the output is written into y each time
+  for (int i = 0; i != 2; ++i) {
+    for (auto& v : x) v += 1.0f;
+    ORT_THROW_ON_ERROR(OrtBindInput(binding.get(), "X", value_x.get()));
+    ORT_THROW_ON_ERROR(OrtRunWithBinding(session.get(), nullptr, binding.get()));
+    for (size_t j = 0; j != x.size(); ++j) {
+      ASSERT_EQ(x[j] * x[j], y[j]);
+    }
+  }
+
+  size_t output_count;
+  ORT_THROW_ON_ERROR(OrtGetBoundOutputCount(binding.get(), &output_count));
+  ASSERT_EQ(output_count, 1u);
+  OrtValue* output;
+  ORT_THROW_ON_ERROR(OrtGetBoundOutputValue(binding.get(), 0, &output));
+  void* output_data;
+  ORT_THROW_ON_ERROR(OrtGetTensorMutableData(output, &output_data));
+  ASSERT_EQ(output_data, y.data());
+  OrtReleaseValue(output);
+}
+
+TEST_F(CApiTest, io_binding_preallocated_output_of_other_shape) {
+  SessionOptionsWrapper sf(env);
+  std::unique_ptr<OrtSession, decltype(&OrtReleaseSession)> session(sf.OrtCreateSession(MODEL_URI),
+                                                                     OrtReleaseSession);
+  OrtAllocatorInfo* info_ptr;
+  ORT_THROW_ON_ERROR(OrtCreateCpuAllocatorInfo(OrtDeviceAllocator, OrtMemTypeDefault, &info_ptr));
+  std::unique_ptr<OrtAllocatorInfo, decltype(&OrtReleaseAllocatorInfo)> info(info_ptr, OrtReleaseAllocatorInfo);
+
+  std::vector<float> x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<float> y(6);
+  auto value_x = CreateFloatTensor(info.get(), x, {3, 2});
+  auto value_y = CreateFloatTensor(info.get(), y, {6});
+
+  OrtIoBinding* binding_ptr;
+  ORT_THROW_ON_ERROR(OrtCreateIoBinding(session.get(), &binding_ptr));
+  std::unique_ptr<OrtIoBinding> binding(binding_ptr);
+  ORT_THROW_ON_ERROR(OrtBindInput(binding.get(), "X", value_x.get()));
+  ORT_THROW_ON_ERROR(OrtBindOutput(binding.get(), "Y", value_y.get()));
+
+  // y can't hold the output of shape {3, 2} so it is replaced by a new output
+  ORT_THROW_ON_ERROR(OrtRunWithBinding(session.get(), nullptr, binding.get()));
+
+  OrtValue* output;
+  ORT_THROW_ON_ERROR(OrtGetBoundOutputValue(binding.get(), 0, &output));
+  std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> output_y(output, OrtReleaseValue);
+  float* output_data;
+  ORT_THROW_ON_ERROR(OrtGetTensorMutableData(output_y.get(), (void**)&output_data));
+  ASSERT_NE(output_data, y.data());
+  for (size_t j = 0; j != x.size(); ++j) {
+    ASSERT_EQ(x[j] * x[j], output_data[j]);
+  }
+}
+
+TEST_F(CApiTest, io_binding_output_to_device) {
+  SessionOptionsWrapper sf(env);
+  std::unique_ptr<OrtSession, decltype(&OrtReleaseSession)> session(sf.OrtCreateSession(MODEL_URI),
+                                                                     OrtReleaseSession);
+  OrtAllocatorInfo* info_ptr;
+  ORT_THROW_ON_ERROR(OrtCreateCpuAllocatorInfo(OrtArenaAllocator, OrtMemTypeDefault, &info_ptr));
+  std::unique_ptr<OrtAllocatorInfo, decltype(&OrtReleaseAllocatorInfo)> info(info_ptr, OrtReleaseAllocatorInfo);
+
+  const std::vector<size_t> shape = {3, 2};
+  std::vector<float> x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  auto value_x = CreateFloatTensor(info.get(), x, shape);
+
+  OrtIoBinding* binding_ptr;
+  ORT_THROW_ON_ERROR(OrtCreateIoBinding(session.get(), &binding_ptr));
+  std::unique_ptr<OrtIoBinding> binding(binding_ptr);
+  ORT_THROW_ON_ERROR(OrtBindInput(binding.get(), "X", value_x.get()));
+  ORT_THROW_ON_ERROR(OrtBindOutputToDevice(binding.get(), "Y", info.get()));
+  ORT_THROW_ON_ERROR(OrtRunWithBinding(session.get(), nullptr, binding.get()));
+
+  OrtValue* output;
+  ORT_THROW_ON_ERROR(OrtGetBoundOutputValue(binding.get(), 0, &output));
+  std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> value_y(output, OrtReleaseValue);
+  float* y;
+  ORT_THROW_ON_ERROR(OrtGetTensorMutableData(value_y.get(), (void**)&y));
+  for (size_t j = 0; j != x.size(); ++j) {
+    ASSERT_EQ(x[j] * x[j], y[j]);
+  }
+}
+
+TEST_F(CApiTest, io_binding_state) {
+  SessionOptionsWrapper sf(env);
+  std::unique_ptr<OrtSession, decltype(&OrtReleaseSession)> session(sf.OrtCreateSession(MODEL_URI),
+                                                                     OrtReleaseSession);
+  OrtAllocatorInfo* info_ptr;
+  ORT_THROW_ON_ERROR(OrtCreateCpuAllocatorInfo(OrtDeviceAllocator, OrtMemTypeDefault, &info_ptr));
+  std::unique_ptr<OrtAllocatorInfo, decltype(&OrtReleaseAllocatorInfo)> info(info_ptr, OrtReleaseAllocatorInfo);
+
+  const std::vector<size_t> shape = {3, 2};
+  std::vector<float> x = {1.0f, 2.0f, 1.5f, 0.5f, -1.0f, 1.25f};
+  auto value_x = CreateFloatTensor(info.get(), x, shape);
+
+  OrtIoBinding* binding_ptr;
+  ORT_THROW_ON_ERROR(OrtCreateIoBinding(session.get(), &binding_ptr));
+  std::unique_ptr<OrtIoBinding> binding(binding_ptr);
+
+  // Y = X * X, feeding Y back to X gives x^2, x^4, x^8 ...
+  ORT_THROW_ON_ERROR(OrtBindState(binding.get(), "X", "Y", value_x.get()));
+
+  for (int pass = 0; pass != 2; ++pass) {
+    std::vector<float> expected = x;
+    for (int i = 0; i != 3; ++i) {
+      ORT_THROW_ON_ERROR(OrtRunWithBinding(session.get(), nullptr, binding.get()));
+      for (auto& v : expected) v *= v;
+
+      OrtValue* output;
+      ORT_THROW_ON_ERROR(OrtGetBoundOutputValue(binding.get(), 0, &output));
+      std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> value_y(output, OrtReleaseValue);
+      float* y;
+      ORT_THROW_ON_ERROR(OrtGetTensorMutableData(value_y.get(), (void**)&y));
+      for (size_t j = 0; j != x.size(); ++j) {
+        ASSERT_EQ(expected[j], y[j]);
+      }
+    }
+
+    // the initial value isn't modified by the runs
+    OrtResetBoundStates(binding.get());
+  }
+}